@@ -24,7 +24,9 @@
 #include <deal.II/base/mu_parser_internal.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 
+#include <array>
 #include <map>
 #include <vector>
 
@@ -344,6 +346,43 @@ public:
   virtual double
   value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+  /**
+   * Return all components of the function at the given point.
+   */
+  virtual void
+  vector_value(const Point<dim> &p, Vector<double> &values) const override;
+
+  /**
+   * Return the value of the given component of the function at all the
+   * given points. This is considerably faster than calling value() for each
+   * point, since the parser objects of the current thread are looked up only
+   * once.
+   */
+  virtual void
+  value_list(const std::vector<Point<dim>> &points,
+             std::vector<double> &          values,
+             const unsigned int             component = 0) const override;
+
+  /**
+   * Return all components of the function at all the given points, looking
+   * up the parser objects of the current thread only once.
+   */
+  virtual void
+  vector_value_list(const std::vector<Point<dim>> &points,
+                    std::vector<Vector<double>> &  values) const override;
+
+  /**
+   * Return the value of the given component of the function at the points
+   * whose coordinates are given by the lanes of @p p, as for example
+   * returned by FEEvaluation::quadrature_point(). This allows to use a
+   * FunctionParser object for coefficients or right hand sides inside the
+   * quadrature loops of matrix-free operators.
+   */
+  template <std::size_t width>
+  VectorizedArray<double, width>
+  value(const Point<dim, VectorizedArray<double, width>> &p,
+        const unsigned int                               component = 0) const;
+
   /**
    * Return an array of function expressions (one per component), used to
    * initialize this function.
@@ -372,6 +411,30 @@ public:
 };
 
 
+template <int dim>
+template <std::size_t width>
+VectorizedArray<double, width>
+FunctionParser<dim>::value(const Point<dim, VectorizedArray<double, width>> &p,
+                           const unsigned int component) const
+{
+  std::array<Point<dim>, width> points;
+  for (unsigned int v = 0; v < width; ++v)
+    for (unsigned int d = 0; d < dim; ++d)
+      points[v][d] = p[d][v];
+
+  std::array<double, width> values;
+  this->do_value_list(make_array_view(points.cbegin(), points.cend()),
+                      this->get_time(),
+                      component,
+                      make_array_view(values.begin(), values.end()));
+
+  VectorizedArray<double, width> result;
+  result.load(values.data());
+  return result;
+}
+
+
+
 template <int dim>
 std::string
 FunctionParser<dim>::default_variable_names()
@@ -21,6 +21,8 @@
 #include <deal.II/base/smartpointer.h>
 #include <deal.II/base/tensor.h>
 
+#include <vector>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace Functions
@@ -73,6 +75,24 @@ namespace Functions
     hessian(const Point<dim> & point,
             const unsigned int component) const override;
 
+    /**
+     * Evaluate the restriction at all @p points with a single call to
+     * Function::value_list() of the higher-dimensional function.
+     */
+    void
+    value_list(const std::vector<Point<dim>> &points,
+               std::vector<double> &          values,
+               const unsigned int             component) const override;
+
+    /**
+     * Evaluate the gradient of the restriction at all @p points with a single
+     * call to Function::gradient_list() of the higher-dimensional function.
+     */
+    void
+    gradient_list(const std::vector<Point<dim>> &points,
+                  std::vector<Tensor<1, dim>> &  gradients,
+                  const unsigned int             component) const override;
+
   private:
     // The higher-dimensional function that has been restricted.
     const SmartPointer<const Function<dim + 1>> function;
@@ -132,6 +152,24 @@ namespace Functions
     SymmetricTensor<2, 1>
     hessian(const Point<1> &point, const unsigned int component) const override;
 
+    /**
+     * Evaluate the restriction at all @p points with a single call to
+     * Function::value_list() of the higher-dimensional function.
+     */
+    void
+    value_list(const std::vector<Point<1>> &points,
+               std::vector<double> &        values,
+               const unsigned int           component) const override;
+
+    /**
+     * Evaluate the gradient of the restriction at all @p points with a single
+     * call to Function::gradient_list() of the higher-dimensional function.
+     */
+    void
+    gradient_list(const std::vector<Point<1>> &points,
+                  std::vector<Tensor<1, 1>> &  gradients,
+                  const unsigned int           component) const override;
+
   private:
     // The higher-dimensional function that has been restricted.
     const SmartPointer<const Function<dim + 1>> function;
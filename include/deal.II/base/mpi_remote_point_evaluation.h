@@ -1,6 +1,6 @@
 // ---------------------------------------------------------------------
 //
-// Copyright (C) 2021 - 2022 by the deal.II authors
+// Copyright (C) 2021 - 2023 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -20,9 +20,13 @@
 
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi_tags.h>
+#include <deal.II/base/subscriptor.h>
 
 #include <deal.II/dofs/dof_handler.h>
 
+#include <cstring>
+#include <type_traits>
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -41,7 +45,7 @@ namespace Utilities
      *   result according to the points.
      */
     template <int dim, int spacedim = dim>
-    class RemotePointEvaluation
+    class RemotePointEvaluation : public Subscriptor
     {
     public:
       /**
@@ -70,6 +74,20 @@ namespace Utilities
        */
       ~RemotePointEvaluation();
 
+      /**
+       * The persistent MPI requests set up by evaluate_and_process() refer to
+       * the buffers of this object, and the signal connected to the
+       * triangulation refers to this object, so objects of this class cannot
+       * be copied.
+       */
+      RemotePointEvaluation(const RemotePointEvaluation &) = delete;
+
+      /**
+       * Copy assignment is not possible, see the copy constructor.
+       */
+      RemotePointEvaluation &
+      operator=(const RemotePointEvaluation &) = delete;
+
       /**
        * Set up internal data structures and communication pattern based on
        * a list of points @p points and mesh description (@p tria and @p
@@ -86,6 +104,38 @@ namespace Utilities
              const Triangulation<dim, spacedim> &tria,
              const Mapping<dim, spacedim> &      mapping);
 
+      /**
+       * Update the positions of the points passed to reinit(), e.g., for
+       * points that move slightly in every time step. The new positions are
+       * sent to the processes that own the cells the points were found in
+       * before, which compute the reference positions of the points in these
+       * cells. If every point is still inside (up to the tolerance) all of
+       * its cells, only the reference positions are updated, and the
+       * communication pattern, including the persistent MPI requests used by
+       * evaluate_and_process(), is kept.
+       *
+       * Otherwise, the communication pattern is updated incrementally: A
+       * point stays associated with those of its cells that still contain
+       * it. Only the points that are not inside any of their previous cells
+       * anymore, as well as the points that were not found during the last
+       * setup (see all_points_found()), are located anew, as in reinit().
+       * The entries of all other points keep their place in the
+       * communication pattern.
+       *
+       * @note If a point lay on a face or vertex shared by several cells and
+       *   still lies inside all of them, it keeps being associated with all
+       *   of them. Conversely, a point that moves onto a face shared with
+       *   another cell is not associated with that cell, unless it has left
+       *   all of its previous cells.
+       *
+       * @return Whether the communication pattern was kept unchanged.
+       *
+       * @warning This is a collective call that needs to be executed by all
+       *   processors in the communicator.
+       */
+      bool
+      update_points(const std::vector<Point<spacedim>> &points);
+
       /**
        * Data of points positioned in a cell.
        */
@@ -126,6 +176,11 @@ namespace Utilities
        *   vertex) that is shared by multiple cells or a point is outside of the
        *   computational domain.
        *
+       * @note For types @p T that are trivially copyable (except bool), the
+       *   values are communicated through persistent MPI requests (see
+       *   MPI_Send_init() and MPI_Recv_init()), which are set up on the first
+       *   call and reused until the communication pattern changes.
+       *
        * @warning This is a collective call that needs to be executed by all
        *   processors in the communicator.
        */
@@ -202,6 +257,42 @@ namespace Utilities
       is_ready() const;
 
     private:
+      /**
+       * Send the values in @p buffer_comm, sorted by the ranks in send_ranks,
+       * to the processes that requested them, and write the values received
+       * from other processes into @p output. This variant communicates
+       * through persistent requests and is used for trivially copyable types.
+       */
+      template <typename T>
+      void
+      communicate_evaluated_values(const ArrayView<const T> &buffer_comm,
+                                   std::vector<T> &          output,
+                                   std::true_type) const;
+
+      /**
+       * Same as above, but serializing the values. This variant is used for
+       * all other types.
+       */
+      template <typename T>
+      void
+      communicate_evaluated_values(const ArrayView<const T> &buffer_comm,
+                                   std::vector<T> &          output,
+                                   std::false_type) const;
+
+      /**
+       * Free the persistent MPI requests and their buffers.
+       */
+      void
+      clear_persistent_requests() const;
+
+      /**
+       * Set unique_mapping and all_points_found_flag from the number of
+       * entries of each point given by point_ptrs. This is a collective
+       * call.
+       */
+      void
+      update_mapping_flags();
+
       /**
        * Tolerance to be used while determining the surrounding cells of a
        * point.
@@ -301,6 +392,25 @@ namespace Utilities
        * specified by send_ranks.
        */
       std::vector<unsigned int> send_ptrs;
+
+      /**
+       * The size in bytes of the type the persistent requests have been set
+       * up for, or zero if they have not been set up.
+       */
+      mutable std::size_t persistent_requests_entry_size;
+
+      /**
+       * Buffers the persistent requests send from and receive into.
+       */
+      mutable std::vector<char> persistent_send_buffer;
+      mutable std::vector<char> persistent_recv_buffer;
+
+      /**
+       * Persistent requests for sending to the ranks in send_ranks and
+       * receiving from the ranks in recv_ranks, excluding the own rank.
+       */
+      mutable std::vector<MPI_Request> persistent_send_requests;
+      mutable std::vector<MPI_Request> persistent_recv_requests;
     };
 
 
@@ -372,6 +482,135 @@ namespace Utilities
             buffer_comm[send_index] = buffer_eval[i];
         }
 
+      // send data and receive the results evaluated on other processes
+      communicate_evaluated_values(
+        ArrayView<const T>(buffer_comm.data(), buffer_comm.size()),
+        output,
+        std::integral_constant<bool,
+                               std::is_trivially_copyable<T>::value &&
+                                 !std::is_same<T, bool>::value>());
+#endif
+    }
+
+
+    template <int dim, int spacedim>
+    template <typename T>
+    void
+    RemotePointEvaluation<dim, spacedim>::communicate_evaluated_values(
+      const ArrayView<const T> &buffer_comm,
+      std::vector<T> &          output,
+      std::true_type) const
+    {
+#ifndef DEAL_II_WITH_MPI
+      Assert(false, ExcNeedsMPI());
+      (void)buffer_comm;
+      (void)output;
+#else
+      const unsigned int my_rank =
+        Utilities::MPI::this_mpi_process(tria->get_communicator());
+
+      // set up the persistent requests on first use, they stay valid as long
+      // as the communication pattern is not changed
+      if (persistent_requests_entry_size != sizeof(T))
+        {
+          clear_persistent_requests();
+
+          persistent_send_buffer.resize(buffer_comm.size() * sizeof(T));
+          persistent_recv_buffer.resize(
+            (recv_ptrs.empty() ? 0 : recv_ptrs.back()) * sizeof(T));
+
+          for (unsigned int i = 0; i < send_ranks.size(); ++i)
+            {
+              if (send_ranks[i] == my_rank)
+                continue;
+
+              persistent_send_requests.emplace_back(MPI_Request());
+              const int ierr =
+                MPI_Send_init(persistent_send_buffer.data() +
+                                send_ptrs[i] * sizeof(T),
+                              (send_ptrs[i + 1] - send_ptrs[i]) * sizeof(T),
+                              MPI_CHAR,
+                              send_ranks[i],
+                              internal::Tags::remote_point_evaluation,
+                              tria->get_communicator(),
+                              &persistent_send_requests.back());
+              AssertThrowMPI(ierr);
+            }
+
+          for (unsigned int i = 0; i < recv_ranks.size(); ++i)
+            {
+              if (recv_ranks[i] == my_rank)
+                continue;
+
+              persistent_recv_requests.emplace_back(MPI_Request());
+              const int ierr =
+                MPI_Recv_init(persistent_recv_buffer.data() +
+                                recv_ptrs[i] * sizeof(T),
+                              (recv_ptrs[i + 1] - recv_ptrs[i]) * sizeof(T),
+                              MPI_CHAR,
+                              recv_ranks[i],
+                              internal::Tags::remote_point_evaluation,
+                              tria->get_communicator(),
+                              &persistent_recv_requests.back());
+              AssertThrowMPI(ierr);
+            }
+
+          persistent_requests_entry_size = sizeof(T);
+        }
+
+      AssertDimension(buffer_comm.size() * sizeof(T),
+                      persistent_send_buffer.size());
+      AssertDimension(output.size(), recv_permutation.size());
+      if (buffer_comm.size() > 0)
+        std::memcpy(persistent_send_buffer.data(),
+                    buffer_comm.data(),
+                    persistent_send_buffer.size());
+
+      int ierr = MPI_Startall(persistent_recv_requests.size(),
+                              persistent_recv_requests.data());
+      AssertThrowMPI(ierr);
+      ierr = MPI_Startall(persistent_send_requests.size(),
+                          persistent_send_requests.data());
+      AssertThrowMPI(ierr);
+
+      ierr = MPI_Waitall(persistent_recv_requests.size(),
+                         persistent_recv_requests.data(),
+                         MPI_STATUSES_IGNORE);
+      AssertThrowMPI(ierr);
+
+      // write data into output vector
+      for (unsigned int j = 0; j < recv_ranks.size(); ++j)
+        if (recv_ranks[j] != my_rank)
+          for (unsigned int i = recv_ptrs[j]; i < recv_ptrs[j + 1]; ++i)
+            std::memcpy(&output[recv_permutation[i]],
+                        persistent_recv_buffer.data() + i * sizeof(T),
+                        sizeof(T));
+
+      // make sure all messages have been sent
+      ierr = MPI_Waitall(persistent_send_requests.size(),
+                         persistent_send_requests.data(),
+                         MPI_STATUSES_IGNORE);
+      AssertThrowMPI(ierr);
+#endif
+    }
+
+
+    template <int dim, int spacedim>
+    template <typename T>
+    void
+    RemotePointEvaluation<dim, spacedim>::communicate_evaluated_values(
+      const ArrayView<const T> &buffer_comm,
+      std::vector<T> &          output,
+      std::false_type) const
+    {
+#ifndef DEAL_II_WITH_MPI
+      Assert(false, ExcNeedsMPI());
+      (void)buffer_comm;
+      (void)output;
+#else
+      const unsigned int my_rank =
+        Utilities::MPI::this_mpi_process(tria->get_communicator());
+
       // send data
       std::vector<std::vector<char>> send_buffer;
       send_buffer.reserve(send_ranks.size());
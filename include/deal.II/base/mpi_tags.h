@@ -153,6 +153,10 @@ namespace Utilities
           affine_constraints_make_consistent_in_parallel_0,
           affine_constraints_make_consistent_in_parallel_1,
 
+          // internal::MatrixFreeFunctions::VectorDataExchange::Full::
+          // synchronize_sm_neighbors()
+          vector_data_exchange_synchronize_sm_neighbors,
+
         };
       } // namespace Tags
     }   // namespace internal
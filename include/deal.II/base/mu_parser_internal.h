@@ -196,6 +196,27 @@ namespace internal
                     const double       time,
                     ArrayView<Number> &values) const;
 
+      /**
+       * Compute the values of a single component at all the given points.
+       * This is faster than calling do_value() for each point because the
+       * thread-local parser objects are looked up only once.
+       */
+      void
+      do_value_list(const ArrayView<const Point<dim>> &points,
+                    const double                       time,
+                    const unsigned int                 component,
+                    const ArrayView<Number> &          values) const;
+
+      /**
+       * Compute the values of all components at all the given points. The
+       * value of component @p c at point @p q is stored in
+       * <code>values[q * n_components + c]</code>.
+       */
+      void
+      do_all_values_list(const ArrayView<const Point<dim>> &points,
+                         const double                       time,
+                         const ArrayView<Number> &          values) const;
+
       /**
        * An array of function expressions (one per component), required to
        * initialize tfp in each thread.
@@ -18,6 +18,8 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/std_cxx17/optional.h>
 #include <deal.II/base/subscriptor.h>
@@ -32,6 +34,9 @@
 
 #include <deal.II/lac/vector.h>
 
+#include <boost/signals2/connection.hpp>
+
+#include <functional>
 #include <map>
 #include <type_traits>
 #include <vector>
@@ -254,6 +259,252 @@ private:
 };
 
 
+/**
+ * A class for storing at each active cell represented by iterators of type
+ * @p CellIteratorType a vector of data @p DataType, like CellDataStorage, but
+ * with all data of the locally stored cells kept by value in a single
+ * contiguous array.
+ *
+ * CellDataStorage stores the objects of every quadrature point as a separate
+ * heap allocation, and finds the data of a cell by a lookup of its CellId in
+ * a std::map. For problems with many quadrature points, e.g., the history
+ * variables of plasticity models, this results in a large memory overhead and
+ * in poor data locality. This class instead stores the objects of all cells
+ * one after another, and keeps for each active cell, indexed by
+ * CellAccessor::active_cell_index(), the position of its data in this array.
+ * Accessing the data of a cell with get_data() therefore is a constant-time
+ * operation that returns an ArrayView into the array, and the data of
+ * neighboring cells is stored next to each other if the cells are
+ * initialized in the order of the active cells.
+ *
+ * Since the active cell indices change whenever the triangulation changes,
+ * this class connects to the Triangulation::Signals::any_change signal of the
+ * triangulation. After each change, the data of all cells that are still
+ * active, identified by their CellId, is moved to a new array in the order of
+ * the new active cell indices, and the data of all other cells is removed.
+ * The data of refined or coarsened cells can be carried over to the new cells
+ * with parallel::distributed::ContinuousQuadratureDataTransfer, in the same
+ * way as for CellDataStorage.
+ *
+ * In contrast to CellDataStorage, all cells store objects of the same type
+ * @p DataType, which needs to be default constructible and move
+ * constructible. The data of a cell is accessed as
+ * @code
+ * const ArrayView<MyQData> data = data_storage.get_data(cell);
+ * for (unsigned int q = 0; q < data.size(); ++q)
+ *   data[q].value = ...;
+ * @endcode
+ *
+ * @note The ArrayView objects returned by get_data() and try_get_data() are
+ * invalidated by calls to initialize() or erase() and by changes of the
+ * triangulation. Initializing all cells at once with the initialize()
+ * function that takes a range of cells only allocates memory once.
+ */
+template <typename CellIteratorType, typename DataType>
+class ContiguousCellDataStorage : public Subscriptor
+{
+public:
+  /**
+   * Default constructor.
+   */
+  ContiguousCellDataStorage() = default;
+
+  /**
+   * Copying this object is not possible, since it is connected to the
+   * signals of the triangulation.
+   */
+  ContiguousCellDataStorage(const ContiguousCellDataStorage &) = delete;
+
+  /**
+   * Destructor. Disconnects from the triangulation.
+   */
+  ~ContiguousCellDataStorage() override;
+
+  /**
+   * Copying this object is not possible, since it is connected to the
+   * signals of the triangulation.
+   */
+  ContiguousCellDataStorage &
+  operator=(const ContiguousCellDataStorage &) = delete;
+
+  /**
+   * Initialize data on the active @p cell to store
+   * @p number_of_data_points_per_cell default constructed objects of type
+   * @p DataType. This function has to be called on every cell where data is
+   * to be stored.
+   *
+   * @note Subsequent calls of this function with the same @p cell will not
+   * alter the objects associated with it. In order to remove the stored data,
+   * use the erase() function.
+   *
+   * @note The first time this method is called, it stores a SmartPointer to
+   * the Triangulation object that owns the cell. The future invocations of
+   * this method expects the cell to be from the same stored triangulation.
+   */
+  void
+  initialize(const CellIteratorType &cell,
+             const unsigned int      number_of_data_points_per_cell);
+
+  /**
+   * Same as above but for a range of iterators starting at @p cell_start
+   * until, but not including, @p cell_end for all locally owned active cells,
+   * i.e. for which `cell->is_locally_owned()==true`. The memory for the data
+   * of all these cells is allocated at once.
+   */
+  void
+  initialize(const CellIteratorType &cell_start,
+             const CellIteratorType &cell_end,
+             const unsigned int      number_of_data_points_per_cell);
+
+  /**
+   * Removes data stored at the @p cell. Returns true if the data was removed.
+   * If no data is attached to the @p cell, this function will not do anything
+   * and returns false.
+   */
+  bool
+  erase(const CellIteratorType &cell);
+
+  /**
+   * Clear all the data stored in this object.
+   */
+  void
+  clear();
+
+  /**
+   * Get a view to the data located at @p cell.
+   *
+   * @pre @p cell must be an active cell from the same Triangulation that is
+   * used to initialize() the cell data, and data must have been initialized
+   * on it.
+   */
+  ArrayView<DataType>
+  get_data(const CellIteratorType &cell);
+
+  /**
+   * Get a view to the constant data located at @p cell.
+   *
+   * @pre @p cell must be an active cell from the same Triangulation that is
+   * used to initialize() the cell data, and data must have been initialized
+   * on it.
+   */
+  ArrayView<const DataType>
+  get_data(const CellIteratorType &cell) const;
+
+  /**
+   * Returns a std_cxx17::optional indicating whether @p cell contains an
+   * associated data or not. If data is available, dereferencing the
+   * std_cxx17::optional reveals a view to the data at the quadrature points.
+   * For cells that are not active, an empty std_cxx17::optional is returned.
+   *
+   * @pre @p cell must be from the same Triangulation that is used to
+   * initialize() the cell data.
+   */
+  std_cxx17::optional<ArrayView<DataType>>
+  try_get_data(const CellIteratorType &cell);
+
+  /**
+   * Returns a std_cxx17::optional indicating whether @p cell contains an
+   * associated data or not. If data is available, dereferencing the
+   * std_cxx17::optional reveals a view to the constant data at the
+   * quadrature points. For cells that are not active, an empty
+   * std_cxx17::optional is returned.
+   *
+   * @pre @p cell must be from the same Triangulation that is used to
+   * initialize() the cell data.
+   */
+  std_cxx17::optional<ArrayView<const DataType>>
+  try_get_data(const CellIteratorType &cell) const;
+
+  /**
+   * Return the total number of data objects stored in this object.
+   */
+  std::size_t
+  n_data_points() const;
+
+  /**
+   * Return an estimate for the memory consumption, in bytes, of this
+   * object, not counting memory that the objects of type @p DataType
+   * allocate themselves.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Number of dimensions
+   */
+  static constexpr unsigned int dimension =
+    CellIteratorType::AccessorType::dimension;
+
+  /**
+   * Number of space dimensions
+   */
+  static constexpr unsigned int space_dimension =
+    CellIteratorType::AccessorType::space_dimension;
+
+  /**
+   * Resize the arrays indexed by the active cell index to the current number
+   * of active cells of the triangulation.
+   */
+  void
+  resize_cell_arrays();
+
+  /**
+   * Move the data of all cells that are still active after a change of the
+   * triangulation to a new array in the order of the new active cell
+   * indices, and remove the data of all other cells.
+   */
+  void
+  reorder_after_triangulation_change();
+
+  /**
+   * To ensure that all the cells in the ContiguousCellDataStorage come from
+   * the same Triangulation, we need to store a reference to that
+   * Triangulation within the class.
+   */
+  SmartPointer<const Triangulation<dimension, space_dimension>,
+               ContiguousCellDataStorage<CellIteratorType, DataType>>
+    tria;
+
+  /**
+   * The connection to the Triangulation::Signals::any_change signal of the
+   * triangulation.
+   */
+  boost::signals2::connection tria_listener;
+
+  /**
+   * The data of all cells, stored one cell after another.
+   */
+  std::vector<DataType> data;
+
+  /**
+   * For each active cell, the position of its first data object in the
+   * @p data array, or numbers::invalid_size_type if no data is stored on
+   * the cell.
+   */
+  std::vector<std::size_t> cell_data_offsets;
+
+  /**
+   * For each active cell, the number of data objects stored on it.
+   */
+  std::vector<unsigned int> cell_data_sizes;
+
+  /**
+   * For each active cell with data, its CellId. This is needed to identify
+   * the cells after a change of the triangulation.
+   */
+  std::vector<CellId> cell_ids;
+
+  /**
+   * @addtogroup Exceptions
+   */
+  DeclExceptionMsg(
+    ExcTriangulationMismatch,
+    "The provided cell iterator does not belong to the triangulation that corresponds to the ContiguousCellDataStorage object.");
+};
+
+
+
 /**
  * An abstract class which specifies requirements for data on
  * a single quadrature point to be transferable during refinement or
@@ -408,6 +659,11 @@ namespace parallel
      * objects of arbitrary order, although with a little bit more work in
      * packing and unpacking of data inside MyQData class.
      *
+     * The data can also be stored in a ContiguousCellDataStorage object
+     * instead of a CellDataStorage object, in which case the data on the new
+     * cells is initialized in the same way with
+     * ContiguousCellDataStorage::initialize().
+     *
      * @note Currently coarsening is not supported.
      *
      * @note The functionality provided by this class can alternatively be achieved
@@ -478,6 +734,15 @@ namespace parallel
         parallel::distributed::Triangulation<dim> &  tria,
         CellDataStorage<CellIteratorType, DataType> &data_storage);
 
+      /**
+       * Same as above, but for cell data stored in a
+       * ContiguousCellDataStorage object.
+       */
+      void
+      prepare_for_coarsening_and_refinement(
+        parallel::distributed::Triangulation<dim> &            tria,
+        ContiguousCellDataStorage<CellIteratorType, DataType> &data_storage);
+
       /**
        * Interpolate the data previously stored in this object before the mesh
        * was refined or coarsened onto the quadrature points of the currently
@@ -572,9 +837,20 @@ namespace parallel
       unsigned int handle;
 
       /**
-       * A pointer to the CellDataStorage class whose data will be transferred.
+       * A function packing the data stored on a cell in the CellDataStorage
+       * or ContiguousCellDataStorage object whose data will be transferred
+       * into a matrix, with the quadrature points as first index.
+       */
+      std::function<void(const CellIteratorType &, FullMatrix<double> &)>
+        pack_cell_data_function;
+
+      /**
+       * A function unpacking the data at the quadrature points of a cell
+       * from a matrix into the CellDataStorage or ContiguousCellDataStorage
+       * object whose data will be transferred.
        */
-      CellDataStorage<CellIteratorType, DataType> *data_storage;
+      std::function<void(const CellIteratorType &, const FullMatrix<double> &)>
+        unpack_cell_data_function;
 
       /**
        * A pointer to the distributed triangulation to which cell data is
@@ -806,6 +1082,278 @@ CellDataStorage<CellIteratorType, DataType>::try_get_data(
     }
 }
 
+//--------------------------------------------------------------------
+//                    ContiguousCellDataStorage
+//--------------------------------------------------------------------
+
+template <typename CellIteratorType, typename DataType>
+inline ContiguousCellDataStorage<CellIteratorType,
+                                 DataType>::~ContiguousCellDataStorage()
+{
+  tria_listener.disconnect();
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline void
+ContiguousCellDataStorage<CellIteratorType, DataType>::initialize(
+  const CellIteratorType &cell,
+  const unsigned int      n_q_points)
+{
+  // The first time this method is called, it has to initialize the reference
+  // to the triangulation object and connect to its signals
+  if (!tria)
+    {
+      tria          = &cell->get_triangulation();
+      tria_listener = tria->signals.any_change.connect(
+        [this]() { this->reorder_after_triangulation_change(); });
+      resize_cell_arrays();
+    }
+  Assert(&cell->get_triangulation() == tria, ExcTriangulationMismatch());
+  Assert(cell->is_active(),
+         ExcMessage("Data can only be stored on active cells."));
+
+  const unsigned int index = cell->active_cell_index();
+  AssertIndexRange(index, cell_data_offsets.size());
+  if (cell_data_offsets[index] == numbers::invalid_size_type)
+    {
+      cell_data_offsets[index] = data.size();
+      cell_data_sizes[index]   = n_q_points;
+      cell_ids[index]          = cell->id();
+      data.resize(data.size() + n_q_points);
+    }
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline void
+ContiguousCellDataStorage<CellIteratorType, DataType>::initialize(
+  const CellIteratorType &cell_start,
+  const CellIteratorType &cell_end,
+  const unsigned int      number)
+{
+  std::size_t n_new_data_points = 0;
+  for (CellIteratorType it = cell_start; it != cell_end; ++it)
+    if (it->is_locally_owned() && it->is_active() &&
+        (cell_data_offsets.size() <= it->active_cell_index() ||
+         cell_data_offsets[it->active_cell_index()] ==
+           numbers::invalid_size_type))
+      n_new_data_points += number;
+  data.reserve(data.size() + n_new_data_points);
+
+  for (CellIteratorType it = cell_start; it != cell_end; ++it)
+    if (it->is_locally_owned() && it->is_active())
+      initialize(it, number);
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline bool
+ContiguousCellDataStorage<CellIteratorType, DataType>::erase(
+  const CellIteratorType &cell)
+{
+  if (!tria || !cell->is_active())
+    return false;
+  Assert(&cell->get_triangulation() == tria, ExcTriangulationMismatch());
+
+  const unsigned int index = cell->active_cell_index();
+  AssertIndexRange(index, cell_data_offsets.size());
+  const std::size_t offset = cell_data_offsets[index];
+  if (offset == numbers::invalid_size_type)
+    return false;
+
+  // close the gap in the data array and shift the offsets of all cells
+  // stored behind the erased cell
+  const unsigned int size = cell_data_sizes[index];
+  data.erase(data.begin() + offset, data.begin() + offset + size);
+  for (std::size_t &other_offset : cell_data_offsets)
+    if (other_offset != numbers::invalid_size_type && other_offset > offset)
+      other_offset -= size;
+
+  cell_data_offsets[index] = numbers::invalid_size_type;
+  cell_data_sizes[index]   = 0;
+  return true;
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline void
+ContiguousCellDataStorage<CellIteratorType, DataType>::clear()
+{
+  data.clear();
+  std::fill(cell_data_offsets.begin(),
+            cell_data_offsets.end(),
+            numbers::invalid_size_type);
+  std::fill(cell_data_sizes.begin(), cell_data_sizes.end(), 0u);
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline ArrayView<DataType>
+ContiguousCellDataStorage<CellIteratorType, DataType>::get_data(
+  const CellIteratorType &cell)
+{
+  Assert(&cell->get_triangulation() == tria, ExcTriangulationMismatch());
+
+  const unsigned int index = cell->active_cell_index();
+  AssertIndexRange(index, cell_data_offsets.size());
+  Assert(cell_data_offsets[index] != numbers::invalid_size_type,
+         ExcMessage("Could not find data for the cell"));
+
+  return make_array_view(data.data() + cell_data_offsets[index],
+                         data.data() + cell_data_offsets[index] +
+                           cell_data_sizes[index]);
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline ArrayView<const DataType>
+ContiguousCellDataStorage<CellIteratorType, DataType>::get_data(
+  const CellIteratorType &cell) const
+{
+  Assert(&cell->get_triangulation() == tria, ExcTriangulationMismatch());
+
+  const unsigned int index = cell->active_cell_index();
+  AssertIndexRange(index, cell_data_offsets.size());
+  Assert(cell_data_offsets[index] != numbers::invalid_size_type,
+         ExcMessage("Could not find QP data for the cell"));
+
+  return make_array_view(data.data() + cell_data_offsets[index],
+                         data.data() + cell_data_offsets[index] +
+                           cell_data_sizes[index]);
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline std_cxx17::optional<ArrayView<DataType>>
+ContiguousCellDataStorage<CellIteratorType, DataType>::try_get_data(
+  const CellIteratorType &cell)
+{
+  Assert(!tria || &cell->get_triangulation() == tria,
+         ExcTriangulationMismatch());
+
+  if (!cell->is_active() ||
+      cell->active_cell_index() >= cell_data_offsets.size() ||
+      cell_data_offsets[cell->active_cell_index()] ==
+        numbers::invalid_size_type)
+    return {};
+  else
+    return {get_data(cell)};
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline std_cxx17::optional<ArrayView<const DataType>>
+ContiguousCellDataStorage<CellIteratorType, DataType>::try_get_data(
+  const CellIteratorType &cell) const
+{
+  Assert(!tria || &cell->get_triangulation() == tria,
+         ExcTriangulationMismatch());
+
+  if (!cell->is_active() ||
+      cell->active_cell_index() >= cell_data_offsets.size() ||
+      cell_data_offsets[cell->active_cell_index()] ==
+        numbers::invalid_size_type)
+    return {};
+  else
+    return {get_data(cell)};
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline std::size_t
+ContiguousCellDataStorage<CellIteratorType, DataType>::n_data_points() const
+{
+  return data.size();
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline std::size_t
+ContiguousCellDataStorage<CellIteratorType, DataType>::memory_consumption()
+  const
+{
+  return sizeof(*this) + data.capacity() * sizeof(DataType) +
+         MemoryConsumption::memory_consumption(cell_data_offsets) +
+         MemoryConsumption::memory_consumption(cell_data_sizes) +
+         cell_ids.capacity() * sizeof(CellId);
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline void
+ContiguousCellDataStorage<CellIteratorType, DataType>::resize_cell_arrays()
+{
+  cell_data_offsets.assign(tria->n_active_cells(), numbers::invalid_size_type);
+  cell_data_sizes.assign(tria->n_active_cells(), 0u);
+  cell_ids.resize(tria->n_active_cells());
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline void
+ContiguousCellDataStorage<CellIteratorType,
+                          DataType>::reorder_after_triangulation_change()
+{
+  // collect the position of the data of all cells with data on the old mesh
+  std::map<CellId, unsigned int> old_cells;
+  for (unsigned int i = 0; i < cell_data_offsets.size(); ++i)
+    if (cell_data_offsets[i] != numbers::invalid_size_type)
+      old_cells.emplace(cell_ids[i], i);
+
+  const std::vector<std::size_t>  old_offsets = std::move(cell_data_offsets);
+  const std::vector<unsigned int> old_sizes   = std::move(cell_data_sizes);
+  std::vector<DataType>           old_data    = std::move(data);
+  data.clear();
+  resize_cell_arrays();
+
+  if (old_cells.empty())
+    return;
+
+  // find the cells that are still active, and move their data to the new
+  // array in the order of the new active cell indices
+  std::vector<unsigned int> old_index(cell_data_offsets.size(),
+                                      numbers::invalid_unsigned_int);
+  std::size_t               n_new_data_points = 0;
+  for (const auto &cell : tria->active_cell_iterators())
+    {
+      const auto it = old_cells.find(cell->id());
+      if (it != old_cells.end())
+        {
+          const unsigned int index = cell->active_cell_index();
+          old_index[index]         = it->second;
+          cell_ids[index]          = it->first;
+          n_new_data_points += old_sizes[it->second];
+        }
+    }
+
+  data.reserve(n_new_data_points);
+  for (unsigned int index = 0; index < old_index.size(); ++index)
+    if (old_index[index] != numbers::invalid_unsigned_int)
+      {
+        const std::size_t  old_offset = old_offsets[old_index[index]];
+        const unsigned int size       = old_sizes[old_index[index]];
+        cell_data_offsets[index]      = data.size();
+        cell_data_sizes[index]        = size;
+        for (unsigned int q = 0; q < size; ++q)
+          data.emplace_back(std::move(old_data[old_offset + q]));
+      }
+}
+
+
+
 //--------------------------------------------------------------------
 //                    ContinuousQuadratureDataTransfer
 //--------------------------------------------------------------------
@@ -884,6 +1432,77 @@ unpack_to_cell_data(const CellIteratorType &                     cell,
 }
 
 
+
+/*
+ * Same as above, but for data stored in a ContiguousCellDataStorage object.
+ */
+template <typename CellIteratorType, typename DataType>
+inline void
+pack_cell_data(
+  const CellIteratorType &                                     cell,
+  const ContiguousCellDataStorage<CellIteratorType, DataType> *data_storage,
+  FullMatrix<double> &                                         matrix_data)
+{
+  static_assert(
+    std::is_base_of<TransferableQuadraturePointData, DataType>::value,
+    "User's DataType class should be derived from QPData");
+
+  if (const auto qpd = data_storage->try_get_data(cell))
+    {
+      const unsigned int m = qpd->size();
+      Assert(m > 0, ExcInternalError());
+      const unsigned int n = (*qpd)[0].number_of_values();
+      matrix_data.reinit(m, n);
+
+      std::vector<double> single_qp_data(n);
+      for (unsigned int q = 0; q < m; ++q)
+        {
+          (*qpd)[q].pack_values(single_qp_data);
+          AssertDimension(single_qp_data.size(), n);
+
+          for (unsigned int i = 0; i < n; ++i)
+            matrix_data(q, i) = single_qp_data[i];
+        }
+    }
+  else
+    {
+      matrix_data.reinit({0, 0});
+    }
+}
+
+
+
+/*
+ * Same as above, but for data stored in a ContiguousCellDataStorage object.
+ */
+template <typename CellIteratorType, typename DataType>
+inline void
+unpack_to_cell_data(
+  const CellIteratorType &                               cell,
+  const FullMatrix<double> &                             values_at_qp,
+  ContiguousCellDataStorage<CellIteratorType, DataType> *data_storage)
+{
+  static_assert(
+    std::is_base_of<TransferableQuadraturePointData, DataType>::value,
+    "User's DataType class should be derived from QPData");
+
+  if (const auto qpd = data_storage->try_get_data(cell))
+    {
+      const unsigned int n = values_at_qp.n();
+      AssertDimension((*qpd)[0].number_of_values(), n);
+
+      std::vector<double> single_qp_data(n);
+      AssertDimension(qpd->size(), values_at_qp.m());
+
+      for (unsigned int q = 0; q < qpd->size(); ++q)
+        {
+          for (unsigned int i = 0; i < n; ++i)
+            single_qp_data[i] = values_at_qp(q, i);
+          (*qpd)[q].unpack_values(single_qp_data);
+        }
+    }
+}
+
 #  ifdef DEAL_II_WITH_P4EST
 
 namespace parallel
@@ -902,7 +1521,6 @@ namespace parallel
       , project_to_fe_matrix(projection_fe->n_dofs_per_cell(), n_q_points)
       , project_to_qp_matrix(n_q_points, projection_fe->n_dofs_per_cell())
       , handle(numbers::invalid_unsigned_int)
-      , data_storage(nullptr)
       , triangulation(nullptr)
     {
       Assert(
@@ -927,12 +1545,53 @@ namespace parallel
     ContinuousQuadratureDataTransfer<dim, DataType>::
       prepare_for_coarsening_and_refinement(
         parallel::distributed::Triangulation<dim> &  tr_,
-        CellDataStorage<CellIteratorType, DataType> &data_storage_)
+        CellDataStorage<CellIteratorType, DataType> &data_storage)
+    {
+      Assert(!pack_cell_data_function,
+             ExcMessage("This function can be called only once"));
+      triangulation = &tr_;
+
+      pack_cell_data_function = [&data_storage](const CellIteratorType &cell,
+                                                FullMatrix<double> &matrix) {
+        pack_cell_data(cell, &data_storage, matrix);
+      };
+      unpack_cell_data_function =
+        [&data_storage](const CellIteratorType &  cell,
+                        const FullMatrix<double> &matrix) {
+          unpack_to_cell_data(cell, matrix, &data_storage);
+        };
+
+      handle = triangulation->register_data_attach(
+        [this](
+          const typename parallel::distributed::Triangulation<
+            dim>::cell_iterator &cell,
+          const typename parallel::distributed::Triangulation<dim>::CellStatus
+            status) { return this->pack_function(cell, status); },
+        /*returns_variable_size_data=*/true);
+    }
+
+
+
+    template <int dim, typename DataType>
+    inline void
+    ContinuousQuadratureDataTransfer<dim, DataType>::
+      prepare_for_coarsening_and_refinement(
+        parallel::distributed::Triangulation<dim> &            tr_,
+        ContiguousCellDataStorage<CellIteratorType, DataType> &data_storage)
     {
-      Assert(data_storage == nullptr,
+      Assert(!pack_cell_data_function,
              ExcMessage("This function can be called only once"));
       triangulation = &tr_;
-      data_storage  = &data_storage_;
+
+      pack_cell_data_function = [&data_storage](const CellIteratorType &cell,
+                                                FullMatrix<double> &matrix) {
+        pack_cell_data(cell, &data_storage, matrix);
+      };
+      unpack_cell_data_function =
+        [&data_storage](const CellIteratorType &  cell,
+                        const FullMatrix<double> &matrix) {
+          unpack_to_cell_data(cell, matrix, &data_storage);
+        };
 
       handle = triangulation->register_data_attach(
         [this](
@@ -960,8 +1619,9 @@ namespace parallel
             &data_range) { this->unpack_function(cell, status, data_range); });
 
       // invalidate the pointers
-      data_storage  = nullptr;
-      triangulation = nullptr;
+      pack_cell_data_function   = nullptr;
+      unpack_cell_data_function = nullptr;
+      triangulation             = nullptr;
     }
 
 
@@ -974,7 +1634,7 @@ namespace parallel
       const typename parallel::distributed::Triangulation<
         dim>::CellStatus /*status*/)
     {
-      pack_cell_data(cell, data_storage, matrix_quadrature);
+      pack_cell_data_function(cell, matrix_quadrature);
 
       // project to FE
       const unsigned int number_of_values = matrix_quadrature.n();
@@ -1031,9 +1691,8 @@ namespace parallel
                                            matrix_dofs_child);
 
                 // finally, put back into the map:
-                unpack_to_cell_data(cell->child(child),
-                                    matrix_quadrature,
-                                    data_storage);
+                unpack_cell_data_function(cell->child(child),
+                                          matrix_quadrature);
               }
         }
       else
@@ -1043,7 +1702,7 @@ namespace parallel
           project_to_qp_matrix.mmult(matrix_quadrature, matrix_dofs);
 
           // finally, put back into the map:
-          unpack_to_cell_data(cell, matrix_quadrature, data_storage);
+          unpack_cell_data_function(cell, matrix_quadrature);
         }
     }
 
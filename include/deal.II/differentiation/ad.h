@@ -24,9 +24,11 @@
 #include <deal.II/differentiation/ad/adolc_math.h>
 #include <deal.II/differentiation/ad/adolc_number_types.h>
 #include <deal.II/differentiation/ad/adolc_product_types.h>
+#include <deal.II/differentiation/ad/dual_number.h>
 #include <deal.II/differentiation/ad/sacado_math.h>
 #include <deal.II/differentiation/ad/sacado_number_types.h>
 #include <deal.II/differentiation/ad/sacado_product_types.h>
+#include <deal.II/differentiation/ad/vectorized_ad_helpers.h>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -44,6 +46,11 @@ namespace Differentiation
    *   - ADOL-C
    *   - Sacado (a component of Trilinos)
    *
+   * In addition, the DualNumber class implements forward-mode automatic
+   * differentiation without any external library, and is used by the
+   * VectorizedScalarFunction class to differentiate functions at batches of
+   * points stored in VectorizedArray objects.
+   *
    * @ingroup auto_symb_diff
    */
   namespace AD
@@ -0,0 +1,961 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_differentiation_ad_dual_number_h
+#define dealii_differentiation_ad_dual_number_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/template_constraints.h>
+#include <deal.II/base/vectorization.h>
+
+#include <array>
+#include <cmath>
+#include <ostream>
+#include <type_traits>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Differentiation
+{
+  namespace AD
+  {
+    /**
+     * A number type for forward-mode automatic differentiation with a
+     * fixed number of directional derivatives, also known as a dual number.
+     * An object of this class stores a value $f$ and the derivatives
+     * $\partial f / \partial x_i$, $i=0,\ldots,n-1$, with respect to
+     * @p n_derivatives independent variables, and all arithmetic operations
+     * and mathematical functions apply the chain rule to the derivatives.
+     *
+     * In contrast to the number types of the ADOL-C and Sacado libraries,
+     * which are wrapped by the classes in ad_helpers.h, this class is
+     * templated on the underlying number type and has a size that is known
+     * at compile time. It can therefore be used with
+     * <code>Number = VectorizedArray<double></code>, in which case each
+     * operation computes the values and derivatives for all lanes of the
+     * vectorized array at once. This is the case needed for the
+     * linearization of constitutive laws inside the quadrature loops of
+     * matrix-free operators, where the quantities at the quadrature points
+     * of several cells are stored in VectorizedArray objects; see the
+     * VectorizedScalarFunction class. Second derivatives are obtained by
+     * nesting, i.e., by using
+     * <code>DualNumber<DualNumber<Number, n>, n></code>.
+     *
+     * Objects of this class can be used as the number type of Tensor and
+     * SymmetricTensor objects. Since VectorizedArray does not support
+     * comparison operators that return a single boolean, neither does this
+     * class, and functions with kinks such as <code>std::abs</code> or
+     * <code>std::max</code> are not provided.
+     *
+     * @tparam Number The number type of the value and the derivatives, e.g.,
+     * <code>double</code>, <code>VectorizedArray<double></code> or another
+     * DualNumber.
+     * @tparam n_derivatives The number of independent variables with
+     * respect to which derivatives are computed.
+     */
+    template <typename Number, int n_derivatives>
+    class DualNumber
+    {
+    public:
+      static_assert(n_derivatives > 0,
+                    "The number of derivatives must be positive.");
+
+      /**
+       * The number type of the value and the derivatives.
+       */
+      using value_type = Number;
+
+      /**
+       * Default constructor. Sets the value and all derivatives to zero.
+       */
+      DualNumber();
+
+      /**
+       * Constructor for a constant, i.e., a number with the given value and
+       * zero derivatives.
+       */
+      DualNumber(const Number &value);
+
+      /**
+       * Constructor for a constant given by a scalar. This allows to use
+       * literals like <code>2.</code> also if @p Number is a VectorizedArray
+       * or a DualNumber.
+       */
+      template <typename T,
+                typename = std::enable_if_t<std::is_arithmetic<T>::value &&
+                                            !std::is_same<T, Number>::value>>
+      DualNumber(const T &value);
+
+      /**
+       * Constructor for an independent variable with the given @p value,
+       * i.e., a number whose derivative with respect to the variable with
+       * index @p index is one and all other derivatives are zero.
+       */
+      DualNumber(const Number &value, const unsigned int index);
+
+      /**
+       * Return a reference to the value.
+       */
+      Number &
+      value();
+
+      /**
+       * Return a reference to the value.
+       */
+      const Number &
+      value() const;
+
+      /**
+       * Return a reference to the derivative with respect to the independent
+       * variable with index @p i.
+       */
+      Number &
+      derivative(const unsigned int i);
+
+      /**
+       * Return a reference to the derivative with respect to the independent
+       * variable with index @p i.
+       */
+      const Number &
+      derivative(const unsigned int i) const;
+
+      /**
+       * Add another number to this one.
+       */
+      DualNumber &
+      operator+=(const DualNumber &other);
+
+      /**
+       * Subtract another number from this one.
+       */
+      DualNumber &
+      operator-=(const DualNumber &other);
+
+      /**
+       * Multiply this number by another one.
+       */
+      DualNumber &
+      operator*=(const DualNumber &other);
+
+      /**
+       * Divide this number by another one.
+       */
+      DualNumber &
+      operator/=(const DualNumber &other);
+
+      /**
+       * Add a constant to this number.
+       */
+      DualNumber &
+      operator+=(const Number &other);
+
+      /**
+       * Subtract a constant from this number.
+       */
+      DualNumber &
+      operator-=(const Number &other);
+
+      /**
+       * Multiply this number by a constant.
+       */
+      DualNumber &
+      operator*=(const Number &other);
+
+      /**
+       * Divide this number by a constant.
+       */
+      DualNumber &
+      operator/=(const Number &other);
+
+    private:
+      /**
+       * The value.
+       */
+      Number val;
+
+      /**
+       * The derivatives with respect to the independent variables.
+       */
+      std::array<Number, n_derivatives> derivatives;
+    };
+
+
+
+    namespace internal
+    {
+      /**
+       * A helper struct that extracts the underlying scalar type of a
+       * (possibly nested) DualNumber and VectorizedArray type.
+       */
+      template <typename Number>
+      struct DualNumberScalarType
+      {
+        using type = Number;
+      };
+
+      template <typename Number, std::size_t width>
+      struct DualNumberScalarType<VectorizedArray<Number, width>>
+      {
+        using type = typename DualNumberScalarType<Number>::type;
+      };
+
+      template <typename Number, int n_derivatives>
+      struct DualNumberScalarType<DualNumber<Number, n_derivatives>>
+      {
+        using type = typename DualNumberScalarType<Number>::type;
+      };
+    } // namespace internal
+
+  } // namespace AD
+} // namespace Differentiation
+
+
+
+template <typename Number, int n_derivatives>
+struct EnableIfScalar<Differentiation::AD::DualNumber<Number, n_derivatives>>
+{
+  using type =
+    Differentiation::AD::DualNumber<typename EnableIfScalar<Number>::type,
+                                    n_derivatives>;
+};
+
+
+
+/* ------------------------- inline functions ------------------------- */
+
+#ifndef DOXYGEN
+
+namespace Differentiation
+{
+  namespace AD
+  {
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>::DualNumber()
+      : val(0.)
+    {
+      derivatives.fill(Number(0.));
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>::DualNumber(const Number &value)
+      : val(value)
+    {
+      derivatives.fill(Number(0.));
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    template <typename T, typename>
+    inline DualNumber<Number, n_derivatives>::DualNumber(const T &value)
+      : val(value)
+    {
+      derivatives.fill(Number(0.));
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>::DualNumber(
+      const Number &     value,
+      const unsigned int index)
+      : val(value)
+    {
+      AssertIndexRange(index, n_derivatives);
+      derivatives.fill(Number(0.));
+      derivatives[index] = Number(1.);
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline Number &
+    DualNumber<Number, n_derivatives>::value()
+    {
+      return val;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline const Number &
+    DualNumber<Number, n_derivatives>::value() const
+    {
+      return val;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline Number &
+    DualNumber<Number, n_derivatives>::derivative(const unsigned int i)
+    {
+      AssertIndexRange(i, n_derivatives);
+      return derivatives[i];
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline const Number &
+    DualNumber<Number, n_derivatives>::derivative(const unsigned int i) const
+    {
+      AssertIndexRange(i, n_derivatives);
+      return derivatives[i];
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives> &
+    DualNumber<Number, n_derivatives>::operator+=(const DualNumber &other)
+    {
+      val += other.val;
+      for (unsigned int i = 0; i < n_derivatives; ++i)
+        derivatives[i] += other.derivatives[i];
+      return *this;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives> &
+    DualNumber<Number, n_derivatives>::operator-=(const DualNumber &other)
+    {
+      val -= other.val;
+      for (unsigned int i = 0; i < n_derivatives; ++i)
+        derivatives[i] -= other.derivatives[i];
+      return *this;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives> &
+    DualNumber<Number, n_derivatives>::operator*=(const DualNumber &other)
+    {
+      for (unsigned int i = 0; i < n_derivatives; ++i)
+        derivatives[i] =
+          derivatives[i] * other.val + val * other.derivatives[i];
+      val *= other.val;
+      return *this;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives> &
+    DualNumber<Number, n_derivatives>::operator/=(const DualNumber &other)
+    {
+      const Number inverse = Number(1.) / other.val;
+      val *= inverse;
+      for (unsigned int i = 0; i < n_derivatives; ++i)
+        derivatives[i] =
+          (derivatives[i] - val * other.derivatives[i]) * inverse;
+      return *this;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives> &
+    DualNumber<Number, n_derivatives>::operator+=(const Number &other)
+    {
+      val += other;
+      return *this;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives> &
+    DualNumber<Number, n_derivatives>::operator-=(const Number &other)
+    {
+      val -= other;
+      return *this;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives> &
+    DualNumber<Number, n_derivatives>::operator*=(const Number &other)
+    {
+      val *= other;
+      for (unsigned int i = 0; i < n_derivatives; ++i)
+        derivatives[i] *= other;
+      return *this;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives> &
+    DualNumber<Number, n_derivatives>::operator/=(const Number &other)
+    {
+      const Number inverse = Number(1.) / other;
+      val *= inverse;
+      for (unsigned int i = 0; i < n_derivatives; ++i)
+        derivatives[i] *= inverse;
+      return *this;
+    }
+
+  } // namespace AD
+} // namespace Differentiation
+
+#endif // DOXYGEN
+
+
+
+namespace Differentiation
+{
+  namespace AD
+  {
+    /**
+     * @name Arithmetic operations on DualNumber objects
+     */
+    /** @{ */
+
+    /**
+     * Unary minus.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator-(const DualNumber<Number, n_derivatives> &x)
+    {
+      DualNumber<Number, n_derivatives> result(-x.value());
+      for (unsigned int i = 0; i < n_derivatives; ++i)
+        result.derivative(i) = -x.derivative(i);
+      return result;
+    }
+
+
+
+    /**
+     * Unary plus.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator+(const DualNumber<Number, n_derivatives> &x)
+    {
+      return x;
+    }
+
+
+
+    /**
+     * Sum of two numbers.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator+(const DualNumber<Number, n_derivatives> &x,
+              const DualNumber<Number, n_derivatives> &y)
+    {
+      DualNumber<Number, n_derivatives> result = x;
+      return result += y;
+    }
+
+
+
+    /**
+     * Difference of two numbers.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator-(const DualNumber<Number, n_derivatives> &x,
+              const DualNumber<Number, n_derivatives> &y)
+    {
+      DualNumber<Number, n_derivatives> result = x;
+      return result -= y;
+    }
+
+
+
+    /**
+     * Product of two numbers.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator*(const DualNumber<Number, n_derivatives> &x,
+              const DualNumber<Number, n_derivatives> &y)
+    {
+      DualNumber<Number, n_derivatives> result = x;
+      return result *= y;
+    }
+
+
+
+    /**
+     * Quotient of two numbers.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator/(const DualNumber<Number, n_derivatives> &x,
+              const DualNumber<Number, n_derivatives> &y)
+    {
+      DualNumber<Number, n_derivatives> result = x;
+      return result /= y;
+    }
+
+
+
+    /**
+     * Sum of a number and a constant of the underlying number type.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator+(const DualNumber<Number, n_derivatives> &x, const Number &y)
+    {
+      DualNumber<Number, n_derivatives> result = x;
+      return result += y;
+    }
+
+
+
+    /**
+     * Sum of a constant of the underlying number type and a number.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator+(const Number &x, const DualNumber<Number, n_derivatives> &y)
+    {
+      DualNumber<Number, n_derivatives> result = y;
+      return result += x;
+    }
+
+
+
+    /**
+     * Difference of a number and a constant of the underlying number type.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator-(const DualNumber<Number, n_derivatives> &x, const Number &y)
+    {
+      DualNumber<Number, n_derivatives> result = x;
+      return result -= y;
+    }
+
+
+
+    /**
+     * Difference of a constant of the underlying number type and a number.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator-(const Number &x, const DualNumber<Number, n_derivatives> &y)
+    {
+      DualNumber<Number, n_derivatives> result = -y;
+      return result += x;
+    }
+
+
+
+    /**
+     * Product of a number and a constant of the underlying number type.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator*(const DualNumber<Number, n_derivatives> &x, const Number &y)
+    {
+      DualNumber<Number, n_derivatives> result = x;
+      return result *= y;
+    }
+
+
+
+    /**
+     * Product of a constant of the underlying number type and a number.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator*(const Number &x, const DualNumber<Number, n_derivatives> &y)
+    {
+      DualNumber<Number, n_derivatives> result = y;
+      return result *= x;
+    }
+
+
+
+    /**
+     * Quotient of a number and a constant of the underlying number type.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator/(const DualNumber<Number, n_derivatives> &x, const Number &y)
+    {
+      DualNumber<Number, n_derivatives> result = x;
+      return result /= y;
+    }
+
+
+
+    /**
+     * Quotient of a constant of the underlying number type and a number.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator/(const Number &x, const DualNumber<Number, n_derivatives> &y)
+    {
+      const Number                      inverse = Number(1.) / y.value();
+      DualNumber<Number, n_derivatives> result(x * inverse);
+      const Number                      factor = -result.value() * inverse;
+      for (unsigned int i = 0; i < n_derivatives; ++i)
+        result.derivative(i) = factor * y.derivative(i);
+      return result;
+    }
+
+
+
+    /**
+     * Sum of a number and a scalar constant.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives, typename T>
+    inline std::enable_if_t<std::is_arithmetic<T>::value,
+                            DualNumber<Number, n_derivatives>>
+    operator+(const DualNumber<Number, n_derivatives> &x, const T &y)
+    {
+      return x + Number(y);
+    }
+
+
+
+    /**
+     * Sum of a scalar constant and a number.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives, typename T>
+    inline std::enable_if_t<std::is_arithmetic<T>::value,
+                            DualNumber<Number, n_derivatives>>
+    operator+(const T &x, const DualNumber<Number, n_derivatives> &y)
+    {
+      return Number(x) + y;
+    }
+
+
+
+    /**
+     * Difference of a number and a scalar constant.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives, typename T>
+    inline std::enable_if_t<std::is_arithmetic<T>::value,
+                            DualNumber<Number, n_derivatives>>
+    operator-(const DualNumber<Number, n_derivatives> &x, const T &y)
+    {
+      return x - Number(y);
+    }
+
+
+
+    /**
+     * Difference of a scalar constant and a number.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives, typename T>
+    inline std::enable_if_t<std::is_arithmetic<T>::value,
+                            DualNumber<Number, n_derivatives>>
+    operator-(const T &x, const DualNumber<Number, n_derivatives> &y)
+    {
+      return Number(x) - y;
+    }
+
+
+
+    /**
+     * Product of a number and a scalar constant.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives, typename T>
+    inline std::enable_if_t<std::is_arithmetic<T>::value,
+                            DualNumber<Number, n_derivatives>>
+    operator*(const DualNumber<Number, n_derivatives> &x, const T &y)
+    {
+      return x * Number(y);
+    }
+
+
+
+    /**
+     * Product of a scalar constant and a number.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives, typename T>
+    inline std::enable_if_t<std::is_arithmetic<T>::value,
+                            DualNumber<Number, n_derivatives>>
+    operator*(const T &x, const DualNumber<Number, n_derivatives> &y)
+    {
+      return Number(x) * y;
+    }
+
+
+
+    /**
+     * Quotient of a number and a scalar constant.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives, typename T>
+    inline std::enable_if_t<std::is_arithmetic<T>::value,
+                            DualNumber<Number, n_derivatives>>
+    operator/(const DualNumber<Number, n_derivatives> &x, const T &y)
+    {
+      return x / Number(y);
+    }
+
+
+
+    /**
+     * Quotient of a scalar constant and a number.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives, typename T>
+    inline std::enable_if_t<std::is_arithmetic<T>::value,
+                            DualNumber<Number, n_derivatives>>
+    operator/(const T &x, const DualNumber<Number, n_derivatives> &y)
+    {
+      return Number(x) / y;
+    }
+
+
+
+    /**
+     * Write the value and the derivatives of a number to a stream.
+     *
+     * @relatesalso DualNumber
+     */
+    template <typename Number, int n_derivatives>
+    inline std::ostream &
+    operator<<(std::ostream &out, const DualNumber<Number, n_derivatives> &x)
+    {
+      out << x.value() << " [";
+      for (unsigned int i = 0; i < n_derivatives; ++i)
+        out << (i > 0 ? " " : "") << x.derivative(i);
+      out << ']';
+      return out;
+    }
+
+    /** @} */
+
+  } // namespace AD
+} // namespace Differentiation
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+
+/**
+ * Implementation of functions from cmath on DualNumber. As for
+ * VectorizedArray, these functions reside in namespace std in order to
+ * ensure a similar interface as for the respective functions in cmath, so
+ * that generic code can call them as, e.g., std::sqrt.
+ */
+namespace std
+{
+  template <typename Number, int n_derivatives>
+  ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  sqrt(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+         &x);
+
+  template <typename Number, int n_derivatives>
+  ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  exp(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x);
+
+  template <typename Number, int n_derivatives>
+  ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  log(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x);
+
+  template <typename Number, int n_derivatives>
+  ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  pow(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x,
+      const typename ::dealii::Differentiation::AD::internal::
+        DualNumberScalarType<Number>::type p);
+
+  template <typename Number, int n_derivatives>
+  ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  sin(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x);
+
+  template <typename Number, int n_derivatives>
+  ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  cos(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x);
+
+
+
+  /**
+   * Square root of a DualNumber.
+   *
+   * @relatesalso DualNumber
+   */
+  template <typename Number, int n_derivatives>
+  inline ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  sqrt(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+         &x)
+  {
+    ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives> result(
+      std::sqrt(x.value()));
+    const Number factor = Number(0.5) / result.value();
+    for (unsigned int i = 0; i < n_derivatives; ++i)
+      result.derivative(i) = factor * x.derivative(i);
+    return result;
+  }
+
+
+
+  /**
+   * Exponential of a DualNumber.
+   *
+   * @relatesalso DualNumber
+   */
+  template <typename Number, int n_derivatives>
+  inline ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  exp(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x)
+  {
+    ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives> result(
+      std::exp(x.value()));
+    for (unsigned int i = 0; i < n_derivatives; ++i)
+      result.derivative(i) = result.value() * x.derivative(i);
+    return result;
+  }
+
+
+
+  /**
+   * Natural logarithm of a DualNumber.
+   *
+   * @relatesalso DualNumber
+   */
+  template <typename Number, int n_derivatives>
+  inline ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  log(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x)
+  {
+    ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives> result(
+      std::log(x.value()));
+    const Number inverse = Number(1.) / x.value();
+    for (unsigned int i = 0; i < n_derivatives; ++i)
+      result.derivative(i) = inverse * x.derivative(i);
+    return result;
+  }
+
+
+
+  /**
+   * Raise a DualNumber to the scalar power @p p.
+   *
+   * @relatesalso DualNumber
+   */
+  template <typename Number, int n_derivatives>
+  inline ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  pow(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x,
+      const typename ::dealii::Differentiation::AD::internal::
+        DualNumberScalarType<Number>::type p)
+  {
+    ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives> result(
+      std::pow(x.value(), p));
+    const Number factor = p * std::pow(x.value(), p - 1);
+    for (unsigned int i = 0; i < n_derivatives; ++i)
+      result.derivative(i) = factor * x.derivative(i);
+    return result;
+  }
+
+
+
+  /**
+   * Sine of a DualNumber.
+   *
+   * @relatesalso DualNumber
+   */
+  template <typename Number, int n_derivatives>
+  inline ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  sin(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x)
+  {
+    ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives> result(
+      std::sin(x.value()));
+    const Number factor = std::cos(x.value());
+    for (unsigned int i = 0; i < n_derivatives; ++i)
+      result.derivative(i) = factor * x.derivative(i);
+    return result;
+  }
+
+
+
+  /**
+   * Cosine of a DualNumber.
+   *
+   * @relatesalso DualNumber
+   */
+  template <typename Number, int n_derivatives>
+  inline ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  cos(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x)
+  {
+    ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives> result(
+      std::cos(x.value()));
+    const Number factor = -std::sin(x.value());
+    for (unsigned int i = 0; i < n_derivatives; ++i)
+      result.derivative(i) = factor * x.derivative(i);
+    return result;
+  }
+} // namespace std
+
+#endif
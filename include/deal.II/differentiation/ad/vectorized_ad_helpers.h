@@ -0,0 +1,701 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_differentiation_ad_vectorized_ad_helpers_h
+#define dealii_differentiation_ad_vectorized_ad_helpers_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/symmetric_tensor.h>
+#include <deal.II/base/table_indices.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/differentiation/ad/dual_number.h>
+
+#include <deal.II/fe/fe_values_extractors.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Differentiation
+{
+  namespace AD
+  {
+    namespace internal
+    {
+      /**
+       * A helper struct that describes how the field associated with an
+       * extractor maps to the independent variables of a
+       * VectorizedScalarFunction. Its members have the same meaning as the
+       * ones of the corresponding struct used by the helper classes in
+       * ad_helpers.h.
+       */
+      template <int dim, typename ExtractorType>
+      struct VectorizedExtractor;
+
+
+      /**
+       * Specialization for scalar fields.
+       */
+      template <int dim>
+      struct VectorizedExtractor<dim, FEValuesExtractors::Scalar>
+      {
+        static constexpr unsigned int n_components = 1;
+
+        static constexpr unsigned int rank = 0;
+
+        static constexpr bool is_symmetric = false;
+
+        template <typename NumberType>
+        using value_type = NumberType;
+
+        static unsigned int
+        first_component(const FEValuesExtractors::Scalar &extractor)
+        {
+          return extractor.component;
+        }
+
+        template <int rank_out>
+        static void
+        set_table_indices(TableIndices<rank_out> &,
+                          const unsigned int,
+                          const unsigned int,
+                          const bool = false)
+        {}
+
+        static double
+        symmetry_factor(const unsigned int)
+        {
+          return 1.;
+        }
+      };
+
+
+      /**
+       * Specialization for vector fields.
+       */
+      template <int dim>
+      struct VectorizedExtractor<dim, FEValuesExtractors::Vector>
+      {
+        static constexpr unsigned int n_components = dim;
+
+        static constexpr unsigned int rank = 1;
+
+        static constexpr bool is_symmetric = false;
+
+        template <typename NumberType>
+        using value_type = Tensor<1, dim, NumberType>;
+
+        static unsigned int
+        first_component(const FEValuesExtractors::Vector &extractor)
+        {
+          return extractor.first_vector_component;
+        }
+
+        template <int rank_out>
+        static void
+        set_table_indices(TableIndices<rank_out> &table_indices,
+                          const unsigned int      offset,
+                          const unsigned int      unrolled_index,
+                          const bool = false)
+        {
+          table_indices[offset] = unrolled_index;
+        }
+
+        static double
+        symmetry_factor(const unsigned int)
+        {
+          return 1.;
+        }
+      };
+
+
+      /**
+       * Specialization for rank-2 tensor fields.
+       */
+      template <int dim>
+      struct VectorizedExtractor<dim, FEValuesExtractors::Tensor<2>>
+      {
+        static constexpr unsigned int n_components = dim * dim;
+
+        static constexpr unsigned int rank = 2;
+
+        static constexpr bool is_symmetric = false;
+
+        template <typename NumberType>
+        using value_type = Tensor<2, dim, NumberType>;
+
+        static unsigned int
+        first_component(const FEValuesExtractors::Tensor<2> &extractor)
+        {
+          return extractor.first_tensor_component;
+        }
+
+        template <int rank_out>
+        static void
+        set_table_indices(TableIndices<rank_out> &table_indices,
+                          const unsigned int      offset,
+                          const unsigned int      unrolled_index,
+                          const bool = false)
+        {
+          const TableIndices<2> indices =
+            Tensor<2, dim>::unrolled_to_component_indices(unrolled_index);
+          table_indices[offset]     = indices[0];
+          table_indices[offset + 1] = indices[1];
+        }
+
+        static double
+        symmetry_factor(const unsigned int)
+        {
+          return 1.;
+        }
+      };
+
+
+      /**
+       * Specialization for rank-2 symmetric tensor fields. Only the
+       * independent components of the tensor are independent variables, so
+       * that the derivative with respect to an off-diagonal component
+       * accumulates the contributions of both symmetric counterparts. These
+       * derivatives are scaled by one half upon extraction. The indices of
+       * the symmetric counterpart of a component are obtained by passing
+       * <tt>transposed = true</tt> to set_table_indices().
+       */
+      template <int dim>
+      struct VectorizedExtractor<dim, FEValuesExtractors::SymmetricTensor<2>>
+      {
+        static constexpr unsigned int n_components =
+          SymmetricTensor<2, dim>::n_independent_components;
+
+        static constexpr unsigned int rank = 2;
+
+        static constexpr bool is_symmetric = true;
+
+        template <typename NumberType>
+        using value_type = SymmetricTensor<2, dim, NumberType>;
+
+        static unsigned int
+        first_component(const FEValuesExtractors::SymmetricTensor<2> &extractor)
+        {
+          return extractor.first_tensor_component;
+        }
+
+        template <int rank_out>
+        static void
+        set_table_indices(TableIndices<rank_out> &table_indices,
+                          const unsigned int      offset,
+                          const unsigned int      unrolled_index,
+                          const bool              transposed = false)
+        {
+          const TableIndices<2> indices =
+            SymmetricTensor<2, dim>::unrolled_to_component_indices(
+              unrolled_index);
+          table_indices[offset]     = indices[transposed ? 1 : 0];
+          table_indices[offset + 1] = indices[transposed ? 0 : 1];
+        }
+
+        static double
+        symmetry_factor(const unsigned int unrolled_index)
+        {
+          const TableIndices<2> indices =
+            SymmetricTensor<2, dim>::unrolled_to_component_indices(
+              unrolled_index);
+          return indices[0] == indices[1] ? 1. : 0.5;
+        }
+      };
+
+
+      /**
+       * A helper struct that selects the type of a derivative of the given
+       * @p rank: the plain number type for rank zero, a SymmetricTensor if
+       * the derivative has the symmetries of a symmetric tensor, and a Tensor
+       * otherwise.
+       */
+      template <int rank, int dim, typename NumberType, bool is_symmetric>
+      struct VectorizedDerivativeType
+      {
+        using type = Tensor<rank, dim, NumberType>;
+      };
+
+      template <int rank, int dim, typename NumberType>
+      struct VectorizedDerivativeType<rank, dim, NumberType, true>
+      {
+        using type = SymmetricTensor<rank, dim, NumberType>;
+      };
+
+      template <int dim, typename NumberType>
+      struct VectorizedDerivativeType<0, dim, NumberType, false>
+      {
+        using type = NumberType;
+      };
+
+
+      /**
+       * Return a reference to the entry of @p t with the given indices. For
+       * scalar fields, @p t itself is returned and the indices are ignored.
+       */
+      template <typename NumberType, int rank>
+      inline NumberType &
+      get_vectorized_entry(NumberType &t, const TableIndices<rank> &)
+      {
+        return t;
+      }
+
+      template <typename NumberType, int rank>
+      inline const NumberType &
+      get_vectorized_entry(const NumberType &t, const TableIndices<rank> &)
+      {
+        return t;
+      }
+
+      template <int rank, int dim, typename NumberType>
+      inline NumberType &
+      get_vectorized_entry(Tensor<rank, dim, NumberType> &t,
+                           const TableIndices<rank> &     indices)
+      {
+        return t[indices];
+      }
+
+      template <int rank, int dim, typename NumberType>
+      inline const NumberType &
+      get_vectorized_entry(const Tensor<rank, dim, NumberType> &t,
+                           const TableIndices<rank> &           indices)
+      {
+        return t[indices];
+      }
+
+      template <int rank, int dim, typename NumberType>
+      inline NumberType &
+      get_vectorized_entry(SymmetricTensor<rank, dim, NumberType> &t,
+                           const TableIndices<rank> &              indices)
+      {
+        return t[indices];
+      }
+
+      template <int rank, int dim, typename NumberType>
+      inline const NumberType &
+      get_vectorized_entry(const SymmetricTensor<rank, dim, NumberType> &t,
+                           const TableIndices<rank> &indices)
+      {
+        return t[indices];
+      }
+    } // namespace internal
+
+
+
+    /**
+     * A helper class for the computation of the first and second derivatives
+     * of a scalar function, typically a stored energy density, with respect
+     * to a set of field variables, at a batch of points at once. This class
+     * is the counterpart of the ScalarFunction class for the DualNumber type
+     * with a number type @p Number that is usually a VectorizedArray. It is
+     * intended for the linearization of constitutive laws inside the
+     * quadrature loops of matrix-free operators, where FEEvaluation provides
+     * the field variables at the quadrature points of several cells in the
+     * lanes of a VectorizedArray, and all lanes are differentiated at once.
+     *
+     * The interface follows the one of ScalarFunction, except that the
+     * number of independent variables is a template argument, so that all
+     * derivatives are stored in arrays of fixed size, and that the gradient
+     * and the Hessian are returned as Tensor objects of that size:
+     * @code
+     *   using ADHelper = AD::VectorizedScalarFunction<
+     *     dim, SymmetricTensor<2, dim>::n_independent_components>;
+     *   using ADNumberType = typename ADHelper::ad_type;
+     *   const FEValuesExtractors::SymmetricTensor<2> C_dofs(0);
+     *
+     *   for (const unsigned int q : phi.quadrature_point_indices())
+     *     {
+     *       const SymmetricTensor<2, dim, VectorizedArray<double>> C = ...;
+     *
+     *       ADHelper ad_helper;
+     *       ad_helper.register_independent_variable(C, C_dofs);
+     *       const SymmetricTensor<2, dim, ADNumberType> C_AD =
+     *         ad_helper.get_sensitive_variables(C_dofs);
+     *
+     *       const ADNumberType psi = ...; // energy in terms of C_AD
+     *       ad_helper.register_dependent_variable(psi);
+     *
+     *       const auto Dpsi  = ad_helper.compute_gradient();
+     *       const auto D2psi = ad_helper.compute_hessian();
+     *       const SymmetricTensor<2, dim, VectorizedArray<double>> S =
+     *         2. * ADHelper::extract_gradient_component(Dpsi, C_dofs);
+     *       const SymmetricTensor<4, dim, VectorizedArray<double>> HH =
+     *         4. * ADHelper::extract_hessian_component(D2psi, C_dofs, C_dofs);
+     *       ...
+     *     }
+     * @endcode
+     *
+     * The derivatives are computed by forward-mode automatic differentiation
+     * with nested DualNumber objects while the function is evaluated. Each
+     * operation therefore costs a multiple of $n^2$ operations for $n$
+     * independent variables, which is efficient for the small number of
+     * independent variables typical for constitutive laws. There is no tape,
+     * so that the function has to be evaluated anew for each batch of
+     * points, and objects of this class may be used concurrently from
+     * several threads.
+     *
+     * @tparam dim The space dimension of the fields.
+     * @tparam n_independent_variables The total number of components of all
+     * fields that are registered as independent variables.
+     * @tparam Number The number type of the values of the fields.
+     */
+    template <int dim,
+              int n_independent_variables,
+              typename Number = VectorizedArray<double>>
+    class VectorizedScalarFunction
+    {
+    public:
+      /**
+       * The number type that is used in, and results from, all computations.
+       */
+      using scalar_type = Number;
+
+      /**
+       * The number type used for the computation of first derivatives.
+       */
+      using first_derivative_type = DualNumber<Number, n_independent_variables>;
+
+      /**
+       * The auto-differentiable number type that is used in the definition
+       * of the function.
+       */
+      using ad_type =
+        DualNumber<first_derivative_type, n_independent_variables>;
+
+      /**
+       * Register the value of a field @p value whose components are the
+       * independent variables associated with the given @p extractor.
+       */
+      template <typename ExtractorType>
+      void
+      register_independent_variable(
+        const typename internal::VectorizedExtractor<dim, ExtractorType>::
+          template value_type<Number> &value,
+        const ExtractorType &          extractor);
+
+      /**
+       * Return the field associated with the given @p extractor in terms of
+       * auto-differentiable numbers that track the derivatives with respect
+       * to all independent variables. This field has to be registered with
+       * register_independent_variable() before.
+       */
+      template <typename ExtractorType>
+      typename internal::VectorizedExtractor<dim, ExtractorType>::
+        template value_type<ad_type>
+        get_sensitive_variables(const ExtractorType &extractor) const;
+
+      /**
+       * Register the definition of the scalar function.
+       */
+      void
+      register_dependent_variable(const ad_type &func);
+
+      /**
+       * Return the value of the scalar function.
+       */
+      Number
+      compute_value() const;
+
+      /**
+       * Return the gradient of the scalar function with respect to all
+       * independent variables.
+       */
+      Tensor<1, n_independent_variables, Number>
+      compute_gradient() const;
+
+      /**
+       * Return the Hessian of the scalar function with respect to all
+       * independent variables.
+       */
+      Tensor<2, n_independent_variables, Number>
+      compute_hessian() const;
+
+      /**
+       * Extract the gradient of the scalar function with respect to the field
+       * associated with @p extractor_row from the @p gradient with respect to
+       * all independent variables, taking into account the symmetries of
+       * symmetric tensor fields.
+       */
+      template <typename ExtractorType_Row>
+      static typename internal::VectorizedExtractor<dim, ExtractorType_Row>::
+        template value_type<Number>
+        extract_gradient_component(
+          const Tensor<1, n_independent_variables, Number> &gradient,
+          const ExtractorType_Row &                         extractor_row);
+
+      /**
+       * Extract the Hessian of the scalar function with respect to the fields
+       * associated with @p extractor_row and @p extractor_col from the
+       * @p hessian with respect to all independent variables, taking into
+       * account the symmetries of symmetric tensor fields. The returned
+       * object is a Tensor whose first indices are associated with the field
+       * of @p extractor_row and whose last indices are associated with the
+       * field of @p extractor_col. If both fields are symmetric tensors, or
+       * one of them is a symmetric tensor and the other one a scalar, then
+       * the result is a SymmetricTensor.
+       */
+      template <typename ExtractorType_Row, typename ExtractorType_Col>
+      static typename internal::VectorizedDerivativeType<
+        internal::VectorizedExtractor<dim, ExtractorType_Row>::rank +
+          internal::VectorizedExtractor<dim, ExtractorType_Col>::rank,
+        dim,
+        Number,
+        (internal::VectorizedExtractor<dim, ExtractorType_Row>::is_symmetric ||
+         internal::VectorizedExtractor<dim, ExtractorType_Row>::rank == 0) &&
+          (internal::VectorizedExtractor<dim, ExtractorType_Col>::
+             is_symmetric ||
+           internal::VectorizedExtractor<dim, ExtractorType_Col>::rank == 0) &&
+          (internal::VectorizedExtractor<dim, ExtractorType_Row>::rank +
+             internal::VectorizedExtractor<dim, ExtractorType_Col>::rank >
+           0)>::type
+      extract_hessian_component(
+        const Tensor<2, n_independent_variables, Number> &hessian,
+        const ExtractorType_Row &                         extractor_row,
+        const ExtractorType_Col &                         extractor_col);
+
+    private:
+      /**
+       * The independent variables, seeded such that their first and second
+       * derivatives with respect to each other are the identity.
+       */
+      std::array<ad_type, n_independent_variables> independent_variables;
+
+      /**
+       * The registered function.
+       */
+      ad_type dependent_variable;
+    };
+
+
+
+    /* ----------------- inline and template functions ----------------- */
+
+#ifndef DOXYGEN
+
+    template <int dim, int n_independent_variables, typename Number>
+    template <typename ExtractorType>
+    inline void
+    VectorizedScalarFunction<dim, n_independent_variables, Number>::
+      register_independent_variable(
+        const typename internal::VectorizedExtractor<dim, ExtractorType>::
+          template value_type<Number> &value,
+        const ExtractorType &          extractor)
+    {
+      using Extractor = internal::VectorizedExtractor<dim, ExtractorType>;
+      const unsigned int first = Extractor::first_component(extractor);
+      Assert(first + Extractor::n_components <= n_independent_variables,
+             ExcMessage("The field exceeds the number of independent "
+                        "variables of this object."));
+
+      for (unsigned int i = 0; i < Extractor::n_components; ++i)
+        {
+          TableIndices<(Extractor::rank > 0 ? Extractor::rank : 1)> indices;
+          Extractor::set_table_indices(indices, 0, i);
+          // Seed both the first and the second level of derivatives. The
+          // derivative of the outer number is the constant one, i.e., a
+          // number with zero derivatives itself.
+          const unsigned int index = first + i;
+          independent_variables[index] =
+            ad_type(first_derivative_type(
+                      internal::get_vectorized_entry(value, indices), index),
+                    index);
+        }
+    }
+
+
+
+    template <int dim, int n_independent_variables, typename Number>
+    template <typename ExtractorType>
+    inline typename internal::VectorizedExtractor<dim, ExtractorType>::
+      template value_type<typename VectorizedScalarFunction<
+        dim,
+        n_independent_variables,
+        Number>::ad_type>
+      VectorizedScalarFunction<dim, n_independent_variables, Number>::
+        get_sensitive_variables(const ExtractorType &extractor) const
+    {
+      using Extractor = internal::VectorizedExtractor<dim, ExtractorType>;
+      const unsigned int first = Extractor::first_component(extractor);
+      AssertIndexRange(first + Extractor::n_components - 1,
+                       n_independent_variables);
+
+      typename Extractor::template value_type<ad_type> result;
+      for (unsigned int i = 0; i < Extractor::n_components; ++i)
+        {
+          TableIndices<(Extractor::rank > 0 ? Extractor::rank : 1)> indices;
+          Extractor::set_table_indices(indices, 0, i);
+          internal::get_vectorized_entry(result, indices) =
+            independent_variables[first + i];
+        }
+      return result;
+    }
+
+
+
+    template <int dim, int n_independent_variables, typename Number>
+    inline void
+    VectorizedScalarFunction<dim, n_independent_variables, Number>::
+      register_dependent_variable(const ad_type &func)
+    {
+      dependent_variable = func;
+    }
+
+
+
+    template <int dim, int n_independent_variables, typename Number>
+    inline Number
+    VectorizedScalarFunction<dim, n_independent_variables, Number>::
+      compute_value() const
+    {
+      return dependent_variable.value().value();
+    }
+
+
+
+    template <int dim, int n_independent_variables, typename Number>
+    inline Tensor<1, n_independent_variables, Number>
+    VectorizedScalarFunction<dim, n_independent_variables, Number>::
+      compute_gradient() const
+    {
+      Tensor<1, n_independent_variables, Number> gradient;
+      for (unsigned int i = 0; i < n_independent_variables; ++i)
+        gradient[i] = dependent_variable.value().derivative(i);
+      return gradient;
+    }
+
+
+
+    template <int dim, int n_independent_variables, typename Number>
+    inline Tensor<2, n_independent_variables, Number>
+    VectorizedScalarFunction<dim, n_independent_variables, Number>::
+      compute_hessian() const
+    {
+      Tensor<2, n_independent_variables, Number> hessian;
+      for (unsigned int i = 0; i < n_independent_variables; ++i)
+        for (unsigned int j = 0; j < n_independent_variables; ++j)
+          hessian[i][j] = dependent_variable.derivative(i).derivative(j);
+      return hessian;
+    }
+
+
+
+    template <int dim, int n_independent_variables, typename Number>
+    template <typename ExtractorType_Row>
+    inline typename internal::VectorizedExtractor<dim, ExtractorType_Row>::
+      template value_type<Number>
+      VectorizedScalarFunction<dim, n_independent_variables, Number>::
+        extract_gradient_component(
+          const Tensor<1, n_independent_variables, Number> &gradient,
+          const ExtractorType_Row &                         extractor_row)
+    {
+      using Extractor = internal::VectorizedExtractor<dim, ExtractorType_Row>;
+      const unsigned int first = Extractor::first_component(extractor_row);
+      AssertIndexRange(first + Extractor::n_components - 1,
+                       n_independent_variables);
+
+      typename Extractor::template value_type<Number> result;
+      for (unsigned int i = 0; i < Extractor::n_components; ++i)
+        {
+          TableIndices<(Extractor::rank > 0 ? Extractor::rank : 1)> indices;
+          Extractor::set_table_indices(indices, 0, i);
+          internal::get_vectorized_entry(result, indices) =
+            Extractor::symmetry_factor(i) * gradient[first + i];
+        }
+      return result;
+    }
+
+
+
+    template <int dim, int n_independent_variables, typename Number>
+    template <typename ExtractorType_Row, typename ExtractorType_Col>
+    inline typename internal::VectorizedDerivativeType<
+      internal::VectorizedExtractor<dim, ExtractorType_Row>::rank +
+        internal::VectorizedExtractor<dim, ExtractorType_Col>::rank,
+      dim,
+      Number,
+      (internal::VectorizedExtractor<dim, ExtractorType_Row>::is_symmetric ||
+       internal::VectorizedExtractor<dim, ExtractorType_Row>::rank == 0) &&
+        (internal::VectorizedExtractor<dim, ExtractorType_Col>::is_symmetric ||
+         internal::VectorizedExtractor<dim, ExtractorType_Col>::rank == 0) &&
+        (internal::VectorizedExtractor<dim, ExtractorType_Row>::rank +
+           internal::VectorizedExtractor<dim, ExtractorType_Col>::rank >
+         0)>::type
+    VectorizedScalarFunction<dim, n_independent_variables, Number>::
+      extract_hessian_component(
+        const Tensor<2, n_independent_variables, Number> &hessian,
+        const ExtractorType_Row &                         extractor_row,
+        const ExtractorType_Col &                         extractor_col)
+    {
+      using ExtractorRow =
+        internal::VectorizedExtractor<dim, ExtractorType_Row>;
+      using ExtractorCol =
+        internal::VectorizedExtractor<dim, ExtractorType_Col>;
+      constexpr int      rank = ExtractorRow::rank + ExtractorCol::rank;
+      const unsigned int first_row =
+        ExtractorRow::first_component(extractor_row);
+      const unsigned int first_col =
+        ExtractorCol::first_component(extractor_col);
+      AssertIndexRange(first_row + ExtractorRow::n_components - 1,
+                       n_independent_variables);
+      AssertIndexRange(first_col + ExtractorCol::n_components - 1,
+                       n_independent_variables);
+
+      typename internal::VectorizedDerivativeType<
+        rank,
+        dim,
+        Number,
+        (ExtractorRow::is_symmetric || ExtractorRow::rank == 0) &&
+          (ExtractorCol::is_symmetric || ExtractorCol::rank == 0) &&
+          (rank > 0)>::type result;
+      for (unsigned int i = 0; i < ExtractorRow::n_components; ++i)
+        for (unsigned int j = 0; j < ExtractorCol::n_components; ++j)
+          {
+            const Number value = (ExtractorRow::symmetry_factor(i) *
+                                  ExtractorCol::symmetry_factor(j)) *
+                                 hessian[first_row + i][first_col + j];
+
+            // If the result is a Tensor but one of the fields is a symmetric
+            // tensor, also fill the entries of the transposed indices of
+            // that field. For SymmetricTensor results, these writes go to
+            // the same entry.
+            for (unsigned int t_row = 0;
+                 t_row < (ExtractorRow::is_symmetric ? 2 : 1);
+                 ++t_row)
+              for (unsigned int t_col = 0;
+                   t_col < (ExtractorCol::is_symmetric ? 2 : 1);
+                   ++t_col)
+                {
+                  TableIndices<(rank > 0 ? rank : 1)> indices;
+                  ExtractorRow::set_table_indices(indices, 0, i, t_row == 1);
+                  ExtractorCol::set_table_indices(indices,
+                                                  ExtractorRow::rank,
+                                                  j,
+                                                  t_col == 1);
+                  internal::get_vectorized_entry(result, indices) = value;
+                }
+          }
+      return result;
+    }
+
+#endif // DOXYGEN
+
+  } // namespace AD
+} // namespace Differentiation
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -35,7 +35,9 @@
 
 #  include <deal.II/base/exceptions.h>
 #  include <deal.II/base/logstream.h>
+#  include <deal.II/base/mutex.h>
 #  include <deal.II/base/utilities.h>
+#  include <deal.II/base/vectorization.h>
 
 #  include <deal.II/differentiation/sd/symengine_number_types.h>
 #  include <deal.II/differentiation/sd/symengine_number_visitor_internal.h>
@@ -49,6 +51,7 @@
 #  include <algorithm>
 #  include <map>
 #  include <memory>
+#  include <string>
 #  include <type_traits>
 #  include <utility>
 #  include <vector>
@@ -1793,6 +1796,41 @@ namespace Differentiation
       void
       optimize();
 
+      /**
+       * Perform the optimization of all registered dependent functions using
+       * the registered symbols, in the same way as optimize(), but make use
+       * of a persistent cache of optimized functions stored in the
+       * directory @p cache_directory.
+       *
+       * If a previous run of the program has already optimized the same set
+       * of dependent functions with respect to the same independent symbols,
+       * using the same optimization method, optimization flags and
+       * @p ReturnType, then the optimized state is read from the cache file
+       * in that directory instead of being recomputed. Otherwise, optimize()
+       * is called and its result is written to the cache. The cache files are
+       * named by a hash of the string representation of the registered
+       * symbols and functions, and the full representation is stored in the
+       * file and compared upon reading, so that hash collisions cannot lead
+       * to the wrong functions being evaluated.
+       *
+       * This is primarily useful for the LLVM optimizer, where the
+       * compilation of the functions may take several seconds for
+       * complicated constitutive laws. Since the "lambda" optimizer cannot
+       * be serialized, it is simply rebuilt when it is read from the cache;
+       * see the serialize() function.
+       *
+       * @note The directory @p cache_directory has to exist. If the cache
+       * file cannot be written, for example because the directory is not
+       * writable, then the optimizer is still usable but nothing is cached.
+       * Since the cache file is first written under a temporary name and
+       * then renamed, several processes may share the same cache directory.
+       *
+       * @return Whether the optimized state was read from the cache, rather
+       * than having been computed by optimize().
+       */
+      bool
+      optimize(const std::string &cache_directory);
+
       /**
        * Returns a flag which indicates whether the optimize()
        * function has been called and the class is finalized.
@@ -1997,6 +2035,53 @@ namespace Differentiation
 
       /** @} */
 
+      /**
+       * @name Evaluation for several sets of values at once
+       */
+      /** @{ */
+
+      /**
+       * Substitute the @p values of the @p symbols, where each lane of the
+       * VectorizedArray holds an independent set of values, and return the
+       * values of all registered dependent functions for all lanes. This is
+       * convenient inside the quadrature loops of matrix-free operators,
+       * where for example the strain at the quadrature points of several
+       * cells is given by a VectorizedArray-valued tensor.
+       *
+       * The order of the returned entries is the same as for the evaluate()
+       * function without arguments, and individual functions can be
+       * retrieved by the extract() function below. The association of the
+       * @p symbols with the registered independent variables is only
+       * determined once for all lanes, and the optimized functions are then
+       * evaluated lane by lane.
+       *
+       * @note As for substitute(), it is expected that there is a 1-1
+       * correspondence between each of the @p symbols and @p values. Unlike
+       * substitute(), this function does not store its results in this
+       * object, so the values returned by evaluate() are not changed and
+       * several threads may call this function concurrently.
+       *
+       * @note This function is only available for real-valued
+       * @p ReturnType.
+       */
+      template <std::size_t width>
+      std::vector<VectorizedArray<ReturnType, width>>
+      substitute_and_evaluate(
+        const types::symbol_vector &                           symbols,
+        const std::vector<VectorizedArray<ReturnType, width>> &values) const;
+
+      /**
+       * Return the value of @p func from the @p cached_evaluation returned
+       * by substitute_and_evaluate().
+       */
+      template <std::size_t width>
+      VectorizedArray<ReturnType, width>
+      extract(const Expression &func,
+              const std::vector<VectorizedArray<ReturnType, width>>
+                &cached_evaluation) const;
+
+      /** @} */
+
     private:
       /**
        * The optimization methods that is to be employed.
@@ -2043,6 +2128,23 @@ namespace Differentiation
       is_valid_nonunique_dependent_variable(
         const SymEngine::RCP<const SymEngine::Basic> &function) const;
 
+      /**
+       * Return the index of the entry in the vector of outputs that holds
+       * the value of the dependent function @p func.
+       */
+      std::size_t
+      get_output_index(const Expression &func) const;
+
+      /**
+       * Return a string that describes the optimization problem that is
+       * solved by this object, i.e., the return type, the optimization
+       * method and flags, and the registered independent symbols and
+       * dependent functions. This is used to identify the entries of the
+       * cache used by optimize(const std::string &).
+       */
+      std::string
+      get_cache_key() const;
+
       /**
        * The output of substituting symbolic values with floating point
        * values through the use of the @p optimizer.
@@ -2139,6 +2241,23 @@ namespace Differentiation
        */
       void
       substitute(const std::vector<ReturnType> &substitution_values) const;
+
+      /**
+       * Substitute the @p substitution_values, ordered in the same way as for
+       * the function above, into the optimized functions and write the
+       * results into @p output_values. As opposed to the function above, the
+       * state of this object is not modified.
+       */
+      void
+      substitute(const std::vector<ReturnType> &substitution_values,
+                 std::vector<ReturnType> &      output_values) const;
+
+      /**
+       * A mutex that guards the evaluation of the "lambda" optimizer with
+       * common subexpression elimination, which stores the values of the
+       * intermediate subexpressions within the optimizer itself.
+       */
+      mutable Threads::Mutex optimizer_mutex;
     };
 
 
@@ -2573,6 +2692,72 @@ namespace Differentiation
       return extract(funcs, dependent_variables_output);
     }
 
+
+
+    template <typename ReturnType>
+    template <std::size_t width>
+    std::vector<VectorizedArray<ReturnType, width>>
+    BatchOptimizer<ReturnType>::substitute_and_evaluate(
+      const types::symbol_vector &                           symbols,
+      const std::vector<VectorizedArray<ReturnType, width>> &values) const
+    {
+      static_assert(std::is_arithmetic<ReturnType>::value,
+                    "This function is only implemented for real numbers.");
+      Assert(
+        optimized() == true,
+        ExcMessage(
+          "The optimizer is not configured to perform substitution. "
+          "This action can only performed after optimize() has been called."));
+      AssertDimension(symbols.size(), values.size());
+      AssertDimension(symbols.size(), n_independent_variables());
+
+      // The optimizer expects the values in the order of the (sorted) map of
+      // independent variables, so determine once for all lanes where the
+      // value of each of the given symbols has to go
+      std::vector<std::size_t> position(symbols.size());
+      for (unsigned int i = 0; i < symbols.size(); ++i)
+        {
+          const auto it = independent_variables_symbols.find(symbols[i]);
+          Assert(it != independent_variables_symbols.end(),
+                 ExcMessage("The symbol " + symbols[i].get_value().__str__() +
+                            " has not been registered."));
+          position[i] =
+            std::distance(independent_variables_symbols.begin(), it);
+        }
+
+      // Evaluate into local storage only, so that concurrent calls do not
+      // interfere with one another
+      std::vector<ReturnType> lane_values(symbols.size());
+      std::vector<ReturnType> lane_results(n_dependent_variables());
+      std::vector<VectorizedArray<ReturnType, width>> results(
+        lane_results.size());
+      for (unsigned int v = 0; v < width; ++v)
+        {
+          for (unsigned int i = 0; i < symbols.size(); ++i)
+            lane_values[position[i]] = values[i][v];
+          substitute(lane_values, lane_results);
+          for (unsigned int j = 0; j < results.size(); ++j)
+            results[j][v] = lane_results[j];
+        }
+
+      return results;
+    }
+
+
+
+    template <typename ReturnType>
+    template <std::size_t width>
+    VectorizedArray<ReturnType, width>
+    BatchOptimizer<ReturnType>::extract(
+      const Expression &                                     func,
+      const std::vector<VectorizedArray<ReturnType, width>> &cached_evaluation)
+      const
+    {
+      const std::size_t index = get_output_index(func);
+      AssertIndexRange(index, cached_evaluation.size());
+      return cached_evaluation[index];
+    }
+
 #  endif // DOXYGEN
 
   } // namespace SD
@@ -61,6 +61,7 @@ template <int dim, class T>
 class Table;
 template <typename Number>
 class Vector;
+class SparsityPattern;
 
 namespace GridTools
 {
@@ -415,6 +416,53 @@ namespace DoFTools
     const bool                       keep_constrained_dofs = true,
     const types::subdomain_id subdomain_id = numbers::invalid_subdomain_id);
 
+  /**
+   * Like the previous function, but build the sparsity pattern directly into
+   * a (static) SparsityPattern object that is compressed upon return,
+   * without going through an intermediate DynamicSparsityPattern. Any
+   * previous content of @p sparsity_pattern is discarded. (Calling
+   * make_sparsity_pattern() with a SparsityPattern that has been sized by
+   * SparsityPattern::reinit() instead only adds the entries, as for any
+   * other kind of sparsity pattern.)
+   *
+   * The pattern is built in two passes over the cells: The first pass only
+   * counts how many column indices are handed to each row (taking into
+   * account the @p constraints), which gives an upper bound for the length
+   * of each row. The second pass writes the actual column indices into the
+   * sparsity pattern, which is then compressed to its exact size. Both
+   * passes run in parallel on cells of the same color of a
+   * GraphColoring::make_graph_coloring() partition of the cells, where two
+   * cells conflict if they write into a common row, i.e., if they share a
+   * degree of freedom or degrees of freedom constrained to a common one.
+   *
+   * The upper bound of the first pass counts an entry once for every cell
+   * that writes it. For continuous elements, the rows of degrees of freedom
+   * on vertices are therefore overestimated by up to a factor of the number
+   * of cells sharing the vertex, i.e., about $2^{dim}$ on regular meshes,
+   * and the peak memory is that of a pattern with the estimated row lengths
+   * rather than the final one. In addition, the graph coloring sets up the
+   * list of conflicting cells for all cells at once and does so on a single
+   * thread. Compared to the DynamicSparsityPattern route, this function
+   * avoids the many separately allocated rows and the final copy, but it is
+   * not guaranteed to use less memory for elements with most of their
+   * degrees of freedom on vertices.
+   *
+   * The remaining arguments have the same meaning as for the previous
+   * function. Since the sparsity pattern has to store all rows of the
+   * matrix, this function can only be used for DoFHandler objects on
+   * triangulations that are not distributed across MPI processes.
+   *
+   * @ingroup constraints
+   */
+  template <int dim, int spacedim, typename number = double>
+  void
+  make_compressed_sparsity_pattern(
+    const DoFHandler<dim, spacedim> &dof_handler,
+    SparsityPattern &                sparsity_pattern,
+    const AffineConstraints<number> &constraints = AffineConstraints<number>(),
+    const bool                       keep_constrained_dofs = true,
+    const types::subdomain_id subdomain_id = numbers::invalid_subdomain_id);
+
   /**
    * Compute which entries of a matrix built on the given @p dof_handler may
    * possibly be nonzero, and create a sparsity pattern object that represents
@@ -2251,6 +2251,22 @@ private:
    */
   std::vector<std::array<unsigned int, 2>> dofmap;
 
+  /**
+   * Scratch arrays for the DoF indices of the two cells adjacent to the
+   * interface, kept as members to avoid allocating memory in every call to
+   * reinit().
+   */
+  std::array<std::vector<types::global_dof_index>, 2> cell_dof_indices;
+
+  /**
+   * Scratch array to sort the DoF indices of the two cells in reinit() in
+   * case the indices on one of the cells are not sorted. The second entry
+   * is the local index on the first cell or the local index on the second
+   * cell shifted by the number of DoFs on the first cell.
+   */
+  std::vector<std::pair<types::global_dof_index, unsigned int>>
+    sorted_dof_indices;
+
   /**
    * Pointer to internal_fe_face_values or internal_fe_subface_values,
    * respectively as determined in reinit().
@@ -2618,46 +2634,76 @@ FEInterfaceValues<dim, spacedim>::reinit(
         fe_face_values->n_quadrature_points;
     }
 
-  // Set up dof mapping and remove duplicates (for continuous elements).
+  // Set up dof mapping and remove duplicates (for continuous elements). The
+  // interface DoFs are sorted by their global index. The arrays are only
+  // cleared and refilled, so no memory gets allocated once the largest
+  // interface has been visited.
   {
-    // Get dof indices first:
-    std::vector<types::global_dof_index> v(
-      fe_face_values->get_fe().n_dofs_per_cell());
+    std::vector<types::global_dof_index> &v = cell_dof_indices[0];
+    v.resize(fe_face_values->get_fe().n_dofs_per_cell());
     cell->get_active_or_mg_dof_indices(v);
-    std::vector<types::global_dof_index> v2(
-      fe_face_values_neighbor->get_fe().n_dofs_per_cell());
+    std::vector<types::global_dof_index> &v2 = cell_dof_indices[1];
+    v2.resize(fe_face_values_neighbor->get_fe().n_dofs_per_cell());
     cell_neighbor->get_active_or_mg_dof_indices(v2);
 
-    // Fill a map from the global dof index to the left and right
-    // local index.
-    std::map<types::global_dof_index, std::pair<unsigned int, unsigned int>>
-                                          tempmap;
-    std::pair<unsigned int, unsigned int> invalid_entry(
-      numbers::invalid_unsigned_int, numbers::invalid_unsigned_int);
+    const unsigned int n_dofs = v.size();
+    dofmap.clear();
+    interface_dof_indices.clear();
 
-    for (unsigned int i = 0; i < v.size(); ++i)
+    if (std::is_sorted(v.begin(), v.end()) &&
+        std::is_sorted(v2.begin(), v2.end()))
       {
-        // If not already existing, add an invalid entry:
-        auto result = tempmap.insert(std::make_pair(v[i], invalid_entry));
-        result.first->second.first = i;
+        // The common case of discontinuous elements, whose DoFs are
+        // enumerated cell by cell: merge the two sorted lists directly
+        unsigned int i = 0, j = 0;
+        while (i < n_dofs || j < v2.size())
+          {
+            if (j == v2.size() || (i < n_dofs && v[i] < v2[j]))
+              {
+                interface_dof_indices.push_back(v[i]);
+                dofmap.push_back({{i, numbers::invalid_unsigned_int}});
+                ++i;
+              }
+            else if (i == n_dofs || v2[j] < v[i])
+              {
+                interface_dof_indices.push_back(v2[j]);
+                dofmap.push_back({{numbers::invalid_unsigned_int, j}});
+                ++j;
+              }
+            else
+              {
+                interface_dof_indices.push_back(v[i]);
+                dofmap.push_back({{i, j}});
+                ++i;
+                ++j;
+              }
+          }
       }
-
-    for (unsigned int i = 0; i < v2.size(); ++i)
-      {
-        // If not already existing, add an invalid entry:
-        auto result = tempmap.insert(std::make_pair(v2[i], invalid_entry));
-        result.first->second.second = i;
-      }
-
-    // Transfer from the map to the sorted std::vectors.
-    dofmap.resize(tempmap.size());
-    interface_dof_indices.resize(tempmap.size());
-    unsigned int idx = 0;
-    for (auto &x : tempmap)
+    else
       {
-        interface_dof_indices[idx] = x.first;
-        dofmap[idx]                = {{x.second.first, x.second.second}};
-        ++idx;
+        // Sort the DoFs of both cells by their global index and join the
+        // entries of DoFs shared between the two cells
+        sorted_dof_indices.clear();
+        for (unsigned int i = 0; i < n_dofs; ++i)
+          sorted_dof_indices.emplace_back(v[i], i);
+        for (unsigned int j = 0; j < v2.size(); ++j)
+          sorted_dof_indices.emplace_back(v2[j], n_dofs + j);
+        std::sort(sorted_dof_indices.begin(), sorted_dof_indices.end());
+
+        for (const auto &entry : sorted_dof_indices)
+          {
+            if (interface_dof_indices.empty() ||
+                interface_dof_indices.back() != entry.first)
+              {
+                interface_dof_indices.push_back(entry.first);
+                dofmap.push_back({{numbers::invalid_unsigned_int,
+                                   numbers::invalid_unsigned_int}});
+              }
+            if (entry.second < n_dofs)
+              dofmap.back()[0] = entry.second;
+            else
+              dofmap.back()[1] = entry.second - n_dofs;
+          }
       }
   }
 }
@@ -427,6 +427,113 @@ namespace FETools
     std::vector<std::vector<FullMatrix<number>>> &matrices,
     const bool                                    isotropic_only = false);
 
+  /**
+   * A process-wide cache of the embedding and projection matrices computed
+   * by FETools::compute_embedding_matrices() and
+   * FETools::compute_projection_matrices().
+   *
+   * Computing these matrices solves a least-squares problem for each child
+   * cell and refinement case, which for high polynomial degrees in 3d can
+   * take seconds to minutes. This cost is paid every time a finite element
+   * such as FE_Nedelec or FE_RaviartThomas of the same degree is created,
+   * on every MPI process and in every run of a program. The functions in
+   * this namespace store the matrices the first time they are computed,
+   * keyed by the finite element, the number type and the arguments of the
+   * computation, and copy them from the cache in later calls. The content
+   * of the cache can be written to a binary file with save() and read back
+   * with load(), for example by all MPI processes at the start of a
+   * program:
+   * @code
+   * if (std::ifstream("fe_matrices.cache"))
+   *   FETools::MatrixCache::load("fe_matrices.cache");
+   *
+   * FE_Nedelec<3> fe(6);
+   * ... // run program, use the prolongation matrices of fe
+   *
+   * if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+   *   FETools::MatrixCache::save("fe_matrices.cache");
+   * @endcode
+   *
+   * The finite element classes of the library use this cache where the
+   * matrices are computed on first use. Since names of finite elements are
+   * not unique (e.g., FE_DGQArbitraryNodes elements based on different
+   * unrecognized sets of nodes have the same name), the key contains, in
+   * addition to FiniteElement::get_name(), a hash of the values of the shape
+   * functions at a few points of the reference cell, computed with
+   * FiniteElement::shape_value_component().
+   *
+   * The cache holds at most a fixed number of entries, see
+   * set_max_n_entries(). When a new entry exceeds this number, the oldest
+   * entries are removed. The cache can also be emptied with clear().
+   *
+   * All functions in this namespace are thread-safe.
+   */
+  namespace MatrixCache
+  {
+    /**
+     * Same as FETools::compute_embedding_matrices(), but take the matrices
+     * from the cache if they have been computed before for the same finite
+     * element, number type and arguments, and add them to the cache
+     * otherwise.
+     */
+    template <int dim, typename number, int spacedim>
+    void
+    compute_embedding_matrices(
+      const FiniteElement<dim, spacedim> &          fe,
+      std::vector<std::vector<FullMatrix<number>>> &matrices,
+      const bool                                    isotropic_only = false,
+      const double                                  threshold      = 1.e-12);
+
+    /**
+     * Same as FETools::compute_projection_matrices(), but take the matrices
+     * from the cache if they have been computed before for the same finite
+     * element, number type and arguments, and add them to the cache
+     * otherwise.
+     */
+    template <int dim, typename number, int spacedim>
+    void
+    compute_projection_matrices(
+      const FiniteElement<dim, spacedim> &          fe,
+      std::vector<std::vector<FullMatrix<number>>> &matrices,
+      const bool                                    isotropic_only = false);
+
+    /**
+     * Write the content of the cache to the binary file @p filename. The
+     * file can only be read on machines with the same binary representation
+     * of numbers.
+     */
+    void
+    save(const std::string &filename);
+
+    /**
+     * Add the entries stored in the file @p filename, which must have been
+     * written by save(), to the cache. Entries already present in the cache
+     * are kept. If the cache then holds more than the maximal number of
+     * entries, the oldest ones are removed.
+     */
+    void
+    load(const std::string &filename);
+
+    /**
+     * Remove all entries from the cache.
+     */
+    void
+    clear();
+
+    /**
+     * Set the maximal number of entries of the cache, removing the oldest
+     * entries if the cache currently holds more. The default is 64.
+     */
+    void
+    set_max_n_entries(const unsigned int max_n_entries);
+
+    /**
+     * Return the number of entries in the cache.
+     */
+    unsigned int
+    n_entries();
+  } // namespace MatrixCache
+
   /**
    * Project scalar data defined in quadrature points to a finite element
    * space on a single cell.
@@ -63,8 +63,12 @@
 #include <deal.II/lac/householder.h>
 
 #include <cctype>
+#include <functional>
+#include <iomanip>
 #include <iostream>
 #include <memory>
+#include <sstream>
+#include <typeinfo>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -2253,6 +2257,177 @@ namespace FETools
   }
 
 
+
+  namespace internal
+  {
+    namespace FEToolsMatrixCache
+    {
+      /**
+       * Copy the matrices stored in the cache under the given key into
+       * @p matrices and return true, or return false if there is no entry
+       * for the key. Defined in fe_tools.cc.
+       */
+      bool
+      get(const std::string &                           key,
+          std::vector<std::vector<FullMatrix<double>>> &matrices);
+
+      /**
+       * Add the given matrices to the cache under the given key. Defined in
+       * fe_tools.cc.
+       */
+      void
+      store(const std::string &                                 key,
+            const std::vector<std::vector<FullMatrix<double>>> &matrices);
+
+
+
+      /**
+       * Return the key under which the matrices of kind @p matrix_kind of
+       * the finite element @p fe, computed in the number type @p number,
+       * are stored in the cache. Besides the name of the element, the key
+       * contains a hash of the values of the shape functions at a few
+       * points of the reference cell. The name alone does not identify an
+       * element uniquely, e.g., all FE_DGQArbitraryNodes elements based on
+       * nodes that are not recognized as a known quadrature formula are
+       * called `FE_DGQArbitraryNodes<dim>(QUnknownNodes(degree+1))`.
+       */
+      template <typename number, int dim, int spacedim>
+      std::string
+      make_key(const FiniteElement<dim, spacedim> &fe,
+               const std::string &                 matrix_kind)
+      {
+        const Quadrature<dim> quadrature =
+          fe.reference_cell().template get_gauss_type_quadrature<dim>(2);
+
+        std::size_t hash = 0;
+        for (const Point<dim> &point : quadrature.get_points())
+          for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+            for (unsigned int c = 0; c < fe.n_components(); ++c)
+              hash ^=
+                std::hash<double>()(fe.shape_value_component(i, point, c)) +
+                0x9e3779b9 + (hash << 6) + (hash >> 2);
+
+        std::ostringstream key;
+        key << fe.get_name() << ' ' << std::hex << hash << ' '
+            << typeid(number).name() << ' ' << matrix_kind;
+        return key.str();
+      }
+
+
+
+      /**
+       * Look up the matrices of the refinement cases computed by
+       * @p compute_function in the cache and copy them to @p matrices.
+       * If they are not cached yet or do not match the size of the
+       * element, compute them and add them to the cache.
+       */
+      template <int dim, typename number, typename ComputeFunction>
+      void
+      get_or_compute(const std::string &                           key,
+                     std::vector<std::vector<FullMatrix<number>>> &matrices,
+                     const unsigned int                            n_dofs,
+                     const bool             isotropic_only,
+                     const ComputeFunction &compute_function)
+      {
+        const unsigned int first_case =
+          isotropic_only ? RefinementCase<dim>::isotropic_refinement :
+                           RefinementCase<dim>::cut_x;
+
+        std::vector<std::vector<FullMatrix<double>>> cached;
+        bool                                         cache_is_valid =
+          get(key, cached) && cached.size() == matrices.size();
+        for (unsigned int ref_case = first_case;
+             cache_is_valid &&
+             ref_case <= RefinementCase<dim>::isotropic_refinement;
+             ++ref_case)
+          {
+            cache_is_valid &=
+              cached[ref_case - 1].size() == matrices[ref_case - 1].size();
+            for (unsigned int c = 0;
+                 cache_is_valid && c < cached[ref_case - 1].size();
+                 ++c)
+              cache_is_valid &= cached[ref_case - 1][c].m() == n_dofs &&
+                                cached[ref_case - 1][c].n() == n_dofs;
+          }
+
+        if (cache_is_valid)
+          {
+            for (unsigned int ref_case = first_case;
+                 ref_case <= RefinementCase<dim>::isotropic_refinement;
+                 ++ref_case)
+              for (unsigned int c = 0; c < cached[ref_case - 1].size(); ++c)
+                matrices[ref_case - 1][c] = cached[ref_case - 1][c];
+            return;
+          }
+
+        compute_function();
+
+        // only store the refinement cases that have been computed
+        cached.clear();
+        cached.resize(matrices.size());
+        for (unsigned int ref_case = first_case;
+             ref_case <= RefinementCase<dim>::isotropic_refinement;
+             ++ref_case)
+          {
+            cached[ref_case - 1].resize(matrices[ref_case - 1].size());
+            for (unsigned int c = 0; c < cached[ref_case - 1].size(); ++c)
+              cached[ref_case - 1][c] = matrices[ref_case - 1][c];
+          }
+        store(key, cached);
+      }
+    } // namespace FEToolsMatrixCache
+  }   // namespace internal
+
+
+
+  namespace MatrixCache
+  {
+    template <int dim, typename number, int spacedim>
+    void
+    compute_embedding_matrices(
+      const FiniteElement<dim, spacedim> &          fe,
+      std::vector<std::vector<FullMatrix<number>>> &matrices,
+      const bool                                    isotropic_only,
+      const double                                  threshold)
+    {
+      std::ostringstream matrix_kind;
+      matrix_kind << "embedding " << isotropic_only << ' '
+                  << std::setprecision(17) << threshold;
+      internal::FEToolsMatrixCache::get_or_compute<dim>(
+        internal::FEToolsMatrixCache::make_key<number>(fe, matrix_kind.str()),
+        matrices,
+        fe.n_dofs_per_cell(),
+        isotropic_only,
+        [&]() {
+          FETools::compute_embedding_matrices(fe,
+                                              matrices,
+                                              isotropic_only,
+                                              threshold);
+        });
+    }
+
+
+
+    template <int dim, typename number, int spacedim>
+    void
+    compute_projection_matrices(
+      const FiniteElement<dim, spacedim> &          fe,
+      std::vector<std::vector<FullMatrix<number>>> &matrices,
+      const bool                                    isotropic_only)
+    {
+      internal::FEToolsMatrixCache::get_or_compute<dim>(
+        internal::FEToolsMatrixCache::make_key<number>(
+          fe, "projection " + std::to_string(isotropic_only)),
+        matrices,
+        fe.n_dofs_per_cell(),
+        isotropic_only,
+        [&]() {
+          FETools::compute_projection_matrices(fe, matrices, isotropic_only);
+        });
+    }
+  } // namespace MatrixCache
+
+
   template <int dim, int spacedim>
   void
   add_fe_name(const std::string &                 parameter_name,
@@ -105,6 +105,18 @@ namespace internal
   {
     using type = Tensor<1, 3, NumberType>;
   };
+
+  namespace FEValuesImplementation
+  {
+    /**
+     * A class that stores the one-dimensional shape functions of a tensor
+     * product finite element at the points of a tensor product quadrature
+     * formula, for the evaluation of finite element functions with sum
+     * factorization. Defined in fe_values.cc.
+     */
+    template <int dim, int spacedim>
+    class TensorProductEvaluationData;
+  } // namespace FEValuesImplementation
 } // namespace internal
 
 
@@ -3978,6 +3990,22 @@ protected:
                                                                      spacedim>
     finite_element_output;
 
+  /**
+   * Data for the evaluation of finite element functions in the
+   * get_function_values() and get_function_gradients() functions with sum
+   * factorization, i.e., by a sequence of one-dimensional interpolations,
+   * rather than by the table of all shape functions at all quadrature
+   * points. The cost of this evaluation is $\mathcal O(p^{d+1})$ instead of
+   * $\mathcal O(p^{2d})$ per cell for polynomial degree $p$. This object is
+   * set up by FEValues for finite elements whose base elements are all the
+   * same scalar tensor product element, such as FE_Q, FE_DGQ, or an
+   * FESystem of copies of one of them, in combination with a tensor product
+   * quadrature formula, and is a null pointer otherwise.
+   */
+  std::unique_ptr<const dealii::internal::FEValuesImplementation::
+                    TensorProductEvaluationData<dim, spacedim>>
+    tensor_product_data;
+
 
   /**
    * Original update flags handed to the constructor of FEValues.
@@ -48,18 +48,54 @@ class DoFHandler;
  * which is used in all operations of MappingQ. The information of the
  * mapping is pre-computed by the MappingQCache::initialize() function.
  *
+ * The support points of all cells are kept in a few contiguous arrays that
+ * are indexed by the level and index of the cells. Only the cells that are
+ * actually accessed are stored, i.e., all cells if the cache is set up on
+ * all levels and only the active cells otherwise. On fine meshes with a high
+ * polynomial degree of the mapping, the cache can take a considerable amount
+ * of memory. It can be reduced by selecting StorageFormat::float_offsets in
+ * the constructor, see there.
+ *
  * The use of this class is discussed extensively in step-65.
  */
 template <int dim, int spacedim = dim>
 class MappingQCache : public MappingQ<dim, spacedim>
 {
 public:
+  /**
+   * The format in which the mapping support points are stored.
+   */
+  enum class StorageFormat
+  {
+    /**
+     * Store all support points in double precision.
+     */
+    full_precision,
+
+    /**
+     * Store the vertices of each cell in double precision and the remaining
+     * support points as single-precision offsets relative to their
+     * $Q_1$ position, i.e., the d-linear interpolation of the vertices.
+     * Cells whose support points all coincide with their $Q_1$ position,
+     * e.g. affine cells away from curved boundaries, store the vertices
+     * only. Since the offsets are typically small compared to the size of
+     * the cell, the relative error introduced in the support points is
+     * usually much smaller than the precision of a float, while the memory
+     * consumption is approximately halved, or reduced to the vertices for
+     * straight-sided cells.
+     */
+    float_offsets
+  };
+
   /**
    * Constructor. @p polynomial_degree denotes the polynomial degree of the
    * polynomials that are used to map cells from the reference to the real
-   * cell.
+   * cell. The argument @p storage_format selects the format in which the
+   * support points are cached.
    */
-  explicit MappingQCache(const unsigned int polynomial_degree);
+  explicit MappingQCache(
+    const unsigned int  polynomial_degree,
+    const StorageFormat storage_format = StorageFormat::full_precision);
 
   /**
    * Copy constructor.
@@ -229,13 +265,84 @@ protected:
     const override;
 
 private:
+  /**
+   * The cached support points of all cells in contiguous arrays.
+   */
+  struct SupportPointCache
+  {
+    /**
+     * The position of the first cell of each level in cell_data_index, with
+     * one additional entry for the end of the last level.
+     */
+    std::vector<unsigned int> level_start;
+
+    /**
+     * For each cell, accessed by `level_start[cell->level()] +
+     * cell->index()`, the index of its data in the arrays below, or
+     * numbers::invalid_unsigned_int if the cell is not stored.
+     */
+    std::vector<unsigned int> cell_data_index;
+
+    /**
+     * The support points of all stored cells, one after the other. In the
+     * format StorageFormat::float_offsets, only the vertices are stored
+     * here.
+     */
+    std::vector<Point<spacedim>> points;
+
+    /**
+     * For the format StorageFormat::float_offsets, the index of the block of
+     * offsets of each stored cell in the field @p offsets, or
+     * numbers::invalid_unsigned_int if all offsets of the cell are zero.
+     */
+    std::vector<unsigned int> offset_index;
+
+    /**
+     * For the format StorageFormat::float_offsets, the offsets of the
+     * support points except the vertices relative to the $Q_1$ positions,
+     * in blocks of $(p+1)^\text{dim} - 2^\text{dim}$ entries.
+     */
+    std::vector<Tensor<1, spacedim, float>> offsets;
+
+    /**
+     * Return the memory consumption (in bytes) of this object.
+     */
+    std::size_t
+    memory_consumption() const;
+  };
+
+  /**
+   * Fill the cache with the support points returned by
+   * @p compute_points_on_cell. If @p use_level_info is false, only the
+   * active cells are stored.
+   */
+  void
+  initialize_cache(
+    const Triangulation<dim, spacedim> &triangulation,
+    const std::function<std::vector<Point<spacedim>>(
+      const typename Triangulation<dim, spacedim>::cell_iterator &)>
+      &        compute_points_on_cell,
+    const bool use_level_info);
+
+  /**
+   * Return the index of the data of the given @p cell in the arrays of the
+   * cache.
+   */
+  unsigned int
+  get_cell_data_index(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell) const;
+
   /**
    * The point cache filled upon calling initialize(). It is made a shared
    * pointer to allow several instances (created via clone()) to share this
    * cache.
    */
-  std::shared_ptr<std::vector<std::vector<std::vector<Point<spacedim>>>>>
-    support_point_cache;
+  std::shared_ptr<SupportPointCache> support_point_cache;
+
+  /**
+   * The format in which the support points are stored.
+   */
+  const StorageFormat storage_format;
 
   /**
    * The connection to Triangulation::signals::any that must be reset once
@@ -1100,6 +1100,53 @@ namespace GridTools
       &cell_hint =
         typename Triangulation<dim, spacedim>::active_cell_iterator());
 
+  /**
+   * Find an active cell around each of the given @p points, and return the
+   * cells and the reference positions of the points in them in two arrays of
+   * the same length as @p points. In contrast to
+   * compute_point_locations(), which locates one point after the other, this
+   * function is meant for large batches of points and works in three
+   * stages:
+   *  - The candidate cells of all points are determined by querying
+   *   GridTools::Cache::get_cell_bounding_boxes_rtree(), in parallel on the
+   *   available threads.
+   *  - The points are grouped by their candidate cells, and all points of a
+   *   cell are transformed to the reference cell with a single call to
+   *   Mapping::transform_points_real_to_unit_cell(), again in parallel. For
+   *   MappingQ, this evaluates the inverse mapping for several points at once
+   *   by the lanes of VectorizedArray. A point is assigned to the first
+   *   candidate cell that contains it, up to @p tolerance; the remaining
+   *   points are checked with their next candidate cell.
+   *  - Points that have not been found in any of their candidate cells, e.g.
+   *   because they are slightly outside a cell on a curved boundary, are
+   *   searched for by find_active_cell_around_point().
+   *
+   * If a point lies on the boundary between several cells, the function
+   * returns one of them, which need not be the same as the one returned by
+   * find_active_cell_around_point(). Artificial cells of a
+   * parallel::TriangulationBase are never returned.
+   *
+   * @param[in] cache The triangulation's GridTools::Cache.
+   * @param[in] points A vector of points.
+   * @param[in] tolerance Tolerance in terms of reference cell coordinates for
+   * a point to be considered inside a cell, see
+   * find_active_cell_around_point().
+   *
+   * @return A pair of arrays: The cell around each point, or the past-the-end
+   * iterator of the triangulation if the point could not be found, and the
+   * reference position of each point in its cell.
+   *
+   * @note This function is not implemented for the codimension one case
+   * (<tt>spacedim != dim</tt>), where it throws an exception.
+   */
+  template <int dim, int spacedim>
+  std::pair<
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>,
+    std::vector<Point<dim>>>
+  find_active_cells_around_points(const Cache<dim, spacedim> &        cache,
+                                  const std::vector<Point<spacedim>> &points,
+                                  const double tolerance = 1.e-10);
+
   /**
    * Given a @p cache and a list of
    * @p local_points for each process, find the points lying on the locally
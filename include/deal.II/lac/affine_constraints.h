@@ -139,6 +139,50 @@ namespace internal
 
 
 
+    /**
+     * A copy of the constraint lines of a closed AffineConstraints object in
+     * compressed row storage: the constrained degrees of freedom, their
+     * inhomogeneities, and all entries of all lines in two contiguous arrays
+     * of column indices and weights. The entries of the constraint with
+     * number @p i are found in the half-open range
+     * <code>[row_starts[i], row_starts[i+1])</code>. Since the lines are
+     * sorted by close(), the row number of a constraint is the same as its
+     * position in AffineConstraints::lines.
+     *
+     * Compared to walking over the individual ConstraintLine objects (each of
+     * which holds its entries in a separately allocated vector), this layout
+     * avoids one indirection per constrained degree of freedom and lets the
+     * compiler vectorize the loops over the entries of a line.
+     */
+    template <typename number>
+    struct CompressedLines
+    {
+      /**
+       * Reset all arrays to an empty state.
+       */
+      void
+      clear();
+
+      /**
+       * Return an estimate of the memory consumption (in bytes) of this
+       * object.
+       */
+      std::size_t
+      memory_consumption() const;
+
+      std::vector<size_type> constrained_dofs;
+
+      std::vector<number> inhomogeneities;
+
+      std::vector<size_type> row_starts;
+
+      std::vector<size_type> column_indices;
+
+      std::vector<number> weights;
+    };
+
+
+
     /**
      * A data structure that collects all the global rows from a local
      * contribution (cell) and their origin (direct/constraint). This
@@ -1941,6 +1985,15 @@ private:
    */
   bool sorted;
 
+  /**
+   * A copy of the content of @p lines in compressed row storage, set up at
+   * the end of close() and used by the functions that apply the closed
+   * constraints to vectors, such as distribute(), set_zero(), and the
+   * vector variants of distribute_local_to_global(). The arrays are empty as
+   * long as the object is not closed.
+   */
+  internal::AffineConstraints::CompressedLines<number> compressed_lines;
+
   mutable Threads::ThreadLocalStorage<
     internal::AffineConstraints::ScratchData<number>>
     scratch_data;
@@ -1952,6 +2005,13 @@ private:
   size_type
   calculate_line_index(const size_type line_n) const;
 
+  /**
+   * Internal function to fill the compressed_lines field from the (sorted)
+   * content of @p lines. Called at the end of close().
+   */
+  void
+  build_compressed_lines();
+
   /**
    * This function actually implements the local_to_global function for
    * standard (non-block) matrices.
@@ -2039,6 +2099,7 @@ inline AffineConstraints<number>::AffineConstraints(
   , lines_cache(affine_constraints.lines_cache)
   , local_lines(affine_constraints.local_lines)
   , sorted(affine_constraints.sorted)
+  , compressed_lines(affine_constraints.compressed_lines)
 {}
 
 template <typename number>
@@ -2128,6 +2189,10 @@ AffineConstraints<number>::set_inhomogeneity(
   Assert(lines_cache[line_index] < lines.size(), ExcInternalError());
   ConstraintLine *line_ptr = &lines[lines_cache[line_index]];
   line_ptr->inhomogeneity  = value;
+
+  // keep the compressed copy of a closed object in sync
+  if (sorted)
+    compressed_lines.inhomogeneities[lines_cache[line_index]] = value;
 }
 
 
@@ -2137,6 +2202,14 @@ template <class VectorType>
 inline void
 AffineConstraints<number>::set_zero(VectorType &vec) const
 {
+  // a closed object already stores the sorted list of constrained dofs
+  if (sorted)
+    {
+      internal::AffineConstraintsImplementation::set_zero_all(
+        compressed_lines.constrained_dofs, vec);
+      return;
+    }
+
   // since lines is a private member, we cannot pass it to the functions
   // above. therefore, copy the content which is cheap
   std::vector<size_type> constrained_lines(lines.size());
@@ -2278,11 +2351,12 @@ AffineConstraints<number>::distribute_local_to_global(
     global_vector(index) += value;
   else
     {
-      const ConstraintLine &position =
-        lines[lines_cache[calculate_line_index(index)]];
-      for (size_type j = 0; j < position.entries.size(); ++j)
-        global_vector(position.entries[j].first) +=
-          value * position.entries[j].second;
+      const size_type row = lines_cache[calculate_line_index(index)];
+      for (size_type j = compressed_lines.row_starts[row];
+           j < compressed_lines.row_starts[row + 1];
+           ++j)
+        global_vector(compressed_lines.column_indices[j]) +=
+          value * compressed_lines.weights[j];
     }
 }
 
@@ -2307,12 +2381,14 @@ AffineConstraints<number>::distribute_local_to_global(
                                                  global_vector);
       else
         {
-          const ConstraintLine &position =
-            lines[lines_cache[calculate_line_index(*local_indices_begin)]];
-          for (size_type j = 0; j < position.entries.size(); ++j)
+          const size_type row =
+            lines_cache[calculate_line_index(*local_indices_begin)];
+          for (size_type j = compressed_lines.row_starts[row];
+               j < compressed_lines.row_starts[row + 1];
+               ++j)
             internal::ElementAccess<VectorType>::add(
-              (*local_vector_begin) * position.entries[j].second,
-              position.entries[j].first,
+              (*local_vector_begin) * compressed_lines.weights[j],
+              compressed_lines.column_indices[j],
               global_vector);
         }
     }
@@ -2353,12 +2429,15 @@ AffineConstraints<number>::get_dof_values(
         *local_vector_begin = global_vector(*local_indices_begin);
       else
         {
-          const ConstraintLine &position =
-            lines[lines_cache[calculate_line_index(*local_indices_begin)]];
-          typename VectorType::value_type value = position.inhomogeneity;
-          for (size_type j = 0; j < position.entries.size(); ++j)
-            value += (global_vector(position.entries[j].first) *
-                      position.entries[j].second);
+          const size_type row =
+            lines_cache[calculate_line_index(*local_indices_begin)];
+          typename VectorType::value_type value =
+            compressed_lines.inhomogeneities[row];
+          for (size_type j = compressed_lines.row_starts[row];
+               j < compressed_lines.row_starts[row + 1];
+               ++j)
+            value += (global_vector(compressed_lines.column_indices[j]) *
+                      compressed_lines.weights[j]);
           *local_vector_begin = value;
         }
     }
@@ -2455,6 +2534,12 @@ AffineConstraints<number>::copy_from(
   lines_cache = other.lines_cache;
   local_lines = other.local_lines;
   sorted      = other.sorted;
+
+  // the compressed lines of the other object may store a different number
+  // type, so set them up from the copied lines
+  compressed_lines.clear();
+  if (sorted)
+    build_compressed_lines();
 }
 
 
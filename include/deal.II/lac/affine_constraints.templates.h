@@ -20,6 +20,7 @@
 
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi_compute_index_owner_internal.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/thread_local_storage.h>
 
@@ -924,6 +925,44 @@ AffineConstraints<number>::close()
 #endif
 
   sorted = true;
+
+  build_compressed_lines();
+}
+
+
+
+template <typename number>
+void
+AffineConstraints<number>::build_compressed_lines()
+{
+  Assert(sorted == true, ExcMatrixNotClosed());
+
+  compressed_lines.clear();
+
+  const size_type n_lines   = lines.size();
+  size_type       n_entries = 0;
+  for (const ConstraintLine &line : lines)
+    n_entries += line.entries.size();
+
+  compressed_lines.constrained_dofs.reserve(n_lines);
+  compressed_lines.inhomogeneities.reserve(n_lines);
+  compressed_lines.row_starts.reserve(n_lines + 1);
+  compressed_lines.column_indices.reserve(n_entries);
+  compressed_lines.weights.reserve(n_entries);
+
+  compressed_lines.row_starts.push_back(0);
+  for (const ConstraintLine &line : lines)
+    {
+      compressed_lines.constrained_dofs.push_back(line.index);
+      compressed_lines.inhomogeneities.push_back(line.inhomogeneity);
+      for (const std::pair<size_type, number> &entry : line.entries)
+        {
+          compressed_lines.column_indices.push_back(entry.first);
+          compressed_lines.weights.push_back(entry.second);
+        }
+      compressed_lines.row_starts.push_back(
+        compressed_lines.column_indices.size());
+    }
 }
 
 
@@ -1110,6 +1149,14 @@ AffineConstraints<number>::shift(const size_type offset)
         entry.first += offset;
     }
 
+  if (sorted)
+    {
+      for (size_type &index : compressed_lines.constrained_dofs)
+        index += offset;
+      for (size_type &index : compressed_lines.column_indices)
+        index += offset;
+    }
+
 #ifdef DEBUG
   // make sure that lines, lines_cache and local_lines
   // are still linked correctly
@@ -1136,6 +1183,8 @@ AffineConstraints<number>::clear()
     lines_cache.swap(tmp);
   }
 
+  compressed_lines.clear();
+
   sorted = false;
 }
 
@@ -1299,7 +1348,8 @@ AffineConstraints<number>::memory_consumption() const
   return (MemoryConsumption::memory_consumption(lines) +
           MemoryConsumption::memory_consumption(lines_cache) +
           MemoryConsumption::memory_consumption(sorted) +
-          MemoryConsumption::memory_consumption(local_lines));
+          MemoryConsumption::memory_consumption(local_lines) +
+          compressed_lines.memory_consumption());
 }
 
 
@@ -2610,11 +2660,16 @@ AffineConstraints<number>::distribute(VectorType &vec) const
       // following.
       IndexSet needed_elements = vec_owned_elements;
 
-      for (const ConstraintLine &line : lines)
-        if (vec_owned_elements.is_element(line.index))
-          for (const std::pair<size_type, number> &entry : line.entries)
-            if (!vec_owned_elements.is_element(entry.first))
-              needed_elements.add_index(entry.first);
+      const size_type n_lines = compressed_lines.constrained_dofs.size();
+      for (size_type row = 0; row < n_lines; ++row)
+        if (vec_owned_elements.is_element(
+              compressed_lines.constrained_dofs[row]))
+          for (size_type j = compressed_lines.row_starts[row];
+               j < compressed_lines.row_starts[row + 1];
+               ++j)
+            if (!vec_owned_elements.is_element(
+                  compressed_lines.column_indices[j]))
+              needed_elements.add_index(compressed_lines.column_indices[j]);
 
       VectorType ghosted_vector;
       internal::import_vector_with_ghost_elements(
@@ -2624,20 +2679,23 @@ AffineConstraints<number>::distribute(VectorType &vec) const
         ghosted_vector,
         std::integral_constant<bool, IsBlockVector<VectorType>::value>());
 
-      for (const ConstraintLine &line : lines)
-        if (vec_owned_elements.is_element(line.index))
+      for (size_type row = 0; row < n_lines; ++row)
+        if (vec_owned_elements.is_element(
+              compressed_lines.constrained_dofs[row]))
           {
-            typename VectorType::value_type new_value = line.inhomogeneity;
-            for (const std::pair<size_type, number> &entry : line.entries)
+            typename VectorType::value_type new_value =
+              compressed_lines.inhomogeneities[row];
+            for (size_type j = compressed_lines.row_starts[row];
+                 j < compressed_lines.row_starts[row + 1];
+                 ++j)
               new_value +=
                 (static_cast<typename VectorType::value_type>(
-                   internal::ElementAccess<VectorType>::get(ghosted_vector,
-                                                            entry.first)) *
-                 entry.second);
+                   internal::ElementAccess<VectorType>::get(
+                     ghosted_vector, compressed_lines.column_indices[j])) *
+                 compressed_lines.weights[j]);
             AssertIsFinite(new_value);
-            internal::ElementAccess<VectorType>::set(new_value,
-                                                     line.index,
-                                                     vec);
+            internal::ElementAccess<VectorType>::set(
+              new_value, compressed_lines.constrained_dofs[row], vec);
           }
 
       // now compress to communicate the entries that we added to
@@ -2652,24 +2710,38 @@ AffineConstraints<number>::distribute(VectorType &vec) const
     // support anything else or because it's completely stored
     // locally)
     {
-      for (const ConstraintLine &next_constraint : lines)
-        {
-          // fill entry in line
-          // next_constraint.index by adding the
-          // different contributions
-          typename VectorType::value_type new_value =
-            next_constraint.inhomogeneity;
-          for (const std::pair<size_type, number> &entry :
-               next_constraint.entries)
-            new_value +=
-              (static_cast<typename VectorType::value_type>(
-                 internal::ElementAccess<VectorType>::get(vec, entry.first)) *
-               entry.second);
-          AssertIsFinite(new_value);
-          internal::ElementAccess<VectorType>::set(new_value,
-                                                   next_constraint.index,
-                                                   vec);
-        }
+      // the rows of a closed object only read from unconstrained entries
+      // and write to distinct constrained entries, so we can work on
+      // disjoint ranges of rows in parallel
+      const auto distribute_range = [&](const size_type begin,
+                                        const size_type end) {
+        for (size_type row = begin; row < end; ++row)
+          {
+            // fill entry in line constrained_dofs[row] by adding the
+            // different contributions
+            typename VectorType::value_type new_value =
+              compressed_lines.inhomogeneities[row];
+            for (size_type j = compressed_lines.row_starts[row];
+                 j < compressed_lines.row_starts[row + 1];
+                 ++j)
+              new_value +=
+                (static_cast<typename VectorType::value_type>(
+                   internal::ElementAccess<VectorType>::get(
+                     vec, compressed_lines.column_indices[j])) *
+                 compressed_lines.weights[j]);
+            AssertIsFinite(new_value);
+            internal::ElementAccess<VectorType>::set(
+              new_value, compressed_lines.constrained_dofs[row], vec);
+          }
+      };
+
+      // each row only touches a handful of entries, so only split the
+      // work into chunks of some thousand rows
+      const unsigned int grain_size = 2048;
+      parallel::apply_to_subranges(size_type(0),
+                                   compressed_lines.constrained_dofs.size(),
+                                   distribute_range,
+                                   grain_size);
     }
 }
 
@@ -2678,6 +2750,32 @@ namespace internal
 {
   namespace AffineConstraints
   {
+    template <typename number>
+    void
+    CompressedLines<number>::clear()
+    {
+      constrained_dofs.clear();
+      inhomogeneities.clear();
+      row_starts.clear();
+      column_indices.clear();
+      weights.clear();
+    }
+
+
+
+    template <typename number>
+    std::size_t
+    CompressedLines<number>::memory_consumption() const
+    {
+      return (MemoryConsumption::memory_consumption(constrained_dofs) +
+              MemoryConsumption::memory_consumption(inhomogeneities) +
+              MemoryConsumption::memory_consumption(row_starts) +
+              MemoryConsumption::memory_consumption(column_indices) +
+              MemoryConsumption::memory_consumption(weights));
+    }
+
+
+
     inline Distributing::Distributing(const size_type global_row,
                                       const size_type local_row)
       : global_row(global_row)
@@ -21,13 +21,18 @@
 
 #include <deal.II/base/index_set.h>
 #include <deal.II/base/subscriptor.h>
+#include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/lac/exceptions.h>
 #include <deal.II/lac/sparsity_pattern_base.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -37,6 +42,250 @@ DEAL_II_NAMESPACE_OPEN
 class DynamicSparsityPattern;
 #endif
 
+namespace internal
+{
+  namespace DynamicSparsityPatternImplementation
+  {
+    /**
+     * A memory pool for the arrays that hold the column indices of the rows
+     * of a DynamicSparsityPattern. Memory is handed out in blocks of a fixed
+     * set of size classes, carved from a small number of large chunks.
+     * Blocks that are returned to the pool are kept in one free list per
+     * size class and reused by later requests of the same size class, so
+     * that growing millions of rows does not translate into millions of
+     * calls to the global allocator, and memory released by one row can be
+     * picked up by another one. Requests larger than the largest size class
+     * are forwarded to the global operator new.
+     *
+     * Each thread works on its own arena of chunks and free lists, so that
+     * rows can be filled concurrently from several threads without
+     * synchronizing the allocations themselves. Finding the arena of the
+     * calling thread in a Threads::ThreadLocalStorage object takes a lock,
+     * so each thread remembers the arena of the pool it used last, and the
+     * lookup only happens when a thread starts to use another pool. A block
+     * may be returned by a different thread than the one that allocated it,
+     * in which case it is recycled by the arena of the returning thread.
+     *
+     * The size classes are spaced by a quarter of a power of two, i.e., a
+     * block wastes at most 25% of its size on top of the slack that the
+     * std::vector of the row keeps for growing. Memory of returned blocks is
+     * only reused within the pool and given back to the system upon clear()
+     * or destruction of the pool, i.e., when the DynamicSparsityPattern is
+     * reinitialized or destroyed.
+     *
+     * All functions of this class may be called concurrently from several
+     * threads, except for clear().
+     */
+    class EntryPool
+    {
+    public:
+      /**
+       * Constructor. Sets up an empty pool.
+       */
+      EntryPool();
+
+      /**
+       * Destructor. Releases all chunks, irrespective of whether the blocks
+       * carved from them have been returned.
+       */
+      ~EntryPool() = default;
+
+      /**
+       * Return a pointer to a block of at least @p n_bytes bytes.
+       */
+      void *
+      allocate(const std::size_t n_bytes);
+
+      /**
+       * Return a block previously obtained by allocate() with the same
+       * @p n_bytes to the pool.
+       */
+      void
+      deallocate(void *block, const std::size_t n_bytes);
+
+      /**
+       * Release all memory held by the pool. Only call this function once
+       * all blocks handed out by it have been returned or are not used any
+       * more, and while no other thread uses the pool.
+       */
+      void
+      clear();
+
+      /**
+       * Return the number of bytes allocated by the pool, including the
+       * blocks that are currently unused.
+       */
+      std::size_t
+      memory_consumption() const;
+
+    private:
+      /**
+       * The smallest block size and the granularity of all block sizes.
+       */
+      static constexpr std::size_t min_block_size = 16;
+
+      /**
+       * The largest block size. Larger requests are forwarded to the global
+       * operator new.
+       */
+      static constexpr std::size_t max_block_size = std::size_t(1) << 16;
+
+      /**
+       * The number of size classes: four classes of 16 to 64 bytes, and four
+       * classes for each further power of two up to max_block_size.
+       */
+      static constexpr unsigned int n_size_classes = 44;
+
+      /**
+       * Chunks start small (so that patterns with few rows do not pay for a
+       * large chunk) and double up to the maximal size.
+       */
+      static constexpr std::size_t min_chunk_size = std::size_t(1) << 12;
+      static constexpr std::size_t max_chunk_size = std::size_t(1) << 20;
+
+      /**
+       * Return the size class of a request of @p n_bytes bytes, which must
+       * not exceed max_block_size.
+       */
+      static unsigned int
+      size_class(const std::size_t n_bytes);
+
+      /**
+       * Return the size in bytes of the blocks of size class @p c.
+       */
+      static std::size_t
+      class_size(const unsigned int c);
+
+      /**
+       * The chunks and free lists used by one thread.
+       */
+      struct Arena
+      {
+        Arena();
+
+        /**
+         * Arenas own their chunks and are never copied.
+         */
+        Arena(const Arena &) = delete;
+
+        Arena &
+        operator=(const Arena &) = delete;
+
+        /**
+         * Push a block of size class @p c onto its free list.
+         */
+        void
+        push_block(void *block, const unsigned int c);
+
+        /**
+         * The chunks from which blocks are carved.
+         */
+        std::vector<std::unique_ptr<char[]>> chunks;
+
+        /**
+         * Size of the last chunk and the number of its bytes already handed
+         * out.
+         */
+        std::size_t chunk_size;
+        std::size_t chunk_fill;
+
+        /**
+         * Heads of the singly-linked lists of free blocks, one per size
+         * class. The link to the next block is stored in the first bytes of
+         * each free block.
+         */
+        std::array<void *, n_size_classes> free_lists;
+      };
+
+      /**
+       * Return the arena of the calling thread.
+       */
+      Arena &
+      get_arena();
+
+      /**
+       * The arenas of the threads that have used the pool.
+       */
+      Threads::ThreadLocalStorage<Arena> arenas;
+
+      /**
+       * A number that identifies the arenas currently held in @p arenas. It
+       * is unique among all pools and changes upon clear(), so that a thread
+       * can tell whether the arena it remembers still belongs to this pool.
+       */
+      std::uint64_t id;
+
+      /**
+       * Total number of bytes in chunks, and in blocks obtained directly
+       * from operator new, respectively.
+       */
+      std::atomic<std::size_t> chunk_bytes;
+      std::atomic<std::size_t> large_block_bytes;
+    };
+
+
+
+    /**
+     * A standard-conforming allocator that obtains its memory from an
+     * EntryPool. A default-constructed allocator (without pool) uses the
+     * global operator new.
+     */
+    template <typename T>
+    class PoolAllocator
+    {
+    public:
+      using value_type = T;
+
+      PoolAllocator(EntryPool *pool = nullptr) noexcept
+        : pool(pool)
+      {}
+
+      template <typename U>
+      PoolAllocator(const PoolAllocator<U> &other) noexcept
+        : pool(other.pool)
+      {}
+
+      T *
+      allocate(const std::size_t n)
+      {
+        if (pool != nullptr)
+          return static_cast<T *>(pool->allocate(n * sizeof(T)));
+        else
+          return static_cast<T *>(::operator new(n * sizeof(T)));
+      }
+
+      void
+      deallocate(T *p, const std::size_t n) noexcept
+      {
+        if (pool != nullptr)
+          pool->deallocate(p, n * sizeof(T));
+        else
+          ::operator delete(p);
+      }
+
+      template <typename U>
+      bool
+      operator==(const PoolAllocator<U> &other) const noexcept
+      {
+        return pool == other.pool;
+      }
+
+      template <typename U>
+      bool
+      operator!=(const PoolAllocator<U> &other) const noexcept
+      {
+        return pool != other.pool;
+      }
+
+    private:
+      EntryPool *pool;
+
+      template <typename U>
+      friend class PoolAllocator;
+    };
+  } // namespace DynamicSparsityPatternImplementation
+} // namespace internal
+
 /**
  * @addtogroup Sparsity
  * @{
@@ -141,7 +390,7 @@ namespace DynamicSparsityPatternIterators
      * A pointer to the element within the current row that we currently point
      * to.
      */
-    std::vector<size_type>::const_iterator current_entry;
+    const size_type *current_entry;
 
     /**
      * A pointer to the end of the current row. We store this to make
@@ -149,7 +398,7 @@ namespace DynamicSparsityPatternIterators
      * needs to do the IndexSet translation from row index to the index within
      * the 'lines' array of DynamicSparsityPattern.
      */
-    std::vector<size_type>::const_iterator end_of_row;
+    const size_type *end_of_row;
 
     /**
      * Move the accessor to the next nonzero entry in the matrix.
@@ -306,6 +555,17 @@ namespace DynamicSparsityPatternIterators
  * inquiring properties of the sparsity pattern are the same.
  *
  *
+ * <h3>Memory management</h3>
+ *
+ * The column indices of each row are stored in a sorted array that grows as
+ * entries are added. Rather than allocating these arrays one by one from
+ * the global heap, which for large patterns means millions of small
+ * allocations and a fragmented heap, the object obtains them from a memory
+ * pool that hands out blocks from a few large chunks and recycles the blocks
+ * rows release when they grow. The pool is thread-safe, so that different
+ * threads may add entries to different rows at the same time.
+ *
+ *
  * <h3>Usage</h3>
  *
  * Usage of this class is explained in step-2 (without constraints) and step-6
@@ -425,6 +685,9 @@ public:
 
   /**
    * Add a nonzero entry. If the entry already exists, this call does nothing.
+   *
+   * This function may be called concurrently from several threads as long
+   * as they add entries to different rows.
    */
   void
   add(const size_type i, const size_type j);
@@ -432,6 +695,9 @@ public:
   /**
    * Add several nonzero entries to the specified row. Already existing
    * entries are ignored.
+   *
+   * This function may be called concurrently from several threads as long
+   * as they add entries to different rows.
    */
   template <typename ForwardIterator>
   void
@@ -666,9 +932,11 @@ public:
 
 private:
   /**
-   * A flag that stores whether any entries have been added so far.
+   * A flag that stores whether any entries have been added so far. This is
+   * an atomic variable because add() and add_entries() may be called
+   * concurrently for different rows.
    */
-  bool have_entries;
+  std::atomic<bool> have_entries;
 
   /**
    * A set that contains the valid rows.
@@ -677,20 +945,44 @@ private:
   IndexSet rowset;
 
 
+  /**
+   * Memory pool from which the column index arrays of all rows are
+   * allocated. Stored by pointer so that the address the allocators of the
+   * rows refer to never changes. Declared before @p lines so that it is
+   * destroyed after all rows have returned their memory.
+   */
+  std::unique_ptr<internal::DynamicSparsityPatternImplementation::EntryPool>
+    entry_pool;
+
   /**
    * Store some data for each row describing which entries of this row are
    * nonzero. Data is stored sorted in the @p entries std::vector.  The vector
    * per row is dynamically growing upon insertion doubling its memory each
-   * time.
+   * time. Its memory is obtained from the @p entry_pool of the sparsity
+   * pattern.
    */
   struct Line
   {
   public:
+    /**
+     * Type of the array of column indices.
+     */
+    using Entries = std::vector<
+      size_type,
+      internal::DynamicSparsityPatternImplementation::PoolAllocator<size_type>>;
+
+    /**
+     * Constructor. Allocate the column indices from the given pool, or with
+     * the global operator new if no pool is given.
+     */
+    Line(internal::DynamicSparsityPatternImplementation::EntryPool *pool =
+           nullptr);
+
     /**
      * Storage for the column indices of this row. This array is always kept
      * sorted.
      */
-    std::vector<size_type> entries;
+    Entries entries;
 
     /**
      * Add the given column number to this line.
@@ -737,17 +1029,21 @@ namespace DynamicSparsityPatternIterators
     , current_row(row)
     , current_entry(
         ((sparsity_pattern->rowset.size() == 0) ?
-           sparsity_pattern->lines[current_row].entries.begin() :
+           sparsity_pattern->lines[current_row].entries.data() :
            sparsity_pattern
              ->lines[sparsity_pattern->rowset.index_within_set(current_row)]
-             .entries.begin()) +
+             .entries.data()) +
         index_within_row)
     , end_of_row(
         (sparsity_pattern->rowset.size() == 0) ?
-          sparsity_pattern->lines[current_row].entries.end() :
+          sparsity_pattern->lines[current_row].entries.data() +
+            sparsity_pattern->lines[current_row].entries.size() :
           sparsity_pattern
-            ->lines[sparsity_pattern->rowset.index_within_set(current_row)]
-            .entries.end())
+              ->lines[sparsity_pattern->rowset.index_within_set(current_row)]
+              .entries.data() +
+            sparsity_pattern
+              ->lines[sparsity_pattern->rowset.index_within_set(current_row)]
+              .entries.size())
   {
     AssertIndexRange(current_row, sparsity_pattern->n_rows());
     Assert((sparsity_pattern->rowset.size() == 0) ||
@@ -769,8 +1065,8 @@ namespace DynamicSparsityPatternIterators
   inline Accessor::Accessor(const DynamicSparsityPattern *sparsity_pattern)
     : sparsity_pattern(sparsity_pattern)
     , current_row(numbers::invalid_size_type)
-    , current_entry()
-    , end_of_row()
+    , current_entry(nullptr)
+    , end_of_row(nullptr)
   {}
 
 
@@ -778,8 +1074,8 @@ namespace DynamicSparsityPatternIterators
   inline Accessor::Accessor()
     : sparsity_pattern(nullptr)
     , current_row(numbers::invalid_size_type)
-    , current_entry()
-    , end_of_row()
+    , current_entry(nullptr)
+    , end_of_row(nullptr)
   {}
 
 
@@ -811,10 +1107,10 @@ namespace DynamicSparsityPatternIterators
 
     return (current_entry -
             ((sparsity_pattern->rowset.size() == 0) ?
-               sparsity_pattern->lines[current_row].entries.begin() :
+               sparsity_pattern->lines[current_row].entries.data() :
                sparsity_pattern
                  ->lines[sparsity_pattern->rowset.index_within_set(current_row)]
-                 .entries.begin()));
+                 .entries.data()));
   }
 
 
@@ -974,6 +1270,15 @@ namespace DynamicSparsityPatternIterators
 } // namespace DynamicSparsityPatternIterators
 
 
+inline DynamicSparsityPattern::Line::Line(
+  internal::DynamicSparsityPatternImplementation::EntryPool *pool)
+  : entries(
+      internal::DynamicSparsityPatternImplementation::PoolAllocator<size_type>(
+        pool))
+{}
+
+
+
 inline void
 DynamicSparsityPattern::Line::add(const size_type j)
 {
@@ -985,7 +1290,7 @@ DynamicSparsityPattern::Line::add(const size_type j)
     }
 
   // do a binary search to find the place where to insert:
-  std::vector<size_type>::iterator it =
+  Entries::iterator it =
     Utilities::lower_bound(entries.begin(), entries.end(), j);
 
   // If this entry is a duplicate, exit immediately
@@ -45,6 +45,11 @@ namespace LinearAlgebra
    */
   namespace distributed
   {
+    namespace internal
+    {
+      class SharedMemoryExchangeBase;
+    }
+
     template <typename>
     class BlockVector;
   }
@@ -244,6 +249,19 @@ namespace LinearAlgebra
      *   MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL,
      *                       &comm_sm);
      * @endcode
+     *
+     * For vectors of @p double and @p float, such a communicator also changes
+     * how update_ghost_values() and compress() with VectorOperation::add work:
+     * Ghost values owned by a process in the same shared-memory domain are
+     * copied directly out of the memory of that process, and compress()
+     * contributions are added by the owner directly from the ghost range of
+     * the neighbor, without packing the data into MPI messages. Only the
+     * data exchanged with processes in other shared-memory domains is sent as
+     * messages. Since this applies to the vector itself, all users of the
+     * vector benefit, not only MatrixFree. As a consequence of the direct
+     * access, update_ghost_values_finish() and compress_finish() wait until
+     * the neighbors in the shared-memory domain are done accessing the memory
+     * of this process.
      */
     template <typename Number, typename MemorySpace = MemorySpace::Host>
     class Vector : public ::dealii::LinearAlgebra::VectorSpaceVector<Number>,
@@ -1407,6 +1425,21 @@ namespace LinearAlgebra
        */
       MPI_Comm comm_sm;
 
+      /**
+       * The shared-memory communicator for which the val array, and in
+       * particular its views into the memory of the other processes of the
+       * shared-memory domain, have been allocated in resize_val().
+       */
+      MPI_Comm allocated_comm_sm;
+
+      /**
+       * Object that performs update_ghost_values() and compress() through
+       * the shared-memory windows of the processes in `comm_sm`. Only set
+       * up if `comm_sm` is not MPI_COMM_SELF, for Number types @p double and
+       * @p float in the Host memory space.
+       */
+      std::shared_ptr<const internal::SharedMemoryExchangeBase> sm_exchanger;
+
       /**
        * A helper function that clears the compress_requests and
        * update_ghost_values_requests field. Used in reinit() functions.
@@ -1421,6 +1454,16 @@ namespace LinearAlgebra
       resize_val(const size_type new_allocated_size,
                  const MPI_Comm &comm_sm = MPI_COMM_SELF);
 
+      /**
+       * A helper function that sets up @p sm_exchanger for the current
+       * partitioner and `comm_sm`, unless an object for them is already
+       * present. The object is shared with all other vectors using the same
+       * partitioner and `comm_sm`, see
+       * internal::get_shared_memory_exchange(). Used in reinit() functions.
+       */
+      void
+      setup_shared_memory_exchange();
+
       // Make all other vector types friends.
       template <typename Number2, typename MemorySpace2>
       friend class Vector;
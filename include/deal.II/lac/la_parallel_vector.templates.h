@@ -1,6 +1,6 @@
 // ---------------------------------------------------------------------
 //
-// Copyright (C) 2011 - 2022 by the deal.II authors
+// Copyright (C) 2011 - 2023 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -23,6 +23,7 @@
 
 #include <deal.II/lac/exceptions.h>
 #include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/la_parallel_vector_shared_memory_exchange.h>
 #include <deal.II/lac/petsc_vector.h>
 #include <deal.II/lac/read_write_vector.h>
 #include <deal.II/lac/trilinos_vector.h>
@@ -493,6 +494,177 @@ namespace LinearAlgebra
             Kokkos::Max<RealType, Kokkos::HostSpace>(result));
         }
       };
+
+
+
+      /**
+       * Ghost exchange through MPI-3 shared memory for vectors set up with a
+       * shared-memory communicator. The general template is used for the
+       * combinations of number type and memory space that the exchange
+       * does not support and only states so.
+       */
+      template <typename Number,
+                typename MemorySpaceType,
+                bool is_supported =
+                  std::is_same<MemorySpaceType,
+                               ::dealii::MemorySpace::Host>::value &&
+                  (std::is_same<Number, double>::value ||
+                   std::is_same<Number, float>::value)>
+      struct SharedMemoryExchange
+      {
+        static constexpr bool supported = false;
+
+        template <typename... Args>
+        static void
+        update_ghost_values_start(Args &&...)
+        {
+          Assert(false, ExcInternalError());
+        }
+
+        template <typename... Args>
+        static void
+        update_ghost_values_finish(Args &&...)
+        {
+          Assert(false, ExcInternalError());
+        }
+
+        template <typename... Args>
+        static void
+        compress_start(Args &&...)
+        {
+          Assert(false, ExcInternalError());
+        }
+
+        template <typename... Args>
+        static void
+        compress_finish(Args &&...)
+        {
+          Assert(false, ExcInternalError());
+        }
+      };
+
+
+
+      /**
+       * Ghost exchange through MPI-3 shared memory for double and float
+       * vectors on the host. Ghost values owned by a process in the same
+       * shared-memory domain are read from, and compress() contributions
+       * are added into, the shared-memory window of the owner directly,
+       * without packing them into MPI messages. Only the ghost values of
+       * processes on other nodes are sent as messages.
+       *
+       * Since the neighbors access the memory of this process directly, the
+       * finish functions end by synchronizing with these neighbors: Without
+       * it, a process could change its locally owned values or ghost values
+       * while a neighbor is still reading them.
+       */
+      template <typename Number, typename MemorySpaceType>
+      struct SharedMemoryExchange<Number, MemorySpaceType, true>
+      {
+        using Exchanger = SharedMemoryExchangeBase;
+
+        static constexpr bool supported = true;
+
+        static void
+        update_ghost_values_start(
+          const Exchanger &  exchanger,
+          const unsigned int communication_channel,
+          ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpaceType>
+            &data,
+          ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpaceType>
+            &                       import_data,
+          std::vector<MPI_Request> &requests)
+        {
+          if (import_data.values.size() < exchanger.n_import_indices())
+            Kokkos::resize(import_data.values, exchanger.n_import_indices());
+
+          exchanger.export_to_ghosted_array_start(
+            communication_channel,
+            ArrayView<const Number>(data.values.data(),
+                                    exchanger.locally_owned_size()),
+            data.values_sm,
+            ArrayView<Number>(data.values.data() +
+                                exchanger.locally_owned_size(),
+                              exchanger.n_ghost_indices()),
+            ArrayView<Number>(import_data.values.data(),
+                              exchanger.n_import_indices()),
+            requests);
+        }
+
+        static void
+        update_ghost_values_finish(
+          const Exchanger &exchanger,
+          ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpaceType>
+            &                       data,
+          std::vector<MPI_Request> &requests)
+        {
+          exchanger.export_to_ghosted_array_finish(
+            ArrayView<const Number>(data.values.data(),
+                                    exchanger.locally_owned_size()),
+            data.values_sm,
+            ArrayView<Number>(data.values.data() +
+                                exchanger.locally_owned_size(),
+                              exchanger.n_ghost_indices()),
+            requests);
+          requests.clear();
+
+          exchanger.synchronize_sm_neighbors();
+        }
+
+        static void
+        compress_start(
+          const Exchanger &  exchanger,
+          const unsigned int communication_channel,
+          ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpaceType>
+            &data,
+          ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpaceType>
+            &                       import_data,
+          std::vector<MPI_Request> &requests)
+        {
+          if (import_data.values.size() < exchanger.n_import_indices())
+            Kokkos::resize(import_data.values, exchanger.n_import_indices());
+
+          exchanger.import_from_ghosted_array_start(
+            VectorOperation::add,
+            communication_channel,
+            ArrayView<const Number>(data.values.data(),
+                                    exchanger.locally_owned_size()),
+            data.values_sm,
+            ArrayView<Number>(data.values.data() +
+                                exchanger.locally_owned_size(),
+                              exchanger.n_ghost_indices()),
+            ArrayView<Number>(import_data.values.data(),
+                              exchanger.n_import_indices()),
+            requests);
+        }
+
+        static void
+        compress_finish(
+          const Exchanger &exchanger,
+          ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpaceType>
+            &data,
+          ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpaceType>
+            &                       import_data,
+          std::vector<MPI_Request> &requests)
+        {
+          exchanger.import_from_ghosted_array_finish(
+            VectorOperation::add,
+            ArrayView<Number>(data.values.data(),
+                              exchanger.locally_owned_size()),
+            data.values_sm,
+            ArrayView<Number>(data.values.data() +
+                                exchanger.locally_owned_size(),
+                              exchanger.n_ghost_indices()),
+            ArrayView<const Number>(import_data.values.data(),
+                                    exchanger.n_import_indices()),
+            requests);
+          requests.clear();
+
+          // the owners zero the ghost values they read from our window, so
+          // the ghost range is only entirely zero once they are done
+          exchanger.synchronize_sm_neighbors();
+        }
+      };
     } // namespace internal
 
 
@@ -529,6 +701,7 @@ namespace LinearAlgebra
                                      allocated_size,
                                      data,
                                      comm_sm);
+      allocated_comm_sm = comm_sm;
 
       thread_loop_partitioner =
         std::make_shared<::dealii::parallel::internal::TBBPartitioner>();
@@ -536,6 +709,24 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number, typename MemorySpaceType>
+    void
+    Vector<Number, MemorySpaceType>::setup_shared_memory_exchange()
+    {
+      // the exchange accesses the memory of the other processes through the
+      // views set up in resize_val(), so these must belong to comm_sm
+      if (internal::SharedMemoryExchange<Number, MemorySpaceType>::supported ==
+            false ||
+          comm_sm == MPI_COMM_SELF || allocated_comm_sm != comm_sm)
+        sm_exchanger.reset();
+      else if (sm_exchanger == nullptr ||
+               sm_exchanger->get_sm_mpi_communicator() != comm_sm)
+        sm_exchanger =
+          internal::get_shared_memory_exchange(partitioner, comm_sm);
+    }
+
+
+
     template <typename Number, typename MemorySpaceType>
     void
     Vector<Number, MemorySpaceType>::reinit(const size_type size,
@@ -552,6 +743,7 @@ namespace LinearAlgebra
 
       // set partitioner to serial version
       partitioner = std::make_shared<Utilities::MPI::Partitioner>(size);
+      sm_exchanger.reset();
 
       // set entries to zero if so requested
       if (omit_zeroing_entries == false)
@@ -585,6 +777,8 @@ namespace LinearAlgebra
       partitioner = std::make_shared<Utilities::MPI::Partitioner>(local_size,
                                                                   ghost_size,
                                                                   comm);
+      sm_exchanger.reset();
+      setup_shared_memory_exchange();
 
       this->operator=(Number());
     }
@@ -606,14 +800,21 @@ namespace LinearAlgebra
       // check whether the partitioners are
       // different (check only if the are allocated
       // differently, not if the actual data is
-      // different)
-      if (partitioner.get() != v.partitioner.get())
+      // different), or whether the memory has been
+      // allocated for a different shared-memory
+      // communicator
+      if (partitioner.get() != v.partitioner.get() ||
+          allocated_comm_sm != this->comm_sm)
         {
           partitioner = v.partitioner;
           const size_type new_allocated_size =
             partitioner->locally_owned_size() + partitioner->n_ghost_indices();
           resize_val(new_allocated_size, this->comm_sm);
+          sm_exchanger.reset();
         }
+      if (sm_exchanger == nullptr)
+        sm_exchanger = v.sm_exchanger;
+      setup_shared_memory_exchange();
 
       if (omit_zeroing_entries == false)
         this->operator=(Number());
@@ -670,14 +871,18 @@ namespace LinearAlgebra
 
       this->comm_sm = comm_sm;
 
-      // set vector size and allocate memory
-      if (partitioner.get() != partitioner_in.get())
+      // set vector size and allocate memory, also if the memory has been
+      // allocated for a different shared-memory communicator
+      if (partitioner.get() != partitioner_in.get() ||
+          allocated_comm_sm != comm_sm)
         {
           partitioner = partitioner_in;
           const size_type new_allocated_size =
             partitioner->locally_owned_size() + partitioner->n_ghost_indices();
           resize_val(new_allocated_size, comm_sm);
+          sm_exchanger.reset();
         }
+      setup_shared_memory_exchange();
 
       // initialize to zero
       *this = Number();
@@ -700,6 +905,7 @@ namespace LinearAlgebra
       : partitioner(std::make_shared<Utilities::MPI::Partitioner>())
       , allocated_size(0)
       , comm_sm(MPI_COMM_SELF)
+      , allocated_comm_sm(MPI_COMM_SELF)
     {
       reinit(0);
     }
@@ -713,6 +919,7 @@ namespace LinearAlgebra
       , allocated_size(0)
       , vector_is_ghosted(false)
       , comm_sm(MPI_COMM_SELF)
+      , allocated_comm_sm(MPI_COMM_SELF)
     {
       reinit(v, true);
 
@@ -741,6 +948,7 @@ namespace LinearAlgebra
       : allocated_size(0)
       , vector_is_ghosted(false)
       , comm_sm(MPI_COMM_SELF)
+      , allocated_comm_sm(MPI_COMM_SELF)
     {
       reinit(local_range, ghost_indices, communicator);
     }
@@ -753,6 +961,7 @@ namespace LinearAlgebra
       : allocated_size(0)
       , vector_is_ghosted(false)
       , comm_sm(MPI_COMM_SELF)
+      , allocated_comm_sm(MPI_COMM_SELF)
     {
       reinit(local_range, communicator);
     }
@@ -764,6 +973,7 @@ namespace LinearAlgebra
       : allocated_size(0)
       , vector_is_ghosted(false)
       , comm_sm(MPI_COMM_SELF)
+      , allocated_comm_sm(MPI_COMM_SELF)
     {
       reinit(size, false);
     }
@@ -776,6 +986,7 @@ namespace LinearAlgebra
       : allocated_size(0)
       , vector_is_ghosted(false)
       , comm_sm(MPI_COMM_SELF)
+      , allocated_comm_sm(MPI_COMM_SELF)
     {
       reinit(partitioner);
     }
@@ -975,6 +1186,18 @@ namespace LinearAlgebra
       // make this function thread safe
       std::lock_guard<std::mutex> lock(mutex);
 
+      // the shared-memory exchange only supports adding up the ghost values
+      if (sm_exchanger != nullptr && operation == VectorOperation::add)
+        {
+          internal::SharedMemoryExchange<Number, MemorySpaceType>::
+            compress_start(*sm_exchanger,
+                           communication_channel,
+                           data,
+                           import_data,
+                           compress_requests);
+          return;
+        }
+
       // allocate import_data in case it is not set up yet
       if (partitioner->n_import_indices() > 0)
         {
@@ -1052,6 +1275,17 @@ namespace LinearAlgebra
 
       // make this function thread safe
       std::lock_guard<std::mutex> lock(mutex);
+
+      if (sm_exchanger != nullptr && operation == VectorOperation::add)
+        {
+          internal::SharedMemoryExchange<Number, MemorySpaceType>::
+            compress_finish(*sm_exchanger,
+                            data,
+                            import_data,
+                            compress_requests);
+          return;
+        }
+
 #  if !defined(DEAL_II_MPI_WITH_DEVICE_SUPPORT)
       if (std::is_same<MemorySpaceType, MemorySpace::Default>::value)
         {
@@ -1111,6 +1345,20 @@ namespace LinearAlgebra
     {
       AssertIndexRange(communication_channel, 200);
 #ifdef DEAL_II_WITH_MPI
+      // with the shared-memory exchange, all processes of the shared-memory
+      // domain need to take part, even if they have no ghost indices
+      if (sm_exchanger != nullptr)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          internal::SharedMemoryExchange<Number, MemorySpaceType>::
+            update_ghost_values_start(*sm_exchanger,
+                                      communication_channel,
+                                      data,
+                                      import_data,
+                                      update_ghost_values_requests);
+          return;
+        }
+
       // nothing to do when we neither have import nor ghost indices.
       if (partitioner->n_ghost_indices() == 0 &&
           partitioner->n_import_indices() == 0)
@@ -1190,6 +1438,17 @@ namespace LinearAlgebra
     Vector<Number, MemorySpaceType>::update_ghost_values_finish() const
     {
 #ifdef DEAL_II_WITH_MPI
+      if (sm_exchanger != nullptr)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          internal::SharedMemoryExchange<Number, MemorySpaceType>::
+            update_ghost_values_finish(*sm_exchanger,
+                                       data,
+                                       update_ghost_values_requests);
+          vector_is_ghosted = true;
+          return;
+        }
+
       // wait for both sends and receives to complete, even though only
       // receives are really necessary. this gives (much) better performance
       AssertDimension(partitioner->ghost_targets().size() +
@@ -1365,6 +1624,9 @@ namespace LinearAlgebra
       std::swap(comm_sm, v.comm_sm);
 #endif
 
+      std::swap(allocated_comm_sm, v.allocated_comm_sm);
+      std::swap(sm_exchanger, v.sm_exchanger);
+
       std::swap(partitioner, v.partitioner);
       std::swap(thread_loop_partitioner, v.thread_loop_partitioner);
       std::swap(allocated_size, v.allocated_size);
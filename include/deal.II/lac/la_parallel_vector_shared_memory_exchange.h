@@ -0,0 +1,177 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_la_parallel_vector_shared_memory_exchange_h
+#define dealii_la_parallel_vector_shared_memory_exchange_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/mpi_stub.h>
+#include <deal.II/base/partitioner.h>
+
+#include <deal.II/lac/vector_operation.h>
+
+#include <memory>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    namespace internal
+    {
+      /**
+       * Interface of the objects that exchange the ghost values of
+       * LinearAlgebra::distributed::Vector through the MPI-3 shared-memory
+       * windows of the processes in a shared-memory domain. The arguments
+       * of the exchange functions are the locally owned range of the
+       * vector, the shared-memory arrays of the processes in the domain,
+       * the ghost range and a buffer for the values sent to or received
+       * from processes outside of the domain.
+       *
+       * The implementation is provided by the matrix-free framework; lac
+       * only depends on this interface and on
+       * get_shared_memory_exchange().
+       */
+      class SharedMemoryExchangeBase
+      {
+      public:
+        virtual ~SharedMemoryExchangeBase() = default;
+
+        virtual unsigned int
+        locally_owned_size() const = 0;
+
+        virtual unsigned int
+        n_ghost_indices() const = 0;
+
+        virtual unsigned int
+        n_import_indices() const = 0;
+
+        virtual MPI_Comm
+        get_sm_mpi_communicator() const = 0;
+
+        /**
+         * Synchronize with the processes of the shared-memory domain whose
+         * memory this process accesses during the exchange, and with the
+         * processes that access the memory of this process.
+         */
+        virtual void
+        synchronize_sm_neighbors() const = 0;
+
+        virtual void
+        export_to_ghosted_array_start(
+          const unsigned int                          communication_channel,
+          const ArrayView<const double> &             locally_owned_array,
+          const std::vector<ArrayView<const double>> &shared_arrays,
+          const ArrayView<double> &                   ghost_array,
+          const ArrayView<double> &                   temporary_storage,
+          std::vector<MPI_Request> &                  requests) const = 0;
+
+        virtual void
+        export_to_ghosted_array_finish(
+          const ArrayView<const double> &             locally_owned_array,
+          const std::vector<ArrayView<const double>> &shared_arrays,
+          const ArrayView<double> &                   ghost_array,
+          std::vector<MPI_Request> &                  requests) const = 0;
+
+        virtual void
+        import_from_ghosted_array_start(
+          const VectorOperation::values               vector_operation,
+          const unsigned int                          communication_channel,
+          const ArrayView<const double> &             locally_owned_array,
+          const std::vector<ArrayView<const double>> &shared_arrays,
+          const ArrayView<double> &                   ghost_array,
+          const ArrayView<double> &                   temporary_storage,
+          std::vector<MPI_Request> &                  requests) const = 0;
+
+        virtual void
+        import_from_ghosted_array_finish(
+          const VectorOperation::values               vector_operation,
+          const ArrayView<double> &                   locally_owned_storage,
+          const std::vector<ArrayView<const double>> &shared_arrays,
+          const ArrayView<double> &                   ghost_array,
+          const ArrayView<const double> &             temporary_storage,
+          std::vector<MPI_Request> &                  requests) const = 0;
+
+        virtual void
+        export_to_ghosted_array_start(
+          const unsigned int                         communication_channel,
+          const ArrayView<const float> &             locally_owned_array,
+          const std::vector<ArrayView<const float>> &shared_arrays,
+          const ArrayView<float> &                   ghost_array,
+          const ArrayView<float> &                   temporary_storage,
+          std::vector<MPI_Request> &                 requests) const = 0;
+
+        virtual void
+        export_to_ghosted_array_finish(
+          const ArrayView<const float> &             locally_owned_array,
+          const std::vector<ArrayView<const float>> &shared_arrays,
+          const ArrayView<float> &                   ghost_array,
+          std::vector<MPI_Request> &                 requests) const = 0;
+
+        virtual void
+        import_from_ghosted_array_start(
+          const VectorOperation::values              vector_operation,
+          const unsigned int                         communication_channel,
+          const ArrayView<const float> &             locally_owned_array,
+          const std::vector<ArrayView<const float>> &shared_arrays,
+          const ArrayView<float> &                   ghost_array,
+          const ArrayView<float> &                   temporary_storage,
+          std::vector<MPI_Request> &                 requests) const = 0;
+
+        virtual void
+        import_from_ghosted_array_finish(
+          const VectorOperation::values              vector_operation,
+          const ArrayView<float> &                   locally_owned_storage,
+          const std::vector<ArrayView<const float>> &shared_arrays,
+          const ArrayView<float> &                   ghost_array,
+          const ArrayView<const float> &             temporary_storage,
+          std::vector<MPI_Request> &                 requests) const = 0;
+      };
+
+
+
+      /**
+       * Return an object that exchanges the ghost values of vectors with
+       * the given @p partitioner through the shared memory of the processes
+       * in @p communicator_sm, or a null pointer if this is not possible
+       * because not all processes of @p communicator_sm are part of the
+       * communicator of @p partitioner (on some process).
+       *
+       * Setting up the exchange requires global communication. The objects
+       * are therefore cached per partitioner and shared-memory communicator
+       * for as long as some vector uses them, so that vectors that are
+       * repeatedly re-initialized with the same partitioner only pay for
+       * the setup once. Like the reinit() functions of the vectors, this
+       * function must be called on all processes of the communicator of
+       * @p partitioner, since the processes agree on whether the cached
+       * object can be used with one reduction: If the object has expired on
+       * some process, a new one is set up on all of them.
+       */
+      std::shared_ptr<const SharedMemoryExchangeBase>
+      get_shared_memory_exchange(
+        const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner,
+        const MPI_Comm &communicator_sm);
+    } // namespace internal
+  }   // namespace distributed
+} // namespace LinearAlgebra
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -823,6 +823,121 @@ namespace internal
 
 
 
+  /**
+   * Multiply the vector @p in of length @p n_dofs by the @p n_matrices
+   * matrices @p shapes of size @p n_dofs times @p n_q_points, which are
+   * stored row by row with the quadrature points running fastest, and write
+   * the results to the arrays @p out. This is the evaluation kernel for
+   * elements without tensor product structure, such as simplex, wedge and
+   * pyramid elements. In contrast to one matrix-vector product per matrix,
+   * all matrices are applied in a single pass over the vector, the entries
+   * of the shape matrices are read contiguously, and several quadrature
+   * points are computed at once with independent accumulators.
+   */
+  template <int n_matrices, typename Number, typename Number2>
+  inline void
+  evaluate_dense_matrices(
+    const std::array<const Number2 *, n_matrices> &shapes,
+    const unsigned int                             n_dofs,
+    const unsigned int                             n_q_points,
+    const Number *                                 in,
+    const std::array<Number *, n_matrices> &       out)
+  {
+    // limit the number of accumulators to fit into registers
+    constexpr unsigned int n_block = n_matrices == 1 ? 4 : 2;
+
+    unsigned int q = 0;
+    for (; q + n_block <= n_q_points; q += n_block)
+      {
+        Number sums[n_matrices][n_block];
+        for (unsigned int m = 0; m < n_matrices; ++m)
+          for (unsigned int b = 0; b < n_block; ++b)
+            sums[m][b] = Number();
+        for (unsigned int i = 0; i < n_dofs; ++i)
+          {
+            const Number x = in[i];
+            for (unsigned int m = 0; m < n_matrices; ++m)
+              {
+                const Number2 *shape = shapes[m] + i * n_q_points + q;
+                for (unsigned int b = 0; b < n_block; ++b)
+                  sums[m][b] += shape[b] * x;
+              }
+          }
+        for (unsigned int m = 0; m < n_matrices; ++m)
+          for (unsigned int b = 0; b < n_block; ++b)
+            out[m][q + b] = sums[m][b];
+      }
+    for (; q < n_q_points; ++q)
+      {
+        Number sums[n_matrices];
+        for (unsigned int m = 0; m < n_matrices; ++m)
+          sums[m] = Number();
+        for (unsigned int i = 0; i < n_dofs; ++i)
+          for (unsigned int m = 0; m < n_matrices; ++m)
+            sums[m] += shapes[m][i * n_q_points + q] * in[i];
+        for (unsigned int m = 0; m < n_matrices; ++m)
+          out[m][q] = sums[m];
+      }
+  }
+
+
+
+  /**
+   * The transpose operation of evaluate_dense_matrices(): Multiply each of
+   * the arrays @p in of length @p n_q_points by the transpose of the
+   * respective matrix in @p shapes, sum the results and write them into
+   * (or add them to, if @p add is true) the vector @p out of length
+   * @p n_dofs. Several rows of the shape matrices are processed at once,
+   * which reads the quadrature point data only once per block of rows.
+   */
+  template <int n_matrices, bool add, typename Number, typename Number2>
+  inline void
+  integrate_dense_matrices(
+    const std::array<const Number2 *, n_matrices> &shapes,
+    const unsigned int                             n_dofs,
+    const unsigned int                             n_q_points,
+    const std::array<const Number *, n_matrices> & in,
+    Number *                                       out)
+  {
+    constexpr unsigned int n_block = 4;
+
+    unsigned int i = 0;
+    for (; i + n_block <= n_dofs; i += n_block)
+      {
+        Number sums[n_block];
+        for (unsigned int b = 0; b < n_block; ++b)
+          sums[b] = Number();
+        for (unsigned int m = 0; m < n_matrices; ++m)
+          {
+            const Number2 *shape = shapes[m] + i * n_q_points;
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              {
+                const Number x = in[m][q];
+                for (unsigned int b = 0; b < n_block; ++b)
+                  sums[b] += shape[b * n_q_points + q] * x;
+              }
+          }
+        for (unsigned int b = 0; b < n_block; ++b)
+          if (add)
+            out[i + b] += sums[b];
+          else
+            out[i + b] = sums[b];
+      }
+    for (; i < n_dofs; ++i)
+      {
+        Number sum = Number();
+        for (unsigned int m = 0; m < n_matrices; ++m)
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            sum += shapes[m][i * n_q_points + q] * in[m][q];
+        if (add)
+          out[i] += sum;
+        else
+          out[i] = sum;
+      }
+  }
+
+
+
   template <int dim, int fe_degree, int n_q_points_1d, typename Number>
   inline void
   FEEvaluationImpl<
@@ -841,50 +956,56 @@ namespace internal
       fe_eval.get_shape_info().dofs_per_component_on_cell;
     const std::size_t n_q_points = fe_eval.get_shape_info().n_q_points;
 
-    const auto &shape_data = fe_eval.get_shape_info().data;
-
-    using Eval =
-      EvaluatorTensorProduct<evaluate_general, 1, 0, 0, Number, Number>;
+    const auto &  shape_data      = fe_eval.get_shape_info().data.front();
+    const Number *shape_values    = shape_data.shape_values.data();
+    const Number *shape_gradients = shape_data.shape_gradients.data();
 
-    if (evaluation_flag & EvaluationFlags::values)
+    // the gradients in direction d are stored after the ones of the
+    // previous directions, both for the shape functions and the quadrature
+    // points
+    const bool evaluate_values = evaluation_flag & EvaluationFlags::values;
+    const bool evaluate_gradients =
+      evaluation_flag & EvaluationFlags::gradients;
+    for (unsigned int c = 0; c < n_components; ++c)
       {
-        const auto shape_values    = shape_data.front().shape_values.data();
-        auto       values_quad_ptr = fe_eval.begin_values();
-        auto       values_dofs_actual_ptr = values_dofs_actual;
-
-        Eval eval(shape_values, nullptr, nullptr, n_dofs, n_q_points);
-        for (unsigned int c = 0; c < n_components; ++c)
+        const Number *in = values_dofs_actual + c * n_dofs;
+        Number *      values_quad =
+          evaluate_values ? fe_eval.begin_values() + c * n_q_points : nullptr;
+        Number *gradients_quad =
+          evaluate_gradients ?
+            fe_eval.begin_gradients() + c * dim * n_q_points :
+            nullptr;
+        if (evaluate_values && evaluate_gradients)
           {
-            eval.template values<0, true, false>(values_dofs_actual_ptr,
-                                                 values_quad_ptr);
-
-            values_quad_ptr += n_q_points;
-            values_dofs_actual_ptr += n_dofs;
+            std::array<const Number *, dim + 1> shapes;
+            std::array<Number *, dim + 1>       out;
+            shapes[0] = shape_values;
+            out[0]    = values_quad;
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                shapes[d + 1] = shape_gradients + d * n_dofs * n_q_points;
+                out[d + 1]    = gradients_quad + d * n_q_points;
+              }
+            evaluate_dense_matrices<dim + 1>(
+              shapes, n_dofs, n_q_points, in, out);
           }
-      }
-
-    if (evaluation_flag & EvaluationFlags::gradients)
-      {
-        const auto shape_gradients = shape_data.front().shape_gradients.data();
-        auto       gradients_quad_ptr     = fe_eval.begin_gradients();
-        auto       values_dofs_actual_ptr = values_dofs_actual;
-
-        for (unsigned int c = 0; c < n_components; ++c)
+        else if (evaluate_values)
+          evaluate_dense_matrices<1>(std::array<const Number *, 1>{
+                                       {shape_values}},
+                                     n_dofs,
+                                     n_q_points,
+                                     in,
+                                     std::array<Number *, 1>{{values_quad}});
+        else if (evaluate_gradients)
           {
+            std::array<const Number *, dim> shapes;
+            std::array<Number *, dim>       out;
             for (unsigned int d = 0; d < dim; ++d)
               {
-                Eval eval(nullptr,
-                          shape_gradients + n_q_points * n_dofs * d,
-                          nullptr,
-                          n_dofs,
-                          n_q_points);
-
-                eval.template gradients<0, true, false>(values_dofs_actual_ptr,
-                                                        gradients_quad_ptr);
-
-                gradients_quad_ptr += n_q_points;
+                shapes[d] = shape_gradients + d * n_dofs * n_q_points;
+                out[d]    = gradients_quad + d * n_q_points;
               }
-            values_dofs_actual_ptr += n_dofs;
+            evaluate_dense_matrices<dim>(shapes, n_dofs, n_q_points, in, out);
           }
       }
   }
@@ -911,60 +1032,75 @@ namespace internal
       fe_eval.get_shape_info().dofs_per_component_on_cell;
     const std::size_t n_q_points = fe_eval.get_shape_info().n_q_points;
 
-    const auto &shape_data = fe_eval.get_shape_info().data;
+    const auto &  shape_data      = fe_eval.get_shape_info().data.front();
+    const Number *shape_values    = shape_data.shape_values.data();
+    const Number *shape_gradients = shape_data.shape_gradients.data();
+
+    const bool integrate_values = integration_flag & EvaluationFlags::values;
+    const bool integrate_gradients =
+      integration_flag & EvaluationFlags::gradients;
+    if (!integrate_values && !integrate_gradients)
+      return;
 
-    using Eval =
-      EvaluatorTensorProduct<evaluate_general, 1, 0, 0, Number, Number>;
+    // collect the matrices and the data at quadrature points of all
+    // contributions, so that they get summed in one pass over the
+    // degrees of freedom
+    std::array<const Number *, dim + 1> shapes;
+    unsigned int                        n_matrices = 0;
+    if (integrate_values)
+      shapes[n_matrices++] = shape_values;
+    if (integrate_gradients)
+      for (unsigned int d = 0; d < dim; ++d)
+        shapes[n_matrices++] = shape_gradients + d * n_dofs * n_q_points;
 
-    if (integration_flag & EvaluationFlags::values)
+    for (unsigned int c = 0; c < n_components; ++c)
       {
-        const auto shape_values    = shape_data.front().shape_values.data();
-        auto       values_quad_ptr = fe_eval.begin_values();
-        auto       values_dofs_actual_ptr = values_dofs_actual;
+        Number *out = values_dofs_actual + c * n_dofs;
 
-        Eval eval(shape_values, nullptr, nullptr, n_dofs, n_q_points);
-        for (unsigned int c = 0; c < n_components; ++c)
+        std::array<const Number *, dim + 1> in;
+        unsigned int                        m = 0;
+        if (integrate_values)
+          in[m++] = fe_eval.begin_values() + c * n_q_points;
+        if (integrate_gradients)
+          for (unsigned int d = 0; d < dim; ++d)
+            in[m++] = fe_eval.begin_gradients() + (c * dim + d) * n_q_points;
+
+        if (n_matrices == dim + 1)
           {
-            if (add_into_values_array == false)
-              eval.template values<0, false, false>(values_quad_ptr,
-                                                    values_dofs_actual_ptr);
+            if (add_into_values_array)
+              integrate_dense_matrices<dim + 1, true>(
+                shapes, n_dofs, n_q_points, in, out);
             else
-              eval.template values<0, false, true>(values_quad_ptr,
-                                                   values_dofs_actual_ptr);
-
-            values_quad_ptr += n_q_points;
-            values_dofs_actual_ptr += n_dofs;
+              integrate_dense_matrices<dim + 1, false>(
+                shapes, n_dofs, n_q_points, in, out);
           }
-      }
-
-    if (integration_flag & EvaluationFlags::gradients)
-      {
-        const auto shape_gradients = shape_data.front().shape_gradients.data();
-        auto       gradients_quad_ptr     = fe_eval.begin_gradients();
-        auto       values_dofs_actual_ptr = values_dofs_actual;
-
-        for (unsigned int c = 0; c < n_components; ++c)
+        else if (n_matrices == 1)
           {
+            const std::array<const Number *, 1> shapes_1 = {{shapes[0]}};
+            const std::array<const Number *, 1> in_1     = {{in[0]}};
+            if (add_into_values_array)
+              integrate_dense_matrices<1, true>(
+                shapes_1, n_dofs, n_q_points, in_1, out);
+            else
+              integrate_dense_matrices<1, false>(
+                shapes_1, n_dofs, n_q_points, in_1, out);
+          }
+        else
+          {
+            AssertDimension(n_matrices, dim);
+            std::array<const Number *, dim> shapes_dim;
+            std::array<const Number *, dim> in_dim;
             for (unsigned int d = 0; d < dim; ++d)
               {
-                Eval eval(nullptr,
-                          shape_gradients + n_q_points * n_dofs * d,
-                          nullptr,
-                          n_dofs,
-                          n_q_points);
-
-                if ((add_into_values_array == false &&
-                     !(integration_flag & EvaluationFlags::values)) &&
-                    d == 0)
-                  eval.template gradients<0, false, false>(
-                    gradients_quad_ptr, values_dofs_actual_ptr);
-                else
-                  eval.template gradients<0, false, true>(
-                    gradients_quad_ptr, values_dofs_actual_ptr);
-
-                gradients_quad_ptr += n_q_points;
+                shapes_dim[d] = shapes[d];
+                in_dim[d]     = in[d];
               }
-            values_dofs_actual_ptr += n_dofs;
+            if (add_into_values_array)
+              integrate_dense_matrices<dim, true>(
+                shapes_dim, n_dofs, n_q_points, in_dim, out);
+            else
+              integrate_dense_matrices<dim, false>(
+                shapes_dim, n_dofs, n_q_points, in_dim, out);
           }
       }
   }
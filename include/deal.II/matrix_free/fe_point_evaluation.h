@@ -803,6 +803,12 @@ public:
    * @param[in] unit_points List of points in the reference locations of the
    * current cell where the FiniteElement object should be
    * evaluated/integrated in the evaluate() and integrate() functions.
+   *
+   * This function is meant to be called for many cells in a row, e.g., for
+   * particles or remote points. On the fast path for tensor-product
+   * elements, the internal data fields keep their memory between calls and
+   * the mapping is only evaluated once per cell if it is affine, see
+   * NonMatching::MappingInfo.
    */
   void
   reinit(const typename Triangulation<dim, spacedim>::cell_iterator &cell,
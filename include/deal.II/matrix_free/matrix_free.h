@@ -274,6 +274,7 @@ public:
       , cell_vectorization_category(other.cell_vectorization_category)
       , cell_vectorization_categories_strict(
           other.cell_vectorization_categories_strict)
+      , active_fe_index_cost(other.active_fe_index_cost)
       , allow_ghosted_vectors_in_loops(other.allow_ghosted_vectors_in_loops)
       , communicator_sm(other.communicator_sm)
     {}
@@ -302,6 +303,7 @@ public:
       cell_vectorization_category   = other.cell_vectorization_category;
       cell_vectorization_categories_strict =
         other.cell_vectorization_categories_strict;
+      active_fe_index_cost           = other.active_fe_index_cost;
       allow_ghosted_vectors_in_loops = other.allow_ghosted_vectors_in_loops;
       communicator_sm                = other.communicator_sm;
 
@@ -336,6 +338,13 @@ public:
      * might degrade parallel performance (bad cache behavior, many
      * synchronization points).
      *
+     * With all three options, the partitions, colors, and chunks are turned
+     * into a graph of tasks with the dependencies between them, including
+     * the completion of the ghost exchange that only the cells next to other
+     * processors wait for. During a loop, each task is started as soon as
+     * the tasks it depends on have finished, rather than in a fixed order of
+     * levels, which lets idle threads pick up any work that is ready.
+     *
      * @note Threading support is currently experimental for the case inner
      * face integrals are performed and it is recommended to use MPI
      * parallelism if possible. While the scheme has been verified to work
@@ -535,6 +544,26 @@ public:
      */
     bool cell_vectorization_categories_strict;
 
+    /**
+     * The relative cost of working on a batch of cells with the given active
+     * FE index in the hp-case. The costs are used to balance the work between
+     * the tasks of the thread-parallel cell loops, see
+     * MatrixFree::get_cell_batch_cost(), and can be used to balance the cells
+     * between MPI processes with MatrixFreeTools::make_cell_weights(). If
+     * empty, which is the default, the costs are estimated from the number of
+     * arithmetic operations of the cell integrals with sum factorization, see
+     * internal::MatrixFreeFunctions::ShapeInfo::estimate_cell_cost(). Users
+     * that have measured the time spent on the cells of the various elements
+     * with their actual operator can pass these times here instead.
+     *
+     * @note The balancing of tasks only merges the independent blocks of
+     * cells of the @p color and @p partition_color schemes of
+     * @p tasks_parallel_scheme into tasks of similar cost, which is why these
+     * schemes should be preferred over the default @p partition_partition
+     * scheme in the hp-case.
+     */
+    std::vector<double> active_fe_index_cost;
+
     /**
      * Assert that vectors passed to the MatrixFree loops are not ghosted.
      * This variable is primarily intended to reveal bugs or performance
@@ -1619,6 +1648,15 @@ public:
   get_cell_active_fe_index(
     const std::pair<unsigned int, unsigned int> range) const;
 
+  /**
+   * Return the relative cost of working on a batch of cells with the given
+   * active FE index, as given by AdditionalData::active_fe_index_cost or
+   * estimated from the number of arithmetic operations of the cell
+   * integrals.
+   */
+  double
+  get_cell_batch_cost(const unsigned int active_fe_index = 0) const;
+
   /**
    * In the hp-adaptive case, return the active FE index of a face range.
    */
@@ -2244,6 +2282,15 @@ private:
     const std::vector<const DoFHandler<dim, dim> *> &dof_handlers,
     const AdditionalData &                           additional_data);
 
+  /**
+   * Sets the cost of the cell batches of the different active FE indices,
+   * either from AdditionalData::active_fe_index_cost or estimated from the
+   * shape info, and passes the cost of each cell batch on to the task
+   * graph of the thread-parallel loops in the hp-case.
+   */
+  void
+  initialize_cell_batch_costs(const AdditionalData &additional_data);
+
   /**
    * Pointers to the DoFHandlers underlying the current problem.
    */
@@ -2290,6 +2337,12 @@ private:
   Table<4, internal::MatrixFreeFunctions::ShapeInfo<VectorizedArrayType>>
     shape_info;
 
+  /**
+   * The relative cost of a cell batch for each active FE index, see
+   * get_cell_batch_cost().
+   */
+  std::vector<double> cell_batch_cost_per_fe_index;
+
   /**
    * Describes how the cells are gone through. With the cell level (first
    * index in this field) and the index within the level, one can reconstruct
@@ -2705,6 +2758,17 @@ MatrixFree<dim, Number, VectorizedArrayType>::get_cell_active_fe_index(
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+double
+MatrixFree<dim, Number, VectorizedArrayType>::get_cell_batch_cost(
+  const unsigned int active_fe_index) const
+{
+  AssertIndexRange(active_fe_index, cell_batch_cost_per_fe_index.size());
+  return cell_batch_cost_per_fe_index[active_fe_index];
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 unsigned int
 MatrixFree<dim, Number, VectorizedArrayType>::get_face_active_fe_index(
@@ -54,22 +54,6 @@
 
 #include <fstream>
 
-//
-// TBB with oneAPI API has deprecated and removed the
-// <code>tbb::tasks</code> backend. With this it is no longer possible to
-// compile the following code that builds a directed acyclic graph (DAG) of
-// (thread parallel) tasks without a major porting effort. It turned out
-// that such a dynamic handling of dependencies and structures is not as
-// competitive as initially assumed. Consequently, this part of the matrix
-// free infrastructure has seen less attention than the rest over the last
-// years and is (presumably) not used that often.
-//
-// In case of detected oneAPI backend we simply disable threading in the
-// matrix free backend for now.
-//
-// Matthias Maier, Martin Kronbichler, 2021
-//
-
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -342,19 +326,20 @@ MatrixFree<dim, Number, VectorizedArrayType>::copy_from(
   const MatrixFree<dim, Number, VectorizedArrayType> &v)
 {
   clear();
-  dof_handlers               = v.dof_handlers;
-  dof_info                   = v.dof_info;
-  constraint_pool_data       = v.constraint_pool_data;
-  constraint_pool_row_index  = v.constraint_pool_row_index;
-  mapping_info               = v.mapping_info;
-  shape_info                 = v.shape_info;
-  cell_level_index           = v.cell_level_index;
-  cell_level_index_end_local = v.cell_level_index_end_local;
-  task_info                  = v.task_info;
-  face_info                  = v.face_info;
-  indices_are_initialized    = v.indices_are_initialized;
-  mapping_is_initialized     = v.mapping_is_initialized;
-  mg_level                   = v.mg_level;
+  dof_handlers                 = v.dof_handlers;
+  dof_info                     = v.dof_info;
+  constraint_pool_data         = v.constraint_pool_data;
+  constraint_pool_row_index    = v.constraint_pool_row_index;
+  mapping_info                 = v.mapping_info;
+  shape_info                   = v.shape_info;
+  cell_batch_cost_per_fe_index = v.cell_batch_cost_per_fe_index;
+  cell_level_index             = v.cell_level_index;
+  cell_level_index_end_local   = v.cell_level_index_end_local;
+  task_info                    = v.task_info;
+  face_info                    = v.face_info;
+  indices_are_initialized      = v.indices_are_initialized;
+  mapping_is_initialized       = v.mapping_is_initialized;
+  mg_level                     = v.mg_level;
 }
 
 
@@ -483,7 +468,7 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
 
         // initialize the basic multithreading information that needs to be
         // passed to the DoFInfo structure
-#if defined(DEAL_II_WITH_TBB) && !defined(DEAL_II_TBB_WITH_ONEAPI)
+#ifdef DEAL_II_WITH_TBB
       if (additional_data.tasks_parallel_scheme != AdditionalData::none &&
           MultithreadInfo::n_threads() > 1)
         {
@@ -557,6 +542,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
     }
 
 
+  initialize_cell_batch_costs(additional_data);
+
   // subdivide cell, face and boundary face partitioner data, s.t., all
   // ranges have the same active FE indices
   if (task_info.scheme != internal::MatrixFreeFunctions::TaskInfo::
@@ -948,6 +935,64 @@ namespace internal
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+void
+MatrixFree<dim, Number, VectorizedArrayType>::initialize_cell_batch_costs(
+  const AdditionalData &additional_data)
+{
+  const unsigned int n_fe_indices = n_active_fe_indices();
+  if (additional_data.active_fe_index_cost.empty() == false)
+    {
+      AssertDimension(additional_data.active_fe_index_cost.size(),
+                      n_fe_indices);
+      cell_batch_cost_per_fe_index = additional_data.active_fe_index_cost;
+    }
+  else
+    {
+      // sum up the cost of all components with the first quadrature formula,
+      // using the quadrature formula with the same index as the element in
+      // case a hp::QCollection is given
+      cell_batch_cost_per_fe_index.assign(n_fe_indices, 0.);
+      for (unsigned int fe_no = 0; fe_no < n_fe_indices; ++fe_no)
+        {
+          const unsigned int q_no = fe_no < shape_info.size(3) ? fe_no : 0;
+          for (unsigned int c = 0; c < shape_info.size(0); ++c)
+            if (shape_info.size(1) > 0 &&
+                shape_info(c, 0, fe_no, q_no).data.empty() == false)
+              cell_batch_cost_per_fe_index[fe_no] +=
+                shape_info(c, 0, fe_no, q_no).estimate_cell_cost();
+        }
+    }
+  for (const double cost : cell_batch_cost_per_fe_index)
+    {
+      (void)cost;
+      Assert(cost > 0,
+             ExcMessage("The cost of the cell batches must be positive."));
+    }
+
+  // only the thread-parallel loops with coloring in the hp-case need the
+  // cost of the individual cell batches; there, blocks of cheap cells get
+  // merged into larger tasks
+  task_info.cell_batch_cost.clear();
+  if (additional_data.initialize_indices == false ||
+      (task_info.scheme != internal::MatrixFreeFunctions::TaskInfo::color &&
+       task_info.scheme !=
+         internal::MatrixFreeFunctions::TaskInfo::partition_color) ||
+      n_fe_indices < 2 || dof_info.empty() ||
+      dof_info[0].cell_active_fe_index.empty())
+    return;
+
+  const unsigned int n_batches = n_cell_batches();
+  AssertIndexRange(n_batches, dof_info[0].cell_active_fe_index.size() + 1);
+  task_info.cell_batch_cost.resize(n_batches);
+  for (unsigned int cell = 0; cell < n_batches; ++cell)
+    task_info.cell_batch_cost[cell] =
+      cell_batch_cost_per_fe_index[dof_info[0].cell_active_fe_index[cell]];
+  task_info.create_flow_graph();
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 void
 MatrixFree<dim, Number, VectorizedArrayType>::initialize_dof_handlers(
@@ -1001,7 +1046,7 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_dof_handlers(
 
 namespace internal
 {
-#if defined(DEAL_II_WITH_TBB) && !defined(DEAL_II_TBB_WITH_ONEAPI)
+#ifdef DEAL_II_WITH_TBB
 
 #  ifdef DEAL_II_TBB_WITH_ONEAPI
   struct unsigned_int_pair_hash
@@ -1583,7 +1628,12 @@ namespace internal
         task_info.initial_setup_blocks_tasks(subdomain_boundary_cells,
                                              renumbering,
                                              irregular_cells);
-        task_info.guess_block_size(dof_info[0].dofs_per_cell[0]);
+        // in the hp-case, choose the block size for the largest element to
+        // not create too large tasks, cheaper cells are merged into larger
+        // tasks in initialize_cell_batch_costs()
+        task_info.guess_block_size(
+          *std::max_element(dof_info[0].dofs_per_cell.begin(),
+                            dof_info[0].dofs_per_cell.end()));
 
         unsigned int n_cell_batches_before =
           *(task_info.cell_partition_data.end() - 2);
@@ -1696,7 +1746,7 @@ namespace internal
         connectivity.reinit(task_info.n_active_cells, task_info.n_active_cells);
         if (do_face_integrals)
           {
-#if defined(DEAL_II_WITH_TBB) && !defined(DEAL_II_TBB_WITH_ONEAPI)
+#ifdef DEAL_II_WITH_TBB
             // step 1: build map between the index in the matrix-free context
             // and the one in the triangulation
             tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,
@@ -2311,6 +2361,7 @@ MatrixFree<dim, Number, VectorizedArrayType>::clear()
   task_info.clear();
   dof_handlers.clear();
   face_info.clear();
+  cell_batch_cost_per_fe_index.clear();
   indices_are_initialized = false;
   mapping_is_initialized  = false;
 }
@@ -2325,6 +2376,7 @@ MatrixFree<dim, Number, VectorizedArrayType>::memory_consumption() const
   memory += MemoryConsumption::memory_consumption(cell_level_index);
   memory += MemoryConsumption::memory_consumption(face_info);
   memory += MemoryConsumption::memory_consumption(shape_info);
+  memory += MemoryConsumption::memory_consumption(cell_batch_cost_per_fe_index);
   memory += MemoryConsumption::memory_consumption(constraint_pool_data);
   memory += MemoryConsumption::memory_consumption(constraint_pool_row_index);
   memory += MemoryConsumption::memory_consumption(task_info);
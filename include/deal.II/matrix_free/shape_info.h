@@ -425,6 +425,20 @@ namespace internal
       std::size_t
       memory_consumption() const;
 
+      /**
+       * Return an estimate of the cost of evaluating and integrating the
+       * values and gradients of all components on a cell with this element
+       * and quadrature formula. The estimate counts the arithmetic
+       * operations of the sum-factorization kernels for tensor product
+       * elements and of the dense kernels for other elements, plus the
+       * number of values that are read from and written to memory. It is
+       * meant for comparing the cost of different elements and quadrature
+       * formulas, e.g. the active FE indices of an hp-computation, rather
+       * than for predicting absolute run times.
+       */
+      double
+      estimate_cell_cost() const;
+
       /**
        * Renumbering from deal.II's numbering of cell degrees of freedom to
        * lexicographic numbering used inside the FEEvaluation schemes of the
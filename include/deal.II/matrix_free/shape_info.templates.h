@@ -1329,6 +1329,53 @@ namespace internal
       return memory;
     }
 
+    template <typename Number>
+    double
+    ShapeInfo<Number>::estimate_cell_cost() const
+    {
+      // nothing to do for objects that have not been initialized
+      if (data.empty())
+        return 0.;
+
+      const unsigned int dim = n_dimensions;
+
+      // operations per component, counting multiplications and additions
+      // separately and including both the evaluation and the integration
+      double operations = 0;
+      if (element_type == tensor_none)
+        {
+          // dense products with the values and the dim gradients of the shape
+          // functions
+          operations = 2. * 2. * (dim + 1) * dofs_per_component_on_cell *
+                       n_q_points;
+        }
+      else
+        {
+          // sum factorization for the interpolation between the degrees of
+          // freedom and the quadrature points in dim sweeps, which is skipped
+          // for collocation, plus one sweep per direction for the gradients
+          // in the collocation space of the quadrature points
+          const double n_dofs_1d = data.front().fe_degree + 1;
+          const double n_q_1d    = data.front().n_q_points_1d;
+          if (element_type != tensor_symmetric_collocation)
+            for (unsigned int d = 0; d < dim; ++d)
+              operations +=
+                std::pow(n_q_1d, d + 1) * std::pow(n_dofs_1d, dim - d);
+          operations += dim * std::pow(n_q_1d, dim + 1);
+          operations *= 2. * 2.;
+        }
+
+      // values read and written: the degrees of freedom of all components and
+      // the inverse Jacobian and JxW values at the quadrature points
+      const double memory_transfer =
+        2. * n_components * dofs_per_component_on_cell +
+        (dim * dim + 1) * n_q_points;
+
+      return n_components * operations + memory_transfer;
+    }
+
+
+
     template <typename Number>
     std::size_t
     UnivariateShapeData<Number>::memory_consumption() const
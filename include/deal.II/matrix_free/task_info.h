@@ -1,6 +1,6 @@
 // ---------------------------------------------------------------------
 //
-// Copyright (C) 2011 - 2021 by the deal.II authors
+// Copyright (C) 2011 - 2023 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -26,6 +26,8 @@
 #include <deal.II/base/tensor.h>
 #include <deal.II/base/vectorization.h>
 
+#include <vector>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -99,6 +101,130 @@ namespace internal
 
   namespace MatrixFreeFunctions
   {
+    /**
+     * A directed acyclic graph describing the work of a thread-parallel
+     * matrix-free loop. Each node represents a piece of work, like the cells
+     * and faces of one block or the completion of the ghost exchange, and the
+     * edges encode which work must have finished before a node may start.
+     * When running the loop, a node is handed to the task scheduler as soon
+     * as all its predecessors have finished, so idle threads can pick up
+     * (steal) any work that is ready rather than waiting at the end of a
+     * fixed partition level, and the ghost exchange only delays the cells
+     * that actually need the ghost data.
+     */
+    struct TaskGraph
+    {
+      /**
+       * The kind of work associated with a node.
+       */
+      enum class NodeType : unsigned char
+      {
+        /**
+         * No work, the node only joins the dependencies of several other
+         * nodes.
+         */
+        join,
+        /**
+         * Call MFWorkerInterface::vector_update_ghosts_finish().
+         */
+        update_ghosts_finish,
+        /**
+         * Call MFWorkerInterface::vector_compress_start().
+         */
+        compress_start,
+        /**
+         * Run the cell, face and boundary work of the range index stored in
+         * Node::first.
+         */
+        range_index,
+        /**
+         * Run the cell work on the range of cell batches from Node::first to
+         * Node::second.
+         */
+        cell_range
+      };
+
+      /**
+       * Description of a node.
+       */
+      struct Node
+      {
+        NodeType     type;
+        unsigned int first;
+        unsigned int second;
+      };
+
+      /**
+       * Clear all nodes and edges.
+       */
+      void
+      clear();
+
+      /**
+       * Add a node to the graph and return its index.
+       */
+      unsigned int
+      add_node(const NodeType     type,
+               const unsigned int first  = 0,
+               const unsigned int second = 0);
+
+      /**
+       * Record that node @p to must not start before node @p from has
+       * finished. All edges must be added before calling finalize().
+       */
+      void
+      add_edge(const unsigned int from, const unsigned int to);
+
+      /**
+       * Convert the edges added so far into the compressed format used when
+       * running the graph.
+       */
+      void
+      finalize();
+
+      /**
+       * Return whether the graph has no nodes.
+       */
+      bool
+      empty() const;
+
+      /**
+       * Return the memory consumption of the class.
+       */
+      std::size_t
+      memory_consumption() const;
+
+      /**
+       * The nodes of the graph.
+       */
+      std::vector<Node> nodes;
+
+      /**
+       * The number of predecessors of each node.
+       */
+      std::vector<unsigned int> n_predecessors;
+
+      /**
+       * The successors of node @p i are stored in the range from
+       * <code>successors[successor_start[i]]</code> to
+       * <code>successors[successor_start[i+1]]</code>.
+       */
+      std::vector<unsigned int> successor_start;
+
+      /**
+       * Linear storage of the successors of all nodes, see @p
+       * successor_start.
+       */
+      std::vector<unsigned int> successors;
+
+      /**
+       * Temporary storage of the edges between add_edge() and finalize().
+       */
+      std::vector<std::pair<unsigned int, unsigned int>> edges;
+    };
+
+
+
     /**
      * A struct that collects all information related to parallelization with
      * threads: The work is subdivided into tasks that can be done
@@ -407,7 +533,10 @@ namespace internal
       update_task_info(const unsigned int partition);
 
       /**
-       * Creates a task graph from a connectivity structure.
+       * Creates the graph of tasks run by loop() from the partitions set up
+       * in make_thread_graph(). Does nothing for the serial scheme. For the
+       * coloring schemes, the blocks of a color are merged into tasks of
+       * similar cost if @p cell_batch_cost is set.
        */
       void
       create_flow_graph();
@@ -599,6 +728,20 @@ namespace internal
        */
       unsigned int n_workers;
 
+      /**
+       * The graph of tasks that is run by loop() if threads are used, see
+       * create_flow_graph().
+       */
+      TaskGraph task_graph;
+
+      /**
+       * The estimated relative cost of each cell batch, used by
+       * create_flow_graph() to balance the work between the tasks in case
+       * the cell batches have different costs, e.g. for different active FE
+       * indices. Empty if all cell batches are assumed to take the same time.
+       */
+      std::vector<double> cell_batch_cost;
+
       /**
        * Stores whether a particular task is at an MPI boundary and needs data
        * exchange
@@ -18,6 +18,8 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/distributed/cell_weights.h>
+
 #include <deal.II/grid/tria.h>
 
 #include <deal.II/matrix_free/fe_evaluation.h>
@@ -43,6 +45,29 @@ namespace MatrixFreeTools
   categorize_by_boundary_ids(const Triangulation<dim> &tria,
                              AdditionalData &          additional_data);
 
+  /**
+   * Return a weighting function for parallel::CellWeights that assigns each
+   * cell a weight proportional to the cost of the cell batches of its
+   * (future) active FE index in @p matrix_free, see
+   * MatrixFree::get_cell_batch_cost(). The cheapest element gets the weight
+   * @p base_weight, and the weights of the other elements are scaled
+   * accordingly and rounded to the nearest integer. This allows to balance
+   * the work of the matrix-free operator evaluation between the MPI
+   * processes in the hp-case, where the cost per cell varies considerably
+   * with the polynomial degree.
+   *
+   * The active FE index of a cell is identified via the position of the
+   * element passed to the weighting function in the hp::FECollection of the
+   * DoFHandler of the cell, which must hence match the first DoFHandler of
+   * @p matrix_free. The costs are copied into the returned function, so
+   * @p matrix_free may be cleared or reinitialized afterwards.
+   */
+  template <int dim, typename Number, typename VectorizedArrayType>
+  typename parallel::CellWeights<dim>::WeightingFunction
+  make_cell_weights(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const unsigned int                                  base_weight = 100);
+
   /**
    * Compute the diagonal of a linear operator (@p diagonal_global), given
    * @p matrix_free and the local cell integral operation @p local_vmult. The
@@ -417,6 +442,46 @@ namespace MatrixFreeTools
       additional_data.mapping_update_flags_boundary_faces;
   }
 
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  typename parallel::CellWeights<dim>::WeightingFunction
+  make_cell_weights(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const unsigned int                                  base_weight)
+  {
+    std::vector<double> costs(matrix_free.n_active_fe_indices());
+    for (unsigned int i = 0; i < costs.size(); ++i)
+      costs[i] = matrix_free.get_cell_batch_cost(i);
+    const double min_cost = *std::min_element(costs.begin(), costs.end());
+    Assert(min_cost > 0, ExcInternalError());
+
+    std::vector<unsigned int> weights(costs.size());
+    for (unsigned int i = 0; i < costs.size(); ++i)
+      weights[i] = static_cast<unsigned int>(
+        std::round(base_weight * costs[i] / min_cost));
+
+    return [weights](const typename DoFHandler<dim>::cell_iterator &cell,
+                     const FiniteElement<dim> &future_fe) -> unsigned int {
+      if (weights.size() == 1)
+        return weights[0];
+
+      const auto &fe_collection = cell->get_dof_handler().get_fe_collection();
+      for (unsigned int i = 0; i < fe_collection.size(); ++i)
+        if (&fe_collection[i] == &future_fe)
+          {
+            AssertIndexRange(i, weights.size());
+            return weights[i];
+          }
+
+      Assert(false,
+             ExcMessage("The finite element passed to the weighting function "
+                        "is not part of the hp::FECollection of the "
+                        "DoFHandler of the cell."));
+      return weights[0];
+    };
+  }
+
   namespace internal
   {
     template <typename Number>
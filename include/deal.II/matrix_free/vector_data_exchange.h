@@ -24,6 +24,7 @@
 #include <deal.II/base/mpi_stub.h>
 #include <deal.II/base/partitioner.h>
 
+#include <deal.II/lac/la_parallel_vector_shared_memory_exchange.h>
 #include <deal.II/lac/vector_operation.h>
 
 #include <memory>
@@ -257,9 +258,13 @@ namespace internal
       /**
        * Similar to the above but using the internal data structures in the
        * partitioner in order to identify indices of degrees of freedom that are
-       * in the same shared memory region.
+       * in the same shared memory region. This class also provides the
+       * shared-memory exchange of LinearAlgebra::distributed::Vector, see
+       * LinearAlgebra::distributed::internal::get_shared_memory_exchange().
        */
-      class Full : public Base
+      class Full : public Base,
+                   public ::dealii::LinearAlgebra::distributed::internal::
+                     SharedMemoryExchangeBase
       {
       public:
         Full(
@@ -282,7 +287,18 @@ namespace internal
         size() const override;
 
         MPI_Comm
-        get_sm_mpi_communicator() const;
+        get_sm_mpi_communicator() const override;
+
+        /**
+         * Exchange an empty message with each process of the shared-memory
+         * domain whose memory this process reads or writes during the
+         * exchange, and with each process that accesses the memory of this
+         * process. When this function returns, all these neighbors have
+         * finished their part of the preceding exchange, so the locally
+         * owned and ghost values may be modified again.
+         */
+        void
+        synchronize_sm_neighbors() const override;
 
         void
         export_to_ghosted_array_start(
@@ -0,0 +1,595 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_non_matching_cut_cell_loop_h
+#define dealii_non_matching_cut_cell_loop_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/graph_coloring.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/std_cxx20/type_traits.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector_operation.h>
+#include <deal.II/lac/vector_type_traits.h>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace NonMatching
+{
+  /**
+   * A class that runs loops over a fixed set of cells, typically the cells
+   * intersected by an immersed interface, in order to apply operators whose
+   * integrals are evaluated with FEPointEvaluation at the points stored in
+   * one or several NonMatching::MappingInfo objects. It fills the role of
+   * MatrixFree::cell_loop() for the cut cells of a CutFEM discretization:
+   * The bulk cells can be treated with MatrixFree and FEEvaluation as usual,
+   * whereas the cut cells, which need to integrate over the quadratures
+   * generated on each cell separately, are treated by this class.
+   *
+   * In reinit(), the degree of freedom indices of all cells are stored
+   * contiguously, and the cells are partitioned into colors with
+   * GraphColoring::make_graph_coloring() such that no two cells of the same
+   * color share a degree of freedom, also taking into account the degrees of
+   * freedom a constrained degree of freedom is distributed to. loop() then
+   * processes one color after the other, and the cells of each color in
+   * parallel on the available threads, so that the local results can be
+   * written into the destination vector without any locking. Within a cell,
+   * the evaluation is vectorized over the points by FEPointEvaluation.
+   *
+   * The precomputation of the geometry is done by NonMatching::MappingInfo
+   * for the same cells and in the same order, e.g. with
+   * @code
+   * const auto cut_cells =
+   *   dof_handler.active_cell_iterators() |
+   *   [&](const typename DoFHandler<dim>::active_cell_iterator &cell) {
+   *     return mesh_classifier.location_to_level_set(cell) ==
+   *            NonMatching::LocationToLevelSet::intersected;
+   *   };
+   *
+   * std::vector<Quadrature<dim>>                             quadratures;
+   * std::vector<NonMatching::ImmersedSurfaceQuadrature<dim>> surfaces;
+   * for (const auto &cell : cut_cells)
+   *   {
+   *     quadrature_generator.generate(cell);
+   *     quadratures.push_back(quadrature_generator.get_inside_quadrature());
+   *     surfaces.push_back(quadrature_generator.get_surface_quadrature());
+   *   }
+   *
+   * mapping_info_cell.reinit_cells(cut_cells, quadratures);
+   * mapping_info_surface.reinit_surface(cut_cells, surfaces);
+   * cut_cell_loop.reinit(dof_handler, constraints, cut_cells);
+   * @endcode
+   * Then, the index of a cell in this class is also the index of the cell in
+   * the MappingInfo objects, which is passed to FEPointEvaluation::reinit().
+   * If the MappingInfo objects use the compressed storage indexed by the
+   * active cell index, the index is obtained from
+   * `get_cell_iterator(cell_index)->active_cell_index()` instead.
+   *
+   * A worker function, e.g. for the bulk and Nitsche terms of a Poisson
+   * problem on the cut cells, looks like this:
+   * @code
+   * cut_cell_loop.loop(
+   *   [&](const NonMatching::CutCellLoop<dim> &data,
+   *       VectorType &                         dst,
+   *       const VectorType &                   src,
+   *       const ArrayView<const unsigned int> &cell_indices) {
+   *     FEPointEvaluation<1, dim> phi_cell(mapping_info_cell, fe);
+   *     FEPointEvaluation<1, dim> phi_surface(mapping_info_surface, fe);
+   *     std::vector<double> src_values(fe.n_dofs_per_cell());
+   *     std::vector<double> dst_values(fe.n_dofs_per_cell());
+   *     std::vector<double> surface_values(fe.n_dofs_per_cell());
+   *
+   *     for (const unsigned int cell_index : cell_indices)
+   *       {
+   *         data.read_dof_values(cell_index, src, make_array_view(src_values));
+   *
+   *         phi_cell.reinit(cell_index);
+   *         phi_cell.evaluate(src_values, EvaluationFlags::gradients);
+   *         for (const unsigned int q : phi_cell.quadrature_point_indices())
+   *           phi_cell.submit_gradient(phi_cell.JxW(q) *
+   *                                      phi_cell.get_gradient(q), q);
+   *         phi_cell.integrate(dst_values, EvaluationFlags::gradients);
+   *
+   *         phi_surface.reinit(cell_index);
+   *         // ... evaluate and integrate the Nitsche terms into
+   *         // surface_values and add them to dst_values ...
+   *
+   *         data.distribute_local_to_global(cell_index,
+   *                                         make_array_view(dst_values),
+   *                                         dst);
+   *       }
+   *   },
+   *   dst,
+   *   src,
+   *   true);
+   * @endcode
+   * The FEPointEvaluation objects are created once for each range of cells
+   * handed to the worker, and each thread works on its own objects.
+   *
+   * Face terms, like the ghost penalty between cut cells, can be added in a
+   * cell-centric way: Each cell evaluates the solution on its own and on the
+   * neighboring cell through MappingInfo::reinit_faces() and
+   * FEPointEvaluation::reinit(cell_index, face_number), and only integrates
+   * the test functions of its own side. Reading the values of the neighbor
+   * does not create conflicts between the threads.
+   *
+   * The class supports the vector types that allow concurrent writes to
+   * different entries, i.e., Vector, BlockVector, and
+   * LinearAlgebra::distributed::Vector. For parallel vectors, the source
+   * vector needs to contain all degrees of freedom of the cells as ghost
+   * entries. The ghost values are only touched for parallel vectors, as
+   * determined by is_serial_vector.
+   */
+  template <int dim, typename Number = double>
+  class CutCellLoop : public Subscriptor
+  {
+  public:
+    using CellIterator = typename DoFHandler<dim>::active_cell_iterator;
+
+    /**
+     * Options for the setup of the loop.
+     */
+    struct AdditionalData
+    {
+      /**
+       * Constructor.
+       */
+      AdditionalData(const unsigned int cells_per_task = 16)
+        : cells_per_task(cells_per_task)
+      {}
+
+      /**
+       * The minimal number of cells that are passed to the worker function
+       * in one call. Larger numbers reduce the overhead of the creation of
+       * the evaluators in the worker function, smaller numbers allow for a
+       * better load balance between the threads.
+       */
+      unsigned int cells_per_task;
+    };
+
+    /**
+     * The type of the worker function called in loop() on a range of cells.
+     */
+    template <typename OutVector, typename InVector>
+    using Worker = std::function<void(const CutCellLoop<dim, Number> &,
+                                      OutVector &,
+                                      const InVector &,
+                                      const ArrayView<const unsigned int> &)>;
+
+    /**
+     * Default constructor. Call reinit() before using the object.
+     */
+    CutCellLoop() = default;
+
+    /**
+     * Set up the loop for the cells in @p cell_iterator_range, which is an
+     * iterable container of active cell iterators of @p dof_handler, like a
+     * std::vector or an IteratorRange. The cells are numbered in the order in
+     * which they appear in the container.
+     *
+     * Pointers to @p dof_handler and @p constraints are stored internally,
+     * so these need to live longer than this object.
+     */
+    template <typename ContainerType>
+    void
+    reinit(const DoFHandler<dim> &          dof_handler,
+           const AffineConstraints<Number> &constraints,
+           const ContainerType &            cell_iterator_range,
+           const AdditionalData &           additional_data = AdditionalData());
+
+    /**
+     * Run the loop over all cells. The @p worker is called with ranges of
+     * cells of the same color, possibly in parallel. If @p zero_dst_vector
+     * is true, the destination vector is set to zero before the loop.
+     * After the loop, the contributions to ghost entries of @p dst are sent
+     * to the owning processes by `dst.compress(VectorOperation::add)`.
+     */
+    template <typename OutVector, typename InVector>
+    void
+    loop(const std_cxx20::type_identity_t<Worker<OutVector, InVector>> &worker,
+         OutVector &                                                   dst,
+         const InVector &                                              src,
+         const bool zero_dst_vector = false) const;
+
+    /**
+     * Return the number of cells of the loop.
+     */
+    unsigned int
+    n_cells() const;
+
+    /**
+     * Return the number of colors the cells are partitioned into.
+     */
+    unsigned int
+    n_colors() const;
+
+    /**
+     * Return the indices of the cells of the given color.
+     */
+    const std::vector<unsigned int> &
+    get_cells_of_color(const unsigned int color) const;
+
+    /**
+     * Return the iterator of the cell with the given index.
+     */
+    const CellIterator &
+    get_cell_iterator(const unsigned int cell_index) const;
+
+    /**
+     * Return the degree of freedom indices of the cell with the given index.
+     */
+    ArrayView<const types::global_dof_index>
+    get_dof_indices(const unsigned int cell_index) const;
+
+    /**
+     * Read the values of the degrees of freedom of the given cell from
+     * @p src into @p local_values, resolving constrained degrees of freedom
+     * with AffineConstraints::get_dof_values().
+     */
+    template <typename VectorType>
+    void
+    read_dof_values(const unsigned int      cell_index,
+                    const VectorType &      src,
+                    const ArrayView<Number> local_values) const;
+
+    /**
+     * Add the values in @p local_values to the degrees of freedom of the
+     * given cell in @p dst, with AffineConstraints::
+     * distribute_local_to_global().
+     */
+    template <typename VectorType>
+    void
+    distribute_local_to_global(const unsigned int            cell_index,
+                               const ArrayView<const Number> local_values,
+                               VectorType &                  dst) const;
+
+    /**
+     * Return an estimate for the memory consumption, in bytes, of this
+     * object.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * Pointer to the constraints passed to reinit().
+     */
+    SmartPointer<const AffineConstraints<Number>> constraints;
+
+    /**
+     * The options passed to reinit().
+     */
+    AdditionalData additional_data;
+
+    /**
+     * The cells of the loop.
+     */
+    std::vector<CellIterator> cells;
+
+    /**
+     * The degree of freedom indices of all cells, in compressed row storage.
+     */
+    std::vector<unsigned int>            dof_indices_start;
+    std::vector<types::global_dof_index> dof_indices;
+
+    /**
+     * The indices of the cells of each color, sorted in ascending order.
+     */
+    std::vector<std::vector<unsigned int>> colors;
+  };
+
+
+
+  /* ---------------------- template functions ------------------ */
+
+
+
+  namespace internal
+  {
+    namespace CutCellLoopImplementation
+    {
+      /**
+       * Update the ghost values of @p vector unless they are already up to
+       * date, and return whether they have been updated. Serial vectors
+       * have no ghost values, so nothing is done for them.
+       */
+      template <typename VectorType,
+                std::enable_if_t<is_serial_vector<VectorType>::value, int> = 0>
+      inline bool
+      update_ghost_values(const VectorType &)
+      {
+        return false;
+      }
+
+
+
+      template <typename VectorType,
+                std::enable_if_t<!is_serial_vector<VectorType>::value, int> =
+                  0>
+      inline bool
+      update_ghost_values(const VectorType &vector)
+      {
+        if (vector.has_ghost_elements())
+          return false;
+
+        vector.update_ghost_values();
+        return true;
+      }
+
+
+
+      /**
+       * Zero out the ghost values of @p vector. Serial vectors have no ghost
+       * values, so nothing is done for them.
+       */
+      template <typename VectorType,
+                std::enable_if_t<is_serial_vector<VectorType>::value, int> = 0>
+      inline void
+      zero_out_ghost_values(const VectorType &)
+      {}
+
+
+
+      template <typename VectorType,
+                std::enable_if_t<!is_serial_vector<VectorType>::value, int> =
+                  0>
+      inline void
+      zero_out_ghost_values(const VectorType &vector)
+      {
+        vector.zero_out_ghost_values();
+      }
+    } // namespace CutCellLoopImplementation
+  }   // namespace internal
+
+
+
+  template <int dim, typename Number>
+  template <typename ContainerType>
+  void
+  CutCellLoop<dim, Number>::reinit(
+    const DoFHandler<dim> &          dof_handler,
+    const AffineConstraints<Number> &constraints,
+    const ContainerType &            cell_iterator_range,
+    const AdditionalData &           additional_data)
+  {
+    this->constraints     = &constraints;
+    this->additional_data = additional_data;
+
+    cells.clear();
+    dof_indices_start.assign(1, 0);
+    dof_indices.clear();
+    std::vector<types::global_dof_index> local_dof_indices;
+    for (const auto &cell : cell_iterator_range)
+      {
+        Assert(&cell->get_triangulation() == &dof_handler.get_triangulation(),
+               ExcMessage("The cells must belong to the triangulation of the "
+                          "DoFHandler passed to this function."));
+
+        const CellIterator dof_cell(&dof_handler.get_triangulation(),
+                                    cell->level(),
+                                    cell->index(),
+                                    &dof_handler);
+        local_dof_indices.resize(dof_cell->get_fe().n_dofs_per_cell());
+        dof_cell->get_dof_indices(local_dof_indices);
+
+        cells.push_back(dof_cell);
+        dof_indices.insert(dof_indices.end(),
+                           local_dof_indices.begin(),
+                           local_dof_indices.end());
+        dof_indices_start.push_back(dof_indices.size());
+      }
+
+    colors.clear();
+    if (cells.empty())
+      return;
+
+    // Two cells conflict if they write into the same entry of the
+    // destination vector, which includes the entries that constrained
+    // degrees of freedom are distributed to
+    const auto get_conflict_indices =
+      [&](const std::vector<unsigned int>::const_iterator &cell_index) {
+        std::vector<types::global_dof_index> conflict_indices;
+        for (const types::global_dof_index index :
+             get_dof_indices(*cell_index))
+          {
+            conflict_indices.push_back(index);
+            if (const auto *entries =
+                  constraints.get_constraint_entries(index))
+              for (const auto &entry : *entries)
+                conflict_indices.push_back(entry.first);
+          }
+        std::sort(conflict_indices.begin(), conflict_indices.end());
+        conflict_indices.erase(std::unique(conflict_indices.begin(),
+                                           conflict_indices.end()),
+                               conflict_indices.end());
+        return conflict_indices;
+      };
+
+    std::vector<unsigned int> cell_indices(cells.size());
+    std::iota(cell_indices.begin(), cell_indices.end(), 0U);
+    const auto coloring =
+      GraphColoring::make_graph_coloring(cell_indices.cbegin(),
+                                         cell_indices.cend(),
+                                         get_conflict_indices);
+
+    colors.resize(coloring.size());
+    for (unsigned int c = 0; c < coloring.size(); ++c)
+      {
+        for (const auto &cell_index : coloring[c])
+          colors[c].push_back(*cell_index);
+        std::sort(colors[c].begin(), colors[c].end());
+      }
+  }
+
+
+
+  template <int dim, typename Number>
+  template <typename OutVector, typename InVector>
+  void
+  CutCellLoop<dim, Number>::loop(
+    const std_cxx20::type_identity_t<Worker<OutVector, InVector>> &worker,
+    OutVector &                                                   dst,
+    const InVector &                                              src,
+    const bool zero_dst_vector) const
+  {
+    if (zero_dst_vector)
+      dst = Number();
+
+    const bool src_ghosts_updated =
+      internal::CutCellLoopImplementation::update_ghost_values(src);
+
+    for (const std::vector<unsigned int> &color : colors)
+      parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(color.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          worker(*this,
+                 dst,
+                 src,
+                 ArrayView<const unsigned int>(color.data() + begin,
+                                               end - begin));
+        },
+        additional_data.cells_per_task);
+
+    dst.compress(VectorOperation::add);
+    if (src_ghosts_updated)
+      internal::CutCellLoopImplementation::zero_out_ghost_values(src);
+  }
+
+
+
+  template <int dim, typename Number>
+  inline unsigned int
+  CutCellLoop<dim, Number>::n_cells() const
+  {
+    return cells.size();
+  }
+
+
+
+  template <int dim, typename Number>
+  inline unsigned int
+  CutCellLoop<dim, Number>::n_colors() const
+  {
+    return colors.size();
+  }
+
+
+
+  template <int dim, typename Number>
+  inline const std::vector<unsigned int> &
+  CutCellLoop<dim, Number>::get_cells_of_color(const unsigned int color) const
+  {
+    AssertIndexRange(color, colors.size());
+    return colors[color];
+  }
+
+
+
+  template <int dim, typename Number>
+  inline const typename CutCellLoop<dim, Number>::CellIterator &
+  CutCellLoop<dim, Number>::get_cell_iterator(
+    const unsigned int cell_index) const
+  {
+    AssertIndexRange(cell_index, cells.size());
+    return cells[cell_index];
+  }
+
+
+
+  template <int dim, typename Number>
+  inline ArrayView<const types::global_dof_index>
+  CutCellLoop<dim, Number>::get_dof_indices(
+    const unsigned int cell_index) const
+  {
+    AssertIndexRange(cell_index, cells.size());
+    return ArrayView<const types::global_dof_index>(
+      dof_indices.data() + dof_indices_start[cell_index],
+      dof_indices_start[cell_index + 1] - dof_indices_start[cell_index]);
+  }
+
+
+
+  template <int dim, typename Number>
+  template <typename VectorType>
+  inline void
+  CutCellLoop<dim, Number>::read_dof_values(
+    const unsigned int      cell_index,
+    const VectorType &      src,
+    const ArrayView<Number> local_values) const
+  {
+    const ArrayView<const types::global_dof_index> indices =
+      get_dof_indices(cell_index);
+    AssertDimension(local_values.size(), indices.size());
+
+    constraints->get_dof_values(src,
+                                indices.begin(),
+                                local_values.begin(),
+                                local_values.end());
+  }
+
+
+
+  template <int dim, typename Number>
+  template <typename VectorType>
+  inline void
+  CutCellLoop<dim, Number>::distribute_local_to_global(
+    const unsigned int            cell_index,
+    const ArrayView<const Number> local_values,
+    VectorType &                  dst) const
+  {
+    const ArrayView<const types::global_dof_index> indices =
+      get_dof_indices(cell_index);
+    AssertDimension(local_values.size(), indices.size());
+
+    constraints->distribute_local_to_global(local_values.begin(),
+                                            local_values.end(),
+                                            indices.begin(),
+                                            dst);
+  }
+
+
+
+  template <int dim, typename Number>
+  std::size_t
+  CutCellLoop<dim, Number>::memory_consumption() const
+  {
+    return sizeof(*this) + cells.capacity() * sizeof(CellIterator) +
+           MemoryConsumption::memory_consumption(dof_indices_start) +
+           MemoryConsumption::memory_consumption(dof_indices) +
+           MemoryConsumption::memory_consumption(colors);
+  }
+
+} // namespace NonMatching
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -1,6 +1,6 @@
 // ---------------------------------------------------------------------
 //
-// Copyright (C) 2021 - 2022 by the deal.II authors
+// Copyright (C) 2021 - 2023 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -34,6 +34,7 @@
 
 #include <deal.II/non_matching/fe_immersed_values.h>
 #include <deal.II/non_matching/mesh_classifier.h>
+#include <deal.II/non_matching/quadrature_cache.h>
 #include <deal.II/non_matching/quadrature_generator.h>
 
 #include <deque>
@@ -226,6 +227,17 @@ namespace NonMatching
     reinit(
       const TriaIterator<DoFCellAccessor<dim, dim, level_dof_access>> &cell);
 
+    /**
+     * Use the immersed quadrature rules stored in @p quadrature_cache on the
+     * intersected cells instead of generating them in every call to
+     * reinit(). On cells for which the cache does not contain up-to-date
+     * quadratures, they are generated as without a cache. The cache needs to
+     * be set up for the same level set function as the one passed to the
+     * constructor of this class, and needs to live longer than this object.
+     */
+    void
+    set_quadrature_cache(const QuadratureCache<dim> &quadrature_cache);
+
     /**
      * Return an dealii::FEValues object reinitialized with a quadrature for the
      * inside region of the cell: $\{x \in K : \psi(x) < 0 \}$.
@@ -367,6 +379,12 @@ namespace NonMatching
      * Object that generates the immersed quadrature rules.
      */
     DiscreteQuadratureGenerator<dim> quadrature_generator;
+
+    /**
+     * Pointer to the cache of immersed quadrature rules passed to
+     * set_quadrature_cache(), if any.
+     */
+    SmartPointer<const QuadratureCache<dim>> quadrature_cache;
   };
 
 
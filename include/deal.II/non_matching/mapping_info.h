@@ -31,7 +31,10 @@
 #include <deal.II/fe/mapping_q.h>
 #include <deal.II/fe/mapping_related_data.h>
 
+#include <deal.II/grid/manifold.h>
+
 #include <memory>
+#include <typeinfo>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -56,6 +59,32 @@ namespace NonMatching
         return mapping->requires_update_flags(update_flags);
       }
 
+      static std::unique_ptr<typename Mapping<dim, spacedim>::InternalDataBase>
+      get_data(const SmartPointer<const Mapping<dim, spacedim>> mapping,
+               const UpdateFlags &                              update_flags,
+               const Quadrature<dim> &                          quadrature)
+      {
+        return mapping->get_data(update_flags, quadrature);
+      }
+
+      static void
+      compute_mapping_data_for_quadrature(
+        const SmartPointer<const Mapping<dim, spacedim>> mapping,
+        const UpdateFlags &                              update_flags_mapping,
+        const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+        const Quadrature<dim> &                                     quadrature,
+        const typename Mapping<dim, spacedim>::InternalDataBase
+          &          internal_mapping_data,
+        MappingData &mapping_data)
+      {
+        mapping_data.initialize(quadrature.size(), update_flags_mapping);
+        mapping->fill_fe_values(cell,
+                                CellSimilarity::none,
+                                quadrature,
+                                internal_mapping_data,
+                                mapping_data);
+      }
+
       static void
       compute_mapping_data_for_quadrature(
         const SmartPointer<const Mapping<dim, spacedim>> mapping,
@@ -196,6 +225,17 @@ namespace NonMatching
    * template argument, e.g. VectorizedArray<double>) provides both mapping data
    * and unit points in vectorized format. The Number template parameter of
    * MappingInfo and FEPointEvaluation has to be identical.
+   *
+   * The reinit() functions for a single cell are designed to be called many
+   * times, e.g., for every cell that contains particles or remote points:
+   * All data fields as well as the scratch data passed to the mapping keep
+   * their memory between calls, so no memory is allocated once the number of
+   * points stops growing. If the underlying mapping is a MappingCartesian, or
+   * a MappingQ and the cell is a parallelogram/parallelepiped described by
+   * flat manifolds, the Jacobian is the same at all points. In that case,
+   * the mapping is only evaluated at the center of the cell and the
+   * Jacobian, its inverse, and the real points of all unit points are
+   * computed from that single evaluation.
    */
   template <int dim, int spacedim = dim, typename Number = double>
   class MappingInfo : public Subscriptor
@@ -410,10 +450,10 @@ namespace NonMatching
      * Store the unit points.
      */
     void
-    store_unit_points(const unsigned int             unit_points_index_offset,
-                      const unsigned int             n_q_points,
-                      const unsigned int             n_q_points_unvectorized,
-                      const std::vector<Point<dim>> &points);
+    store_unit_points(const unsigned int unit_points_index_offset,
+                      const unsigned int n_q_points,
+                      const unsigned int n_q_points_unvectorized,
+                      const ArrayView<const Point<dim>> &points);
 
     /**
      * Store the requested mapping data.
@@ -424,6 +464,35 @@ namespace NonMatching
                        const unsigned int n_q_points_unvectorized,
                        const MappingData &mapping_data);
 
+    /**
+     * Return whether the Jacobian of the mapping is constant on the given
+     * cell, see the class documentation.
+     */
+    bool
+    is_affine_cell(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell) const;
+
+    /**
+     * Compute and store the mapping data of a single cell on which the
+     * mapping is affine from one evaluation of the mapping at the center of
+     * the cell. If @p weights is empty, the weights are set to infinity as in
+     * the Quadrature constructor taking only points.
+     */
+    void
+    reinit_affine_cell(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+      const ArrayView<const Point<dim>> &                         unit_points,
+      const ArrayView<const double> &                             weights);
+
+    /**
+     * Compute and store the mapping data of a single cell for the points of
+     * the given quadrature by the mapping.
+     */
+    void
+    reinit_general_cell(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+      const Quadrature<dim> &                                     quadrature);
+
     /**
      * Compute the compressed cell index.
      */
@@ -472,6 +541,45 @@ namespace NonMatching
     std::shared_ptr<typename Mapping<dim, spacedim>::InternalDataBase>
       internal_mapping_data;
 
+    /**
+     * The internal data of the underlying mapping for the evaluation at the
+     * center of affine cells. Only set up if the mapping supports the affine
+     * shortcut, see the class documentation.
+     */
+    std::unique_ptr<typename Mapping<dim, spacedim>::InternalDataBase>
+      affine_internal_mapping_data;
+
+    /**
+     * The one-point quadrature at the center of the reference cell used for
+     * affine cells.
+     */
+    Quadrature<dim> affine_quadrature;
+
+    /**
+     * The update flags used for the evaluation at the center of affine
+     * cells.
+     */
+    UpdateFlags update_flags_mapping_affine;
+
+    /**
+     * Scratch data for the mapping data at the center of affine cells.
+     */
+    MappingData affine_mapping_data;
+
+    /**
+     * Scratch data for the mapping data of the points of a single cell,
+     * kept to reuse its memory in reinit().
+     */
+    MappingData mapping_data;
+
+    /**
+     * Scratch data for the points and weights passed to reinit() as an
+     * ArrayView, kept to reuse their memory.
+     */
+    std::vector<Point<dim>> scratch_points;
+    std::vector<double>     scratch_weights;
+    Quadrature<dim>         scratch_quadrature;
+
     /**
      * A pointer to the underlying mapping.
      */
@@ -599,6 +707,28 @@ namespace NonMatching
           std::make_unique<typename MappingQ<dim, spacedim>::InternalData>(
             mapping_q->get_degree());
       }
+
+    // set up the evaluation at the center of affine cells for the mappings
+    // that support it, see is_affine_cell()
+    if (dynamic_cast<const MappingCartesian<dim, spacedim> *>(&mapping) !=
+          nullptr ||
+        typeid(mapping) == typeid(MappingQ<dim, spacedim>))
+      {
+        update_flags_mapping_affine =
+          internal::ComputeMappingDataHelper<dim, spacedim>::
+            required_update_flags(this->mapping,
+                                  update_flags_mapping | update_jacobians |
+                                    update_quadrature_points);
+
+        Point<dim> center;
+        for (unsigned int d = 0; d < dim; ++d)
+          center[d] = 0.5;
+        affine_quadrature = Quadrature<dim>(center);
+
+        affine_internal_mapping_data =
+          internal::ComputeMappingDataHelper<dim, spacedim>::get_data(
+            this->mapping, update_flags_mapping_affine, affine_quadrature);
+      }
   }
 
 
@@ -609,7 +739,7 @@ namespace NonMatching
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const std::vector<Point<dim>> &                             unit_points_in)
   {
-    reinit(cell, Quadrature<dim>(unit_points_in));
+    reinit(cell, make_array_view(unit_points_in));
   }
 
 
@@ -620,9 +750,22 @@ namespace NonMatching
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const ArrayView<const Point<dim>> &                         unit_points_in)
   {
-    reinit(cell,
-           std::vector<Point<dim>>(unit_points_in.begin(),
-                                   unit_points_in.end()));
+    if (is_affine_cell(cell))
+      reinit_affine_cell(cell, unit_points_in, ArrayView<const double>());
+    else
+      {
+        // copy the points into the scratch quadrature, reusing the memory of
+        // previous calls
+        scratch_points.assign(unit_points_in.begin(), unit_points_in.end());
+        scratch_weights.assign(unit_points_in.size(),
+                               std::numeric_limits<double>::infinity());
+        scratch_quadrature.initialize(scratch_points, scratch_weights);
+
+        reinit_general_cell(cell, scratch_quadrature);
+      }
+
+    state = State::single_cell;
+    is_reinitialized();
   }
 
 
@@ -632,6 +775,151 @@ namespace NonMatching
   MappingInfo<dim, spacedim, Number>::reinit(
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const Quadrature<dim> &                                     quadrature)
+  {
+    if (is_affine_cell(cell))
+      reinit_affine_cell(cell,
+                         make_array_view(quadrature.get_points()),
+                         make_array_view(quadrature.get_weights()));
+    else
+      reinit_general_cell(cell, quadrature);
+
+    state = State::single_cell;
+    is_reinitialized();
+  }
+
+
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  MappingInfo<dim, spacedim, Number>::is_affine_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
+  {
+    if (affine_internal_mapping_data == nullptr ||
+        cell->reference_cell() != ReferenceCells::get_hypercube<dim>())
+      return false;
+
+    // MappingCartesian can only be used on axis-parallel cells, on which it
+    // is always affine
+    if (dynamic_cast<const MappingCartesian<dim, spacedim> *>(&*mapping) !=
+        nullptr)
+      return true;
+
+    // for MappingQ of higher degree, the support points in the interior of
+    // the cell, faces, and lines are placed by the manifolds, which must
+    // therefore be flat
+    const auto &mapping_q =
+      static_cast<const MappingQ<dim, spacedim> &>(*mapping);
+    if (mapping_q.get_degree() > 1)
+      {
+        const auto is_flat = [](const Manifold<dim, spacedim> &manifold) {
+          return dynamic_cast<const FlatManifold<dim, spacedim> *>(
+                   &manifold) != nullptr;
+        };
+        if (!is_flat(cell->get_manifold()))
+          return false;
+        if (dim > 1)
+          for (const unsigned int f : cell->face_indices())
+            if (!is_flat(cell->face(f)->get_manifold()))
+              return false;
+        if (dim > 2)
+          for (const unsigned int l : cell->line_indices())
+            if (!is_flat(cell->line(l)->get_manifold()))
+              return false;
+      }
+
+    // the vertices must span a parallelogram/parallelepiped, i.e., each
+    // vertex is given by the sum of the edge vectors emanating from vertex 0
+    const Point<spacedim> &v0 = cell->vertex(0);
+    const double           tolerance =
+      1e-12 * v0.distance(cell->vertex(cell->n_vertices() - 1));
+    for (unsigned int v = 3; v < cell->n_vertices(); ++v)
+      {
+        Point<spacedim> vertex = v0;
+        for (unsigned int d = 0; d < dim; ++d)
+          if (v & (1U << d))
+            vertex += cell->vertex(1U << d) - v0;
+        if (vertex.distance(cell->vertex(v)) > tolerance)
+          return false;
+      }
+
+    return true;
+  }
+
+
+
+  template <int dim, int spacedim, typename Number>
+  void
+  MappingInfo<dim, spacedim, Number>::reinit_affine_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<dim>> &                         unit_points_in,
+    const ArrayView<const double> &                             weights)
+  {
+    const unsigned int n_points = unit_points_in.size();
+    AssertIndexRange(weights.size(), n_points + 1);
+    Assert(weights.empty() || weights.size() == n_points,
+           ExcDimensionMismatch(weights.size(), n_points));
+
+    n_q_points_unvectorized.resize(1);
+    n_q_points_unvectorized[0] = n_points;
+
+    const unsigned int n_q_points =
+      compute_n_q_points<VectorizedArrayType>(n_points);
+
+    const unsigned int n_q_points_data = compute_n_q_points<Number>(n_points);
+
+    // resize data vectors
+    resize_unit_points(n_q_points);
+    resize_data_fields(n_q_points_data);
+
+    // store unit points
+    store_unit_points(0, n_q_points, n_points, unit_points_in);
+
+    // evaluate the mapping at the center of the cell only
+    internal::ComputeMappingDataHelper<dim, spacedim>::
+      compute_mapping_data_for_quadrature(mapping,
+                                          update_flags_mapping_affine,
+                                          cell,
+                                          affine_quadrature,
+                                          *affine_internal_mapping_data,
+                                          affine_mapping_data);
+
+    // all other quantities follow from the constant Jacobian
+    const Point<dim> &center = affine_quadrature.point(0);
+    const DerivativeForm<1, dim, spacedim> &jacobian =
+      affine_mapping_data.jacobians[0];
+    mapping_data.initialize(n_points, update_flags_mapping);
+    for (unsigned int q = 0; q < n_points; ++q)
+      {
+        if (update_flags_mapping & UpdateFlags::update_jacobians)
+          mapping_data.jacobians[q] = jacobian;
+        if (update_flags_mapping & UpdateFlags::update_inverse_jacobians)
+          mapping_data.inverse_jacobians[q] =
+            affine_mapping_data.inverse_jacobians[0];
+        if (update_flags_mapping & UpdateFlags::update_JxW_values)
+          mapping_data.JxW_values[q] =
+            affine_mapping_data.JxW_values[0] *
+            (weights.empty() ? std::numeric_limits<double>::infinity() :
+                               weights[q]);
+        if (update_flags_mapping & UpdateFlags::update_normal_vectors)
+          mapping_data.normal_vectors[q] =
+            affine_mapping_data.normal_vectors[0];
+        if (update_flags_mapping & UpdateFlags::update_quadrature_points)
+          mapping_data.quadrature_points[q] =
+            affine_mapping_data.quadrature_points[0] +
+            apply_transformation(jacobian, unit_points_in[q] - center);
+      }
+
+    // store mapping data
+    store_mapping_data(0, n_q_points_data, n_points, mapping_data);
+  }
+
+
+
+  template <int dim, int spacedim, typename Number>
+  void
+  MappingInfo<dim, spacedim, Number>::reinit_general_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const Quadrature<dim> &                                     quadrature)
   {
     n_q_points_unvectorized.resize(1);
     n_q_points_unvectorized[0] = quadrature.size();
@@ -653,7 +941,6 @@ namespace NonMatching
                       quadrature.get_points());
 
     // compute mapping data
-    MappingData                mapping_data;
     CellSimilarity::Similarity cell_similarity = CellSimilarity::none;
     internal::ComputeMappingDataHelper<dim, spacedim>::
       compute_mapping_data_for_quadrature(mapping,
@@ -669,9 +956,6 @@ namespace NonMatching
                        n_q_points_data,
                        n_q_points_unvectorized[0],
                        mapping_data);
-
-    state = State::single_cell;
-    is_reinitialized();
   }
 
 
@@ -1117,10 +1401,10 @@ namespace NonMatching
   template <int dim, int spacedim, typename Number>
   void
   MappingInfo<dim, spacedim, Number>::store_unit_points(
-    const unsigned int             unit_points_index_offset,
-    const unsigned int             n_q_points,
-    const unsigned int             n_q_points_unvectorized,
-    const std::vector<Point<dim>> &points)
+    const unsigned int                 unit_points_index_offset,
+    const unsigned int                 n_q_points,
+    const unsigned int                 n_q_points_unvectorized,
+    const ArrayView<const Point<dim>> &points)
   {
     const unsigned int n_lanes =
       dealii::internal::VectorizedArrayTrait<VectorizedArrayType>::width;
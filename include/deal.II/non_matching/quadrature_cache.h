@@ -0,0 +1,380 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_non_matching_quadrature_cache_h
+#define dealii_non_matching_quadrature_cache_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/thread_local_storage.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/grid/cell_id.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/hp/q_collection.h>
+
+#include <deal.II/non_matching/immersed_surface_quadrature.h>
+#include <deal.II/non_matching/mesh_classifier.h>
+#include <deal.II/non_matching/quadrature_generator.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace NonMatching
+{
+  /**
+   * A class that stores the immersed quadrature rules generated by
+   * DiscreteQuadratureGenerator on all locally owned intersected cells of a
+   * mesh, for a discrete level set function described by a DoFHandler and a
+   * vector.
+   *
+   * Generating the immersed quadrature rules is expensive, and in
+   * time-dependent problems or nonlinear iterations, most of the intersected
+   * cells typically do not change between two calls of the assembly. This
+   * class therefore stores, for each intersected cell identified by its
+   * CellId, the generated quadratures together with a hash of the local
+   * values of the level set function on that cell. The quadratures are
+   * defined on the reference cell and only depend on these local values, so
+   * update() only needs to regenerate the quadratures on those cells where
+   * the hash has changed or that have become intersected. The regeneration
+   * is done in parallel on the available threads.
+   *
+   * The cached quadratures can be used in two ways:
+   * - By passing the cache to NonMatching::FEValues::set_quadrature_cache(),
+   *   in which case NonMatching::FEValues::reinit() looks up the quadratures
+   *   instead of generating them.
+   * - By querying them with get_inside_quadrature(), get_outside_quadrature(),
+   *   and get_surface_quadrature() for a single cell, or with
+   *   get_inside_quadratures(), get_outside_quadratures(), and
+   *   get_surface_quadratures() for a range of cells. The latter return the
+   *   vectors of quadratures expected by
+   *   NonMatching::MappingInfo::reinit_cells() and
+   *   NonMatching::MappingInfo::reinit_surface() for matrix-free evaluation:
+   * @code
+   * const auto cells = filter_iterators(dof_handler.active_cell_iterators(),
+   *                                     IteratorFilters::LocallyOwnedCell());
+   * mapping_info_cells.reinit_cells(
+   *   cells, quadrature_cache.get_inside_quadratures(cells));
+   * mapping_info_surface.reinit_surface(
+   *   cells, quadrature_cache.get_surface_quadratures(cells));
+   * @endcode
+   *
+   * A typical use in a time loop looks like this:
+   * @code
+   * NonMatching::MeshClassifier<dim>  mesh_classifier(dof_handler, level_set);
+   * NonMatching::QuadratureCache<dim> quadrature_cache(q_collection_1D,
+   *                                                    dof_handler,
+   *                                                    level_set);
+   * fe_values.set_quadrature_cache(quadrature_cache);
+   *
+   * for (unsigned int step = 0; step < n_steps; ++step)
+   *   {
+   *     // ... update level_set ...
+   *     mesh_classifier.reclassify();
+   *     quadrature_cache.update(mesh_classifier);
+   *
+   *     // ... assemble using fe_values ...
+   *   }
+   * @endcode
+   *
+   * @note Pointers to the DoFHandler and the level set vector passed to the
+   * constructor are stored internally, so these need to live longer than this
+   * object. The vector needs to contain the values of all locally relevant
+   * degrees of freedom.
+   */
+  template <int dim>
+  class QuadratureCache : public Subscriptor
+  {
+  public:
+    using AdditionalData = AdditionalQGeneratorData;
+
+    /**
+     * The quadrature rules generated on a cell.
+     */
+    struct CellQuadratures
+    {
+      /**
+       * Quadrature for the region $\{x \in K : \psi(x) < 0 \}$.
+       */
+      Quadrature<dim> inside;
+
+      /**
+       * Quadrature for the region $\{x \in K : \psi(x) > 0 \}$.
+       */
+      Quadrature<dim> outside;
+
+      /**
+       * Quadrature for the region $\{x \in K : \psi(x) = 0 \}$.
+       */
+      ImmersedSurfaceQuadrature<dim> surface;
+
+      /**
+       * Index of the 1d quadrature in the hp::QCollection<1> that was used to
+       * generate the quadratures.
+       */
+      unsigned int q_index;
+
+      /**
+       * Hash of the local values of the level set function the quadratures
+       * were generated with.
+       */
+      std::size_t level_set_hash;
+    };
+
+    /**
+     * Constructor. The arguments are the same as those of
+     * DiscreteQuadratureGenerator. For hp-problems, the 1d quadrature with
+     * the index of the active FE index of a cell is used, unless the
+     * collection only contains a single quadrature.
+     */
+    template <class VectorType>
+    QuadratureCache(const hp::QCollection<1> &quadratures1D,
+                    const DoFHandler<dim> &   dof_handler,
+                    const VectorType &        level_set,
+                    const AdditionalData &additional_data = AdditionalData());
+
+    /**
+     * Bring the stored quadratures up to date with the current values of the
+     * level set vector: Generate the quadratures on all locally owned cells
+     * that @p mesh_classifier classifies as intersected, unless quadratures
+     * generated with the same local level set values are already stored, and
+     * remove the quadratures of all other cells.
+     *
+     * @note The MeshClassifier needs to have been reclassified with the
+     * current level set vector.
+     */
+    void
+    update(const MeshClassifier<dim> &mesh_classifier);
+
+    /**
+     * Remove all stored quadratures.
+     */
+    void
+    clear();
+
+    /**
+     * Return a pointer to the quadratures stored for the given cell, or a
+     * null pointer if there are none or if the local values of the level set
+     * function on the cell have changed since the quadratures were generated.
+     */
+    const CellQuadratures *
+    get_quadratures(
+      const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+    /**
+     * Return the quadrature for the inside region of the given cell, or an
+     * empty quadrature if no quadratures are stored for the cell.
+     */
+    const Quadrature<dim> &
+    get_inside_quadrature(
+      const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+    /**
+     * Return the quadrature for the outside region of the given cell, or an
+     * empty quadrature if no quadratures are stored for the cell.
+     */
+    const Quadrature<dim> &
+    get_outside_quadrature(
+      const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+    /**
+     * Return the quadrature for the surface region of the given cell, or an
+     * empty quadrature if no quadratures are stored for the cell.
+     */
+    const ImmersedSurfaceQuadrature<dim> &
+    get_surface_quadrature(
+      const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+    /**
+     * Return the quadratures for the inside region of all cells in
+     * @p cell_range, in the order of the range. Cells without stored
+     * quadratures get an empty quadrature.
+     */
+    template <typename ContainerType>
+    std::vector<Quadrature<dim>>
+    get_inside_quadratures(const ContainerType &cell_range) const;
+
+    /**
+     * Return the quadratures for the outside region of all cells in
+     * @p cell_range, in the order of the range. Cells without stored
+     * quadratures get an empty quadrature.
+     */
+    template <typename ContainerType>
+    std::vector<Quadrature<dim>>
+    get_outside_quadratures(const ContainerType &cell_range) const;
+
+    /**
+     * Return the quadratures for the surface region of all cells in
+     * @p cell_range, in the order of the range. Cells without stored
+     * quadratures get an empty quadrature.
+     */
+    template <typename ContainerType>
+    std::vector<ImmersedSurfaceQuadrature<dim>>
+    get_surface_quadratures(const ContainerType &cell_range) const;
+
+    /**
+     * Return the number of cells for which quadratures are stored.
+     */
+    unsigned int
+    n_cells() const;
+
+    /**
+     * Return the number of cells on which the quadratures were generated in
+     * the last call to update().
+     */
+    unsigned int
+    n_generated_cells() const;
+
+    /**
+     * Return an estimate for the memory consumption, in bytes, of this
+     * object.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * Return the index of the 1d quadrature to be used on the given cell.
+     */
+    unsigned int
+    get_q_index(
+      const typename DoFHandler<dim>::active_cell_iterator &cell) const;
+
+    /**
+     * Compute the hash of the local values of the level set function on the
+     * given cell.
+     */
+    std::size_t
+    compute_level_set_hash(
+      const typename DoFHandler<dim>::active_cell_iterator &cell) const;
+
+    /**
+     * Pointer to the DoFHandler passed to the constructor.
+     */
+    const SmartPointer<const DoFHandler<dim>> dof_handler;
+
+    /**
+     * The number of 1d quadratures passed to the constructor.
+     */
+    const unsigned int n_quadratures1D;
+
+    /**
+     * Function filling the local values of the level set function on a
+     * cell. The second argument is scratch space for the DoF indices of the
+     * cell.
+     */
+    std::function<void(const typename DoFHandler<dim>::active_cell_iterator &,
+                       std::vector<types::global_dof_index> &,
+                       std::vector<double> &)>
+      get_local_level_set_values;
+
+    /**
+     * Scratch space for compute_level_set_hash(), which is called on every
+     * lookup, possibly by several threads at once.
+     */
+    struct HashScratchData
+    {
+      std::vector<types::global_dof_index> dof_indices;
+      std::vector<double>                  local_values;
+    };
+
+    mutable Threads::ThreadLocalStorage<HashScratchData> hash_scratch_data;
+
+    /**
+     * Function creating a DiscreteQuadratureGenerator for the level set
+     * function. Every thread creates its own generator, because the
+     * generators store the quadratures of the last cell.
+     */
+    std::function<std::unique_ptr<DiscreteQuadratureGenerator<dim>>()>
+      create_generator;
+
+    /**
+     * The quadratures stored for the intersected cells.
+     */
+    std::map<CellId, CellQuadratures> cell_quadratures;
+
+    /**
+     * The number of cells on which the quadratures were generated in the last
+     * call to update().
+     */
+    unsigned int n_generated;
+
+    /**
+     * Empty quadratures, returned for cells without stored quadratures.
+     */
+    const Quadrature<dim>                empty_quadrature;
+    const ImmersedSurfaceQuadrature<dim> empty_surface_quadrature;
+  };
+
+
+
+#ifndef DOXYGEN
+
+  template <int dim>
+  template <typename ContainerType>
+  std::vector<Quadrature<dim>>
+  QuadratureCache<dim>::get_inside_quadratures(
+    const ContainerType &cell_range) const
+  {
+    std::vector<Quadrature<dim>> quadratures;
+    for (const auto &cell : cell_range)
+      quadratures.push_back(get_inside_quadrature(cell));
+    return quadratures;
+  }
+
+
+
+  template <int dim>
+  template <typename ContainerType>
+  std::vector<Quadrature<dim>>
+  QuadratureCache<dim>::get_outside_quadratures(
+    const ContainerType &cell_range) const
+  {
+    std::vector<Quadrature<dim>> quadratures;
+    for (const auto &cell : cell_range)
+      quadratures.push_back(get_outside_quadrature(cell));
+    return quadratures;
+  }
+
+
+
+  template <int dim>
+  template <typename ContainerType>
+  std::vector<ImmersedSurfaceQuadrature<dim>>
+  QuadratureCache<dim>::get_surface_quadratures(
+    const ContainerType &cell_range) const
+  {
+    std::vector<ImmersedSurfaceQuadrature<dim>> quadratures;
+    for (const auto &cell : cell_range)
+      quadratures.push_back(get_surface_quadrature(cell));
+    return quadratures;
+  }
+
+#endif
+
+} // namespace NonMatching
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
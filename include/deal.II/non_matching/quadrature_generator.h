@@ -658,19 +658,43 @@ namespace NonMatching
                    const BoundingBox<1> &interval,
                    std::vector<double> & roots);
 
+        /**
+         * Same as the function above, but the values of each of the
+         * @p functions at the lower and upper end of @p interval are passed in
+         * @p end_point_values. This allows the caller to evaluate the functions
+         * at the end points of many intervals at once.
+         */
+        void
+        find_roots(
+          const std::vector<std::reference_wrapper<const Function<1>>>
+            &                                           functions,
+          const BoundingBox<1> &                        interval,
+          const std::vector<std::pair<double, double>> &end_point_values,
+          std::vector<double> &                         roots);
+
       private:
         /**
          * Attempt to find the roots of the @p function over the interval defined by
-         * @p interval and add these to @p roots. @p recursion_depth holds the number
-         * of times this function has been called recursively.
+         * @p interval and add these to @p roots. @p left_value and
+         * @p right_value are the values of the function at the end points of
+         * the interval. @p recursion_depth holds the number of times this
+         * function has been called recursively.
          */
         void
         find_roots(const Function<1> &   function,
                    const BoundingBox<1> &interval,
+                   const double          left_value,
+                   const double          right_value,
                    const unsigned int    recursion_depth,
                    std::vector<double> & roots);
 
         const AdditionalData additional_data;
+
+        /**
+         * The values of the functions at the end points of the interval,
+         * stored as member to avoid allocating it in every call.
+         */
+        std::vector<std::pair<double, double>> function_end_point_values;
       };
 
 
@@ -823,6 +847,13 @@ namespace NonMatching
        * $w_s = \frac{\|\nabla \psi(x_s)\|}{|\partial_i \psi(x_s)|} w_I$,
        *
        * where $i$ is the height function direction.
+       *
+       * The level set functions are evaluated at the end points of the
+       * intervals $[L, R]$ of all points $x_I$, and their gradients at all
+       * surface points, with a single call to Function::value_list() and
+       * Function::gradient_list(), respectively. This allows functions that
+       * implement these, like the restrictions of a finite element field, to
+       * evaluate many points at once.
        */
       template <int dim, int spacedim>
       class UpThroughDimensionCreator
@@ -858,7 +889,8 @@ namespace NonMatching
       private:
         /**
          * Create a surface quadrature point from the lower-dimensional point
-         * and add it to surface_quadrature.
+         * and add it together with the lower-dimensional weight to
+         * surface_points and surface_weights.
          *
          * This function is only called when $dim=spacedim$ and there is a
          * single level set function. At this point there should only be a
@@ -869,11 +901,35 @@ namespace NonMatching
           const Point<dim - 1> &point,
           const double          weight,
           const std::vector<std::reference_wrapper<const Function<dim>>>
-            &                             level_sets,
-          const BoundingBox<dim> &        box,
+            &                     level_sets,
+          const BoundingBox<dim> &box,
+          const unsigned int      height_function_direction);
+
+        /**
+         * Evaluate the gradient of the level set function at all points in
+         * surface_points at once, and use it to compute the normals and the
+         * weights of the surface quadrature points, which are added to
+         * @p surface_quadrature.
+         */
+        void
+        add_surface_points(
+          const Function<dim> &           level_set,
           const unsigned int              height_function_direction,
           ImmersedSurfaceQuadrature<dim> &surface_quadrature);
 
+        /**
+         * Evaluate all level set functions at the end points of the intervals
+         * in the height function direction through all points of
+         * @p low_dim_quadrature, and store the values in end_point_values.
+         */
+        void
+        evaluate_at_end_points(
+          const std::vector<std::reference_wrapper<const Function<dim>>>
+            &                        level_sets,
+          const BoundingBox<dim> &   box,
+          const Quadrature<dim - 1> &low_dim_quadrature,
+          const unsigned int         height_function_direction);
+
         /**
          * One dimensional quadrature rules used to create the immersed
          * quadratures.
@@ -909,6 +965,41 @@ namespace NonMatching
          * $x_I \in \mathbb{R}^{dim-1}$.
          */
         std::vector<double> roots;
+
+        /**
+         * The end points of the intervals in the height function direction
+         * for all lower dimensional quadrature points, with the lower and the
+         * upper end point of each interval stored consecutively.
+         */
+        std::vector<Point<dim>> end_points;
+
+        /**
+         * The values of all level set functions at the points in end_points.
+         * The values of the level set function with index $j$ start at
+         * position $j$ times the size of end_points.
+         */
+        std::vector<double> end_point_values;
+
+        /**
+         * The values of the level set functions at the end points of the
+         * interval of the current lower dimensional quadrature point, as
+         * passed to the RootFinder.
+         */
+        std::vector<std::pair<double, double>> interval_end_point_values;
+
+        /**
+         * The points and the lower dimensional weights of the surface
+         * quadrature, before the normals and the surface weights have been
+         * computed.
+         */
+        std::vector<Point<dim>> surface_points;
+        std::vector<double>     surface_weights;
+
+        /**
+         * The gradients of the level set function at the points in
+         * surface_points.
+         */
+        std::vector<Tensor<1, dim>> surface_gradients;
       };
 
 
@@ -1186,6 +1277,14 @@ namespace NonMatching
          * q_collection1d.
          */
         hp::QCollection<dim> tensor_products;
+
+        /**
+         * Scratch space for the vertices of the current box and the values
+         * of a level set function at these vertices, used when estimating
+         * the bounds of the level set functions.
+         */
+        std::vector<Point<dim>> box_vertices;
+        std::vector<double>     box_vertex_values;
       };
 
 
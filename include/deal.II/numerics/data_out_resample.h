@@ -25,7 +25,9 @@
 
 #include <deal.II/numerics/data_out.h>
 #include <deal.II/numerics/data_out_dof_data.h>
+#include <deal.II/numerics/point_interpolation_operator.h>
 
+#include <map>
 #include <memory>
 
 DEAL_II_NAMESPACE_OPEN
@@ -110,7 +112,11 @@ public:
    * patches to be written by the low-level functions of the base class.
    * However it skips the update of the mapping and reuses the one registered
    * via update_mapping(). This allows to skip the expensive setup of the
-   * internal communication routines.
+   * internal communication routines. Furthermore, the interpolation of each
+   * DoFHandler to the points of the patches is computed only once and then
+   * reused, see PointInterpolationOperator. The interpolation is computed
+   * anew when the degrees of freedom of a DoFHandler have been distributed
+   * anew or renumbered, see PointInterpolationOperator::dof_indices_changed().
    *
    * @note This function can be only used if a mapping has been registered via
    *   update_mapping() or the other build_patches() function. The same
@@ -147,6 +153,16 @@ private:
    */
   Utilities::MPI::RemotePointEvaluation<dim, spacedim> rpe;
 
+  /**
+   * Operators interpolating a component of the data vectors of a DoFHandler
+   * to the evaluation points. They are set up on first use in
+   * build_patches(), set up again there if the degrees of freedom have
+   * changed, and reset in update_mapping().
+   */
+  std::map<std::pair<const DoFHandler<dim, spacedim> *, unsigned int>,
+           std::unique_ptr<PointInterpolationOperator<1, dim, spacedim>>>
+    interpolation_operators;
+
   /**
    * Partitioner to create internally distributed vectors.
    */
@@ -0,0 +1,828 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_point_interpolation_operator_h
+#define dealii_point_interpolation_operator_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/component_mask.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+
+#include <deal.II/lac/vector_element_access.h>
+
+#include <deal.II/numerics/vector_tools_common.h>
+#include <deal.II/numerics/vector_tools_evaluate.h>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * An operator that interpolates finite element functions described by a
+ * DoFHandler and a vector to a fixed set of points.
+ *
+ * The interpolation is a linear map from the degrees of freedom to the
+ * values at the points. This class computes the matrix of this map once in
+ * reinit(), i.e., it locates the points in the mesh and evaluates the shape
+ * functions of the cells around the points, and stores the matrix in a
+ * compressed row format. Afterwards, vmult() can be applied to any number of
+ * vectors, e.g., in every time step, without repeating the point location
+ * and the evaluation of the shape functions. The rows of the matrix are
+ * processed in parallel on the available threads.
+ *
+ * Two setups are available:
+ * - The points are handed over through a Utilities::MPI::RemotePointEvaluation
+ *   object. The points can then be located on any process, and vmult()
+ *   computes the values on the processes owning the cells around the points
+ *   and communicates them to the processes that requested them. If a point
+ *   lies on the boundary of several cells, the values of these cells are
+ *   combined as specified by VectorTools::EvaluationFlags, like in
+ *   VectorTools::point_values().
+ * - The points are given directly. They are then located among the locally
+ *   owned cells of the calling process, with one cell per point, and no
+ *   communication takes place.
+ *
+ * The following code snippet samples the first component of a solution at
+ * some probe locations in every time step:
+ * @code
+ * Utilities::MPI::RemotePointEvaluation<dim> rpe;
+ * rpe.reinit(probe_locations, triangulation, mapping);
+ *
+ * PointInterpolationOperator<1, dim> interpolation;
+ * interpolation.reinit(rpe, dof_handler);
+ *
+ * std::vector<double> probe_values;
+ * for (unsigned int step = 0; step < n_steps; ++step)
+ *   {
+ *     // ... compute solution ...
+ *     solution.update_ghost_values();
+ *     interpolation.vmult(probe_values, solution);
+ *   }
+ * @endcode
+ *
+ * The template argument @p n_components specifies the number of components
+ * of the finite element, starting from the component selected in reinit(),
+ * that are interpolated. The values at the points are of the same type as
+ * the ones returned by VectorTools::point_values(), i.e., scalars for
+ * @p n_components equal to one and tensors otherwise.
+ *
+ * @note The shape functions are evaluated with FEValues, so this class works
+ * with all finite elements, including the ones whose shape functions are
+ * mapped from the reference cell, such as FE_RaviartThomas.
+ *
+ * @note The vectors passed to vmult() need to give access to the values of
+ * all degrees of freedom of the locally owned cells around the points, i.e.,
+ * ghost values need to be up to date for parallel vectors.
+ *
+ * @warning The matrix is computed for the DoFHandler and the positions of the
+ * points at the time of the call to reinit(). If the degrees of freedom are
+ * redistributed or renumbered, or if the Utilities::MPI::RemotePointEvaluation
+ * object is set up again or its points are moved, reinit() needs to be called
+ * again. Changes of the degrees of freedom can be detected with
+ * dof_indices_changed().
+ */
+template <int n_components, int dim, int spacedim = dim>
+class PointInterpolationOperator : public Subscriptor
+{
+public:
+  /**
+   * The type of the values at the points for a vector with entries of type
+   * @p Number.
+   */
+  template <typename Number>
+  using value_type =
+    typename FEPointEvaluation<n_components, dim, spacedim, Number>::
+      value_type;
+
+  /**
+   * Constructor. The object needs to be set up by one of the reinit()
+   * functions before it can be used.
+   */
+  PointInterpolationOperator();
+
+  /**
+   * Set up the interpolation to the points of @p remote_point_evaluation,
+   * for the components of the finite element of @p dof_handler starting at
+   * @p first_selected_component. The points are located on the processes
+   * that own the cells around them, which compute the corresponding rows of
+   * the matrix.
+   *
+   * @note @p remote_point_evaluation is stored by reference and needs to
+   * live longer than this object.
+   */
+  void
+  reinit(const Utilities::MPI::RemotePointEvaluation<dim, spacedim>
+           &                              remote_point_evaluation,
+         const DoFHandler<dim, spacedim> &dof_handler,
+         const unsigned int               first_selected_component = 0);
+
+  /**
+   * Set up the interpolation to the given @p points, for the components of
+   * the finite element of @p dof_handler starting at
+   * @p first_selected_component. The points are located with
+   * GridTools::find_active_cells_around_points() and need to lie in locally
+   * owned cells of the calling process, otherwise an exception of type
+   * VectorTools::ExcPointNotAvailableHere is thrown.
+   */
+  void
+  reinit(const std::vector<Point<spacedim>> &points,
+         const DoFHandler<dim, spacedim> &   dof_handler,
+         const Mapping<dim, spacedim> &      mapping,
+         const unsigned int                  first_selected_component = 0);
+
+  /**
+   * Same as the function above, but set up the interpolation for all
+   * components of the finite element selected by @p component_mask at once.
+   * Their number does not need to match the template argument
+   * @p n_components, and the values are computed with
+   * vmult_selected_components() instead of vmult().
+   */
+  void
+  reinit(const std::vector<Point<spacedim>> &points,
+         const DoFHandler<dim, spacedim> &   dof_handler,
+         const Mapping<dim, spacedim> &      mapping,
+         const ComponentMask &               component_mask);
+
+  /**
+   * Interpolate the finite element function described by @p src to the
+   * points and write the results into @p dst, which is resized to the number
+   * of points. If the object was set up with a
+   * Utilities::MPI::RemotePointEvaluation object, the values of a point
+   * that lies in several cells are combined according to @p flags, and
+   * points that have not been found get a zero value.
+   *
+   * @warning If the object was set up with a
+   * Utilities::MPI::RemotePointEvaluation object, this is a collective call
+   * that needs to be executed by all processors in the communicator.
+   */
+  template <typename VectorType>
+  void
+  vmult(std::vector<value_type<typename VectorType::value_type>> &dst,
+        const VectorType &                                         src,
+        const VectorTools::EvaluationFlags::EvaluationFlags        flags =
+          VectorTools::EvaluationFlags::avg) const;
+
+  /**
+   * Interpolate the selected components of the finite element function
+   * described by @p src to the points and write the results into @p dst,
+   * which is resized to the number of points times n_selected_components().
+   * The value of the selected component with index @p c at the point with
+   * index @p p is stored at position `p * n_selected_components() + c`.
+   *
+   * This function is only available if the points were given directly.
+   */
+  template <typename VectorType>
+  void
+  vmult_selected_components(std::vector<typename VectorType::value_type> &dst,
+                            const VectorType &src) const;
+
+  /**
+   * Return the number of points the values are computed at in vmult().
+   */
+  unsigned int
+  n_points() const;
+
+  /**
+   * Return the number of components of the finite element that are
+   * interpolated.
+   */
+  unsigned int
+  n_selected_components() const;
+
+  /**
+   * Return whether the degrees of freedom of the cells around the points
+   * have changed since the last call to reinit(), e.g., because they have
+   * been distributed anew or renumbered. In this case, the results of
+   * vmult() would be wrong and reinit() needs to be called again. This
+   * function compares the number of degrees of freedom and a hash of the
+   * DoF indices of the cells around the points with the ones recorded in
+   * reinit(), which is much cheaper than setting up the object again.
+   *
+   * @note The triangulation must not have changed since reinit(). If the
+   * object was set up with a Utilities::MPI::RemotePointEvaluation object,
+   * only the cells owned by the calling process are checked.
+   */
+  bool
+  dof_indices_changed() const;
+
+  /**
+   * Return the number of nonzero entries of the locally stored rows of the
+   * interpolation matrix.
+   */
+  std::size_t
+  n_nonzero_elements() const;
+
+  /**
+   * Return an estimate for the memory consumption, in bytes, of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  using CellData =
+    typename Utilities::MPI::RemotePointEvaluation<dim, spacedim>::CellData;
+
+  /**
+   * Locate the @p points among the locally owned cells and compute the
+   * rows of the interpolation matrix for the components in
+   * selected_components.
+   */
+  void
+  setup_from_points(const std::vector<Point<spacedim>> &points,
+                    const Mapping<dim, spacedim> &      mapping);
+
+  /**
+   * Compute the rows of the interpolation matrix for the points of the given
+   * cells, one row per point and selected component.
+   */
+  void
+  compute_matrix(const Mapping<dim, spacedim> &mapping,
+                 const CellData &              cell_data);
+
+  /**
+   * Compute the hash of the DoF indices of the cells in
+   * cell_levels_and_indices.
+   */
+  std::size_t
+  compute_dof_indices_hash() const;
+
+  /**
+   * Compute the entry of the matrix-vector product for the given row.
+   */
+  template <typename VectorType>
+  typename VectorType::value_type
+  compute_row(const std::size_t row, const VectorType &src) const;
+
+  /**
+   * Compute the value at the point with the given index in the order of the
+   * rows of the matrix.
+   */
+  template <typename VectorType>
+  value_type<typename VectorType::value_type>
+  compute_value(const unsigned int point, const VectorType &src) const;
+
+  /**
+   * The RemotePointEvaluation object passed to reinit(), or a null pointer
+   * if the points were given directly.
+   */
+  SmartPointer<const Utilities::MPI::RemotePointEvaluation<dim, spacedim>>
+    remote_point_evaluation;
+
+  /**
+   * The DoFHandler passed to reinit().
+   */
+  SmartPointer<const DoFHandler<dim, spacedim>> dof_handler;
+
+  /**
+   * The components of the finite element that are interpolated.
+   */
+  std::vector<unsigned int> selected_components;
+
+  /**
+   * The cells around the points, given by level and index, and the number
+   * of degrees of freedom and the hash of the DoF indices of these cells at
+   * the time of reinit(), which are used by dof_indices_changed().
+   */
+  std::vector<std::pair<int, int>> cell_levels_and_indices;
+  types::global_dof_index          n_dofs;
+  std::size_t                      dof_indices_hash;
+
+  /**
+   * For points given directly, the index of the point in the order of the
+   * rows of the matrix, which groups the points by cells.
+   */
+  std::vector<unsigned int> point_to_row;
+
+  /**
+   * The offsets of the rows in @p column_indices and @p matrix_values. The
+   * row of the selected component @p c at point @p q has index
+   * `q * selected_components.size() + c`.
+   */
+  std::vector<std::size_t> row_ptrs;
+
+  /**
+   * The global indices of the degrees of freedom of the nonzero entries.
+   */
+  std::vector<types::global_dof_index> column_indices;
+
+  /**
+   * The values of the nonzero entries, i.e., the values of the shape
+   * functions at the points.
+   */
+  std::vector<double> matrix_values;
+};
+
+
+
+namespace internal
+{
+  namespace PointInterpolationOperatorImplementation
+  {
+    /**
+     * Return a reference to the component @p c of a scalar value.
+     */
+    template <typename Number>
+    inline Number &
+    component(Number &value, const unsigned int c)
+    {
+      (void)c;
+      AssertIndexRange(c, 1);
+      return value;
+    }
+
+
+
+    /**
+     * Return a reference to the component @p c of a vector value.
+     */
+    template <int n_components, typename Number>
+    inline Number &
+    component(Tensor<1, n_components, Number> &value, const unsigned int c)
+    {
+      return value[c];
+    }
+
+
+
+    /**
+     * Combine the hash @p seed with the given DoF indices.
+     */
+    inline void
+    hash_dof_indices(const std::vector<types::global_dof_index> &dof_indices,
+                     std::size_t &                               seed)
+    {
+      for (const types::global_dof_index index : dof_indices)
+        seed ^= std::hash<types::global_dof_index>()(index) + 0x9e3779b9 +
+                (seed << 6) + (seed >> 2);
+    }
+  } // namespace PointInterpolationOperatorImplementation
+} // namespace internal
+
+
+
+template <int n_components, int dim, int spacedim>
+PointInterpolationOperator<n_components, dim, spacedim>::
+  PointInterpolationOperator()
+  : n_dofs(numbers::invalid_dof_index)
+  , dof_indices_hash(0)
+{}
+
+
+
+template <int n_components, int dim, int spacedim>
+void
+PointInterpolationOperator<n_components, dim, spacedim>::reinit(
+  const Utilities::MPI::RemotePointEvaluation<dim, spacedim>
+    &                              remote_point_evaluation,
+  const DoFHandler<dim, spacedim> &dof_handler,
+  const unsigned int               first_selected_component)
+{
+  Assert(remote_point_evaluation.is_ready(),
+         ExcMessage(
+           "Utilities::MPI::RemotePointEvaluation is not ready yet! "
+           "Please call Utilities::MPI::RemotePointEvaluation::reinit() "
+           "before setting up this object."));
+  Assert(&dof_handler.get_triangulation() ==
+           &remote_point_evaluation.get_triangulation(),
+         ExcMessage("The provided Utilities::MPI::RemotePointEvaluation and "
+                    "DoFHandler object have been set up with different "
+                    "Triangulation objects, a scenario not supported!"));
+
+  this->remote_point_evaluation = &remote_point_evaluation;
+  this->dof_handler             = &dof_handler;
+  selected_components.resize(n_components);
+  std::iota(selected_components.begin(),
+            selected_components.end(),
+            first_selected_component);
+  point_to_row.clear();
+
+  compute_matrix(remote_point_evaluation.get_mapping(),
+                 remote_point_evaluation.get_cell_data());
+}
+
+
+
+template <int n_components, int dim, int spacedim>
+void
+PointInterpolationOperator<n_components, dim, spacedim>::reinit(
+  const std::vector<Point<spacedim>> &points,
+  const DoFHandler<dim, spacedim> &   dof_handler,
+  const Mapping<dim, spacedim> &      mapping,
+  const unsigned int                  first_selected_component)
+{
+  this->remote_point_evaluation = nullptr;
+  this->dof_handler             = &dof_handler;
+  selected_components.resize(n_components);
+  std::iota(selected_components.begin(),
+            selected_components.end(),
+            first_selected_component);
+
+  setup_from_points(points, mapping);
+}
+
+
+
+template <int n_components, int dim, int spacedim>
+void
+PointInterpolationOperator<n_components, dim, spacedim>::reinit(
+  const std::vector<Point<spacedim>> &points,
+  const DoFHandler<dim, spacedim> &   dof_handler,
+  const Mapping<dim, spacedim> &      mapping,
+  const ComponentMask &               component_mask)
+{
+  const unsigned int n_fe_components =
+    dof_handler.get_fe_collection().n_components();
+  Assert(component_mask.size() == 0 ||
+           component_mask.size() == n_fe_components,
+         ExcDimensionMismatch(component_mask.size(), n_fe_components));
+
+  this->remote_point_evaluation = nullptr;
+  this->dof_handler             = &dof_handler;
+  selected_components.clear();
+  for (unsigned int c = 0; c < n_fe_components; ++c)
+    if (component_mask[c])
+      selected_components.push_back(c);
+
+  setup_from_points(points, mapping);
+}
+
+
+
+template <int n_components, int dim, int spacedim>
+void
+PointInterpolationOperator<n_components, dim, spacedim>::setup_from_points(
+  const std::vector<Point<spacedim>> &points,
+  const Mapping<dim, spacedim> &      mapping)
+{
+  const GridTools::Cache<dim, spacedim> cache(dof_handler->get_triangulation(),
+                                              mapping);
+  const auto cells_and_reference_points =
+    GridTools::find_active_cells_around_points(cache, points);
+  const auto &cells            = cells_and_reference_points.first;
+  const auto &reference_points = cells_and_reference_points.second;
+
+  for (const auto &cell : cells)
+    AssertThrow(cell.state() == IteratorState::valid &&
+                  cell->is_locally_owned(),
+                VectorTools::ExcPointNotAvailableHere());
+
+  // group the points by cells, so that the shape functions only need to be
+  // evaluated once per cell
+  std::vector<unsigned int> permutation(points.size());
+  std::iota(permutation.begin(), permutation.end(), 0U);
+  std::stable_sort(permutation.begin(),
+                   permutation.end(),
+                   [&](const unsigned int a, const unsigned int b) {
+                     return cells[a] < cells[b];
+                   });
+
+  CellData cell_data;
+  point_to_row.resize(points.size());
+  for (unsigned int i = 0; i < permutation.size(); ++i)
+    {
+      const unsigned int p = permutation[i];
+      if (i == 0 || cells[p] != cells[permutation[i - 1]])
+        {
+          cell_data.cells.emplace_back(cells[p]->level(), cells[p]->index());
+          cell_data.reference_point_ptrs.emplace_back(i);
+        }
+      cell_data.reference_point_values.emplace_back(
+        cells[p]->reference_cell().is_hyper_cube() ?
+          GeometryInfo<dim>::project_to_unit_cell(reference_points[p]) :
+          reference_points[p]);
+      point_to_row[p] = i;
+    }
+  cell_data.reference_point_ptrs.emplace_back(points.size());
+
+  compute_matrix(mapping, cell_data);
+}
+
+
+
+template <int n_components, int dim, int spacedim>
+void
+PointInterpolationOperator<n_components, dim, spacedim>::compute_matrix(
+  const Mapping<dim, spacedim> &mapping,
+  const CellData &              cell_data)
+{
+  const unsigned int n_selected = selected_components.size();
+
+  row_ptrs.assign(1, 0);
+  row_ptrs.reserve(cell_data.reference_point_values.size() * n_selected + 1);
+  column_indices.clear();
+  matrix_values.clear();
+  cell_levels_and_indices = cell_data.cells;
+  n_dofs                  = dof_handler->n_dofs();
+  dof_indices_hash        = 0;
+
+  std::vector<types::global_dof_index> dof_indices;
+  std::vector<Point<dim>>              unit_points;
+  for (unsigned int i = 0; i < cell_data.cells.size(); ++i)
+    {
+      const typename DoFHandler<dim, spacedim>::active_cell_iterator cell(
+        &dof_handler->get_triangulation(),
+        cell_data.cells[i].first,
+        cell_data.cells[i].second,
+        &*dof_handler);
+
+      const FiniteElement<dim, spacedim> &fe = cell->get_fe();
+      Assert(n_selected == 0 || selected_components.back() < fe.n_components(),
+             ExcIndexRange(selected_components.back(), 0, fe.n_components()));
+
+      unit_points.assign(cell_data.reference_point_values.begin() +
+                           cell_data.reference_point_ptrs[i],
+                         cell_data.reference_point_values.begin() +
+                           cell_data.reference_point_ptrs[i + 1]);
+      FEValues<dim, spacedim> fe_values(mapping,
+                                        fe,
+                                        Quadrature<dim>(unit_points),
+                                        update_values);
+      fe_values.reinit(cell);
+
+      dof_indices.resize(fe.n_dofs_per_cell());
+      cell->get_dof_indices(dof_indices);
+      internal::PointInterpolationOperatorImplementation::hash_dof_indices(
+        dof_indices, dof_indices_hash);
+
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        for (const unsigned int component : selected_components)
+          {
+            for (unsigned int j = 0; j < dof_indices.size(); ++j)
+              {
+                const double value =
+                  fe_values.shape_value_component(j, q, component);
+                if (value != 0.)
+                  {
+                    column_indices.push_back(dof_indices[j]);
+                    matrix_values.push_back(value);
+                  }
+              }
+            row_ptrs.push_back(column_indices.size());
+          }
+    }
+}
+
+
+
+template <int n_components, int dim, int spacedim>
+std::size_t
+PointInterpolationOperator<n_components, dim, spacedim>::
+  compute_dof_indices_hash() const
+{
+  std::size_t                          hash = 0;
+  std::vector<types::global_dof_index> dof_indices;
+  for (const auto &level_and_index : cell_levels_and_indices)
+    {
+      const typename DoFHandler<dim, spacedim>::active_cell_iterator cell(
+        &dof_handler->get_triangulation(),
+        level_and_index.first,
+        level_and_index.second,
+        &*dof_handler);
+      dof_indices.resize(cell->get_fe().n_dofs_per_cell());
+      cell->get_dof_indices(dof_indices);
+      internal::PointInterpolationOperatorImplementation::hash_dof_indices(
+        dof_indices, hash);
+    }
+  return hash;
+}
+
+
+
+template <int n_components, int dim, int spacedim>
+template <typename VectorType>
+inline typename VectorType::value_type
+PointInterpolationOperator<n_components, dim, spacedim>::compute_row(
+  const std::size_t row,
+  const VectorType &src) const
+{
+  typename VectorType::value_type sum = {};
+  for (std::size_t j = row_ptrs[row]; j < row_ptrs[row + 1]; ++j)
+    sum += matrix_values[j] * dealii::internal::ElementAccess<VectorType>::get(
+                                src, column_indices[j]);
+  return sum;
+}
+
+
+
+template <int n_components, int dim, int spacedim>
+template <typename VectorType>
+inline typename PointInterpolationOperator<n_components, dim, spacedim>::
+  template value_type<typename VectorType::value_type>
+  PointInterpolationOperator<n_components, dim, spacedim>::compute_value(
+    const unsigned int point,
+    const VectorType & src) const
+{
+  value_type<typename VectorType::value_type> value = {};
+  for (unsigned int c = 0; c < n_components; ++c)
+    internal::PointInterpolationOperatorImplementation::component(value, c) =
+      compute_row(point * n_components + c, src);
+  return value;
+}
+
+
+
+template <int n_components, int dim, int spacedim>
+template <typename VectorType>
+void
+PointInterpolationOperator<n_components, dim, spacedim>::vmult(
+  std::vector<value_type<typename VectorType::value_type>> &dst,
+  const VectorType &                                         src,
+  const VectorTools::EvaluationFlags::EvaluationFlags        flags) const
+{
+  using result_type = value_type<typename VectorType::value_type>;
+
+  Assert(dof_handler != nullptr,
+         ExcMessage("PointInterpolationOperator::reinit() has not been "
+                    "called yet!"));
+  AssertDimension(src.size(), dof_handler->n_dofs());
+  Assert(selected_components.size() == n_components,
+         ExcMessage("The object has been set up for a number of components "
+                    "that differs from the template argument n_components. "
+                    "Use vmult_selected_components() instead."));
+
+  const unsigned int grain_size = 128;
+
+  // points given directly: one value per point, no communication
+  if (remote_point_evaluation == nullptr)
+    {
+      dst.resize(point_to_row.size());
+      parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(point_to_row.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int p = begin; p < end; ++p)
+            dst[p] = compute_value(point_to_row[p], src);
+        },
+        grain_size);
+      return;
+    }
+
+  Assert(remote_point_evaluation->is_ready(),
+         ExcMessage("The Utilities::MPI::RemotePointEvaluation object has "
+                    "been invalidated, e.g., by a change of the "
+                    "Triangulation. Please set it up again and call "
+                    "reinit() on this object."));
+
+  const auto evaluation_function = [&](const ArrayView<result_type> &values,
+                                       const CellData &) {
+    AssertDimension(values.size() * n_components + 1, row_ptrs.size());
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(values.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int q = begin; q < end; ++q)
+          values[q] = compute_value(q, src);
+      },
+      grain_size);
+  };
+
+  std::vector<result_type> buffer;
+  if (remote_point_evaluation->is_map_unique())
+    {
+      // each point has exactly one result
+      remote_point_evaluation->template evaluate_and_process<result_type>(
+        dst, buffer, evaluation_function);
+    }
+  else
+    {
+      // multiple or no results per point: combine the results
+      std::vector<result_type> values;
+      remote_point_evaluation->template evaluate_and_process<result_type>(
+        values, buffer, evaluation_function);
+
+      const auto &ptr = remote_point_evaluation->get_point_ptrs();
+      dst.assign(ptr.size() - 1, result_type());
+      for (unsigned int i = 0; i < ptr.size() - 1; ++i)
+        if (ptr[i + 1] > ptr[i])
+          dst[i] = VectorTools::internal::reduce(
+            flags,
+            ArrayView<const result_type>(values.data() + ptr[i],
+                                         ptr[i + 1] - ptr[i]));
+    }
+}
+
+
+
+template <int n_components, int dim, int spacedim>
+template <typename VectorType>
+void
+PointInterpolationOperator<n_components, dim, spacedim>::
+  vmult_selected_components(std::vector<typename VectorType::value_type> &dst,
+                            const VectorType &src) const
+{
+  Assert(dof_handler != nullptr,
+         ExcMessage("PointInterpolationOperator::reinit() has not been "
+                    "called yet!"));
+  Assert(remote_point_evaluation == nullptr, ExcNotImplemented());
+  AssertDimension(src.size(), dof_handler->n_dofs());
+
+  const unsigned int n_selected = selected_components.size();
+  dst.resize(point_to_row.size() * n_selected);
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(point_to_row.size()),
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int p = begin; p < end; ++p)
+        for (unsigned int c = 0; c < n_selected; ++c)
+          dst[p * n_selected + c] =
+            compute_row(std::size_t(point_to_row[p]) * n_selected + c, src);
+    },
+    128);
+}
+
+
+
+template <int n_components, int dim, int spacedim>
+unsigned int
+PointInterpolationOperator<n_components, dim, spacedim>::n_points() const
+{
+  if (remote_point_evaluation != nullptr)
+    return remote_point_evaluation->get_point_ptrs().size() - 1;
+  else
+    return point_to_row.size();
+}
+
+
+
+template <int n_components, int dim, int spacedim>
+unsigned int
+PointInterpolationOperator<n_components, dim, spacedim>::n_selected_components()
+  const
+{
+  return selected_components.size();
+}
+
+
+
+template <int n_components, int dim, int spacedim>
+bool
+PointInterpolationOperator<n_components, dim, spacedim>::dof_indices_changed()
+  const
+{
+  Assert(dof_handler != nullptr,
+         ExcMessage("PointInterpolationOperator::reinit() has not been "
+                    "called yet!"));
+
+  return dof_handler->n_dofs() != n_dofs ||
+         compute_dof_indices_hash() != dof_indices_hash;
+}
+
+
+
+template <int n_components, int dim, int spacedim>
+std::size_t
+PointInterpolationOperator<n_components, dim, spacedim>::n_nonzero_elements()
+  const
+{
+  return matrix_values.size();
+}
+
+
+
+template <int n_components, int dim, int spacedim>
+std::size_t
+PointInterpolationOperator<n_components, dim, spacedim>::memory_consumption()
+  const
+{
+  return sizeof(*this) +
+         MemoryConsumption::memory_consumption(selected_components) +
+         MemoryConsumption::memory_consumption(cell_levels_and_indices) +
+         MemoryConsumption::memory_consumption(point_to_row) +
+         MemoryConsumption::memory_consumption(row_ptrs) +
+         MemoryConsumption::memory_consumption(column_indices) +
+         MemoryConsumption::memory_consumption(matrix_values);
+}
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
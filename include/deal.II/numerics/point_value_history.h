@@ -35,10 +35,12 @@
 #include <deal.II/lac/vector.h>
 
 #include <deal.II/numerics/data_postprocessor.h>
+#include <deal.II/numerics/point_interpolation_operator.h>
 
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -115,11 +117,14 @@ namespace internal
  * point will most likely change slightly, making the interpretation of the
  * data difficult, hence this is not implemented currently.)
  *
- * <li> Secondly, @p evaluate_field_at_requested_location calls @p
- * VectorTools::point_value to compute values at the specific point requested.
- * This method is valid for any FE that is supported by @p
- * VectorTools::point_value. Specifically, this method can be called by codes
- * using adaptive mesh refinement.
+ * <li> Secondly, @p evaluate_field_at_requested_location computes values at
+ * the specific point requested, like @p VectorTools::point_value. This
+ * method is valid for any FE that is supported by @p
+ * VectorTools::point_value. The points are located and the shape functions
+ * are evaluated only once, by a PointInterpolationOperator that is reused
+ * for all subsequent calls until the triangulation or the degrees of
+ * freedom change. Specifically, this method can be called by codes using
+ * adaptive mesh refinement.
  *
  * <li>Finally, the class offers a function @p evaluate_field that takes a @p
  * DataPostprocessor object. This method allows the deal.II data postprocessor
@@ -378,8 +383,9 @@ public:
    * Extract values at the points actually requested from the VectorType
    * supplied and add them to the new dataset in vector_name. Unlike the other
    * evaluate_field methods this method does not care if the dof_handler has
-   * been modified because it uses calls to @p VectorTools::point_value to
-   * extract there data. Therefore, if only this method is used, the class is
+   * been modified because it locates the requested points anew after each
+   * change of the triangulation or of the number of degrees of freedom.
+   * Therefore, if only this method is used, the class is
    * fully compatible with adaptive refinement. The component_mask supplied
    * when the field was added is used to select components to extract. If a @p
    * DoFHandler is used, one (and only one) evaluate_field method must be
@@ -620,6 +626,16 @@ private:
     point_geometry_data;
 
 
+  /**
+   * The operators interpolating the components of the finite element
+   * selected for each mnemonic to the requested locations, set up on first
+   * use in evaluate_field_at_requested_location(). They are reset whenever
+   * the triangulation changes and set up anew when the degrees of freedom
+   * change.
+   */
+  std::map<std::string, std::unique_ptr<PointInterpolationOperator<1, dim>>>
+    interpolation_operators;
+
   /**
    * Used to enforce @p closed state for some methods.
    */
@@ -0,0 +1,310 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_particles_neighbor_search_h
+#define dealii_particles_neighbor_search_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/smartpointer.h>
+
+#include <deal.II/particles/particle_handler.h>
+#include <deal.II/particles/particle_iterator.h>
+
+#include <array>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Particles
+{
+  /**
+   * A class that finds, for each locally owned particle of a
+   * ParticleHandler, all particles within a given cutoff radius. This is
+   * the basic building block for short-range particle-particle interactions
+   * as they appear, e.g., in the discrete element method or in smoothed
+   * particle hydrodynamics.
+   *
+   * The particles are sorted into a uniform grid of bins whose size is at
+   * least the search radius (a so-called cell-linked list), such that the
+   * neighbors of a particle can only be located in the bin of the particle
+   * and the directly adjacent bins. The bins are built by a counting sort,
+   * and the neighbor lists of the particles are computed in parallel on the
+   * available threads. The bins are independent of the cells of the
+   * triangulation, so the cutoff radius may be smaller or larger than the
+   * cells.
+   *
+   * Besides the locally owned particles, the ghost particles of the
+   * ParticleHandler are also considered as neighbors, which allows the
+   * computation of interactions across the boundaries of the locally owned
+   * subdomain. To this end, ParticleHandler::exchange_ghost_particles()
+   * needs to be called before this class is set up, and the ghost layer of
+   * the triangulation needs to be at least as wide as the cutoff radius.
+   *
+   * <h3>Incremental updates</h3>
+   *
+   * If the particles only move by a small distance between two time steps,
+   * the acceleration structure does not need to be rebuilt: When setting
+   * up the object with a positive @p skin, a list of candidates within the
+   * radius `cutoff_radius + skin` is stored for each particle (a so-called
+   * Verlet list). As long as no particle has moved by more than half the
+   * skin since the candidates were computed, all neighbors within the
+   * cutoff radius are contained in the candidates, and update() only
+   * filters the candidates by their current distance. Otherwise, update()
+   * rebuilds the bins and candidate lists from scratch.
+   *
+   * update() can be used as long as the particles are only moved through
+   * ParticleAccessor::set_location() or ParticleHandler::
+   * set_particle_positions() followed by
+   * ParticleHandler::update_ghost_particles(). Functions that change the
+   * particle container, like
+   * ParticleHandler::sort_particles_into_subdomains_and_cells() or
+   * ParticleHandler::exchange_ghost_particles(), invalidate this object and
+   * require a call to reinit().
+   *
+   * The particles are identified by an index: The locally owned particles
+   * are numbered in the order in which they are visited from
+   * ParticleHandler::begin() to ParticleHandler::end(), followed by the ghost
+   * particles in the order from ParticleHandler::begin_ghost() to
+   * ParticleHandler::end_ghost().
+   */
+  template <int dim, int spacedim = dim>
+  class NeighborSearch
+  {
+  public:
+    /**
+     * Default constructor. Call reinit() before using the object.
+     */
+    NeighborSearch();
+
+    /**
+     * Constructor, which calls reinit() with the given arguments.
+     */
+    NeighborSearch(const ParticleHandler<dim, spacedim> &particle_handler,
+                   const double                          cutoff_radius,
+                   const double                          skin = 0.);
+
+    /**
+     * Build the bins and the neighbor lists for the particles currently
+     * stored in @p particle_handler.
+     *
+     * @param particle_handler The particles to search. The object keeps a
+     * pointer to it, so it needs to live longer than this object.
+     *
+     * @param cutoff_radius Two particles are neighbors if their distance is
+     * at most this radius.
+     *
+     * @param skin The additional distance for which candidates are stored to
+     * allow for cheap updates after small displacements of the particles, see
+     * the general documentation of this class.
+     */
+    void
+    reinit(const ParticleHandler<dim, spacedim> &particle_handler,
+           const double                          cutoff_radius,
+           const double                          skin = 0.);
+
+    /**
+     * Update the neighbor lists after the particles have moved. If no
+     * particle has moved by more than half of the skin since the candidate
+     * lists were computed, only the candidates are filtered by their current
+     * distance. Otherwise, all data structures are rebuilt.
+     *
+     * @return Whether the data structures were rebuilt.
+     */
+    bool
+    update();
+
+    /**
+     * Return the number of locally owned particles, i.e., the number of
+     * particles for which neighbor lists are available.
+     */
+    unsigned int
+    n_locally_owned_particles() const;
+
+    /**
+     * Return the number of particles that can appear as neighbors, i.e., the
+     * number of locally owned and ghost particles.
+     */
+    unsigned int
+    n_particles() const;
+
+    /**
+     * Return the particle with the given index, see the general
+     * documentation of this class for the numbering of the particles.
+     */
+    const ParticleIterator<dim, spacedim> &
+    get_particle(const unsigned int index) const;
+
+    /**
+     * Return the indices of all particles within the cutoff radius of the
+     * locally owned particle with index @p index, not including the particle
+     * itself, sorted in ascending order.
+     */
+    ArrayView<const unsigned int>
+    get_neighbors(const unsigned int index) const;
+
+    /**
+     * Return an estimate for the memory consumption, in bytes, of this
+     * object.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * Sort the particles into bins and compute the candidate lists.
+     */
+    void
+    build();
+
+    /**
+     * Compute the neighbor lists by filtering the candidate lists with the
+     * given positions of the particles.
+     */
+    void
+    filter_candidates(const std::vector<Point<spacedim>> &positions);
+
+    /**
+     * Return the bin index of a point in each coordinate direction.
+     */
+    std::array<unsigned int, spacedim>
+    get_bin(const Point<spacedim> &point) const;
+
+    /**
+     * The particles the neighbors are searched for.
+     */
+    SmartPointer<const ParticleHandler<dim, spacedim>,
+                 NeighborSearch<dim, spacedim>>
+      particle_handler;
+
+    /**
+     * The radius within which particles are neighbors.
+     */
+    double cutoff_radius;
+
+    /**
+     * The additional radius for which candidates are stored.
+     */
+    double skin;
+
+    /**
+     * The number of locally owned particles.
+     */
+    unsigned int n_owned_particles;
+
+    /**
+     * Iterators to all locally owned and ghost particles.
+     */
+    std::vector<ParticleIterator<dim, spacedim>> particles;
+
+    /**
+     * The positions of the particles at the time the candidate lists were
+     * computed.
+     */
+    std::vector<Point<spacedim>> positions_at_build;
+
+    /**
+     * The lower left corner of the grid of bins.
+     */
+    Point<spacedim> bin_origin;
+
+    /**
+     * The size of the bins in all directions.
+     */
+    double bin_size;
+
+    /**
+     * The number of bins in each coordinate direction.
+     */
+    std::array<unsigned int, spacedim> n_bins;
+
+    /**
+     * The position of the first particle of each bin in bin_particles, in
+     * compressed row storage.
+     */
+    std::vector<unsigned int> bin_start;
+
+    /**
+     * The indices of the particles sorted by bins.
+     */
+    std::vector<unsigned int> bin_particles;
+
+    /**
+     * The candidates within the radius `cutoff_radius + skin` of each locally
+     * owned particle, in compressed row storage.
+     */
+    std::vector<unsigned int> candidate_start;
+    std::vector<unsigned int> candidates;
+
+    /**
+     * The neighbors within the cutoff radius of each locally owned particle,
+     * in compressed row storage.
+     */
+    std::vector<unsigned int> neighbor_start;
+    std::vector<unsigned int> neighbors;
+  };
+
+
+
+  /* ---------------------- inline functions ------------------ */
+
+
+
+  template <int dim, int spacedim>
+  inline unsigned int
+  NeighborSearch<dim, spacedim>::n_locally_owned_particles() const
+  {
+    return n_owned_particles;
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline unsigned int
+  NeighborSearch<dim, spacedim>::n_particles() const
+  {
+    return particles.size();
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline const ParticleIterator<dim, spacedim> &
+  NeighborSearch<dim, spacedim>::get_particle(const unsigned int index) const
+  {
+    AssertIndexRange(index, particles.size());
+    return particles[index];
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline ArrayView<const unsigned int>
+  NeighborSearch<dim, spacedim>::get_neighbors(const unsigned int index) const
+  {
+    AssertIndexRange(index, n_owned_particles);
+    return ArrayView<const unsigned int>(neighbors.data() +
+                                           neighbor_start[index],
+                                         neighbor_start[index + 1] -
+                                           neighbor_start[index]);
+  }
+
+} // namespace Particles
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -713,6 +713,13 @@ namespace Particles
      * triggered whenever a particle is deleted, and the connected functions
      * are called passing an iterator to the particle in question, and its last
      * known cell association.
+     *
+     * The reference locations of the particles and the new cells of the
+     * particles that left their cell are computed in parallel on the
+     * available threads. Afterwards, the data of all particles is rearranged
+     * in the PropertyPool so that the particles of each cell are stored
+     * contiguously, in the order in which they are visited when looping over
+     * the cells.
      */
     void
     sort_particles_into_subdomains_and_cells();
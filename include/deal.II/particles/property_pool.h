@@ -230,7 +230,8 @@ namespace Particles
      * container. This makes sure memory access is contiguous with actual
      * memory location. Because the ordering is given in the input argument
      * the complexity of this function is $O(N)$ where $N$ is the number of
-     * elements in the input argument.
+     * elements in the input argument. The memory slots are copied in
+     * parallel.
      */
     void
     sort_memory_slots(const std::vector<Handle> &handles_to_sort);
@@ -1,6 +1,6 @@
 // ---------------------------------------------------------------------
 //
-// Copyright (C) 2020 - 2021 by the deal.II authors
+// Copyright (C) 2020 - 2023 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -19,6 +19,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/index_set.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/quadrature.h>
 
@@ -31,6 +32,9 @@
 
 #include <deal.II/lac/affine_constraints.h>
 #include <deal.II/lac/sparsity_pattern_base.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_point_evaluation.h>
 
 #include <deal.II/particles/particle_handler.h>
 
@@ -41,6 +45,44 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace Particles
 {
+  namespace internal
+  {
+    /**
+     * Collect the cells that contain locally owned particles of
+     * @p particle_handler, in the order in which the particles are visited
+     * by ParticleHandler::begin() to ParticleHandler::end(), together with
+     * the position of the first particle of each cell in this order. The
+     * last entry of @p particle_offsets is the number of locally owned
+     * particles.
+     */
+    template <int dim, int spacedim>
+    void
+    collect_cells_with_particles(
+      const Particles::ParticleHandler<dim, spacedim> &particle_handler,
+      std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+        &                        cells,
+      std::vector<unsigned int> &particle_offsets)
+    {
+      cells.clear();
+      particle_offsets.assign(1, 0);
+
+      auto particle = particle_handler.begin();
+      while (particle != particle_handler.end())
+        {
+          const auto cell = particle->get_surrounding_cell();
+          const auto pic  = particle_handler.particles_in_cell(cell);
+          Assert(pic.begin() == particle, ExcInternalError());
+
+          cells.push_back(cell);
+          particle_offsets.push_back(particle_offsets.back() +
+                                     particle_handler.n_particles_in_cell(cell));
+          particle = pic.end();
+        }
+    }
+  } // namespace internal
+
+
+
   /**
    * A namespace for functions offering tools to handle ParticleHandler objects
    * and their coupling with DoFHandler objects.
@@ -248,6 +290,233 @@ namespace Particles
       interpolated_field.compress(VectorOperation::add);
     }
 
+
+
+    /**
+     * Evaluate a finite element field at the positions of all locally owned
+     * particles of @p particle_handler.
+     *
+     * The particles are visited cell by cell, and the field is evaluated for
+     * all particles of a cell at once by an FEPointEvaluation object, which
+     * groups the reference locations of the particles into the lanes of
+     * VectorizedArray. The cells are distributed to the available threads.
+     *
+     * @param[in] mapping The mapping describing the geometry of the cells.
+     *
+     * @param[in] dof_handler The DoFHandler the field is defined on. Only
+     * one finite element is supported.
+     *
+     * @param[in] field_vector The vector of the field to be evaluated. For
+     * parallel vectors, the ghost values must be up to date.
+     *
+     * @param[in] particle_handler The particle handler whose particles serve
+     * as evaluation points.
+     *
+     * @param[out] values The values of the field at the particles, in the
+     * order in which the locally owned particles are visited by
+     * ParticleHandler::begin() to ParticleHandler::end(). The vector is
+     * resized to the number of locally owned particles.
+     *
+     * @param[out] gradients The gradients of the field at the particles, in
+     * the same order as @p values. Only filled if @p evaluation_flags
+     * contains EvaluationFlags::gradients, otherwise left untouched.
+     *
+     * @param[in] evaluation_flags Which quantities to compute.
+     *
+     * @param[in] first_selected_component The first of the @p n_components
+     * components of the finite element that are evaluated.
+     */
+    template <int n_components, int dim, typename VectorType>
+    void
+    evaluate_field_at_particles(
+      const Mapping<dim> &                     mapping,
+      const DoFHandler<dim> &                  dof_handler,
+      const VectorType &                       field_vector,
+      const Particles::ParticleHandler<dim> &  particle_handler,
+      std::vector<typename FEPointEvaluation<n_components,
+                                             dim,
+                                             dim,
+                                             typename VectorType::value_type>::
+                    value_type> &              values,
+      std::vector<typename FEPointEvaluation<n_components,
+                                             dim,
+                                             dim,
+                                             typename VectorType::value_type>::
+                    gradient_type> &           gradients,
+      const EvaluationFlags::EvaluationFlags evaluation_flags =
+        EvaluationFlags::values,
+      const unsigned int first_selected_component = 0)
+    {
+      using Number = typename VectorType::value_type;
+
+      Assert(dof_handler.has_hp_capabilities() == false,
+             ExcNotImplemented());
+
+      std::vector<typename Triangulation<dim>::active_cell_iterator> cells;
+      std::vector<unsigned int> particle_offsets;
+      internal::collect_cells_with_particles(particle_handler,
+                                             cells,
+                                             particle_offsets);
+
+      values.resize(particle_offsets.back());
+      if (evaluation_flags & EvaluationFlags::gradients)
+        gradients.resize(particle_offsets.back());
+
+      UpdateFlags update_flags = update_default;
+      if (evaluation_flags & EvaluationFlags::values)
+        update_flags |= update_values;
+      if (evaluation_flags & EvaluationFlags::gradients)
+        update_flags |= update_gradients;
+
+      parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(cells.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          FEPointEvaluation<n_components, dim, dim, Number> evaluator(
+            mapping,
+            dof_handler.get_fe(),
+            update_flags,
+            first_selected_component);
+          std::vector<Number> local_values(
+            dof_handler.get_fe().n_dofs_per_cell());
+          std::vector<Point<dim>> unit_points;
+
+          for (unsigned int c = begin; c < end; ++c)
+            {
+              unit_points.clear();
+              for (const auto &particle :
+                   particle_handler.particles_in_cell(cells[c]))
+                unit_points.push_back(particle.get_reference_location());
+
+              const typename DoFHandler<dim>::cell_iterator dof_cell(
+                *cells[c], &dof_handler);
+              dof_cell->get_dof_values(field_vector,
+                                       local_values.begin(),
+                                       local_values.end());
+
+              evaluator.reinit(cells[c], unit_points);
+              evaluator.evaluate(local_values, evaluation_flags);
+
+              for (unsigned int q = 0; q < unit_points.size(); ++q)
+                {
+                  if (evaluation_flags & EvaluationFlags::values)
+                    values[particle_offsets[c] + q] = evaluator.get_value(q);
+                  if (evaluation_flags & EvaluationFlags::gradients)
+                    gradients[particle_offsets[c] + q] =
+                      evaluator.get_gradient(q);
+                }
+            }
+        },
+        16);
+    }
+
+
+
+    /**
+     * Integrate values given at the positions of all locally owned particles
+     * of @p particle_handler against the test functions of a finite element
+     * space, i.e., compute the vector
+     * \f[
+     * v_j \dealcoloneq \sum_i \varphi_j(x_i) \cdot f_i,
+     * \f]
+     * where $x_i$ is the position of particle $i$ and $f_i$ the value given
+     * for it. This is the transpose of evaluate_field_at_particles() and can
+     * be used to deposit quantities carried by particles onto the mesh.
+     *
+     * The cell contributions are computed on the available threads, using
+     * one FEPointEvaluation call per cell for all of its particles, and then
+     * added to @p dst through
+     * AffineConstraints::distribute_local_to_global(). The contributions
+     * are added to the current content of @p dst, and
+     * `dst.compress(VectorOperation::add)` is called at the end.
+     *
+     * @param[in] values The values at the particles, in the order in which
+     * the locally owned particles are visited by ParticleHandler::begin() to
+     * ParticleHandler::end().
+     */
+    template <int n_components, int dim, typename VectorType>
+    void
+    integrate_field_from_particles(
+      const Mapping<dim> &                    mapping,
+      const DoFHandler<dim> &                 dof_handler,
+      const Particles::ParticleHandler<dim> & particle_handler,
+      const std::vector<
+        typename FEPointEvaluation<n_components,
+                                   dim,
+                                   dim,
+                                   typename VectorType::value_type>::
+          value_type> &                       values,
+      VectorType &                            dst,
+      const AffineConstraints<typename VectorType::value_type> &constraints =
+        AffineConstraints<typename VectorType::value_type>(),
+      const unsigned int first_selected_component = 0)
+    {
+      using Number = typename VectorType::value_type;
+
+      Assert(dof_handler.has_hp_capabilities() == false,
+             ExcNotImplemented());
+
+      std::vector<typename Triangulation<dim>::active_cell_iterator> cells;
+      std::vector<unsigned int> particle_offsets;
+      internal::collect_cells_with_particles(particle_handler,
+                                             cells,
+                                             particle_offsets);
+      AssertDimension(values.size(), particle_offsets.back());
+
+      // Compute the contributions of all cells in parallel and only add them
+      // to the global vector afterwards, since the cells share degrees of
+      // freedom
+      const unsigned int dofs_per_cell = dof_handler.get_fe().n_dofs_per_cell();
+      std::vector<Number> cell_contributions(cells.size() * dofs_per_cell);
+
+      parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(cells.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          FEPointEvaluation<n_components, dim, dim, Number> evaluator(
+            mapping,
+            dof_handler.get_fe(),
+            update_values,
+            first_selected_component);
+          std::vector<Point<dim>> unit_points;
+
+          for (unsigned int c = begin; c < end; ++c)
+            {
+              unit_points.clear();
+              for (const auto &particle :
+                   particle_handler.particles_in_cell(cells[c]))
+                unit_points.push_back(particle.get_reference_location());
+
+              evaluator.reinit(cells[c], unit_points);
+              for (unsigned int q = 0; q < unit_points.size(); ++q)
+                evaluator.submit_value(values[particle_offsets[c] + q], q);
+              evaluator.integrate(
+                make_array_view(cell_contributions.begin() +
+                                  c * dofs_per_cell,
+                                cell_contributions.begin() +
+                                  (c + 1) * dofs_per_cell),
+                EvaluationFlags::values);
+            }
+        },
+        16);
+
+      Vector<Number>                       local_contribution(dofs_per_cell);
+      std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+      for (unsigned int c = 0; c < cells.size(); ++c)
+        {
+          const typename DoFHandler<dim>::cell_iterator dof_cell(*cells[c],
+                                                                 &dof_handler);
+          dof_cell->get_dof_indices(dof_indices);
+          std::copy(cell_contributions.begin() + c * dofs_per_cell,
+                    cell_contributions.begin() + (c + 1) * dofs_per_cell,
+                    local_contribution.begin());
+          constraints.distribute_local_to_global(local_contribution,
+                                                 dof_indices,
+                                                 dst);
+        }
+      dst.compress(VectorOperation::add);
+    }
+
   } // namespace Utilities
 } // namespace Particles
 DEAL_II_NAMESPACE_CLOSE
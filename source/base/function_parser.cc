@@ -107,6 +107,54 @@ FunctionParser<dim>::value(const Point<dim> & p,
   return this->do_value(p, this->get_time(), component);
 }
 
+
+
+template <int dim>
+void
+FunctionParser<dim>::vector_value(const Point<dim> &p,
+                                  Vector<double> &  values) const
+{
+  AssertDimension(values.size(), this->n_components);
+  ArrayView<double> values_view(values.begin(), values.size());
+  this->do_all_values(p, this->get_time(), values_view);
+}
+
+
+
+template <int dim>
+void
+FunctionParser<dim>::value_list(const std::vector<Point<dim>> &points,
+                                std::vector<double> &          values,
+                                const unsigned int             component) const
+{
+  AssertDimension(values.size(), points.size());
+  this->do_value_list(make_array_view(points),
+                      this->get_time(),
+                      component,
+                      make_array_view(values));
+}
+
+
+
+template <int dim>
+void
+FunctionParser<dim>::vector_value_list(
+  const std::vector<Point<dim>> &points,
+  std::vector<Vector<double>> &  values) const
+{
+  AssertDimension(values.size(), points.size());
+  std::vector<double> all_values(points.size() * this->n_components);
+  this->do_all_values_list(make_array_view(points),
+                           this->get_time(),
+                           make_array_view(all_values));
+  for (unsigned int q = 0; q < points.size(); ++q)
+    {
+      AssertDimension(values[q].size(), this->n_components);
+      for (unsigned int c = 0; c < this->n_components; ++c)
+        values[q][c] = all_values[q * this->n_components + c];
+    }
+}
+
 // Explicit Instantiations.
 
 template class FunctionParser<1>;
@@ -136,6 +136,55 @@ namespace Functions
 
 
 
+  template <int dim>
+  void
+  CoordinateRestriction<dim>::value_list(const std::vector<Point<dim>> &points,
+                                         std::vector<double> &          values,
+                                         const unsigned int component) const
+  {
+    AssertDimension(points.size(), values.size());
+
+    std::vector<Point<dim + 1>> full_points(points.size());
+    for (unsigned int i = 0; i < points.size(); ++i)
+      full_points[i] = internal::create_higher_dim_point(points[i],
+                                                         restricted_direction,
+                                                         coordinate_value);
+
+    function->value_list(full_points, values, component);
+  }
+
+
+
+  template <int dim>
+  void
+  CoordinateRestriction<dim>::gradient_list(
+    const std::vector<Point<dim>> &points,
+    std::vector<Tensor<1, dim>> &  gradients,
+    const unsigned int             component) const
+  {
+    AssertDimension(points.size(), gradients.size());
+
+    std::vector<Point<dim + 1>> full_points(points.size());
+    for (unsigned int i = 0; i < points.size(); ++i)
+      full_points[i] = internal::create_higher_dim_point(points[i],
+                                                         restricted_direction,
+                                                         coordinate_value);
+
+    std::vector<Tensor<1, dim + 1>> full_gradients(points.size());
+    function->gradient_list(full_points, full_gradients, component);
+
+    for (unsigned int i = 0; i < points.size(); ++i)
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          const unsigned int index_to_write_from =
+            internal::coordinate_to_one_dim_higher<dim>(restricted_direction,
+                                                        d);
+          gradients[i][d] = full_gradients[i][index_to_write_from];
+        }
+  }
+
+
+
   template <int dim>
   PointRestriction<dim>::PointRestriction(const Function<dim + 1> &function,
                                           const unsigned int open_direction,
@@ -199,6 +248,48 @@ namespace Functions
 
 
 
+  template <int dim>
+  void
+  PointRestriction<dim>::value_list(const std::vector<Point<1>> &points_1D,
+                                    std::vector<double> &        values,
+                                    const unsigned int component) const
+  {
+    AssertDimension(points_1D.size(), values.size());
+
+    std::vector<Point<dim + 1>> full_points(points_1D.size());
+    for (unsigned int i = 0; i < points_1D.size(); ++i)
+      full_points[i] = internal::create_higher_dim_point(point,
+                                                         open_direction,
+                                                         points_1D[i](0));
+
+    function->value_list(full_points, values, component);
+  }
+
+
+
+  template <int dim>
+  void
+  PointRestriction<dim>::gradient_list(const std::vector<Point<1>> &points_1D,
+                                       std::vector<Tensor<1, 1>> &  gradients,
+                                       const unsigned int component) const
+  {
+    AssertDimension(points_1D.size(), gradients.size());
+
+    std::vector<Point<dim + 1>> full_points(points_1D.size());
+    for (unsigned int i = 0; i < points_1D.size(); ++i)
+      full_points[i] = internal::create_higher_dim_point(point,
+                                                         open_direction,
+                                                         points_1D[i](0));
+
+    std::vector<Tensor<1, dim + 1>> full_gradients(points_1D.size());
+    function->gradient_list(full_points, full_gradients, component);
+
+    for (unsigned int i = 0; i < points_1D.size(); ++i)
+      gradients[i][0] = full_gradients[i][open_direction];
+  }
+
+
+
 } // namespace Functions
 #include "function_restriction.inst"
 DEAL_II_NAMESPACE_CLOSE
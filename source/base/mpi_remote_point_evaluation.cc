@@ -1,6 +1,6 @@
 // ---------------------------------------------------------------------
 //
-// Copyright (C) 2021 - 2022 by the deal.II authors
+// Copyright (C) 2021 - 2023 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -28,6 +28,10 @@
 #include <deal.II/grid/grid_tools_cache.h>
 #include <deal.II/grid/tria.h>
 
+#include <algorithm>
+#include <limits>
+#include <map>
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -35,6 +39,51 @@ namespace Utilities
 {
   namespace MPI
   {
+    namespace
+    {
+      /**
+       * Locate the given points among the locally owned cells of all
+       * processes and set up the communication pattern for them.
+       */
+      template <int dim, int spacedim>
+      GridTools::internal::DistributedComputePointLocationsInternal<dim,
+                                                                    spacedim>
+      compute_point_locations(
+        const std::vector<Point<spacedim>> &      points,
+        const Triangulation<dim, spacedim> &      tria,
+        const Mapping<dim, spacedim> &            mapping,
+        const double                              tolerance,
+        const bool                                enforce_unique_mapping,
+        const unsigned int                        rtree_level,
+        const std::function<std::vector<bool>()> &marked_vertices)
+      {
+        std::vector<BoundingBox<spacedim>> local_boxes;
+        for (const auto &cell :
+             tria.active_cell_iterators() | IteratorFilters::LocallyOwnedCell())
+          local_boxes.push_back(mapping.get_bounding_box(cell));
+
+        // create r-tree of bounding boxes
+        const auto local_tree = pack_rtree(local_boxes);
+
+        // compress r-tree to a minimal set of bounding boxes
+        std::vector<std::vector<BoundingBox<spacedim>>> global_bboxes(1);
+        global_bboxes[0] = extract_rtree_level(local_tree, rtree_level);
+
+        const GridTools::Cache<dim, spacedim> cache(tria, mapping);
+
+        return GridTools::internal::distributed_compute_point_locations(
+          cache,
+          points,
+          global_bboxes,
+          marked_vertices ? marked_vertices() : std::vector<bool>(),
+          tolerance,
+          true,
+          enforce_unique_mapping);
+      }
+    } // namespace
+
+
+
     template <int dim, int spacedim>
     RemotePointEvaluation<dim, spacedim>::RemotePointEvaluation(
       const double                              tolerance,
@@ -46,6 +95,7 @@ namespace Utilities
       , rtree_level(rtree_level)
       , marked_vertices(marked_vertices)
       , ready_flag(false)
+      , persistent_requests_entry_size(0)
     {}
 
 
@@ -55,6 +105,8 @@ namespace Utilities
     {
       if (tria_signal.connected())
         tria_signal.disconnect();
+
+      clear_persistent_requests();
     }
 
 
@@ -75,35 +127,22 @@ namespace Utilities
       if (tria_signal.connected())
         tria_signal.disconnect();
 
+      // the communication pattern changes, so do the persistent requests
+      clear_persistent_requests();
+
       tria_signal =
         tria.signals.any_change.connect([&]() { this->ready_flag = false; });
 
       this->tria    = &tria;
       this->mapping = &mapping;
 
-      std::vector<BoundingBox<spacedim>> local_boxes;
-      for (const auto &cell :
-           tria.active_cell_iterators() | IteratorFilters::LocallyOwnedCell())
-        local_boxes.push_back(mapping.get_bounding_box(cell));
-
-      // create r-tree of bounding boxes
-      const auto local_tree = pack_rtree(local_boxes);
-
-      // compress r-tree to a minimal set of bounding boxes
-      std::vector<std::vector<BoundingBox<spacedim>>> global_bboxes(1);
-      global_bboxes[0] = extract_rtree_level(local_tree, rtree_level);
-
-      const GridTools::Cache<dim, spacedim> cache(tria, mapping);
-
-      const auto data =
-        GridTools::internal::distributed_compute_point_locations(
-          cache,
-          points,
-          global_bboxes,
-          marked_vertices ? marked_vertices() : std::vector<bool>(),
-          tolerance,
-          true,
-          enforce_unique_mapping);
+      const auto data = compute_point_locations(points,
+                                                tria,
+                                                mapping,
+                                                tolerance,
+                                                enforce_unique_mapping,
+                                                rtree_level,
+                                                marked_vertices);
 
       this->recv_ranks = data.recv_ranks;
       this->recv_ptrs  = data.recv_ptrs;
@@ -125,27 +164,61 @@ namespace Utilities
           this->point_ptrs[std::get<1>(data.recv_components[i]) + 1]++;
         }
 
+      for (unsigned int i = 0; i < points.size(); ++i)
+        this->point_ptrs[i + 1] += this->point_ptrs[i];
+
+      update_mapping_flags();
+
+      cell_data        = {};
+      send_permutation = {};
+
+      std::pair<int, int> dummy{-1, -1};
+      for (const auto &i : data.send_components)
+        {
+          if (dummy != std::get<0>(i))
+            {
+              dummy = std::get<0>(i);
+              cell_data.cells.emplace_back(dummy);
+              cell_data.reference_point_ptrs.emplace_back(
+                cell_data.reference_point_values.size());
+            }
+
+          cell_data.reference_point_values.emplace_back(std::get<3>(i));
+          send_permutation.emplace_back(std::get<5>(i));
+        }
+
+      cell_data.reference_point_ptrs.emplace_back(
+        cell_data.reference_point_values.size());
+
+      this->ready_flag = true;
+#endif
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    RemotePointEvaluation<dim, spacedim>::update_mapping_flags()
+    {
       std::tuple<unsigned int, unsigned int> n_owning_processes_default{
         numbers::invalid_unsigned_int, 0};
       std::tuple<unsigned int, unsigned int> n_owning_processes_local =
         n_owning_processes_default;
 
-      for (unsigned int i = 0; i < points.size(); ++i)
+      for (unsigned int i = 0; i + 1 < point_ptrs.size(); ++i)
         {
           std::get<0>(n_owning_processes_local) =
             std::min(std::get<0>(n_owning_processes_local),
-                     this->point_ptrs[i + 1]);
+                     point_ptrs[i + 1] - point_ptrs[i]);
           std::get<1>(n_owning_processes_local) =
             std::max(std::get<1>(n_owning_processes_local),
-                     this->point_ptrs[i + 1]);
-
-          this->point_ptrs[i + 1] += this->point_ptrs[i];
+                     point_ptrs[i + 1] - point_ptrs[i]);
         }
 
       const auto n_owning_processes_global =
         Utilities::MPI::all_reduce<std::tuple<unsigned int, unsigned int>>(
           n_owning_processes_local,
-          tria.get_communicator(),
+          tria->get_communicator(),
           [&](const auto &a,
               const auto &b) -> std::tuple<unsigned int, unsigned int> {
             if (a == n_owning_processes_default)
@@ -173,30 +246,318 @@ namespace Utilities
 
       Assert(enforce_unique_mapping == false || unique_mapping,
              ExcInternalError());
+    }
 
-      cell_data        = {};
-      send_permutation = {};
 
-      std::pair<int, int> dummy{-1, -1};
-      for (const auto &i : data.send_components)
-        {
-          if (dummy != std::get<0>(i))
+
+    template <int dim, int spacedim>
+    bool
+    RemotePointEvaluation<dim, spacedim>::update_points(
+      const std::vector<Point<spacedim>> &points)
+    {
+#ifndef DEAL_II_WITH_MPI
+      Assert(false, ExcNeedsMPI());
+      (void)points;
+      return false;
+#else
+      Assert(is_ready(),
+             ExcMessage("The function update_points() can only be called "
+                        "after reinit() and as long as the triangulation "
+                        "has not changed."));
+      AssertDimension(points.size(), point_ptrs.size() - 1);
+
+      // Send the new positions to the processes owning the cells the points
+      // were found in, and compute the new reference positions there.
+      std::vector<Point<dim>> new_reference_points(
+        cell_data.reference_point_values.size());
+      std::vector<unsigned int> entry_is_inside(
+        cell_data.reference_point_values.size(), 1);
+
+      std::vector<Point<spacedim>> buffer;
+      this->process_and_evaluate<Point<spacedim>>(
+        points,
+        buffer,
+        [&](const ArrayView<const Point<spacedim>> &values,
+            const CellData &                        cell_data) {
+          for (unsigned int i = 0; i < cell_data.cells.size(); ++i)
             {
-              dummy = std::get<0>(i);
-              cell_data.cells.emplace_back(dummy);
-              cell_data.reference_point_ptrs.emplace_back(
-                cell_data.reference_point_values.size());
+              const typename Triangulation<dim, spacedim>::active_cell_iterator
+                cell(&*tria,
+                     cell_data.cells[i].first,
+                     cell_data.cells[i].second);
+
+              const unsigned int begin = cell_data.reference_point_ptrs[i];
+              const unsigned int n_points =
+                cell_data.reference_point_ptrs[i + 1] - begin;
+
+              mapping->transform_points_real_to_unit_cell(
+                cell,
+                ArrayView<const Point<spacedim>>(values.data() + begin,
+                                                 n_points),
+                ArrayView<Point<dim>>(new_reference_points.data() + begin,
+                                      n_points));
+
+              for (unsigned int q = begin; q < begin + n_points; ++q)
+                if (new_reference_points[q][0] ==
+                      std::numeric_limits<double>::infinity() ||
+                    !cell->reference_cell().contains_point(
+                      new_reference_points[q], tolerance))
+                  entry_is_inside[q] = 0;
             }
-
-          cell_data.reference_point_values.emplace_back(std::get<3>(i));
-          send_permutation.emplace_back(std::get<5>(i));
+        });
+
+      // Points that have not been found before might have moved into the
+      // domain, so they need to be located anew as well.
+      const bool pattern_is_valid =
+        all_points_found_flag &&
+        std::find(entry_is_inside.begin(), entry_is_inside.end(), 0U) ==
+          entry_is_inside.end();
+      if (Utilities::MPI::min(pattern_is_valid ? 1 : 0,
+                              tria->get_communicator()) == 1)
+        {
+          cell_data.reference_point_values = std::move(new_reference_points);
+          return true;
         }
 
-      cell_data.reference_point_ptrs.emplace_back(
-        cell_data.reference_point_values.size());
+      // Tell the processes that requested the points which of the entries
+      // are still valid. The entries of cells that do not contain their
+      // point anymore are dropped. The points left without any entry are
+      // located anew.
+      std::vector<unsigned int> entry_is_kept, buffer_kept;
+      this->evaluate_and_process<unsigned int>(
+        entry_is_kept,
+        buffer_kept,
+        [&](const ArrayView<unsigned int> &values, const CellData &) {
+          for (unsigned int q = 0; q < values.size(); ++q)
+            values[q] = entry_is_inside[q];
+        });
+
+      const unsigned int           n_points = points.size();
+      std::vector<unsigned int>    moved_points;
+      std::vector<Point<spacedim>> moved_positions;
+      for (unsigned int i = 0; i < n_points; ++i)
+        if (std::find(entry_is_kept.begin() + point_ptrs[i],
+                      entry_is_kept.begin() + point_ptrs[i + 1],
+                      1U) == entry_is_kept.begin() + point_ptrs[i + 1])
+          {
+            moved_points.push_back(i);
+            moved_positions.push_back(points[i]);
+          }
+
+      const auto data = compute_point_locations(moved_positions,
+                                                *tria,
+                                                *mapping,
+                                                tolerance,
+                                                enforce_unique_mapping,
+                                                rtree_level,
+                                                marked_vertices);
+
+      // Merge the kept entries and the new ones into a single communication
+      // pattern. For each pair of processes, the kept entries come first, in
+      // their previous order, followed by the new entries in the order of
+      // the new pattern. Both the sending and the receiving process know
+      // which entries are kept, so they agree on the order.
+      const auto rank_of_position = [](const std::vector<unsigned int> &ranks,
+                                       const std::vector<unsigned int> &ptrs) {
+        std::vector<unsigned int> result(ptrs.empty() ? 0 : ptrs.back());
+        for (unsigned int j = 0; j < ranks.size(); ++j)
+          for (unsigned int p = ptrs[j]; p < ptrs[j + 1]; ++p)
+            result[p] = ranks[j];
+        return result;
+      };
+
+      const auto set_up_ranks =
+        [](const std::map<unsigned int, unsigned int> &n_kept,
+           const std::map<unsigned int, unsigned int> &n_new,
+           std::vector<unsigned int> &                 ranks,
+           std::vector<unsigned int> &                 ptrs,
+           std::map<unsigned int, unsigned int> &      offsets) {
+          std::map<unsigned int, unsigned int> n_entries = n_kept;
+          for (const auto &entry : n_new)
+            n_entries[entry.first] += entry.second;
+
+          ranks.clear();
+          ptrs.assign(1, 0);
+          offsets.clear();
+          for (const auto &entry : n_entries)
+            if (entry.second > 0)
+              {
+                offsets[entry.first] = ptrs.back();
+                ranks.push_back(entry.first);
+                ptrs.push_back(ptrs.back() + entry.second);
+              }
+        };
+
+      // ... on the side of the processes owning the cells
+      {
+        const std::vector<unsigned int> old_rank =
+          rank_of_position(send_ranks, send_ptrs);
+        const std::vector<unsigned int> new_rank =
+          rank_of_position(data.send_ranks, data.send_ptrs);
+
+        std::vector<unsigned int> old_entry_at_position(old_rank.size());
+        for (unsigned int k = 0; k < send_permutation.size(); ++k)
+          old_entry_at_position[send_permutation[k]] = k;
+
+        std::map<unsigned int, unsigned int> n_kept, n_new;
+        std::vector<unsigned int>            kept_index(
+          send_permutation.size(), numbers::invalid_unsigned_int);
+        for (unsigned int p = 0; p < old_rank.size(); ++p)
+          if (entry_is_inside[old_entry_at_position[p]])
+            kept_index[old_entry_at_position[p]] = n_kept[old_rank[p]]++;
+        for (const unsigned int rank : new_rank)
+          ++n_new[rank];
+
+        std::map<unsigned int, unsigned int> offsets;
+        set_up_ranks(n_kept, n_new, send_ranks, send_ptrs, offsets);
+
+        // cell, reference point, and position in the send buffer
+        std::vector<std::tuple<std::pair<int, int>, Point<dim>, unsigned int>>
+          entries;
+        for (unsigned int i = 0; i < cell_data.cells.size(); ++i)
+          for (unsigned int k = cell_data.reference_point_ptrs[i];
+               k < cell_data.reference_point_ptrs[i + 1];
+               ++k)
+            if (kept_index[k] != numbers::invalid_unsigned_int)
+              entries.emplace_back(
+                cell_data.cells[i],
+                new_reference_points[k],
+                offsets[old_rank[send_permutation[k]]] + kept_index[k]);
+        for (const auto &component : data.send_components)
+          {
+            const unsigned int p    = std::get<5>(component);
+            const unsigned int rank = new_rank[p];
+            const unsigned int j =
+              std::find(data.send_ranks.begin(), data.send_ranks.end(), rank) -
+              data.send_ranks.begin();
+            entries.emplace_back(std::get<0>(component),
+                                 std::get<3>(component),
+                                 offsets[rank] + n_kept[rank] + p -
+                                   data.send_ptrs[j]);
+          }
+
+        std::stable_sort(entries.begin(),
+                         entries.end(),
+                         [](const auto &a, const auto &b) {
+                           return std::get<0>(a) < std::get<0>(b);
+                         });
+
+        cell_data        = {};
+        send_permutation = {};
+        for (unsigned int e = 0; e < entries.size(); ++e)
+          {
+            if (e == 0 ||
+                std::get<0>(entries[e]) != std::get<0>(entries[e - 1]))
+              {
+                cell_data.cells.emplace_back(std::get<0>(entries[e]));
+                cell_data.reference_point_ptrs.emplace_back(e);
+              }
+            cell_data.reference_point_values.emplace_back(
+              std::get<1>(entries[e]));
+            send_permutation.emplace_back(std::get<2>(entries[e]));
+          }
+        cell_data.reference_point_ptrs.emplace_back(entries.size());
+      }
+
+      // ... and on the side of the processes that requested the points
+      {
+        const std::vector<unsigned int> old_rank =
+          rank_of_position(recv_ranks, recv_ptrs);
+        const std::vector<unsigned int> new_rank =
+          rank_of_position(data.recv_ranks, data.recv_ptrs);
+
+        std::vector<unsigned int> old_position_of_entry(old_rank.size());
+        for (unsigned int p = 0; p < recv_permutation.size(); ++p)
+          old_position_of_entry[recv_permutation[p]] = p;
+
+        std::map<unsigned int, unsigned int> n_kept, n_new;
+        std::vector<unsigned int>            kept_index(
+          old_rank.size(), numbers::invalid_unsigned_int);
+        for (unsigned int p = 0; p < old_rank.size(); ++p)
+          if (entry_is_kept[recv_permutation[p]] == 1)
+            kept_index[p] = n_kept[old_rank[p]]++;
+        for (const unsigned int rank : new_rank)
+          ++n_new[rank];
+
+        std::map<unsigned int, unsigned int> offsets;
+        set_up_ranks(n_kept, n_new, recv_ranks, recv_ptrs, offsets);
+
+        // the new entries are sorted by the index of the moved points
+        std::vector<unsigned int> positions;
+        std::vector<unsigned int> new_point_ptrs(n_points + 1, 0);
+        auto component = data.recv_components.begin();
+        for (unsigned int i = 0, m = 0; i < n_points; ++i)
+          {
+            if (m < moved_points.size() && moved_points[m] == i)
+              {
+                for (; component != data.recv_components.end() &&
+                       std::get<1>(*component) == m;
+                     ++component)
+                  {
+                    const unsigned int p    = std::get<2>(*component);
+                    const unsigned int rank = new_rank[p];
+                    const unsigned int j =
+                      std::find(data.recv_ranks.begin(),
+                                data.recv_ranks.end(),
+                                rank) -
+                      data.recv_ranks.begin();
+                    positions.push_back(offsets[rank] + n_kept[rank] + p -
+                                        data.recv_ptrs[j]);
+                  }
+                ++m;
+              }
+            else
+              for (unsigned int e = point_ptrs[i]; e < point_ptrs[i + 1]; ++e)
+                {
+                  const unsigned int p = old_position_of_entry[e];
+                  if (kept_index[p] != numbers::invalid_unsigned_int)
+                    positions.push_back(offsets[old_rank[p]] + kept_index[p]);
+                }
+            new_point_ptrs[i + 1] = positions.size();
+          }
+
+        point_ptrs = std::move(new_point_ptrs);
+        recv_permutation.resize(positions.size());
+        for (unsigned int e = 0; e < positions.size(); ++e)
+          recv_permutation[positions[e]] = e;
+      }
+
+      update_mapping_flags();
+
+      // the communication pattern has changed, so the persistent requests
+      // need to be set up again
+      clear_persistent_requests();
+
+      return false;
+#endif
+    }
 
-      this->ready_flag = true;
+
+
+    template <int dim, int spacedim>
+    void
+    RemotePointEvaluation<dim, spacedim>::clear_persistent_requests() const
+    {
+#ifdef DEAL_II_WITH_MPI
+      if (Utilities::MPI::job_supports_mpi())
+        {
+          for (auto &request : persistent_send_requests)
+            {
+              const int ierr = MPI_Request_free(&request);
+              AssertThrowMPI(ierr);
+            }
+          for (auto &request : persistent_recv_requests)
+            {
+              const int ierr = MPI_Request_free(&request);
+              AssertThrowMPI(ierr);
+            }
+        }
 #endif
+      persistent_send_requests.clear();
+      persistent_recv_requests.clear();
+      persistent_send_buffer.clear();
+      persistent_recv_buffer.clear();
+      persistent_requests_entry_size = 0;
     }
 
 
@@ -474,6 +474,117 @@ namespace internal
 #endif
     }
 
+    template <int dim, typename Number>
+    void
+    ParserImplementation<dim, Number>::do_value_list(
+      const ArrayView<const Point<dim>> &points,
+      const double                       time,
+      const unsigned int                 component,
+      const ArrayView<Number> &          values) const
+    {
+#ifdef DEAL_II_WITH_MUPARSER
+      Assert(this->initialized == true, ExcNotInitialized());
+      AssertDimension(values.size(), points.size());
+
+      // look up the thread-local parser objects only once for all points,
+      // which is considerably more expensive than evaluating the byte code
+      // of simple expressions
+      internal::FunctionParser::ParserData &data = this->parser_data.get();
+      if (data.vars.size() == 0)
+        init_muparser();
+      AssertIndexRange(component, data.parsers.size());
+
+      if (dim != this->n_vars)
+        data.vars[dim] = time;
+
+      try
+        {
+          Assert(dynamic_cast<Parser *>(data.parsers[component].get()),
+                 ExcInternalError());
+          // NOLINTNEXTLINE don't warn about using static_cast once we check
+          mu::Parser &parser = static_cast<Parser &>(*data.parsers[component]);
+          for (unsigned int q = 0; q < points.size(); ++q)
+            {
+              for (unsigned int i = 0; i < dim; ++i)
+                data.vars[i] = points[q][i];
+              values[q] = parser.Eval();
+            }
+        } // try
+      catch (mu::ParserError &e)
+        {
+          std::cerr << "Message:  <" << e.GetMsg() << ">\n";
+          std::cerr << "Formula:  <" << e.GetExpr() << ">\n";
+          std::cerr << "Token:    <" << e.GetToken() << ">\n";
+          std::cerr << "Position: <" << e.GetPos() << ">\n";
+          std::cerr << "Errc:     <" << e.GetCode() << ">" << std::endl;
+          AssertThrow(false, ExcParseError(e.GetCode(), e.GetMsg()));
+        } // catch
+#else
+      (void)points;
+      (void)time;
+      (void)component;
+      (void)values;
+      AssertThrow(false, ExcNeedsFunctionparser());
+#endif
+    }
+
+    template <int dim, typename Number>
+    void
+    ParserImplementation<dim, Number>::do_all_values_list(
+      const ArrayView<const Point<dim>> &points,
+      const double                       time,
+      const ArrayView<Number> &          values) const
+    {
+#ifdef DEAL_II_WITH_MUPARSER
+      Assert(this->initialized == true, ExcNotInitialized());
+
+      // look up the thread-local parser objects only once for all points
+      internal::FunctionParser::ParserData &data = this->parser_data.get();
+      if (data.vars.size() == 0)
+        init_muparser();
+
+      const unsigned int n_components = data.parsers.size();
+      AssertDimension(values.size(), points.size() * n_components);
+
+      if (dim != this->n_vars)
+        data.vars[dim] = time;
+
+      try
+        {
+          for (unsigned int q = 0; q < points.size(); ++q)
+            {
+              for (unsigned int i = 0; i < dim; ++i)
+                data.vars[i] = points[q][i];
+              for (unsigned int component = 0; component < n_components;
+                   ++component)
+                {
+                  Assert(dynamic_cast<Parser *>(data.parsers[component].get()),
+                         ExcInternalError());
+                  mu::Parser &parser =
+                    // We just checked that the pointer is valid so suppress
+                    // the clang-tidy check
+                    static_cast<Parser &>(*data.parsers[component]); // NOLINT
+                  values[q * n_components + component] = parser.Eval();
+                }
+            }
+        } // try
+      catch (mu::ParserError &e)
+        {
+          std::cerr << "Message:  <" << e.GetMsg() << ">\n";
+          std::cerr << "Formula:  <" << e.GetExpr() << ">\n";
+          std::cerr << "Token:    <" << e.GetToken() << ">\n";
+          std::cerr << "Position: <" << e.GetPos() << ">\n";
+          std::cerr << "Errc:     <" << e.GetCode() << ">" << std::endl;
+          AssertThrow(false, ExcParseError(e.GetCode(), e.GetMsg()));
+        } // catch
+#else
+      (void)points;
+      (void)time;
+      (void)values;
+      AssertThrow(false, ExcNeedsFunctionparser());
+#endif
+    }
+
 // explicit instantiations
 #include "mu_parser_internal.inst"
 
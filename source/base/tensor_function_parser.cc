@@ -125,10 +125,17 @@ TensorFunctionParser<rank, dim, Number>::value_list(
   Assert(p.size() == values.size(),
          ExcDimensionMismatch(p.size(), values.size()));
 
+  constexpr unsigned int n_components =
+    Tensor<rank, dim, Number>::n_independent_components;
+  std::vector<Number> all_values(p.size() * n_components);
+  this->do_all_values_list(make_array_view(p),
+                           this->get_time(),
+                           make_array_view(all_values));
+
   for (unsigned int i = 0; i < p.size(); ++i)
-    {
-      values[i] = value(p[i]);
-    }
+    values[i] = Tensor<rank, dim, Number>(
+      make_array_view(all_values.cbegin() + i * n_components,
+                      all_values.cbegin() + (i + 1) * n_components));
 }
 
 // explicit instantiations
@@ -20,9 +20,19 @@
 #  include <deal.II/differentiation/sd/symengine_optimizer.h>
 #  include <deal.II/differentiation/sd/symengine_utilities.h>
 
+#  include <boost/archive/binary_iarchive.hpp>
+#  include <boost/archive/binary_oarchive.hpp>
 #  include <boost/archive/text_iarchive.hpp>
 #  include <boost/archive/text_oarchive.hpp>
 
+#  include <cstdint>
+#  include <cstdio>
+#  include <fstream>
+#  include <iomanip>
+#  include <random>
+#  include <sstream>
+#  include <string>
+#  include <typeinfo>
 #  include <utility>
 
 DEAL_II_NAMESPACE_OPEN
@@ -390,6 +400,114 @@ namespace Differentiation
 
 
 
+    template <typename ReturnType>
+    bool
+    BatchOptimizer<ReturnType>::optimize(const std::string &cache_directory)
+    {
+      Assert(optimized() == false,
+             ExcMessage("Cannot call optimize() more than once."));
+
+      const std::string key = get_cache_key();
+
+      // Name the cache file by a hash of the key. We use the FNV-1a hash
+      // here rather than std::hash, since the latter is not guaranteed to
+      // give the same result with different compilers or standard libraries.
+      std::uint64_t hash = 14695981039346656037ULL;
+      for (const char c : key)
+        {
+          hash ^= static_cast<unsigned char>(c);
+          hash *= 1099511628211ULL;
+        }
+      std::ostringstream filename;
+      filename << cache_directory << "/batch_optimizer_" << std::hex
+               << std::setw(16) << std::setfill('0') << hash << ".bin";
+
+      // See whether a previous run has already optimized the same functions.
+      // The cache file could have been written by an incompatible version of
+      // the library, in which case we simply compute the optimizer anew.
+      {
+        std::ifstream in(filename.str(), std::ios::binary);
+        if (in)
+          {
+            BatchOptimizer<ReturnType> cached_optimizer;
+            bool                       found = false;
+            try
+              {
+                boost::archive::binary_iarchive archive(in);
+                std::string                     cached_key;
+                archive >> cached_key;
+                if (cached_key == key)
+                  {
+                    cached_optimizer.load(archive, 0);
+                    found = true;
+                  }
+              }
+            catch (const std::exception &)
+              {
+                found = false;
+              }
+
+            if (found)
+              {
+                method = cached_optimizer.method;
+                flags  = cached_optimizer.flags;
+                independent_variables_symbols =
+                  std::move(cached_optimizer.independent_variables_symbols);
+                dependent_variables_functions =
+                  std::move(cached_optimizer.dependent_variables_functions);
+                dependent_variables_output =
+                  std::move(cached_optimizer.dependent_variables_output);
+                map_dep_expr_vec_entry =
+                  std::move(cached_optimizer.map_dep_expr_vec_entry);
+                optimizer = std::move(cached_optimizer.optimizer);
+                ready_for_value_extraction = false;
+                has_been_serialized        = true;
+                return true;
+              }
+          }
+      }
+
+      optimize();
+
+      // Write the result into the cache. Other processes might be doing the
+      // same at the same time, so we first write to a file with a unique name
+      // and then move it to its final place.
+      const std::string temporary_filename =
+        filename.str() + ".tmp." + std::to_string(std::random_device()());
+      {
+        std::ofstream out(temporary_filename, std::ios::binary);
+        if (!out)
+          return false;
+        boost::archive::binary_oarchive archive(out);
+        archive << key;
+        save(archive, 0);
+      }
+      if (std::rename(temporary_filename.c_str(), filename.str().c_str()) != 0)
+        std::remove(temporary_filename.c_str());
+
+      return false;
+    }
+
+
+
+    template <typename ReturnType>
+    std::string
+    BatchOptimizer<ReturnType>::get_cache_key() const
+    {
+      std::ostringstream key;
+      key << "BatchOptimizer<" << typeid(ReturnType).name() << "> "
+          << static_cast<int>(method) << ' ' << static_cast<int>(flags)
+          << '\n';
+      for (const auto &symbol : independent_variables_symbols)
+        key << symbol.first << '\n';
+      key << '\n';
+      for (const auto &function : dependent_variables_functions)
+        key << function << '\n';
+      return key.str();
+    }
+
+
+
     template <typename ReturnType>
     void
     BatchOptimizer<ReturnType>::substitute(
@@ -470,7 +588,8 @@ namespace Differentiation
     template <typename ReturnType>
     void
     BatchOptimizer<ReturnType>::substitute(
-      const std::vector<ReturnType> &substitution_values) const
+      const std::vector<ReturnType> &substitution_values,
+      std::vector<ReturnType> &      output_values) const
     {
       Assert(
         optimized() == true,
@@ -481,6 +600,7 @@ namespace Differentiation
       Assert(substitution_values.size() == independent_variables_symbols.size(),
              ExcDimensionMismatch(substitution_values.size(),
                                   independent_variables_symbols.size()));
+      AssertDimension(output_values.size(), n_dependent_variables());
 
       if (typename internal::DictionaryOptimizer<ReturnType>::OptimizerType
             *opt = dynamic_cast<typename internal::DictionaryOptimizer<
@@ -490,7 +610,7 @@ namespace Differentiation
                  ExcInternalError());
           internal::OptimizerHelper<ReturnType,
                                     internal::DictionaryOptimizer<ReturnType>>::
-            substitute(opt, dependent_variables_output, substitution_values);
+            substitute(opt, output_values, substitution_values);
         }
       else if (typename internal::LambdaOptimizer<ReturnType>::OptimizerType
                  *opt = dynamic_cast<typename internal::LambdaOptimizer<
@@ -498,9 +618,13 @@ namespace Differentiation
         {
           Assert(optimization_method() == OptimizerType::lambda,
                  ExcInternalError());
+          // With CSE, the optimizer stores the intermediate values itself
+          std::unique_lock<std::mutex> lock(optimizer_mutex, std::defer_lock);
+          if (use_symbolic_CSE())
+            lock.lock();
           internal::OptimizerHelper<ReturnType,
                                     internal::LambdaOptimizer<ReturnType>>::
-            substitute(opt, dependent_variables_output, substitution_values);
+            substitute(opt, output_values, substitution_values);
         }
 #  ifdef HAVE_SYMENGINE_LLVM
       else if (typename internal::LLVMOptimizer<ReturnType>::OptimizerType
@@ -511,14 +635,23 @@ namespace Differentiation
                  ExcInternalError());
           internal::OptimizerHelper<ReturnType,
                                     internal::LLVMOptimizer<ReturnType>>::
-            substitute(opt, dependent_variables_output, substitution_values);
+            substitute(opt, output_values, substitution_values);
         }
 #  endif
       else
         {
           AssertThrow(false, ExcNotImplemented());
         }
+    }
+
 
+
+    template <typename ReturnType>
+    void
+    BatchOptimizer<ReturnType>::substitute(
+      const std::vector<ReturnType> &substitution_values) const
+    {
+      substitute(substitution_values, dependent_variables_output);
       ready_for_value_extraction = true;
     }
 
@@ -544,6 +677,17 @@ namespace Differentiation
     BatchOptimizer<ReturnType>::extract(
       const Expression &             func,
       const std::vector<ReturnType> &cached_evaluation) const
+    {
+      const std::size_t index = get_output_index(func);
+      AssertIndexRange(index, cached_evaluation.size());
+      return cached_evaluation[index];
+    }
+
+
+
+    template <typename ReturnType>
+    std::size_t
+    BatchOptimizer<ReturnType>::get_output_index(const Expression &func) const
     {
       // TODO[JPP]: Find a way to fix this bug that crops up in serialization
       // cases, e.g. symengine/batch_optimizer_05. Even though the entry is
@@ -613,7 +757,7 @@ namespace Differentiation
                   new_map_expr.get_value().__str__())
                 {
                   map_dep_expr_vec_entry[func] = e.second;
-                  return extract(func, cached_evaluation);
+                  return get_output_index(func);
                 }
             }
 
@@ -627,7 +771,7 @@ namespace Differentiation
              ExcMessage("Function has not been registered."));
       Assert(it->second < n_dependent_variables(), ExcInternalError());
 
-      return cached_evaluation[it->second];
+      return it->second;
     }
 
 
@@ -13,10 +13,12 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/graph_coloring.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/utilities.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria_base.h>
@@ -39,6 +41,7 @@
 #include <deal.II/hp/q_collection.h>
 
 #include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/sparsity_pattern.h>
 #include <deal.II/lac/sparsity_pattern_base.h>
 #include <deal.II/lac/vector.h>
 
@@ -108,6 +111,162 @@ namespace DoFTools
 
 
 
+  namespace internal
+  {
+    namespace
+    {
+      /**
+       * A sparsity pattern that does not store any entries, but only counts
+       * how many column indices are added to each row. The result is an
+       * upper bound for the number of nonzero entries of the rows, as the
+       * same entry may be added more than once.
+       */
+      class RowLengthCounter : public SparsityPatternBase
+      {
+      public:
+        RowLengthCounter(std::vector<unsigned int> &row_lengths)
+          : SparsityPatternBase(row_lengths.size(), row_lengths.size())
+          , row_lengths(row_lengths)
+        {}
+
+        virtual void
+        add_row_entries(const size_type &                 row,
+                        const ArrayView<const size_type> &columns,
+                        const bool indices_are_sorted = false) override
+        {
+          (void)indices_are_sorted;
+          AssertIndexRange(row, row_lengths.size());
+          row_lengths[row] += columns.size();
+        }
+
+        virtual void
+        add_entries(const ArrayView<const std::pair<size_type, size_type>>
+                      &entries) override
+        {
+          for (const auto &entry : entries)
+            {
+              AssertIndexRange(entry.first, row_lengths.size());
+              ++row_lengths[entry.first];
+            }
+        }
+
+      private:
+        std::vector<unsigned int> &row_lengths;
+      };
+
+
+
+      struct SparsityScratchData
+      {};
+
+
+
+      struct SparsityCopyData
+      {
+        std::vector<types::global_dof_index> dof_indices;
+      };
+    } // namespace
+  }   // namespace internal
+
+
+
+  template <int dim, int spacedim, typename number>
+  void
+  make_compressed_sparsity_pattern(
+    const DoFHandler<dim, spacedim> &dof,
+    SparsityPattern &                sparsity,
+    const AffineConstraints<number> &constraints,
+    const bool                       keep_constrained_dofs,
+    const types::subdomain_id        subdomain_id)
+  {
+    Assert((dynamic_cast<
+              const parallel::DistributedTriangulationBase<dim, spacedim> *>(
+              &dof.get_triangulation()) == nullptr),
+           ExcMessage("This function builds the sparsity pattern of all "
+                      "rows of the matrix and can therefore not be used "
+                      "with distributed triangulations."));
+
+    const types::global_dof_index n_dofs = dof.n_dofs();
+    if (n_dofs == 0)
+      {
+        sparsity.reinit(0, 0, 0);
+        sparsity.compress();
+        return;
+      }
+
+    const auto cell_is_relevant =
+      [subdomain_id](
+        const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell) {
+        return ((subdomain_id == numbers::invalid_subdomain_id) ||
+                (subdomain_id == cell->subdomain_id())) &&
+               cell->is_locally_owned();
+      };
+
+    // two cells write into the same rows of the sparsity pattern if they
+    // share degrees of freedom, or if degrees of freedom on them are
+    // constrained to a common one. color the cells accordingly so that we
+    // can work on all cells of one color in parallel
+    using CellIterator = typename DoFHandler<dim, spacedim>::active_cell_iterator;
+    const std::vector<std::vector<CellIterator>> colored_cells =
+      GraphColoring::make_graph_coloring(
+        dof.begin_active(),
+        dof.end(),
+        std::function<std::vector<types::global_dof_index>(
+          const CellIterator &)>(
+          [&constraints, &cell_is_relevant](const CellIterator &cell) {
+            std::vector<types::global_dof_index> conflicts;
+            if (cell_is_relevant(cell))
+              {
+                conflicts.resize(cell->get_fe().n_dofs_per_cell());
+                cell->get_dof_indices(conflicts);
+                constraints.resolve_indices(conflicts);
+              }
+            return conflicts;
+          }));
+
+    const auto worker = [&cell_is_relevant](const CellIterator &cell,
+                                            internal::SparsityScratchData &,
+                                            internal::SparsityCopyData &copy) {
+      if (cell_is_relevant(cell))
+        {
+          copy.dof_indices.resize(cell->get_fe().n_dofs_per_cell());
+          cell->get_dof_indices(copy.dof_indices);
+        }
+      else
+        copy.dof_indices.clear();
+    };
+
+    const auto add_cell_entries = [&](SparsityPatternBase &pattern) {
+      WorkStream::run(
+        colored_cells,
+        worker,
+        [&](const internal::SparsityCopyData &copy) {
+          if (copy.dof_indices.size() > 0)
+            constraints.add_entries_local_to_global(copy.dof_indices,
+                                                    pattern,
+                                                    keep_constrained_dofs);
+        },
+        internal::SparsityScratchData(),
+        internal::SparsityCopyData());
+    };
+
+    // first pass: find an upper bound for the length of each row
+    {
+      std::vector<unsigned int> row_lengths(n_dofs, 0);
+      internal::RowLengthCounter counter(row_lengths);
+      add_cell_entries(counter);
+
+      sparsity.reinit(n_dofs, n_dofs, row_lengths);
+    }
+
+    // second pass: write the column indices into the pre-allocated rows and
+    // squeeze out the unused space
+    add_cell_entries(sparsity);
+    sparsity.compress();
+  }
+
+
+
   template <int dim, int spacedim, typename number>
   void
   make_sparsity_pattern(const DoFHandler<dim, spacedim> &dof,
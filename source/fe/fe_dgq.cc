@@ -441,13 +441,11 @@ FE_DGQ<dim, spacedim>::get_prolongation_matrix(
             FullMatrix<double>(this->n_dofs_per_cell(),
                                this->n_dofs_per_cell()));
           if (dim == spacedim)
-            FETools::compute_embedding_matrices(*this,
-                                                isotropic_matrices,
-                                                true);
+            FETools::MatrixCache::compute_embedding_matrices(
+              *this, isotropic_matrices, true);
           else
-            FETools::compute_embedding_matrices(FE_DGQ<dim>(this->degree),
-                                                isotropic_matrices,
-                                                true);
+            FETools::MatrixCache::compute_embedding_matrices(
+              FE_DGQ<dim>(this->degree), isotropic_matrices, true);
           this_nonconst.prolongation[refinement_case - 1].swap(
             isotropic_matrices.back());
         }
@@ -459,18 +457,18 @@ FE_DGQ<dim, spacedim>::get_prolongation_matrix(
           this_nonconst.reinit_restriction_and_prolongation_matrices();
           if (dim == spacedim)
             {
-              FETools::compute_embedding_matrices(*this,
-                                                  this_nonconst.prolongation);
-              FETools::compute_projection_matrices(*this,
-                                                   this_nonconst.restriction);
+              FETools::MatrixCache::compute_embedding_matrices(
+                *this, this_nonconst.prolongation);
+              FETools::MatrixCache::compute_projection_matrices(
+                *this, this_nonconst.restriction);
             }
           else
             {
               FE_DGQ<dim> tmp(this->degree);
-              FETools::compute_embedding_matrices(tmp,
-                                                  this_nonconst.prolongation);
-              FETools::compute_projection_matrices(tmp,
-                                                   this_nonconst.restriction);
+              FETools::MatrixCache::compute_embedding_matrices(
+                tmp, this_nonconst.prolongation);
+              FETools::MatrixCache::compute_projection_matrices(
+                tmp, this_nonconst.restriction);
             }
         }
     }
@@ -517,13 +515,11 @@ FE_DGQ<dim, spacedim>::get_restriction_matrix(
             FullMatrix<double>(this->n_dofs_per_cell(),
                                this->n_dofs_per_cell()));
           if (dim == spacedim)
-            FETools::compute_projection_matrices(*this,
-                                                 isotropic_matrices,
-                                                 true);
+            FETools::MatrixCache::compute_projection_matrices(
+              *this, isotropic_matrices, true);
           else
-            FETools::compute_projection_matrices(FE_DGQ<dim>(this->degree),
-                                                 isotropic_matrices,
-                                                 true);
+            FETools::MatrixCache::compute_projection_matrices(
+              FE_DGQ<dim>(this->degree), isotropic_matrices, true);
           this_nonconst.restriction[refinement_case - 1].swap(
             isotropic_matrices.back());
         }
@@ -535,18 +531,18 @@ FE_DGQ<dim, spacedim>::get_restriction_matrix(
           this_nonconst.reinit_restriction_and_prolongation_matrices();
           if (dim == spacedim)
             {
-              FETools::compute_embedding_matrices(*this,
-                                                  this_nonconst.prolongation);
-              FETools::compute_projection_matrices(*this,
-                                                   this_nonconst.restriction);
+              FETools::MatrixCache::compute_embedding_matrices(
+                *this, this_nonconst.prolongation);
+              FETools::MatrixCache::compute_projection_matrices(
+                *this, this_nonconst.restriction);
             }
           else
             {
               FE_DGQ<dim> tmp(this->degree);
-              FETools::compute_embedding_matrices(tmp,
-                                                  this_nonconst.prolongation);
-              FETools::compute_projection_matrices(tmp,
-                                                   this_nonconst.restriction);
+              FETools::MatrixCache::compute_embedding_matrices(
+                tmp, this_nonconst.prolongation);
+              FETools::MatrixCache::compute_projection_matrices(
+                tmp, this_nonconst.restriction);
             }
         }
     }
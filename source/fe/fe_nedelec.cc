@@ -3062,7 +3062,7 @@ FE_Nedelec<dim>::get_prolongation_matrix(
 #endif
       this_nonconst.reinit_restriction_and_prolongation_matrices();
       // Fill prolongation matrices with embedding operators
-      FETools::compute_embedding_matrices(
+      FETools::MatrixCache::compute_embedding_matrices(
         this_nonconst,
         this_nonconst.prolongation,
         true,
@@ -3118,7 +3118,7 @@ FE_Nedelec<dim>::get_restriction_matrix(
 #endif
       this_nonconst.reinit_restriction_and_prolongation_matrices();
       // Fill prolongation matrices with embedding operators
-      FETools::compute_embedding_matrices(
+      FETools::MatrixCache::compute_embedding_matrices(
         this_nonconst,
         this_nonconst.prolongation,
         true,
@@ -83,7 +83,7 @@ FE_RaviartThomas<dim>::FE_RaviartThomas(const unsigned int deg)
   // refinement
   this->reinit_restriction_and_prolongation_matrices(true);
   // Fill prolongation matrices with embedding operators
-  FETools::compute_embedding_matrices(*this, this->prolongation);
+  FETools::MatrixCache::compute_embedding_matrices(*this, this->prolongation);
   initialize_restriction();
 
   // TODO: the implementation makes the assumption that all faces have the
@@ -700,7 +700,9 @@ FE_RaviartThomasNodal<dim>::get_prolongation_matrix(
             GeometryInfo<dim>::n_children(RefinementCase<dim>(refinement_case)),
             FullMatrix<double>(this->n_dofs_per_cell(),
                                this->n_dofs_per_cell()));
-          FETools::compute_embedding_matrices(*this, isotropic_matrices, true);
+          FETools::MatrixCache::compute_embedding_matrices(*this,
+                                                           isotropic_matrices,
+                                                           true);
           this_nonconst.prolongation[refinement_case - 1].swap(
             isotropic_matrices.back());
         }
@@ -710,10 +712,10 @@ FE_RaviartThomasNodal<dim>::get_prolongation_matrix(
           // we only check for their size and the reinit call initializes them
           // all
           this_nonconst.reinit_restriction_and_prolongation_matrices();
-          FETools::compute_embedding_matrices(*this,
-                                              this_nonconst.prolongation);
-          FETools::compute_projection_matrices(*this,
-                                               this_nonconst.restriction);
+          FETools::MatrixCache::compute_embedding_matrices(
+            *this, this_nonconst.prolongation);
+          FETools::MatrixCache::compute_projection_matrices(
+            *this, this_nonconst.restriction);
         }
     }
 
@@ -758,7 +760,9 @@ FE_RaviartThomasNodal<dim>::get_restriction_matrix(
             GeometryInfo<dim>::n_children(RefinementCase<dim>(refinement_case)),
             FullMatrix<double>(this->n_dofs_per_cell(),
                                this->n_dofs_per_cell()));
-          FETools::compute_projection_matrices(*this, isotropic_matrices, true);
+          FETools::MatrixCache::compute_projection_matrices(*this,
+                                                            isotropic_matrices,
+                                                            true);
           this_nonconst.restriction[refinement_case - 1].swap(
             isotropic_matrices.back());
         }
@@ -768,10 +772,10 @@ FE_RaviartThomasNodal<dim>::get_restriction_matrix(
           // we only check for their size and the reinit call initializes them
           // all
           this_nonconst.reinit_restriction_and_prolongation_matrices();
-          FETools::compute_embedding_matrices(*this,
-                                              this_nonconst.prolongation);
-          FETools::compute_projection_matrices(*this,
-                                               this_nonconst.restriction);
+          FETools::MatrixCache::compute_embedding_matrices(
+            *this, this_nonconst.prolongation);
+          FETools::MatrixCache::compute_projection_matrices(
+            *this, this_nonconst.restriction);
         }
     }
 
@@ -335,7 +335,9 @@ FE_SimplexPoly<dim, spacedim>::get_prolongation_matrix(
         GeometryInfo<dim>::n_children(RefinementCase<dim>(refinement_case)),
         FullMatrix<double>(this->n_dofs_per_cell(), this->n_dofs_per_cell()));
 
-      FETools::compute_embedding_matrices(*this, isotropic_matrices, true);
+      FETools::MatrixCache::compute_embedding_matrices(*this,
+                                                       isotropic_matrices,
+                                                       true);
 
       this_nonconst.prolongation[refinement_case - 1].swap(
         isotropic_matrices.back());
@@ -377,7 +379,9 @@ FE_SimplexPoly<dim, spacedim>::get_restriction_matrix(
         GeometryInfo<dim>::n_children(RefinementCase<dim>(refinement_case)),
         FullMatrix<double>(this->n_dofs_per_cell(), this->n_dofs_per_cell()));
 
-      FETools::compute_projection_matrices(*this, isotropic_matrices, true);
+      FETools::MatrixCache::compute_projection_matrices(*this,
+                                                        isotropic_matrices,
+                                                        true);
 
       this_nonconst.restriction[refinement_case - 1].swap(
         isotropic_matrices.back());
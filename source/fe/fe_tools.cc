@@ -16,8 +16,240 @@
 
 #include <deal.II/fe/fe_tools.templates.h>
 
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+
 DEAL_II_NAMESPACE_OPEN
 
+namespace FETools
+{
+  namespace internal
+  {
+    namespace FEToolsMatrixCache
+    {
+      namespace
+      {
+        // The cached matrices, keyed by the finite element, the number type
+        // and the kind of matrices, the keys in the order in which they were
+        // added, the maximal number of entries, and the lock for accessing
+        // them. Finite elements may be created during static
+        // initialization, so create the cache upon first use.
+        struct Cache
+        {
+          std::map<std::string, std::vector<std::vector<FullMatrix<double>>>>
+                                  entries;
+          std::deque<std::string> keys_in_insertion_order;
+          unsigned int            max_n_entries = 64;
+          std::mutex              mutex;
+        };
+
+        Cache &
+        get_cache()
+        {
+          static Cache cache;
+          return cache;
+        }
+
+        // Remove the oldest entries until the cache holds no more than
+        // the maximal number of entries. The caller must hold the lock.
+        void
+        remove_oldest_entries(Cache &cache)
+        {
+          while (cache.entries.size() > cache.max_n_entries)
+            {
+              cache.entries.erase(cache.keys_in_insertion_order.front());
+              cache.keys_in_insertion_order.pop_front();
+            }
+        }
+
+
+
+        // Add an entry to the cache unless the key is already present. The
+        // caller must hold the lock.
+        void
+        add_entry(Cache &                                             cache,
+                  const std::string &                                 key,
+                  const std::vector<std::vector<FullMatrix<double>>> &matrices)
+        {
+          if (cache.entries.emplace(key, matrices).second)
+            {
+              cache.keys_in_insertion_order.push_back(key);
+              remove_oldest_entries(cache);
+            }
+        }
+
+
+
+        // An identifier at the start of the files written by
+        // MatrixCache::save()
+        const std::string file_identifier = "deal.II FETools::MatrixCache 2";
+      } // namespace
+
+
+
+      bool
+      get(const std::string &                           key,
+          std::vector<std::vector<FullMatrix<double>>> &matrices)
+      {
+        Cache &                     cache = get_cache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        const auto                  entry = cache.entries.find(key);
+        if (entry == cache.entries.end())
+          return false;
+        matrices = entry->second;
+        return true;
+      }
+
+
+
+      void
+      store(const std::string &                                 key,
+            const std::vector<std::vector<FullMatrix<double>>> &matrices)
+      {
+        Cache &                     cache = get_cache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        add_entry(cache, key, matrices);
+      }
+    } // namespace FEToolsMatrixCache
+  }   // namespace internal
+
+
+
+  namespace MatrixCache
+  {
+    void
+    save(const std::string &filename)
+    {
+      std::ofstream out(filename, std::ios::binary);
+      AssertThrow(out, ExcFileNotOpen(filename));
+
+      const auto write_size = [&out](const std::size_t size) {
+        const std::uint64_t value = size;
+        out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+      };
+
+      internal::FEToolsMatrixCache::Cache &cache =
+        internal::FEToolsMatrixCache::get_cache();
+      std::lock_guard<std::mutex> lock(cache.mutex);
+      out << internal::FEToolsMatrixCache::file_identifier << '\n';
+      write_size(cache.entries.size());
+      for (const auto &entry : cache.entries)
+        {
+          write_size(entry.first.size());
+          out.write(entry.first.data(), entry.first.size());
+          write_size(entry.second.size());
+          for (const auto &matrices : entry.second)
+            {
+              write_size(matrices.size());
+              for (const auto &matrix : matrices)
+                {
+                  write_size(matrix.m());
+                  write_size(matrix.n());
+                  if (!matrix.empty())
+                    out.write(reinterpret_cast<const char *>(&matrix(0, 0)),
+                              matrix.m() * matrix.n() * sizeof(double));
+                }
+            }
+        }
+      AssertThrow(out, ExcIO());
+    }
+
+
+
+    void
+    load(const std::string &filename)
+    {
+      std::ifstream in(filename, std::ios::binary);
+      AssertThrow(in, ExcFileNotOpen(filename));
+
+      const auto read_size = [&in]() -> std::size_t {
+        std::uint64_t value = 0;
+        in.read(reinterpret_cast<char *>(&value), sizeof(value));
+        AssertThrow(in, ExcIO());
+        return value;
+      };
+
+      std::string identifier;
+      std::getline(in, identifier);
+      AssertThrow(identifier == internal::FEToolsMatrixCache::file_identifier,
+                  ExcMessage("The file <" + filename +
+                             "> was not written by "
+                             "FETools::MatrixCache::save()."));
+
+      std::map<std::string, std::vector<std::vector<FullMatrix<double>>>>
+                        entries;
+      const std::size_t n_entries = read_size();
+      for (std::size_t e = 0; e < n_entries; ++e)
+        {
+          std::string key(read_size(), ' ');
+          in.read(&key[0], key.size());
+          std::vector<std::vector<FullMatrix<double>>> &matrices = entries[key];
+          matrices.resize(read_size());
+          for (auto &matrices_of_case : matrices)
+            {
+              matrices_of_case.resize(read_size());
+              for (auto &matrix : matrices_of_case)
+                {
+                  const std::size_t m = read_size();
+                  const std::size_t n = read_size();
+                  matrix.reinit(m, n);
+                  if (!matrix.empty())
+                    in.read(reinterpret_cast<char *>(&matrix(0, 0)),
+                            m * n * sizeof(double));
+                }
+            }
+          AssertThrow(in, ExcIO());
+        }
+
+      internal::FEToolsMatrixCache::Cache &cache =
+        internal::FEToolsMatrixCache::get_cache();
+      std::lock_guard<std::mutex> lock(cache.mutex);
+      for (const auto &entry : entries)
+        add_entry(cache, entry.first, entry.second);
+    }
+
+
+
+    void
+    clear()
+    {
+      internal::FEToolsMatrixCache::Cache &cache =
+        internal::FEToolsMatrixCache::get_cache();
+      std::lock_guard<std::mutex> lock(cache.mutex);
+      cache.entries.clear();
+      cache.keys_in_insertion_order.clear();
+    }
+
+
+
+    void
+    set_max_n_entries(const unsigned int max_n_entries)
+    {
+      internal::FEToolsMatrixCache::Cache &cache =
+        internal::FEToolsMatrixCache::get_cache();
+      std::lock_guard<std::mutex> lock(cache.mutex);
+      cache.max_n_entries = max_n_entries;
+      internal::FEToolsMatrixCache::remove_oldest_entries(cache);
+    }
+
+
+
+    unsigned int
+    n_entries()
+    {
+      internal::FEToolsMatrixCache::Cache &cache =
+        internal::FEToolsMatrixCache::get_cache();
+      std::lock_guard<std::mutex> lock(cache.mutex);
+      return cache.entries.size();
+    }
+  } // namespace MatrixCache
+} // namespace FETools
+
+
+
 /*-------------- Explicit Instantiations -------------------------------*/
 #include "fe_tools.inst"
 
@@ -19,6 +19,7 @@
 #include <deal.II/base/numbers.h>
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/signaling_nan.h>
+#include <deal.II/base/tensor_product_polynomials.h>
 #include <deal.II/base/thread_management.h>
 
 #include <deal.II/differentiation/ad.h>
@@ -26,6 +27,7 @@
 #include <deal.II/dofs/dof_accessor.h>
 
 #include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_poly.h>
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/mapping.h>
 
@@ -45,6 +47,8 @@
 #include <deal.II/lac/vector.h>
 #include <deal.II/lac/vector_element_access.h>
 
+#include <deal.II/matrix_free/tensor_product_kernels.h>
+
 #include <boost/container/small_vector.hpp>
 
 #include <iomanip>
@@ -133,6 +137,282 @@ namespace internal
       }
     };
   } // namespace
+
+
+
+  namespace FEValuesImplementation
+  {
+    template <int dim, int spacedim>
+    class TensorProductEvaluationData
+    {
+    public:
+      /**
+       * Return a new object for the given finite element and quadrature
+       * formula, or a null pointer if the finite element is not composed of
+       * copies of a single scalar tensor product element, or if the
+       * quadrature formula is not an isotropic tensor product formula.
+       */
+      static std::unique_ptr<const TensorProductEvaluationData>
+      create(const FiniteElement<dim, spacedim> &fe,
+             const Quadrature<dim> &             quadrature);
+
+      /**
+       * Evaluate the values and/or the gradients on the reference cell of
+       * the given vector component at the quadrature points, given the
+       * values of all degrees of freedom of a cell in the numbering of the
+       * finite element. Returns false without doing anything if the number
+       * type is not supported by the sum factorization kernels, i.e., if it
+       * is neither double nor float.
+       */
+      template <typename Number>
+      bool
+      evaluate(const Number *     dof_values,
+               const unsigned int component,
+               double *           values,
+               Tensor<1, dim> *   reference_gradients) const
+      {
+        using is_supported =
+          std::integral_constant<bool,
+                                 std::is_same<Number, double>::value ||
+                                   std::is_same<Number, float>::value>;
+        return evaluate_impl(
+          dof_values, component, values, reference_gradients, is_supported());
+      }
+
+      /**
+       * Return the number of quadrature points.
+       */
+      unsigned int
+      n_q_points() const
+      {
+        return Utilities::fixed_power<dim>(n_q_points_1d);
+      }
+
+    private:
+      template <typename Number>
+      bool
+      evaluate_impl(const Number *,
+                    const unsigned int,
+                    double *,
+                    Tensor<1, dim> *,
+                    std::false_type) const
+      {
+        return false;
+      }
+
+      template <typename Number>
+      bool
+      evaluate_impl(const Number *     dof_values,
+                    const unsigned int component,
+                    double *           values,
+                    Tensor<1, dim> *   reference_gradients,
+                    std::true_type) const;
+
+      /**
+       * The number of one-dimensional shape functions.
+       */
+      unsigned int n_dofs_1d;
+
+      /**
+       * The number of points of the one-dimensional quadrature formula.
+       */
+      unsigned int n_q_points_1d;
+
+      /**
+       * The index of the degree of freedom of the finite element for the
+       * shape functions of each component in lexicographic order.
+       */
+      std::vector<unsigned int> lexicographic_numbering;
+
+      /**
+       * Values and derivatives of the one-dimensional shape functions at the
+       * one-dimensional quadrature points, with the quadrature points
+       * running fastest.
+       */
+      AlignedVector<double> shape_values;
+      AlignedVector<double> shape_gradients;
+    };
+
+
+
+    template <int dim, int spacedim>
+    std::unique_ptr<const TensorProductEvaluationData<dim, spacedim>>
+    TensorProductEvaluationData<dim, spacedim>::create(
+      const FiniteElement<dim, spacedim> &fe,
+      const Quadrature<dim> &             quadrature)
+    {
+      if (fe.n_base_elements() != 1 || fe.n_dofs_per_cell() == 0 ||
+          quadrature.size() == 0 || quadrature.is_tensor_product() == false)
+        return {};
+
+      const auto *fe_poly =
+        dynamic_cast<const FE_Poly<dim, spacedim> *>(&fe.base_element(0));
+      if (fe_poly == nullptr || fe_poly->n_components() != 1)
+        return {};
+      const auto *polynomial_space =
+        dynamic_cast<const TensorProductPolynomials<dim> *>(
+          &fe_poly->get_poly_space());
+      if (polynomial_space == nullptr)
+        return {};
+
+      const std::vector<Polynomials::Polynomial<double>> polynomials =
+        polynomial_space->get_underlying_polynomials();
+      const unsigned int n_dofs_1d = polynomials.size();
+      if (Utilities::fixed_power<dim>(n_dofs_1d) != fe_poly->n_dofs_per_cell())
+        return {};
+
+      // for linear elements, the evaluation with the full tables of shape
+      // functions is as fast as sum factorization
+      if (n_dofs_1d < 3)
+        return {};
+
+      // check that all one-dimensional quadrature formulas are the same, and
+      // that the points of the quadrature formula are in lexicographic order
+      const auto tensor_basis = quadrature.get_tensor_basis();
+      const std::vector<Point<1>> &points_1d     = tensor_basis[0].get_points();
+      const unsigned int           n_q_points_1d = points_1d.size();
+      for (unsigned int d = 1; d < dim; ++d)
+        if (tensor_basis[d].get_points() != points_1d)
+          return {};
+      if (Utilities::fixed_power<dim>(n_q_points_1d) != quadrature.size() ||
+          n_dofs_1d > 128 || n_q_points_1d > 128)
+        return {};
+      for (unsigned int q = 0; q < quadrature.size(); ++q)
+        for (unsigned int d = 0, stride = 1; d < dim;
+             ++d, stride *= n_q_points_1d)
+          if (quadrature.point(q)[d] !=
+              points_1d[(q / stride) % n_q_points_1d][0])
+            return {};
+
+      auto data = std::make_unique<TensorProductEvaluationData>();
+      data->n_dofs_1d     = n_dofs_1d;
+      data->n_q_points_1d = n_q_points_1d;
+
+      const std::vector<unsigned int> &numbering_inverse =
+        polynomial_space->get_numbering_inverse();
+      const unsigned int n_scalar_dofs = fe_poly->n_dofs_per_cell();
+      data->lexicographic_numbering.resize(fe.n_components() * n_scalar_dofs);
+      for (unsigned int c = 0; c < fe.n_components(); ++c)
+        for (unsigned int i = 0; i < n_scalar_dofs; ++i)
+          data->lexicographic_numbering[c * n_scalar_dofs + i] =
+            fe.component_to_system_index(c, numbering_inverse[i]);
+
+      data->shape_values.resize(n_dofs_1d * n_q_points_1d);
+      data->shape_gradients.resize(n_dofs_1d * n_q_points_1d);
+      std::vector<double> polynomial_values(2);
+      for (unsigned int i = 0; i < n_dofs_1d; ++i)
+        for (unsigned int q = 0; q < n_q_points_1d; ++q)
+          {
+            polynomials[i].value(points_1d[q][0], polynomial_values);
+            data->shape_values[i * n_q_points_1d + q]    = polynomial_values[0];
+            data->shape_gradients[i * n_q_points_1d + q] = polynomial_values[1];
+          }
+
+      return data;
+    }
+
+
+
+    template <int dim, int spacedim>
+    template <typename Number>
+    bool
+    TensorProductEvaluationData<dim, spacedim>::evaluate_impl(
+      const Number *     dof_values,
+      const unsigned int component,
+      double *           values,
+      Tensor<1, dim> *   reference_gradients,
+      std::true_type) const
+    {
+      const unsigned int n_scalar_dofs = Utilities::fixed_power<dim>(n_dofs_1d);
+      const unsigned int n_q_points    = this->n_q_points();
+      const unsigned int n_max =
+        Utilities::fixed_power<dim>(std::max(n_dofs_1d, n_q_points_1d));
+
+      // gather the values of the degrees of freedom of the component in
+      // lexicographic order, followed by two scratch arrays for the
+      // intermediate results of the one-dimensional interpolations and by
+      // the gradients in each direction
+      boost::container::small_vector<double, 1024> scratch(
+        n_scalar_dofs + 2 * n_max + dim * n_q_points);
+      double *lexicographic_values = scratch.data();
+      double *tmp1                 = lexicographic_values + n_scalar_dofs;
+      double *tmp2                 = tmp1 + n_max;
+      double *gradients            = tmp2 + n_max;
+      const unsigned int *numbering =
+        lexicographic_numbering.data() + component * n_scalar_dofs;
+      for (unsigned int i = 0; i < n_scalar_dofs; ++i)
+        lexicographic_values[i] = static_cast<double>(dof_values[numbering[i]]);
+
+      dealii::internal::EvaluatorTensorProduct<
+        dealii::internal::evaluate_general,
+        dim,
+        0,
+        0,
+        double,
+        double>
+        eval(shape_values.data(),
+             shape_gradients.data(),
+             nullptr,
+             n_dofs_1d,
+             n_q_points_1d);
+
+      // in each direction, interpolate the result of the previous direction
+      // and, for the gradient in that direction, differentiate it instead
+      const bool evaluate_gradients = reference_gradients != nullptr;
+      if (dim == 1)
+        {
+          if (values != nullptr)
+            eval.template values<0, true, false>(lexicographic_values, values);
+          if (evaluate_gradients)
+            eval.template gradients<0, true, false>(lexicographic_values,
+                                                    gradients);
+        }
+      else if (dim == 2)
+        {
+          eval.template values<0, true, false>(lexicographic_values, tmp1);
+          if (values != nullptr)
+            eval.template values<dim - 1, true, false>(tmp1, values);
+          if (evaluate_gradients)
+            {
+              eval.template gradients<dim - 1, true, false>(tmp1,
+                                                            gradients +
+                                                              n_q_points);
+              eval.template gradients<0, true, false>(lexicographic_values,
+                                                      tmp1);
+              eval.template values<dim - 1, true, false>(tmp1, gradients);
+            }
+        }
+      else if (dim == 3)
+        {
+          eval.template values<0, true, false>(lexicographic_values, tmp1);
+          eval.template values<1, true, false>(tmp1, tmp2);
+          if (values != nullptr)
+            eval.template values<dim - 1, true, false>(tmp2, values);
+          if (evaluate_gradients)
+            {
+              eval.template gradients<dim - 1, true, false>(
+                tmp2, gradients + (dim - 1) * n_q_points);
+              eval.template gradients<1, true, false>(tmp1, tmp2);
+              eval.template values<dim - 1, true, false>(tmp2,
+                                                         gradients +
+                                                           n_q_points);
+              eval.template gradients<0, true, false>(lexicographic_values,
+                                                      tmp1);
+              eval.template values<1, true, false>(tmp1, tmp2);
+              eval.template values<dim - 1, true, false>(tmp2, gradients);
+            }
+        }
+      else
+        Assert(false, ExcNotImplemented());
+
+      if (evaluate_gradients)
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          for (unsigned int d = 0; d < dim; ++d)
+            reference_gradients[q][d] = gradients[d * n_q_points + q];
+
+      return true;
+    }
+  } // namespace FEValuesImplementation
 } // namespace internal
 
 
@@ -3260,6 +3540,66 @@ namespace internal
               }
         }
   }
+
+
+
+  // Evaluate the values of all components of the finite element at the
+  // quadrature points with sum factorization, writing the value of
+  // component c at point q through the given function. Returns false if
+  // the number type is not supported by the tensor product evaluators.
+  template <int dim, int spacedim, typename Number, typename StoreFunction>
+  bool
+  do_function_values_tensor_product(
+    const FEValuesImplementation::TensorProductEvaluationData<dim, spacedim>
+      &                 data,
+    const Number *      dof_values,
+    const unsigned int  n_components,
+    const StoreFunction store)
+  {
+    std::vector<double> values(data.n_q_points());
+    for (unsigned int c = 0; c < n_components; ++c)
+      {
+        if (!data.evaluate(dof_values, c, values.data(), nullptr))
+          return false;
+        for (unsigned int q = 0; q < values.size(); ++q)
+          store(q, c, values[q]);
+      }
+    return true;
+  }
+
+
+
+  // Same as above for the gradients, which are evaluated on the reference
+  // cell and then transformed to real space with the given mapping.
+  template <int dim, int spacedim, typename Number, typename StoreFunction>
+  bool
+  do_function_gradients_tensor_product(
+    const FEValuesImplementation::TensorProductEvaluationData<dim, spacedim>
+      &                                                     data,
+    const Mapping<dim, spacedim> &                          mapping,
+    const typename Mapping<dim, spacedim>::InternalDataBase &mapping_data,
+    const Number *                                           dof_values,
+    const unsigned int                                       n_components,
+    const StoreFunction                                      store)
+  {
+    std::vector<Tensor<1, dim>>      reference_gradients(data.n_q_points());
+    std::vector<Tensor<1, spacedim>> gradients(data.n_q_points());
+    for (unsigned int c = 0; c < n_components; ++c)
+      {
+        if (!data.evaluate(dof_values,
+                           c,
+                           nullptr,
+                           reference_gradients.data()))
+          return false;
+        mapping.transform(make_array_view(reference_gradients),
+                          mapping_covariant,
+                          mapping_data,
+                          make_array_view(gradients));
+        for (unsigned int q = 0; q < gradients.size(); ++q)
+          store(q, c, gradients[q]);
+      }
+    return true;
+  }
 } // namespace internal
 
 
@@ -3281,6 +3621,18 @@ FEValuesBase<dim, spacedim>::get_function_values(
   // get function values of dofs on this cell
   Vector<Number> dof_values(dofs_per_cell);
   present_cell.get_interpolated_dof_values(fe_function, dof_values);
+  if (tensor_product_data != nullptr)
+    {
+      AssertDimension(values.size(), tensor_product_data->n_q_points());
+      if (internal::do_function_values_tensor_product(
+            *tensor_product_data,
+            dof_values.begin(),
+            1,
+            [&](const unsigned int q, const unsigned int, const double value) {
+              values[q] = value;
+            }))
+        return;
+    }
   internal::do_function_values(dof_values.begin(),
                                this->finite_element_output.shape_values,
                                values);
@@ -3329,6 +3681,23 @@ FEValuesBase<dim, spacedim>::get_function_values(
   // get function values of dofs on this cell
   Vector<Number> dof_values(dofs_per_cell);
   present_cell.get_interpolated_dof_values(fe_function, dof_values);
+  if (tensor_product_data != nullptr)
+    {
+      AssertDimension(values.size(), tensor_product_data->n_q_points());
+      for (const auto &value : values)
+        {
+          (void)value;
+          AssertDimension(value.size(), fe->n_components());
+        }
+      if (internal::do_function_values_tensor_product(
+            *tensor_product_data,
+            dof_values.begin(),
+            fe->n_components(),
+            [&](const unsigned int q,
+                const unsigned int c,
+                const double       value) { values[q][c] = value; }))
+        return;
+    }
   internal::do_function_values(
     dof_values.begin(),
     this->finite_element_output.shape_values,
@@ -3421,6 +3790,22 @@ FEValuesBase<dim, spacedim>::get_function_gradients(
   // get function values of dofs on this cell
   Vector<Number> dof_values(dofs_per_cell);
   present_cell.get_interpolated_dof_values(fe_function, dof_values);
+  if (tensor_product_data != nullptr)
+    {
+      AssertDimension(gradients.size(), tensor_product_data->n_q_points());
+      if (internal::do_function_gradients_tensor_product(
+            *tensor_product_data,
+            *this->mapping,
+            *this->mapping_data,
+            dof_values.begin(),
+            1,
+            [&](const unsigned int          q,
+                const unsigned int,
+                const Tensor<1, spacedim> &gradient) {
+              gradients[q] = gradient;
+            }))
+        return;
+    }
   internal::do_function_derivatives(dof_values.begin(),
                                     this->finite_element_output.shape_gradients,
                                     gradients);
@@ -3471,6 +3856,27 @@ FEValuesBase<dim, spacedim>::get_function_gradients(
   // get function values of dofs on this cell
   Vector<Number> dof_values(dofs_per_cell);
   present_cell.get_interpolated_dof_values(fe_function, dof_values);
+  if (tensor_product_data != nullptr)
+    {
+      AssertDimension(gradients.size(), tensor_product_data->n_q_points());
+      for (const auto &gradient : gradients)
+        {
+          (void)gradient;
+          AssertDimension(gradient.size(), fe->n_components());
+        }
+      if (internal::do_function_gradients_tensor_product(
+            *tensor_product_data,
+            *this->mapping,
+            *this->mapping_data,
+            dof_values.begin(),
+            fe->n_components(),
+            [&](const unsigned int          q,
+                const unsigned int          c,
+                const Tensor<1, spacedim> &gradient) {
+              gradients[q][c] = gradient;
+            }))
+        return;
+    }
   internal::do_function_derivatives(
     dof_values.begin(),
     this->finite_element_output.shape_gradients,
@@ -4182,6 +4588,14 @@ FEValues<dim, spacedim>::initialize(const UpdateFlags update_flags)
   else
     this->mapping_data =
       std::make_unique<typename Mapping<dim, spacedim>::InternalDataBase>();
+
+  // evaluate finite element functions with sum factorization if possible;
+  // the gradients additionally need the covariant transformation of the
+  // mapping
+  if ((flags & update_gradients) == false ||
+      (flags & update_covariant_transformation))
+    this->tensor_product_data = internal::FEValuesImplementation::
+      TensorProductEvaluationData<dim, spacedim>::create(*this->fe, quadrature);
 }
 
 
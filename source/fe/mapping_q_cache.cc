@@ -37,8 +37,10 @@ DEAL_II_NAMESPACE_OPEN
 
 template <int dim, int spacedim>
 MappingQCache<dim, spacedim>::MappingQCache(
-  const unsigned int polynomial_degree)
+  const unsigned int  polynomial_degree,
+  const StorageFormat storage_format)
   : MappingQ<dim, spacedim>(polynomial_degree)
+  , storage_format(storage_format)
   , uses_level_info(false)
 {}
 
@@ -49,6 +51,7 @@ MappingQCache<dim, spacedim>::MappingQCache(
   const MappingQCache<dim, spacedim> &mapping)
   : MappingQ<dim, spacedim>(mapping)
   , support_point_cache(mapping.support_point_cache)
+  , storage_format(mapping.storage_format)
   , uses_level_info(mapping.uses_level_info)
 {}
 
@@ -152,28 +155,106 @@ MappingQCache<dim, spacedim>::initialize(
   const std::function<std::vector<Point<spacedim>>(
     const typename Triangulation<dim, spacedim>::cell_iterator &)>
     &compute_points_on_cell)
+{
+  initialize_cache(triangulation, compute_points_on_cell, true);
+}
+
+
+
+template <int dim, int spacedim>
+void
+MappingQCache<dim, spacedim>::initialize_cache(
+  const Triangulation<dim, spacedim> &triangulation,
+  const std::function<std::vector<Point<spacedim>>(
+    const typename Triangulation<dim, spacedim>::cell_iterator &)>
+    &        compute_points_on_cell,
+  const bool use_level_info)
 {
   clear_signal.disconnect();
   clear_signal = triangulation.signals.any_change.connect(
     [&]() -> void { this->support_point_cache.reset(); });
 
-  support_point_cache =
-    std::make_shared<std::vector<std::vector<std::vector<Point<spacedim>>>>>(
-      triangulation.n_levels());
+  const unsigned int n_vertices = GeometryInfo<dim>::vertices_per_cell;
+  const unsigned int n_points =
+    Utilities::pow<unsigned int>(this->get_degree() + 1, dim);
+  const unsigned int n_offsets = n_points - n_vertices;
+
+  // Step 1: assign a position in the contiguous arrays to all cells that
+  // need to be stored
+  auto cache = std::make_shared<SupportPointCache>();
+  cache->level_start.resize(triangulation.n_levels() + 1);
   for (unsigned int l = 0; l < triangulation.n_levels(); ++l)
-    (*support_point_cache)[l].resize(triangulation.n_raw_cells(l));
+    cache->level_start[l + 1] =
+      cache->level_start[l] + triangulation.n_raw_cells(l);
+  cache->cell_data_index.resize(cache->level_start.back(),
+                                numbers::invalid_unsigned_int);
+
+  unsigned int n_stored_cells = 0;
+  for (const auto &cell : triangulation.cell_iterators())
+    if (use_level_info || cell->is_active())
+      cache->cell_data_index[cache->level_start[cell->level()] +
+                             cell->index()] = n_stored_cells++;
+
+  const bool use_offsets = storage_format == StorageFormat::float_offsets;
+  cache->points.resize(static_cast<std::size_t>(n_stored_cells) *
+                       (use_offsets ? n_vertices : n_points));
+  std::vector<unsigned char> cell_has_offsets;
+  if (use_offsets)
+    {
+      cache->offsets.resize(static_cast<std::size_t>(n_stored_cells) *
+                            n_offsets);
+      cell_has_offsets.resize(n_stored_cells, 0);
+    }
 
+  // Step 2: compute the points of all cells in parallel and write them to
+  // the slots assigned above
   WorkStream::run(
     triangulation.begin(),
     triangulation.end(),
     [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell,
         void *,
         void *) {
-      (*support_point_cache)[cell->level()][cell->index()] =
-        compute_points_on_cell(cell);
-      AssertDimension(
-        (*support_point_cache)[cell->level()][cell->index()].size(),
-        Utilities::pow(this->get_degree() + 1, dim));
+      const unsigned int data_index =
+        cache->cell_data_index[cache->level_start[cell->level()] +
+                               cell->index()];
+      if (data_index == numbers::invalid_unsigned_int)
+        return;
+
+      const std::vector<Point<spacedim>> points = compute_points_on_cell(cell);
+      AssertDimension(points.size(), n_points);
+
+      if (use_offsets == false)
+        {
+          std::copy(points.begin(),
+                    points.end(),
+                    cache->points.begin() +
+                      static_cast<std::size_t>(data_index) * n_points);
+          return;
+        }
+
+      std::copy(points.begin(),
+                points.begin() + n_vertices,
+                cache->points.begin() +
+                  static_cast<std::size_t>(data_index) * n_vertices);
+
+      // offsets below this tolerance relative to the size of the cell are
+      // roundoff in the computation of the points of straight-sided cells
+      double cell_size = 0;
+      for (unsigned int v = 1; v < n_vertices; ++v)
+        cell_size = std::max(cell_size, points[v].distance(points[0]));
+
+      Tensor<1, spacedim, float> *offsets =
+        cache->offsets.data() +
+        static_cast<std::size_t>(data_index) * n_offsets;
+      for (unsigned int q = 0; q < n_offsets; ++q)
+        {
+          Tensor<1, spacedim> offset = points[n_vertices + q];
+          for (unsigned int v = 0; v < n_vertices; ++v)
+            offset -= this->support_point_weights_cell(q, v) * points[v];
+          offsets[q] = offset;
+          if (offset.norm() > 1e-12 * cell_size)
+            cell_has_offsets[data_index] = 1;
+        }
     },
     /* copier */ std::function<void(void *)>(),
     /* scratch_data */ nullptr,
@@ -181,7 +262,30 @@ MappingQCache<dim, spacedim>::initialize(
     2 * MultithreadInfo::n_threads(),
     /* chunk_size = */ 1);
 
-  uses_level_info = true;
+  // Step 3: compress the offsets by dropping the blocks of all cells whose
+  // points coincide with their Q1 positions
+  if (use_offsets)
+    {
+      cache->offset_index.resize(n_stored_cells, numbers::invalid_unsigned_int);
+      unsigned int n_blocks = 0;
+      for (unsigned int c = 0; c < n_stored_cells; ++c)
+        if (cell_has_offsets[c])
+          {
+            if (n_blocks != c)
+              std::copy(cache->offsets.begin() +
+                          static_cast<std::size_t>(c) * n_offsets,
+                        cache->offsets.begin() +
+                          static_cast<std::size_t>(c + 1) * n_offsets,
+                        cache->offsets.begin() +
+                          static_cast<std::size_t>(n_blocks) * n_offsets);
+            cache->offset_index[c] = n_blocks++;
+          }
+      cache->offsets.resize(static_cast<std::size_t>(n_blocks) * n_offsets);
+      cache->offsets.shrink_to_fit();
+    }
+
+  support_point_cache = cache;
+  uses_level_info     = use_level_info;
 }
 
 
@@ -343,8 +447,8 @@ MappingQCache<dim, spacedim>::initialize(
   const bool interpolation_of_values_is_needed =
     ((is_fe_q || is_fe_dgq) && fe.degree == this->get_degree()) == false;
 
-  // Step 2: loop over all cells
-  this->initialize(
+  // Step 2: loop over all active cells
+  this->initialize_cache(
     dof_handler.get_triangulation(),
     [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell_tria)
       -> std::vector<Point<spacedim>> {
@@ -404,8 +508,8 @@ MappingQCache<dim, spacedim>::initialize(
       std::vector<Point<spacedim>> result;
 
       // Step 2b) read of quadrature points in the relative displacement case
-      // note: we also take this path for non-active or artificial cells so that
-      // these cells are filled with some useful data
+      // note: we also take this path for artificial cells so that these
+      // cells are filled with some useful data
       if (vector_describes_relative_displacement ||
           is_active_non_artificial_cell == false)
         {
@@ -415,9 +519,9 @@ MappingQCache<dim, spacedim>::initialize(
           else
             result = fe_values_all.get()->get_quadrature_points();
 
-          // for non-active or artificial cells we are done here and return
-          // the absolute positions, since the provided vector cannot contain
-          // any useful information for these cells
+          // for artificial cells we are done here and return the absolute
+          // positions, since the provided vector cannot contain any useful
+          // information for these cells
           if (is_active_non_artificial_cell == false)
             return result;
         }
@@ -485,9 +589,8 @@ MappingQCache<dim, spacedim>::initialize(
         }
 
       return result;
-    });
-
-  uses_level_info = false;
+    },
+    false);
 }
 
 
@@ -711,8 +814,7 @@ std::size_t
 MappingQCache<dim, spacedim>::memory_consumption() const
 {
   if (support_point_cache.get() != nullptr)
-    return sizeof(*this) +
-           MemoryConsumption::memory_consumption(*support_point_cache);
+    return sizeof(*this) + support_point_cache->memory_consumption();
   else
     return sizeof(*this);
 }
@@ -720,8 +822,21 @@ MappingQCache<dim, spacedim>::memory_consumption() const
 
 
 template <int dim, int spacedim>
-std::vector<Point<spacedim>>
-MappingQCache<dim, spacedim>::compute_mapping_support_points(
+std::size_t
+MappingQCache<dim, spacedim>::SupportPointCache::memory_consumption() const
+{
+  return MemoryConsumption::memory_consumption(level_start) +
+         MemoryConsumption::memory_consumption(cell_data_index) +
+         MemoryConsumption::memory_consumption(points) +
+         MemoryConsumption::memory_consumption(offset_index) +
+         MemoryConsumption::memory_consumption(offsets);
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+MappingQCache<dim, spacedim>::get_cell_data_index(
   const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
 {
   Assert(support_point_cache.get() != nullptr,
@@ -730,9 +845,61 @@ MappingQCache<dim, spacedim>::compute_mapping_support_points(
 
   Assert(uses_level_info || cell->is_active(), ExcInternalError());
 
-  AssertIndexRange(cell->level(), support_point_cache->size());
-  AssertIndexRange(cell->index(), (*support_point_cache)[cell->level()].size());
-  return (*support_point_cache)[cell->level()][cell->index()];
+  const SupportPointCache &cache = *support_point_cache;
+  AssertIndexRange(cell->level(), cache.level_start.size() - 1);
+  AssertIndexRange(cell->index(),
+                   cache.level_start[cell->level() + 1] -
+                     cache.level_start[cell->level()]);
+  const unsigned int data_index =
+    cache.cell_data_index[cache.level_start[cell->level()] + cell->index()];
+  Assert(data_index != numbers::invalid_unsigned_int, ExcInternalError());
+  return data_index;
+}
+
+
+
+template <int dim, int spacedim>
+std::vector<Point<spacedim>>
+MappingQCache<dim, spacedim>::compute_mapping_support_points(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
+{
+  const unsigned int data_index = get_cell_data_index(cell);
+  const unsigned int n_vertices = GeometryInfo<dim>::vertices_per_cell;
+  const unsigned int n_points =
+    Utilities::pow<unsigned int>(this->get_degree() + 1, dim);
+  const SupportPointCache &cache = *support_point_cache;
+
+  if (storage_format == StorageFormat::full_precision)
+    {
+      const auto ptr =
+        cache.points.begin() + static_cast<std::size_t>(data_index) * n_points;
+      return std::vector<Point<spacedim>>(ptr, ptr + n_points);
+    }
+
+  // reconstruct the points from the vertices and the offsets to the Q1
+  // positions
+  const unsigned int n_offsets = n_points - n_vertices;
+
+  const Point<spacedim> *vertices =
+    cache.points.data() + static_cast<std::size_t>(data_index) * n_vertices;
+  std::vector<Point<spacedim>> points(vertices, vertices + n_vertices);
+  points.resize(n_points);
+  for (unsigned int q = 0; q < n_offsets; ++q)
+    for (unsigned int v = 0; v < n_vertices; ++v)
+      points[n_vertices + q] +=
+        this->support_point_weights_cell(q, v) * vertices[v];
+
+  const unsigned int block = cache.offset_index[data_index];
+  if (block != numbers::invalid_unsigned_int)
+    {
+      const Tensor<1, spacedim, float> *offsets =
+        cache.offsets.data() + static_cast<std::size_t>(block) * n_offsets;
+      for (unsigned int q = 0; q < n_offsets; ++q)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          points[n_vertices + q][d] += offsets[q][d];
+    }
+
+  return points;
 }
 
 
@@ -743,15 +910,15 @@ boost::container::small_vector<Point<spacedim>,
 MappingQCache<dim, spacedim>::get_vertices(
   const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
 {
-  Assert(support_point_cache.get() != nullptr,
-         ExcMessage("Must call MappingQCache::initialize() before "
-                    "using it or after mesh has changed!"));
-
-  Assert(uses_level_info || cell->is_active(), ExcInternalError());
-
-  AssertIndexRange(cell->level(), support_point_cache->size());
-  AssertIndexRange(cell->index(), (*support_point_cache)[cell->level()].size());
-  const auto ptr = (*support_point_cache)[cell->level()][cell->index()].begin();
+  const unsigned int data_index = get_cell_data_index(cell);
+
+  // the vertices come first in both storage formats
+  const std::size_t n_points_per_cell =
+    storage_format == StorageFormat::full_precision ?
+      Utilities::pow<unsigned int>(this->get_degree() + 1, dim) :
+      GeometryInfo<dim>::vertices_per_cell;
+  const auto ptr =
+    support_point_cache->points.begin() + data_index * n_points_per_cell;
   return boost::container::small_vector<Point<spacedim>,
                                         GeometryInfo<dim>::vertices_per_cell>(
     ptr, ptr + cell->n_vertices());
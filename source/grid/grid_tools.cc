@@ -17,6 +17,7 @@
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi.templates.h>
 #include <deal.II/base/mpi_consensus_algorithms.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/thread_management.h>
 
@@ -5911,6 +5912,175 @@ namespace GridTools
 
 
 
+  template <int dim, int spacedim>
+  std::pair<
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>,
+    std::vector<Point<dim>>>
+  find_active_cells_around_points(const Cache<dim, spacedim> &        cache,
+                                  const std::vector<Point<spacedim>> &points,
+                                  const double tolerance)
+  {
+    AssertThrow((dim == spacedim),
+                ExcMessage("Only implemented for dim==spacedim."));
+
+    namespace bgi = boost::geometry::index;
+    using active_cell_iterator =
+      typename Triangulation<dim, spacedim>::active_cell_iterator;
+
+    const auto &       mapping  = cache.get_mapping();
+    const unsigned int n_points = points.size();
+
+    std::vector<active_cell_iterator> cells(n_points,
+                                            cache.get_triangulation().end());
+    std::vector<Point<dim>>           reference_points(n_points);
+    if (n_points == 0)
+      return std::make_pair(std::move(cells), std::move(reference_points));
+
+    // Step 1: collect the candidate cells of all points, i.e., the cells
+    // whose bounding box contains the point, in compressed row storage. The
+    // points are split into chunks that are processed in parallel. Note that
+    // the rtree needs to be built before entering the parallel region.
+    const auto &b_tree = cache.get_cell_bounding_boxes_rtree();
+
+    const unsigned int chunk_size = 256;
+    const unsigned int n_chunks   = (n_points + chunk_size - 1) / chunk_size;
+    std::vector<std::vector<active_cell_iterator>> chunk_candidates(n_chunks);
+    std::vector<unsigned int> candidate_ptrs(n_points + 1, 0);
+    parallel::apply_to_subranges(
+      0U,
+      n_chunks,
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<std::pair<BoundingBox<spacedim>, active_cell_iterator>>
+          boxes;
+        for (unsigned int c = begin; c < end; ++c)
+          for (unsigned int i = c * chunk_size;
+               i < std::min(n_points, (c + 1) * chunk_size);
+               ++i)
+            {
+              boxes.clear();
+              b_tree.query(bgi::intersects(points[i]),
+                           std::back_inserter(boxes));
+              for (const auto &box : boxes)
+                if (box.second->is_artificial() == false)
+                  {
+                    chunk_candidates[c].push_back(box.second);
+                    ++candidate_ptrs[i + 1];
+                  }
+            }
+      },
+      1);
+    std::partial_sum(candidate_ptrs.begin(),
+                     candidate_ptrs.end(),
+                     candidate_ptrs.begin());
+
+    std::vector<active_cell_iterator> candidates;
+    candidates.reserve(candidate_ptrs.back());
+    for (auto &chunk : chunk_candidates)
+      {
+        candidates.insert(candidates.end(), chunk.begin(), chunk.end());
+        std::vector<active_cell_iterator>().swap(chunk);
+      }
+
+    // Step 2: check the candidates of all points, starting with the first
+    // candidate of every point. The points are grouped by their current
+    // candidate cell, such that all points of a cell are transformed to the
+    // reference cell at once, which allows the mapping to work on several
+    // points simultaneously. The cells are processed in parallel. The points
+    // that are not inside their current candidate cell are checked against
+    // their next candidate in the next round.
+    std::vector<unsigned int> pending_points(n_points);
+    std::iota(pending_points.begin(), pending_points.end(), 0U);
+    std::vector<std::pair<unsigned int, unsigned int>> cell_and_point;
+    std::vector<unsigned int>                          cell_ptrs;
+    std::vector<unsigned char> point_found(n_points, 0);
+    std::vector<unsigned int>  unresolved_points;
+
+    for (unsigned int round = 0; !pending_points.empty(); ++round)
+      {
+        cell_and_point.clear();
+        for (const unsigned int i : pending_points)
+          if (candidate_ptrs[i] + round < candidate_ptrs[i + 1])
+            cell_and_point.emplace_back(
+              candidates[candidate_ptrs[i] + round]->active_cell_index(), i);
+          else
+            unresolved_points.push_back(i);
+        std::sort(cell_and_point.begin(), cell_and_point.end());
+
+        cell_ptrs.clear();
+        for (unsigned int k = 0; k < cell_and_point.size(); ++k)
+          if (k == 0 || cell_and_point[k].first != cell_and_point[k - 1].first)
+            cell_ptrs.push_back(k);
+        cell_ptrs.push_back(cell_and_point.size());
+
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(cell_ptrs.size() - 1),
+          [&](const unsigned int begin, const unsigned int end) {
+            std::vector<Point<spacedim>> real_points;
+            std::vector<Point<dim>>      unit_points;
+            for (unsigned int c = begin; c < end; ++c)
+              {
+                const unsigned int first_point =
+                  cell_and_point[cell_ptrs[c]].second;
+                const active_cell_iterator &cell =
+                  candidates[candidate_ptrs[first_point] + round];
+
+                real_points.clear();
+                for (unsigned int k = cell_ptrs[c]; k < cell_ptrs[c + 1]; ++k)
+                  real_points.push_back(points[cell_and_point[k].second]);
+                unit_points.resize(real_points.size());
+
+                mapping.transform_points_real_to_unit_cell(cell,
+                                                           real_points,
+                                                           unit_points);
+
+                for (unsigned int k = cell_ptrs[c], q = 0;
+                     k < cell_ptrs[c + 1];
+                     ++k, ++q)
+                  if (unit_points[q][0] !=
+                        std::numeric_limits<double>::infinity() &&
+                      cell->reference_cell().contains_point(unit_points[q],
+                                                            tolerance))
+                    {
+                      const unsigned int i = cell_and_point[k].second;
+                      cells[i]             = cell;
+                      reference_points[i]  = unit_points[q];
+                      point_found[i]       = 1;
+                    }
+              }
+          },
+          16);
+
+        pending_points.clear();
+        for (const auto &entry : cell_and_point)
+          if (point_found[entry.second] == 0)
+            pending_points.push_back(entry.second);
+      }
+
+    // Step 3: search the points that are not inside any of their candidate
+    // cells with the more expensive algorithm that also considers cells
+    // in the vicinity of the closest vertex. As in step 1, artificial cells
+    // are not accepted
+    std::sort(unresolved_points.begin(), unresolved_points.end());
+    active_cell_iterator cell_hint;
+    for (const unsigned int i : unresolved_points)
+      {
+        const auto cell_and_reference_point = find_active_cell_around_point(
+          cache, points[i], cell_hint, {}, tolerance);
+        if (cell_and_reference_point.first.state() == IteratorState::valid &&
+            cell_and_reference_point.first->is_artificial() == false)
+          {
+            cells[i]            = cell_and_reference_point.first;
+            reference_points[i] = cell_and_reference_point.second;
+            cell_hint           = cells[i];
+          }
+      }
+
+    return std::make_pair(std::move(cells), std::move(reference_points));
+  }
+
+
+
   template <int dim, int spacedim>
 #ifndef DOXYGEN
   std::tuple<
@@ -21,6 +21,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <numeric>
 #include <set>
@@ -28,6 +30,186 @@
 DEAL_II_NAMESPACE_OPEN
 
 
+namespace internal
+{
+  namespace DynamicSparsityPatternImplementation
+  {
+    namespace
+    {
+      /**
+       * The source of the identifiers of the pools.
+       */
+      std::atomic<std::uint64_t> next_pool_id(0);
+
+      /**
+       * The identifier of the pool the current thread has used last, and the
+       * arena of the thread in that pool.
+       */
+      thread_local std::uint64_t last_pool_id    = std::uint64_t(-1);
+      thread_local void *        last_pool_arena = nullptr;
+    } // namespace
+
+
+
+    EntryPool::EntryPool()
+      : id(next_pool_id++)
+      , chunk_bytes(0)
+      , large_block_bytes(0)
+    {}
+
+
+
+    EntryPool::Arena::Arena()
+      : chunk_size(0)
+      , chunk_fill(0)
+    {
+      free_lists.fill(nullptr);
+    }
+
+
+
+    unsigned int
+    EntryPool::size_class(const std::size_t n_bytes)
+    {
+      AssertIndexRange(n_bytes, max_block_size + 1);
+      if (n_bytes <= 4 * min_block_size)
+        return n_bytes <= min_block_size ?
+                 0 :
+                 (n_bytes + min_block_size - 1) / min_block_size - 1;
+
+      // find the power of two p with 2^p < n_bytes <= 2^(p+1) and split the
+      // interval into four classes of size 2^(p-2)
+      unsigned int p = 6;
+      while ((std::size_t(1) << (p + 1)) < n_bytes)
+        ++p;
+      const std::size_t step = std::size_t(1) << (p - 2);
+      const unsigned int sub =
+        (n_bytes - (std::size_t(1) << p) + step - 1) / step;
+      return 4 * (p - 5) + sub - 1;
+    }
+
+
+
+    std::size_t
+    EntryPool::class_size(const unsigned int c)
+    {
+      AssertIndexRange(c, n_size_classes);
+      if (c < 4)
+        return (c + 1) * min_block_size;
+      const unsigned int p = c / 4 + 5;
+      return (std::size_t(1) << p) + (c % 4 + 1) * (std::size_t(1) << (p - 2));
+    }
+
+
+
+    void
+    EntryPool::Arena::push_block(void *block, const unsigned int c)
+    {
+      // the link to the next free block is stored in the first bytes of the
+      // block. use memcpy rather than a cast to not violate aliasing rules
+      std::memcpy(block, &free_lists[c], sizeof(void *));
+      free_lists[c] = block;
+    }
+
+
+
+    EntryPool::Arena &
+    EntryPool::get_arena()
+    {
+      if (last_pool_id != id)
+        {
+          last_pool_arena = &arenas.get();
+          last_pool_id    = id;
+        }
+      return *static_cast<Arena *>(last_pool_arena);
+    }
+
+
+
+    void *
+    EntryPool::allocate(const std::size_t n_bytes)
+    {
+      if (n_bytes > max_block_size)
+        {
+          large_block_bytes += n_bytes;
+          return ::operator new(n_bytes);
+        }
+
+      const unsigned int c          = size_class(n_bytes);
+      const std::size_t  block_size = class_size(c);
+      Arena &            arena      = get_arena();
+
+      // first try to recycle a block of the right size
+      if (arena.free_lists[c] != nullptr)
+        {
+          void *block = arena.free_lists[c];
+          std::memcpy(&arena.free_lists[c], block, sizeof(void *));
+          return block;
+        }
+
+      // then carve a new block from the current chunk. if it is too small,
+      // put its remainder onto the free lists (it is a multiple of the
+      // smallest block size since all blocks are) and start a new chunk
+      if (arena.chunk_fill + block_size > arena.chunk_size)
+        {
+          for (unsigned int k = n_size_classes; k-- > 0;)
+            while (arena.chunk_size - arena.chunk_fill >= class_size(k))
+              {
+                arena.push_block(arena.chunks.back().get() + arena.chunk_fill,
+                                 k);
+                arena.chunk_fill += class_size(k);
+              }
+          Assert(arena.chunk_fill == arena.chunk_size, ExcInternalError());
+
+          arena.chunk_size =
+            std::max(std::min(2 * arena.chunk_size, max_chunk_size),
+                     std::max(min_chunk_size, block_size));
+          arena.chunks.emplace_back(new char[arena.chunk_size]);
+          arena.chunk_fill = 0;
+          chunk_bytes += arena.chunk_size;
+        }
+
+      void *block = arena.chunks.back().get() + arena.chunk_fill;
+      arena.chunk_fill += block_size;
+      return block;
+    }
+
+
+
+    void
+    EntryPool::deallocate(void *block, const std::size_t n_bytes)
+    {
+      if (n_bytes > max_block_size)
+        {
+          ::operator delete(block);
+          large_block_bytes -= n_bytes;
+          return;
+        }
+
+      get_arena().push_block(block, size_class(n_bytes));
+    }
+
+
+
+    void
+    EntryPool::clear()
+    {
+      arenas.clear();
+      id          = next_pool_id++;
+      chunk_bytes = 0;
+    }
+
+
+
+    std::size_t
+    EntryPool::memory_consumption() const
+    {
+      return sizeof(*this) + chunk_bytes + large_block_bytes;
+    }
+  } // namespace DynamicSparsityPatternImplementation
+} // namespace internal
+
+
 
 template <typename ForwardIterator>
 void
@@ -64,9 +246,9 @@ DynamicSparsityPattern::Line::add_entries(ForwardIterator begin,
       // the first entry. check whether the
       // first entry is a duplicate before
       // actually doing something.
-      ForwardIterator                  my_it = begin;
-      size_type                        col   = *my_it;
-      std::vector<size_type>::iterator it =
+      ForwardIterator   my_it = begin;
+      size_type         col   = *my_it;
+      Entries::iterator it =
         Utilities::lower_bound(entries.begin(), entries.end(), col);
       while (*it == col)
         {
@@ -103,7 +285,7 @@ DynamicSparsityPattern::Line::add_entries(ForwardIterator begin,
              ExcInternalError());
 
       // now merge the two lists.
-      std::vector<size_type>::iterator it2 = it + (end - my_it);
+      Entries::iterator it2 = it + (end - my_it);
 
       // as long as there are indices both in
       // the end of the entries list and in the
@@ -146,8 +328,8 @@ DynamicSparsityPattern::Line::add_entries(ForwardIterator begin,
   if (stop_size > entries.capacity())
     entries.reserve(stop_size);
 
-  size_type                        col = *my_it;
-  std::vector<size_type>::iterator it, it2;
+  size_type         col = *my_it;
+  Entries::iterator it, it2;
   // insert the first element as for one
   // entry only first check the last
   // element (or if line is still empty)
@@ -223,6 +405,8 @@ DynamicSparsityPattern::DynamicSparsityPattern()
   : SparsityPatternBase()
   , have_entries(false)
   , rowset(0)
+  , entry_pool(
+      std::make_unique<internal::DynamicSparsityPatternImplementation::EntryPool>())
 {}
 
 
@@ -231,6 +415,8 @@ DynamicSparsityPattern::DynamicSparsityPattern(const DynamicSparsityPattern &s)
   : SparsityPatternBase()
   , have_entries(false)
   , rowset(0)
+  , entry_pool(
+      std::make_unique<internal::DynamicSparsityPatternImplementation::EntryPool>())
 {
   (void)s;
   Assert(s.rows == 0 && s.cols == 0,
@@ -248,6 +434,8 @@ DynamicSparsityPattern::DynamicSparsityPattern(const size_type m,
   : SparsityPatternBase()
   , have_entries(false)
   , rowset(0)
+  , entry_pool(
+      std::make_unique<internal::DynamicSparsityPatternImplementation::EntryPool>())
 {
   reinit(m, n, rowset_);
 }
@@ -257,6 +445,8 @@ DynamicSparsityPattern::DynamicSparsityPattern(const IndexSet &rowset_)
   : SparsityPatternBase()
   , have_entries(false)
   , rowset(0)
+  , entry_pool(
+      std::make_unique<internal::DynamicSparsityPatternImplementation::EntryPool>())
 {
   reinit(rowset_.size(), rowset_.size(), rowset_);
 }
@@ -266,6 +456,8 @@ DynamicSparsityPattern::DynamicSparsityPattern(const size_type n)
   : SparsityPatternBase()
   , have_entries(false)
   , rowset(0)
+  , entry_pool(
+      std::make_unique<internal::DynamicSparsityPatternImplementation::EntryPool>())
 {
   reinit(n, n);
 }
@@ -309,9 +501,16 @@ DynamicSparsityPattern::reinit(const size_type m,
            "of indices in this IndexSet may be less than the number "
            "of rows, but the *size* of the IndexSet must be equal.)"));
 
-  std::vector<Line> new_lines(rowset.size() == 0 ? n_rows() :
-                                                   rowset.n_elements());
-  lines.swap(new_lines);
+  // release the old rows, which returns their memory to the pool, before
+  // releasing the memory of the pool itself
+  {
+    std::vector<Line> tmp;
+    lines.swap(tmp);
+  }
+  entry_pool->clear();
+
+  lines.resize(rowset.size() == 0 ? n_rows() : rowset.n_elements(),
+               Line(entry_pool.get()));
 }
 
 
@@ -428,7 +627,8 @@ DynamicSparsityPattern::clear_row(const size_type row)
     rowset.size() == 0 ? row : rowset.index_within_set(row);
 
   AssertIndexRange(rowindex, lines.size());
-  lines[rowindex].entries = std::vector<size_type>();
+  Line::Entries tmp(lines[rowindex].entries.get_allocator());
+  lines[rowindex].entries.swap(tmp);
 }
 
 
@@ -448,7 +648,8 @@ DynamicSparsityPattern::get_view(const IndexSet &rows) const
         rowset.size() == 0 ? *it : rowset.index_within_set(*it);
 
       view.lines[view_row].entries = lines[rowindex].entries;
-      view.have_entries |= (lines[rowindex].entries.size() > 0);
+      if (lines[rowindex].entries.size() > 0)
+        view.have_entries = true;
     }
   return view;
 }
@@ -649,8 +850,8 @@ DynamicSparsityPattern::memory_consumption() const
                   MemoryConsumption::memory_consumption(rowset) -
                   sizeof(rowset);
 
-  for (const auto &line : lines)
-    mem += MemoryConsumption::memory_consumption(line);
+  // the column indices of all rows are stored in the pool
+  mem += lines.capacity() * sizeof(Line) + entry_pool->memory_consumption();
 
   return mem;
 }
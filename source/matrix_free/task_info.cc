@@ -28,33 +28,16 @@
 
 
 #ifdef DEAL_II_WITH_TBB
-#  include <tbb/blocked_range.h>
-#  include <tbb/parallel_for.h>
-#  include <tbb/task.h>
-#  ifndef DEAL_II_TBB_WITH_ONEAPI
-#    include <tbb/task_scheduler_init.h>
-#  endif
+#  include <tbb/task_group.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <set>
 
-//
-// TBB with oneAPI API has deprecated and removed the
-// <code>tbb::tasks</code> backend. With this it is no longer possible to
-// compile the following code that builds a directed acyclic graph (DAG) of
-// (thread parallel) tasks without a major porting effort. It turned out
-// that such a dynamic handling of dependencies and structures is not as
-// competitive as initially assumed. Consequently, this part of the matrix
-// free infrastructure has seen less attention than the rest over the last
-// years and is (presumably) not used that often.
-//
-// In case of detected oneAPI backend we simply disable threading in the
-// matrix free backend for now.
-//
-// Matthias Maier, Martin Kronbichler, 2021
-//
-
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -64,284 +47,188 @@ namespace internal
 {
   namespace MatrixFreeFunctions
   {
-#if defined(DEAL_II_WITH_TBB) && !defined(DEAL_II_TBB_WITH_ONEAPI)
+    void
+    TaskGraph::clear()
+    {
+      nodes.clear();
+      n_predecessors.clear();
+      successor_start.clear();
+      successors.clear();
+      edges.clear();
+    }
+
 
-    // This defines the TBB data structures that are needed to schedule the
-    // partition-partition variant
 
-    namespace partition
+    unsigned int
+    TaskGraph::add_node(const NodeType     type,
+                        const unsigned int first,
+                        const unsigned int second)
     {
-      class ActualCellWork
-      {
-      public:
-        ActualCellWork(MFWorkerInterface **worker_pointer,
-                       const unsigned int  partition,
-                       const TaskInfo &    task_info)
-          : worker(nullptr)
-          , worker_pointer(worker_pointer)
-          , partition(partition)
-          , task_info(task_info)
-        {}
-
-        ActualCellWork(MFWorkerInterface &worker,
-                       const unsigned int partition,
-                       const TaskInfo &   task_info)
-          : worker(&worker)
-          , worker_pointer(nullptr)
-          , partition(partition)
-          , task_info(task_info)
-        {}
-
-        void
-        operator()() const
-        {
-          MFWorkerInterface *used_worker =
-            worker != nullptr ? worker : *worker_pointer;
-          Assert(used_worker != nullptr, ExcInternalError());
-          used_worker->cell(partition);
+      nodes.push_back(Node{type, first, second});
+      return nodes.size() - 1;
+    }
 
-          if (task_info.face_partition_data.empty() == false)
-            {
-              used_worker->face(partition);
-              used_worker->boundary(partition);
-            }
-        }
 
-      private:
-        MFWorkerInterface * worker;
-        MFWorkerInterface **worker_pointer;
-        const unsigned int  partition;
-        const TaskInfo &    task_info;
-      };
 
-      class CellWork : public tbb::task
-      {
-      public:
-        CellWork(MFWorkerInterface &worker,
-                 const unsigned int partition,
-                 const TaskInfo &   task_info,
-                 const bool         is_blocked)
-          : dummy(nullptr)
-          , work(worker, partition, task_info)
-          , is_blocked(is_blocked)
-        {}
-
-        tbb::task *
-        execute() override
-        {
-          work();
+    void
+    TaskGraph::add_edge(const unsigned int from, const unsigned int to)
+    {
+      AssertIndexRange(from, nodes.size());
+      AssertIndexRange(to, nodes.size());
+      edges.emplace_back(from, to);
+    }
+
+
 
-          if (is_blocked == true)
-            tbb::empty_task::spawn(*dummy);
-          return nullptr;
+    void
+    TaskGraph::finalize()
+    {
+      n_predecessors.clear();
+      n_predecessors.resize(nodes.size(), 0);
+      successor_start.clear();
+      successor_start.resize(nodes.size() + 1, 0);
+      for (const auto &edge : edges)
+        {
+          ++successor_start[edge.first + 1];
+          ++n_predecessors[edge.second];
         }
+      for (unsigned int i = 0; i < nodes.size(); ++i)
+        successor_start[i + 1] += successor_start[i];
 
-        tbb::empty_task *dummy;
+      successors.resize(edges.size());
+      std::vector<unsigned int> position(successor_start.begin(),
+                                         successor_start.end() - 1);
+      for (const auto &edge : edges)
+        successors[position[edge.first]++] = edge.second;
 
-      private:
-        ActualCellWork work;
-        const bool     is_blocked;
-      };
+      edges.clear();
+      edges.shrink_to_fit();
+    }
 
 
 
-      class PartitionWork : public tbb::task
-      {
-      public:
-        PartitionWork(MFWorkerInterface &function_in,
-                      const unsigned int partition_in,
-                      const TaskInfo &   task_info_in,
-                      const bool         is_blocked_in = false)
-          : dummy(nullptr)
-          , function(function_in)
-          , partition(partition_in)
-          , task_info(task_info_in)
-          , is_blocked(is_blocked_in)
-        {}
-
-        tbb::task *
-        execute() override
-        {
-          tbb::empty_task *root =
-            new (tbb::task::allocate_root()) tbb::empty_task;
-          const unsigned int evens = task_info.partition_evens[partition];
-          const unsigned int odds  = task_info.partition_odds[partition];
-          const unsigned int n_blocked_workers =
-            task_info.partition_n_blocked_workers[partition];
-          const unsigned int n_workers =
-            task_info.partition_n_workers[partition];
-          std::vector<CellWork *> worker(n_workers);
-          std::vector<CellWork *> blocked_worker(n_blocked_workers);
-
-          root->set_ref_count(evens + 1);
-          for (unsigned int j = 0; j < evens; ++j)
-            {
-              worker[j] = new (root->allocate_child())
-                CellWork(function,
-                         task_info.partition_row_index[partition] + 2 * j,
-                         task_info,
-                         false);
-              if (j > 0)
-                {
-                  worker[j]->set_ref_count(2);
-                  blocked_worker[j - 1]->dummy =
-                    new (worker[j]->allocate_child()) tbb::empty_task;
-                  tbb::task::spawn(*blocked_worker[j - 1]);
-                }
-              else
-                worker[j]->set_ref_count(1);
-              if (j < evens - 1)
-                {
-                  blocked_worker[j] = new (worker[j]->allocate_child())
-                    CellWork(function,
-                             task_info.partition_row_index[partition] + 2 * j +
-                               1,
-                             task_info,
-                             true);
-                }
-              else
-                {
-                  if (odds == evens)
-                    {
-                      worker[evens] = new (worker[j]->allocate_child())
-                        CellWork(function,
-                                 task_info.partition_row_index[partition] +
-                                   2 * j + 1,
-                                 task_info,
-                                 false);
-                      tbb::task::spawn(*worker[evens]);
-                    }
-                  else
-                    {
-                      tbb::empty_task *child =
-                        new (worker[j]->allocate_child()) tbb::empty_task();
-                      tbb::task::spawn(*child);
-                    }
-                }
-            }
+    bool
+    TaskGraph::empty() const
+    {
+      return nodes.empty();
+    }
 
-          root->wait_for_all();
-          root->destroy(*root);
-          if (is_blocked == true)
-            tbb::empty_task::spawn(*dummy);
-          return nullptr;
-        }
 
-        tbb::empty_task *dummy;
 
-      private:
-        MFWorkerInterface &function;
-        const unsigned int partition;
-        const TaskInfo &   task_info;
-        const bool         is_blocked;
-      };
+    std::size_t
+    TaskGraph::memory_consumption() const
+    {
+      return nodes.capacity() * sizeof(Node) +
+             MemoryConsumption::memory_consumption(n_predecessors) +
+             MemoryConsumption::memory_consumption(successor_start) +
+             MemoryConsumption::memory_consumption(successors) +
+             MemoryConsumption::memory_consumption(edges);
+    }
 
-    } // end of namespace partition
 
 
+#ifdef DEAL_II_WITH_TBB
 
-    namespace color
+    namespace
     {
-      class CellWork
+      /**
+       * Run the work associated with a node of the task graph.
+       */
+      void
+      run_node(const TaskGraph::Node &node,
+               const TaskInfo &       task_info,
+               MFWorkerInterface &    worker)
       {
-      public:
-        CellWork(MFWorkerInterface &worker_in,
-                 const TaskInfo &   task_info_in,
-                 const unsigned int partition_in)
-          : worker(worker_in)
-          , task_info(task_info_in)
-          , partition(partition_in)
-        {}
-
-        void
-        operator()(const tbb::blocked_range<unsigned int> &r) const
-        {
-          const unsigned int start_index =
-            task_info.cell_partition_data[partition] +
-            task_info.block_size * r.begin();
-          const unsigned int end_index =
-            std::min(start_index + task_info.block_size * (r.end() - r.begin()),
-                     task_info.cell_partition_data[partition + 1]);
-          worker.cell(std::make_pair(start_index, end_index));
-
-          if (task_info.face_partition_data.empty() == false)
-            {
-              AssertThrow(false, ExcNotImplemented());
-            }
-        }
-
-      private:
-        MFWorkerInterface &worker;
-        const TaskInfo &   task_info;
-        const unsigned int partition;
-      };
+        switch (node.type)
+          {
+            case TaskGraph::NodeType::join:
+              break;
+            case TaskGraph::NodeType::update_ghosts_finish:
+              worker.vector_update_ghosts_finish();
+              break;
+            case TaskGraph::NodeType::compress_start:
+              worker.vector_compress_start();
+              break;
+            case TaskGraph::NodeType::range_index:
+              worker.cell(node.first);
+              if (task_info.face_partition_data.empty() == false)
+                {
+                  worker.face(node.first);
+                  worker.boundary(node.first);
+                }
+              break;
+            case TaskGraph::NodeType::cell_range:
+              // a range might consist of several blocks merged by
+              // create_flow_graph(), which are passed on one by one because
+              // only the cells within a block are sorted by the active FE
+              // index in the hp-case
+              for (unsigned int cell = node.first; cell < node.second;
+                   cell += task_info.block_size)
+                worker.cell(std::make_pair(
+                  cell, std::min(cell + task_info.block_size, node.second)));
+              if (task_info.face_partition_data.empty() == false)
+                {
+                  AssertThrow(false, ExcNotImplemented());
+                }
+              break;
+            default:
+              Assert(false, ExcInternalError());
+          }
+      }
 
 
 
-      class PartitionWork : public tbb::task
+      /**
+       * Run all nodes of the task graph of @p task_info. A node is spawned
+       * as a task once the counter of its unfinished predecessors drops to
+       * zero. To save on scheduling overhead, a finishing task directly
+       * continues with one of the successors it has made ready and only
+       * spawns the others.
+       */
+      void
+      run_task_graph(const TaskInfo &task_info, MFWorkerInterface &worker)
       {
-      public:
-        PartitionWork(MFWorkerInterface &worker_in,
-                      const unsigned int partition_in,
-                      const TaskInfo &   task_info_in,
-                      const bool         is_blocked_in)
-          : dummy(nullptr)
-          , worker(worker_in)
-          , partition(partition_in)
-          , task_info(task_info_in)
-          , is_blocked(is_blocked_in)
-        {}
-
-        tbb::task *
-        execute() override
-        {
-          const unsigned int n_chunks =
-            (task_info.cell_partition_data[partition + 1] -
-             task_info.cell_partition_data[partition] + task_info.block_size -
-             1) /
-            task_info.block_size;
-          parallel_for(tbb::blocked_range<unsigned int>(0, n_chunks, 1),
-                       CellWork(worker, task_info, partition));
-          if (is_blocked == true)
-            tbb::empty_task::spawn(*dummy);
-          return nullptr;
-        }
+        const TaskGraph &  graph   = task_info.task_graph;
+        const unsigned int n_nodes = graph.nodes.size();
 
-        tbb::empty_task *dummy;
+        std::unique_ptr<std::atomic<unsigned int>[]> n_unfinished(
+          new std::atomic<unsigned int>[n_nodes]);
+        for (unsigned int i = 0; i < n_nodes; ++i)
+          n_unfinished[i].store(graph.n_predecessors[i],
+                                std::memory_order_relaxed);
 
-      private:
-        MFWorkerInterface &worker;
-        const unsigned int partition;
-        const TaskInfo &   task_info;
-        const bool         is_blocked;
-      };
+        tbb::task_group task_group;
 
-    } // end of namespace color
+        std::function<void(unsigned int)> process = [&](unsigned int node) {
+          while (node != numbers::invalid_unsigned_int)
+            {
+              run_node(graph.nodes[node], task_info, worker);
 
+              unsigned int next = numbers::invalid_unsigned_int;
+              for (unsigned int j = graph.successor_start[node];
+                   j < graph.successor_start[node + 1];
+                   ++j)
+                {
+                  const unsigned int successor = graph.successors[j];
+                  if (n_unfinished[successor].fetch_sub(
+                        1, std::memory_order_acq_rel) == 1)
+                    {
+                      if (next != numbers::invalid_unsigned_int)
+                        task_group.run([&process, next]() { process(next); });
+                      next = successor;
+                    }
+                }
+              node = next;
+            }
+        };
 
+        for (unsigned int i = 0; i < n_nodes; ++i)
+          if (graph.n_predecessors[i] == 0)
+            task_group.run([&process, i]() { process(i); });
 
-    class MPICommunication : public tbb::task
-    {
-    public:
-      MPICommunication(MFWorkerInterface &worker_in, const bool do_compress)
-        : worker(worker_in)
-        , do_compress(do_compress)
-      {}
-
-      tbb::task *
-      execute() override
-      {
-        if (do_compress == false)
-          worker.vector_update_ghosts_finish();
-        else
-          worker.vector_compress_start();
-        return nullptr;
+        task_group.wait();
       }
-
-    private:
-      MFWorkerInterface &worker;
-      const bool         do_compress;
-    };
+    } // namespace
 
 #endif // DEAL_II_WITH_TBB
 
@@ -362,244 +249,21 @@ namespace internal
 
       funct.vector_update_ghosts_start();
 
-#if defined(DEAL_II_WITH_TBB) && !defined(DEAL_II_TBB_WITH_ONEAPI)
+#ifdef DEAL_II_WITH_TBB
 
       if (scheme != none)
         {
           funct.zero_dst_vector_range(numbers::invalid_unsigned_int);
-          if (scheme == partition_partition && evens > 0)
-            {
-              tbb::empty_task *root =
-                new (tbb::task::allocate_root()) tbb::empty_task;
-              root->set_ref_count(evens + 1);
-              std::vector<partition::PartitionWork *> worker(n_workers);
-              std::vector<partition::PartitionWork *> blocked_worker(
-                n_blocked_workers);
-              MPICommunication *worker_compr =
-                new (root->allocate_child()) MPICommunication(funct, true);
-              worker_compr->set_ref_count(1);
-              for (unsigned int j = 0; j < evens; ++j)
-                {
-                  if (j > 0)
-                    {
-                      worker[j] = new (root->allocate_child())
-                        partition::PartitionWork(funct, 2 * j, *this, false);
-                      worker[j]->set_ref_count(2);
-                      blocked_worker[j - 1]->dummy =
-                        new (worker[j]->allocate_child()) tbb::empty_task;
-                      tbb::task::spawn(*blocked_worker[j - 1]);
-                    }
-                  else
-                    {
-                      worker[j] = new (worker_compr->allocate_child())
-                        partition::PartitionWork(funct, 2 * j, *this, false);
-                      worker[j]->set_ref_count(2);
-                      MPICommunication *worker_dist =
-                        new (worker[j]->allocate_child())
-                          MPICommunication(funct, false);
-                      tbb::task::spawn(*worker_dist);
-                    }
-                  if (j < evens - 1)
-                    {
-                      blocked_worker[j] = new (worker[j]->allocate_child())
-                        partition::PartitionWork(funct, 2 * j + 1, *this, true);
-                    }
-                  else
-                    {
-                      if (odds == evens)
-                        {
-                          worker[evens] = new (worker[j]->allocate_child())
-                            partition::PartitionWork(funct,
-                                                     2 * j + 1,
-                                                     *this,
-                                                     false);
-                          tbb::task::spawn(*worker[evens]);
-                        }
-                      else
-                        {
-                          tbb::empty_task *child =
-                            new (worker[j]->allocate_child()) tbb::empty_task();
-                          tbb::task::spawn(*child);
-                        }
-                    }
-                }
-
-              root->wait_for_all();
-              root->destroy(*root);
-            }
-          else if (scheme == partition_partition)
+          if (task_graph.empty() == false)
+            run_task_graph(*this, funct);
+          else
             {
-              // catch the case of empty partition list: we still need to call
+              // catch the case of an empty cell range: we still need to call
               // the vector communication routines to clean up and initiate
               // things
               funct.vector_update_ghosts_finish();
               funct.vector_compress_start();
             }
-          else // end of partition-partition, start of partition-color
-            {
-              // check whether there is only one partition. if not, build up the
-              // tree of partitions
-              if (odds > 0)
-                {
-                  tbb::empty_task *root =
-                    new (tbb::task::allocate_root()) tbb::empty_task;
-                  root->set_ref_count(evens + 1);
-                  const unsigned int n_blocked_workers =
-                    odds - (odds + evens + 1) % 2;
-                  const unsigned int n_workers =
-                    cell_partition_data.size() - 1 - n_blocked_workers;
-                  std::vector<color::PartitionWork *> worker(n_workers);
-                  std::vector<color::PartitionWork *> blocked_worker(
-                    n_blocked_workers);
-                  unsigned int      worker_index = 0, slice_index = 0;
-                  int               spawn_index_child = -2;
-                  MPICommunication *worker_compr =
-                    new (root->allocate_child()) MPICommunication(funct, true);
-                  worker_compr->set_ref_count(1);
-                  for (unsigned int part = 0;
-                       part < partition_row_index.size() - 1;
-                       part++)
-                    {
-                      if (part == 0)
-                        worker[worker_index] =
-                          new (worker_compr->allocate_child())
-                            color::PartitionWork(funct,
-                                                 slice_index,
-                                                 *this,
-                                                 false);
-                      else
-                        worker[worker_index] = new (root->allocate_child())
-                          color::PartitionWork(funct,
-                                               slice_index,
-                                               *this,
-                                               false);
-                      slice_index++;
-                      for (; slice_index < partition_row_index[part + 1];
-                           slice_index++)
-                        {
-                          worker[worker_index]->set_ref_count(1);
-                          worker_index++;
-                          worker[worker_index] =
-                            new (worker[worker_index - 1]->allocate_child())
-                              color::PartitionWork(funct,
-                                                   slice_index,
-                                                   *this,
-                                                   false);
-                        }
-                      worker[worker_index]->set_ref_count(2);
-                      if (part > 0)
-                        {
-                          blocked_worker[(part - 1) / 2]->dummy =
-                            new (worker[worker_index]->allocate_child())
-                              tbb::empty_task;
-                          worker_index++;
-                          if (spawn_index_child == -1)
-                            tbb::task::spawn(*blocked_worker[(part - 1) / 2]);
-                          else
-                            {
-                              Assert(spawn_index_child >= 0,
-                                     ExcInternalError());
-                              tbb::task::spawn(*worker[spawn_index_child]);
-                            }
-                          spawn_index_child = -2;
-                        }
-                      else
-                        {
-                          MPICommunication *worker_dist =
-                            new (worker[worker_index]->allocate_child())
-                              MPICommunication(funct, false);
-                          tbb::task::spawn(*worker_dist);
-                          worker_index++;
-                        }
-                      part += 1;
-                      if (part < partition_row_index.size() - 1)
-                        {
-                          if (part < partition_row_index.size() - 2)
-                            {
-                              blocked_worker[part / 2] =
-                                new (worker[worker_index - 1]->allocate_child())
-                                  color::PartitionWork(funct,
-                                                       slice_index,
-                                                       *this,
-                                                       true);
-                              slice_index++;
-                              if (slice_index < partition_row_index[part + 1])
-                                {
-                                  blocked_worker[part / 2]->set_ref_count(1);
-                                  worker[worker_index] = new (
-                                    blocked_worker[part / 2]->allocate_child())
-                                    color::PartitionWork(funct,
-                                                         slice_index,
-                                                         *this,
-                                                         false);
-                                  slice_index++;
-                                }
-                              else
-                                {
-                                  spawn_index_child = -1;
-                                  continue;
-                                }
-                            }
-                          for (; slice_index < partition_row_index[part + 1];
-                               slice_index++)
-                            {
-                              if (slice_index > partition_row_index[part])
-                                {
-                                  worker[worker_index]->set_ref_count(1);
-                                  worker_index++;
-                                }
-                              worker[worker_index] =
-                                new (worker[worker_index - 1]->allocate_child())
-                                  color::PartitionWork(funct,
-                                                       slice_index,
-                                                       *this,
-                                                       false);
-                            }
-                          spawn_index_child = worker_index;
-                          worker_index++;
-                        }
-                      else
-                        {
-                          tbb::empty_task *final =
-                            new (worker[worker_index - 1]->allocate_child())
-                              tbb::empty_task;
-                          tbb::task::spawn(*final);
-                          spawn_index_child = worker_index - 1;
-                        }
-                    }
-                  if (evens == odds)
-                    {
-                      Assert(spawn_index_child >= 0, ExcInternalError());
-                      tbb::task::spawn(*worker[spawn_index_child]);
-                    }
-                  root->wait_for_all();
-                  root->destroy(*root);
-                }
-              // case when we only have one partition: this is the usual
-              // coloring scheme, and we just schedule a parallel for loop for
-              // each color
-              else
-                {
-                  Assert(evens <= 1, ExcInternalError());
-                  funct.vector_update_ghosts_finish();
-
-                  for (unsigned int color = 0; color < partition_row_index[1];
-                       ++color)
-                    {
-                      tbb::empty_task *root =
-                        new (tbb::task::allocate_root()) tbb::empty_task;
-                      root->set_ref_count(2);
-                      color::PartitionWork *worker =
-                        new (root->allocate_child())
-                          color::PartitionWork(funct, color, *this, false);
-                      tbb::empty_task::spawn(*worker);
-                      root->wait_for_all();
-                      root->destroy(*root);
-                    }
-
-                  funct.vector_compress_start();
-                }
-            }
         }
       else
 #endif
@@ -679,6 +343,8 @@ namespace internal
       partition_odds.clear();
       partition_n_blocked_workers.clear();
       partition_n_workers.clear();
+      task_graph.clear();
+      cell_batch_cost.clear();
       communicator = MPI_COMM_SELF;
       my_pid       = 0;
       n_procs      = 1;
@@ -714,7 +380,9 @@ namespace internal
         MemoryConsumption::memory_consumption(partition_evens) +
         MemoryConsumption::memory_consumption(partition_odds) +
         MemoryConsumption::memory_consumption(partition_n_blocked_workers) +
-        MemoryConsumption::memory_consumption(partition_n_workers));
+        MemoryConsumption::memory_consumption(partition_n_workers) +
+        MemoryConsumption::memory_consumption(cell_batch_cost) +
+        task_graph.memory_consumption());
     }
 
 
@@ -2346,6 +2014,146 @@ namespace internal
                                       partition_odds[part] -
                                       partition_n_blocked_workers[part];
         }
+
+      create_flow_graph();
+    }
+
+
+
+    void
+    TaskInfo::create_flow_graph()
+    {
+      task_graph.clear();
+      if (scheme == none)
+        return;
+
+      using NodeType = TaskGraph::NodeType;
+
+      const unsigned int ghosts_finish =
+        task_graph.add_node(NodeType::update_ghosts_finish);
+      const unsigned int compress_start =
+        task_graph.add_node(NodeType::compress_start);
+
+      const unsigned int        n_partitions = partition_row_index.size() - 1;
+      std::vector<unsigned int> partition_start(n_partitions);
+      std::vector<unsigned int> partition_done(n_partitions);
+      for (unsigned int part = 0; part < n_partitions; ++part)
+        {
+          partition_start[part] = task_graph.add_node(NodeType::join);
+          partition_done[part]  = task_graph.add_node(NodeType::join);
+          task_graph.add_edge(partition_start[part], partition_done[part]);
+        }
+
+      // The partitions are layers in the sense of Cuthill-McKee, so the
+      // cells of a partition only conflict with the ones of the same and the
+      // two adjacent partitions. The odd partitions can hence be worked on
+      // right away, whereas an even partition has to wait for its odd
+      // neighbors. The cells that need ghost data, and that write into the
+      // entries sent by the compress operation, are in partition zero.
+      for (unsigned int part = 0; part < n_partitions; part += 2)
+        {
+          if (part > 0)
+            task_graph.add_edge(partition_done[part - 1],
+                                partition_start[part]);
+          if (part + 1 < n_partitions)
+            task_graph.add_edge(partition_done[part + 1],
+                                partition_start[part]);
+        }
+      if (n_partitions > 0)
+        {
+          task_graph.add_edge(ghosts_finish, partition_start[0]);
+          task_graph.add_edge(partition_done[0], compress_start);
+        }
+      else
+        task_graph.add_edge(ghosts_finish, compress_start);
+
+      for (unsigned int part = 0; part < n_partitions; ++part)
+        if (scheme == partition_partition)
+          {
+            // the same structure on the second level: the odd chunks within
+            // the partition are independent, the even ones wait for their
+            // odd neighbors
+            const unsigned int first_node = task_graph.nodes.size();
+            const unsigned int n_chunks =
+              partition_row_index[part + 1] - partition_row_index[part];
+            for (unsigned int i = 0; i < n_chunks; ++i)
+              {
+                const unsigned int node =
+                  task_graph.add_node(NodeType::range_index,
+                                      partition_row_index[part] + i);
+                task_graph.add_edge(partition_start[part], node);
+                task_graph.add_edge(node, partition_done[part]);
+              }
+            for (unsigned int i = 0; i < n_chunks; i += 2)
+              {
+                if (i > 0)
+                  task_graph.add_edge(first_node + i - 1, first_node + i);
+                if (i + 1 < n_chunks)
+                  task_graph.add_edge(first_node + i + 1, first_node + i);
+              }
+          }
+        else
+          {
+            // the colors within the partition are worked on one after the
+            // other, with each color split into independent blocks. If the
+            // cell batches have different costs, the block size has been
+            // chosen for the most expensive ones, and consecutive blocks are
+            // merged into one task as long as the cost of the task does not
+            // exceed the one of a block of the most expensive cell batches.
+            Assert(block_size > 0, ExcInternalError());
+            const auto block_cost = [&](const unsigned int begin,
+                                        const unsigned int end) {
+              double cost = 0;
+              for (unsigned int cell = begin; cell < end; ++cell)
+                cost += cell_batch_cost[cell];
+              return cost;
+            };
+            const double max_task_cost =
+              cell_batch_cost.empty() ?
+                0. :
+                block_size * *std::max_element(cell_batch_cost.begin(),
+                                               cell_batch_cost.end());
+
+            unsigned int previous = partition_start[part];
+            for (unsigned int color = partition_row_index[part];
+                 color < partition_row_index[part + 1];
+                 ++color)
+              {
+                const unsigned int color_done =
+                  task_graph.add_node(NodeType::join);
+                task_graph.add_edge(previous, color_done);
+                const unsigned int color_end = cell_partition_data[color + 1];
+                for (unsigned int cell = cell_partition_data[color];
+                     cell < color_end;)
+                  {
+                    unsigned int end = std::min(cell + block_size, color_end);
+                    if (cell_batch_cost.empty() == false)
+                      {
+                        AssertIndexRange(color_end - 1, cell_batch_cost.size());
+                        double cost = block_cost(cell, end);
+                        while (end < color_end)
+                          {
+                            const unsigned int next_end =
+                              std::min(end + block_size, color_end);
+                            const double next_cost = block_cost(end, next_end);
+                            if (cost + next_cost > max_task_cost)
+                              break;
+                            cost += next_cost;
+                            end = next_end;
+                          }
+                      }
+                    const unsigned int node =
+                      task_graph.add_node(NodeType::cell_range, cell, end);
+                    task_graph.add_edge(previous, node);
+                    task_graph.add_edge(node, color_done);
+                    cell = end;
+                  }
+                previous = color_done;
+              }
+            task_graph.add_edge(previous, partition_done[part]);
+          }
+
+      task_graph.finalize();
     }
   } // namespace MatrixFreeFunctions
 } // namespace internal
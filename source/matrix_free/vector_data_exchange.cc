@@ -25,7 +25,9 @@
 
 #include <boost/serialization/utility.hpp>
 
+#include <algorithm>
 #include <map>
+#include <mutex>
 #include <vector>
 
 
@@ -1376,6 +1378,45 @@ namespace internal
 
 
 
+      void
+      Full::synchronize_sm_neighbors() const
+      {
+#ifdef DEAL_II_WITH_MPI
+        if (sm_ghost_ranks.empty() && sm_import_ranks.empty())
+          return;
+
+        const int tag = Utilities::MPI::internal::Tags::
+          vector_data_exchange_synchronize_sm_neighbors;
+
+        // the relation is symmetric: if we read the memory of a process
+        // (it is in sm_ghost_ranks), we are in its list sm_import_ranks and
+        // vice versa, so every message has a matching receive
+        std::vector<MPI_Request> requests;
+        requests.reserve(2 * (sm_ghost_ranks.size() + sm_import_ranks.size()));
+
+        int dummy = 0;
+        for (const auto &ranks : {&sm_ghost_ranks, &sm_import_ranks})
+          for (const unsigned int rank : *ranks)
+            {
+              requests.emplace_back();
+              int ierr = MPI_Irecv(
+                &dummy, 0, MPI_INT, rank, tag, comm_sm, &requests.back());
+              AssertThrowMPI(ierr);
+
+              requests.emplace_back();
+              ierr = MPI_Isend(
+                &dummy, 0, MPI_INT, rank, tag, comm_sm, &requests.back());
+              AssertThrowMPI(ierr);
+            }
+
+        const int ierr =
+          MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+#endif
+      }
+
+
+
       void
       Full::reset_ghost_values(const ArrayView<double> &ghost_array) const
       {
@@ -1417,4 +1458,116 @@ namespace internal
 } // namespace internal
 
 
+
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    namespace internal
+    {
+      std::shared_ptr<const SharedMemoryExchangeBase>
+      get_shared_memory_exchange(
+        const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner,
+        const MPI_Comm &communicator_sm)
+      {
+#ifndef DEAL_II_WITH_MPI
+        (void)partitioner;
+        (void)communicator_sm;
+        return nullptr;
+#else
+        using Exchanger =
+          ::dealii::internal::MatrixFreeFunctions::VectorDataExchange::Full;
+
+        // The cache only holds weak pointers, so an exchanger lives as long
+        // as some vector uses it. The partitioner is also stored as weak
+        // pointer in order to detect a new partitioner at the address of
+        // an expired one. The mutex only protects the cache itself and is
+        // never held during MPI calls.
+        struct CacheEntry
+        {
+          std::weak_ptr<const Utilities::MPI::Partitioner> partitioner;
+          MPI_Comm                                         communicator_sm;
+          std::weak_ptr<const Exchanger>                   exchanger;
+        };
+        static std::vector<CacheEntry> cache;
+        static std::mutex              mutex;
+
+        std::shared_ptr<const Exchanger> cached_exchanger;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+
+          cache.erase(std::remove_if(cache.begin(),
+                                     cache.end(),
+                                     [](const CacheEntry &entry) {
+                                       return entry.exchanger.expired() ||
+                                              entry.partitioner.expired();
+                                     }),
+                      cache.end());
+
+          for (const CacheEntry &entry : cache)
+            if (entry.partitioner.lock() == partitioner &&
+                entry.communicator_sm == communicator_sm)
+              cached_exchanger = entry.exchanger.lock();
+        }
+
+        // the exchange identifies the processes of communicator_sm by their
+        // rank in the communicator of the partitioner, so it can only be
+        // used if all processes of communicator_sm are part of it -- on all
+        // processes. An exchanger is only in the cache if this was the case.
+        const MPI_Comm comm         = partitioner->get_mpi_communicator();
+        bool           sm_is_subset = true;
+        if (cached_exchanger == nullptr)
+          {
+            MPI_Group group, group_sm;
+            int       ierr = MPI_Comm_group(comm, &group);
+            AssertThrowMPI(ierr);
+            ierr = MPI_Comm_group(communicator_sm, &group_sm);
+            AssertThrowMPI(ierr);
+
+            const unsigned int n_sm =
+              Utilities::MPI::n_mpi_processes(communicator_sm);
+            std::vector<int> ranks_sm(n_sm), ranks(n_sm);
+            for (unsigned int i = 0; i < n_sm; ++i)
+              ranks_sm[i] = i;
+            ierr = MPI_Group_translate_ranks(
+              group_sm, n_sm, ranks_sm.data(), group, ranks.data());
+            AssertThrowMPI(ierr);
+
+            ierr = MPI_Group_free(&group_sm);
+            AssertThrowMPI(ierr);
+            ierr = MPI_Group_free(&group);
+            AssertThrowMPI(ierr);
+
+            sm_is_subset =
+              std::find(ranks.begin(), ranks.end(), MPI_UNDEFINED) ==
+              ranks.end();
+          }
+
+        // Whether a cached object is still alive is decided by each process
+        // on its own, so agree on the cache hit in the same collective
+        // operation that checks the processes of communicator_sm. Setting up
+        // a new object is collective as well and must therefore happen
+        // either on all processes or on none.
+        const int local_flags[2] = {cached_exchanger != nullptr ? 1 : 0,
+                                    sm_is_subset ? 1 : 0};
+        int       global_flags[2];
+        Utilities::MPI::min(local_flags, comm, global_flags);
+        if (global_flags[0] == 1)
+          return cached_exchanger;
+        if (global_flags[1] == 0)
+          return nullptr;
+
+        const auto exchanger =
+          std::make_shared<const Exchanger>(partitioner, communicator_sm);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        cache.push_back(CacheEntry{partitioner, communicator_sm, exchanger});
+        return exchanger;
+#endif
+      }
+    } // namespace internal
+  }   // namespace distributed
+} // namespace LinearAlgebra
+
+
 DEAL_II_NAMESPACE_CLOSE
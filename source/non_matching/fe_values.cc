@@ -1,6 +1,6 @@
 // ---------------------------------------------------------------------
 //
-// Copyright (C) 2021 - 2022 by the deal.II authors
+// Copyright (C) 2021 - 2023 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -182,15 +182,37 @@ namespace NonMatching
 
             const unsigned int q1D_index =
               q_collection_1D.size() > 1 ? active_fe_index : 0;
-            quadrature_generator.set_1D_quadrature(q1D_index);
-            quadrature_generator.generate(cell);
+
+            // Use the quadratures from the cache if they were generated with
+            // the current level set values, and generate them otherwise
+            const typename QuadratureCache<dim>::CellQuadratures
+              *cached_quadratures = nullptr;
+            if (quadrature_cache != nullptr)
+              {
+                cached_quadratures = quadrature_cache->get_quadratures(cell);
+                if (cached_quadratures != nullptr &&
+                    cached_quadratures->q_index != q1D_index)
+                  cached_quadratures = nullptr;
+              }
+
+            if (cached_quadratures == nullptr)
+              {
+                quadrature_generator.set_1D_quadrature(q1D_index);
+                quadrature_generator.generate(cell);
+              }
 
             const Quadrature<dim> &inside_quadrature =
-              quadrature_generator.get_inside_quadrature();
+              cached_quadratures != nullptr ?
+                cached_quadratures->inside :
+                quadrature_generator.get_inside_quadrature();
             const Quadrature<dim> &outside_quadrature =
-              quadrature_generator.get_outside_quadrature();
+              cached_quadratures != nullptr ?
+                cached_quadratures->outside :
+                quadrature_generator.get_outside_quadrature();
             const ImmersedSurfaceQuadrature<dim> &surface_quadrature =
-              quadrature_generator.get_surface_quadrature();
+              cached_quadratures != nullptr ?
+                cached_quadratures->surface :
+                quadrature_generator.get_surface_quadrature();
 
             // Even if a cell is formally intersected the number of created
             // quadrature points can be 0. Avoid creating an FEValues object
@@ -236,6 +258,16 @@ namespace NonMatching
 
 
 
+  template <int dim>
+  void
+  FEValues<dim>::set_quadrature_cache(
+    const QuadratureCache<dim> &quadrature_cache)
+  {
+    this->quadrature_cache = &quadrature_cache;
+  }
+
+
+
   template <int dim>
   const std_cxx17::optional<dealii::FEValues<dim>> &
   FEValues<dim>::get_inside_fe_values() const
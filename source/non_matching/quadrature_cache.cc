@@ -0,0 +1,298 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/la_vector.h>
+#include <deal.II/lac/petsc_block_vector.h>
+#include <deal.II/lac/petsc_vector.h>
+#include <deal.II/lac/trilinos_epetra_vector.h>
+#include <deal.II/lac/trilinos_parallel_block_vector.h>
+#include <deal.II/lac/trilinos_tpetra_vector.h>
+#include <deal.II/lac/trilinos_vector.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/vector_element_access.h>
+
+#include <deal.II/non_matching/quadrature_cache.h>
+
+#include <cstdint>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace NonMatching
+{
+  namespace
+  {
+    /**
+     * Compute a hash of the bit patterns of the given values with the
+     * Fowler-Noll-Vo (FNV-1a) algorithm.
+     */
+    std::size_t
+    hash_values(const std::vector<double> &values, const unsigned int q_index)
+    {
+      std::uint64_t hash = 14695981039346656037ull;
+
+      const auto hash_bytes = [&hash](const void *      data,
+                                      const std::size_t size) {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        for (std::size_t i = 0; i < size; ++i)
+          {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+          }
+      };
+
+      hash_bytes(&q_index, sizeof(q_index));
+      if (values.size() > 0)
+        hash_bytes(values.data(), values.size() * sizeof(double));
+
+      return static_cast<std::size_t>(hash);
+    }
+  } // namespace
+
+
+
+  template <int dim>
+  template <class VectorType>
+  QuadratureCache<dim>::QuadratureCache(
+    const hp::QCollection<1> &quadratures1D,
+    const DoFHandler<dim> &   dof_handler,
+    const VectorType &        level_set,
+    const AdditionalData &    additional_data)
+    : dof_handler(&dof_handler)
+    , n_quadratures1D(quadratures1D.size())
+    , n_generated(0)
+  {
+    AssertDimension(dof_handler.n_dofs(), level_set.size());
+
+    get_local_level_set_values =
+      [&level_set](const typename DoFHandler<dim>::active_cell_iterator &cell,
+                   std::vector<types::global_dof_index> &dof_indices,
+                   std::vector<double> &                 local_values) {
+        dof_indices.resize(cell->get_fe().n_dofs_per_cell());
+        cell->get_dof_indices(dof_indices);
+
+        local_values.resize(dof_indices.size());
+        for (unsigned int i = 0; i < dof_indices.size(); ++i)
+          local_values[i] =
+            dealii::internal::ElementAccess<VectorType>::get(level_set,
+                                                             dof_indices[i]);
+      };
+
+    create_generator =
+      [quadratures1D, &dof_handler, &level_set, additional_data]() {
+        return std::make_unique<DiscreteQuadratureGenerator<dim>>(
+          quadratures1D, dof_handler, level_set, additional_data);
+      };
+  }
+
+
+
+  template <int dim>
+  unsigned int
+  QuadratureCache<dim>::get_q_index(
+    const typename DoFHandler<dim>::active_cell_iterator &cell) const
+  {
+    return n_quadratures1D > 1 ? cell->active_fe_index() : 0;
+  }
+
+
+
+  template <int dim>
+  std::size_t
+  QuadratureCache<dim>::compute_level_set_hash(
+    const typename DoFHandler<dim>::active_cell_iterator &cell) const
+  {
+    HashScratchData &scratch = hash_scratch_data.get();
+    get_local_level_set_values(cell, scratch.dof_indices, scratch.local_values);
+    return hash_values(scratch.local_values, get_q_index(cell));
+  }
+
+
+
+  template <int dim>
+  void
+  QuadratureCache<dim>::update(const MeshClassifier<dim> &mesh_classifier)
+  {
+    // Find the intersected cells whose quadratures need to be generated,
+    // and keep the ones that are up to date
+    std::map<CellId, CellQuadratures> new_cell_quadratures;
+    std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
+    std::vector<std::size_t>                                    hashes;
+    for (const auto &cell : dof_handler->active_cell_iterators())
+      if (cell->is_locally_owned() &&
+          mesh_classifier.location_to_level_set(cell) ==
+            LocationToLevelSet::intersected)
+        {
+          const CellId      cell_id = cell->id();
+          const std::size_t hash    = compute_level_set_hash(cell);
+
+          const auto entry = cell_quadratures.find(cell_id);
+          if (entry != cell_quadratures.end() &&
+              entry->second.level_set_hash == hash)
+            new_cell_quadratures.emplace(cell_id, std::move(entry->second));
+          else
+            {
+              cells.push_back(cell);
+              hashes.push_back(hash);
+            }
+        }
+
+    // Generate the missing quadratures in parallel. Each range of cells
+    // uses its own generator, and the results are moved into the map
+    // afterwards.
+    std::vector<CellQuadratures> generated(cells.size());
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(cells.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        const std::unique_ptr<DiscreteQuadratureGenerator<dim>> generator =
+          create_generator();
+        for (unsigned int i = begin; i < end; ++i)
+          {
+            const unsigned int q_index = get_q_index(cells[i]);
+            generator->set_1D_quadrature(q_index);
+            generator->generate(cells[i]);
+
+            generated[i].inside         = generator->get_inside_quadrature();
+            generated[i].outside        = generator->get_outside_quadrature();
+            generated[i].surface        = generator->get_surface_quadrature();
+            generated[i].q_index        = q_index;
+            generated[i].level_set_hash = hashes[i];
+          }
+      },
+      4);
+
+    for (unsigned int i = 0; i < cells.size(); ++i)
+      new_cell_quadratures.emplace(cells[i]->id(), std::move(generated[i]));
+
+    cell_quadratures.swap(new_cell_quadratures);
+    n_generated = cells.size();
+  }
+
+
+
+  template <int dim>
+  void
+  QuadratureCache<dim>::clear()
+  {
+    cell_quadratures.clear();
+    n_generated = 0;
+  }
+
+
+
+  template <int dim>
+  const typename QuadratureCache<dim>::CellQuadratures *
+  QuadratureCache<dim>::get_quadratures(
+    const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    Assert(&cell->get_triangulation() == &dof_handler->get_triangulation(),
+           ExcMessage("The incoming cell must belong to the triangulation "
+                      "associated with the DoFHandler passed to the "
+                      "constructor."));
+
+    const auto entry = cell_quadratures.find(cell->id());
+    if (entry == cell_quadratures.end())
+      return nullptr;
+
+    const typename DoFHandler<dim>::active_cell_iterator dof_cell(
+      &dof_handler->get_triangulation(),
+      cell->level(),
+      cell->index(),
+      &*dof_handler);
+    if (entry->second.level_set_hash != compute_level_set_hash(dof_cell))
+      return nullptr;
+
+    return &entry->second;
+  }
+
+
+
+  template <int dim>
+  const Quadrature<dim> &
+  QuadratureCache<dim>::get_inside_quadrature(
+    const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    const CellQuadratures *quadratures = get_quadratures(cell);
+    return quadratures != nullptr ? quadratures->inside : empty_quadrature;
+  }
+
+
+
+  template <int dim>
+  const Quadrature<dim> &
+  QuadratureCache<dim>::get_outside_quadrature(
+    const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    const CellQuadratures *quadratures = get_quadratures(cell);
+    return quadratures != nullptr ? quadratures->outside : empty_quadrature;
+  }
+
+
+
+  template <int dim>
+  const ImmersedSurfaceQuadrature<dim> &
+  QuadratureCache<dim>::get_surface_quadrature(
+    const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    const CellQuadratures *quadratures = get_quadratures(cell);
+    return quadratures != nullptr ? quadratures->surface :
+                                    empty_surface_quadrature;
+  }
+
+
+
+  template <int dim>
+  unsigned int
+  QuadratureCache<dim>::n_cells() const
+  {
+    return cell_quadratures.size();
+  }
+
+
+
+  template <int dim>
+  unsigned int
+  QuadratureCache<dim>::n_generated_cells() const
+  {
+    return n_generated;
+  }
+
+
+
+  template <int dim>
+  std::size_t
+  QuadratureCache<dim>::memory_consumption() const
+  {
+    std::size_t memory = sizeof(*this);
+    for (const auto &entry : cell_quadratures)
+      memory += sizeof(entry) + entry.second.inside.memory_consumption() +
+                entry.second.outside.memory_consumption() +
+                entry.second.surface.memory_consumption();
+    return memory;
+  }
+
+
+#include "quadrature_cache.inst"
+
+} // namespace NonMatching
+DEAL_II_NAMESPACE_CLOSE
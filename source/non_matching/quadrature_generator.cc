@@ -143,19 +143,28 @@ namespace NonMatching
        * where $L_f = \min_{v} f(x_v)$, $U_f = \max_{v} f(x_v)|$,
        * and $x_v$ is a vertex.
        *
-       * It is assumed that the incoming function is scalar valued.
+       * It is assumed that the incoming function is scalar valued. The
+       * vectors @p vertices and @p vertex_values are scratch space for the
+       * evaluation of the function at all vertices at once.
        */
       template <int dim>
       void
       take_min_max_at_vertices(const Function<dim> &      function,
                                const BoundingBox<dim> &   box,
+                               std::vector<Point<dim>> &  vertices,
+                               std::vector<double> &      vertex_values,
                                std::pair<double, double> &value_bounds)
       {
         const ReferenceCell &cube = ReferenceCells::get_hypercube<dim>();
+        vertices.resize(cube.n_vertices());
         for (unsigned int i = 0; i < cube.n_vertices(); ++i)
-          {
-            const double vertex_value = function.value(box.vertex(i));
+          vertices[i] = box.vertex(i);
+
+        vertex_values.resize(vertices.size());
+        function.value_list(vertices, vertex_values);
 
+        for (const double vertex_value : vertex_values)
+          {
             value_bounds.first  = std::min(value_bounds.first, vertex_value);
             value_bounds.second = std::max(value_bounds.second, vertex_value);
           }
@@ -171,7 +180,8 @@ namespace NonMatching
        * computed using FunctionTools::taylor_estimate_function_bounds.
        * In addition, the function value is checked for min/max at the at
        * the vertices of the box. The gradient is not checked at the box
-       * vertices.
+       * vertices. The vectors @p vertices and @p vertex_values are scratch
+       * space passed on to take_min_max_at_vertices().
        */
       template <int dim>
       void
@@ -179,6 +189,8 @@ namespace NonMatching
         const std::vector<std::reference_wrapper<const Function<dim>>>
           &                               functions,
         const BoundingBox<dim> &          box,
+        std::vector<Point<dim>> &         vertices,
+        std::vector<double> &             vertex_values,
         std::vector<FunctionBounds<dim>> &all_function_bounds)
       {
         all_function_bounds.clear();
@@ -188,7 +200,8 @@ namespace NonMatching
             FunctionBounds<dim> bounds;
             FunctionTools::taylor_estimate_function_bounds<dim>(
               function, box, bounds.value, bounds.gradient);
-            take_min_max_at_vertices(function, box, bounds.value);
+            take_min_max_at_vertices(
+              function, box, vertices, vertex_values, bounds.value);
 
             all_function_bounds.push_back(bounds);
           }
@@ -534,10 +547,39 @@ namespace NonMatching
         const BoundingBox<1> &                                        interval,
         std::vector<double> &                                         roots)
       {
+        const Point<1> left_point  = interval.vertex(0);
+        const Point<1> right_point = interval.vertex(1);
+
+        // two points are not worth a call to value_list(), which would
+        // also need vectors for the points and values
+        function_end_point_values.clear();
         for (const Function<1> &function : functions)
+          function_end_point_values.emplace_back(function.value(left_point),
+                                                 function.value(right_point));
+
+        find_roots(functions, interval, function_end_point_values, roots);
+      }
+
+
+
+      void
+      RootFinder::find_roots(
+        const std::vector<std::reference_wrapper<const Function<1>>> &functions,
+        const BoundingBox<1> &                                        interval,
+        const std::vector<std::pair<double, double>> &end_point_values,
+        std::vector<double> &                         roots)
+      {
+        AssertDimension(functions.size(), end_point_values.size());
+
+        for (unsigned int i = 0; i < functions.size(); ++i)
           {
             const unsigned int recursion_depth = 0;
-            find_roots(function, interval, recursion_depth, roots);
+            find_roots(functions[i],
+                       interval,
+                       end_point_values[i].first,
+                       end_point_values[i].second,
+                       recursion_depth,
+                       roots);
           }
         // Sort and make sure no roots are duplicated
         std::sort(roots.begin(), roots.end());
@@ -554,13 +596,11 @@ namespace NonMatching
       void
       RootFinder::find_roots(const Function<1> &   function,
                              const BoundingBox<1> &interval,
+                             const double          left_value,
+                             const double          right_value,
                              const unsigned int    recursion_depth,
                              std::vector<double> & roots)
       {
-        // Compute function values at end points.
-        const double left_value  = function.value(interval.vertex(0));
-        const double right_value = function.value(interval.vertex(1));
-
         // If we have a sign change we solve for the root.
         if (boost::math::sign(left_value) != boost::math::sign(right_value))
           {
@@ -620,12 +660,23 @@ namespace NonMatching
             // have reached the max recursion, we stop looking for roots.
             if (recursion_depth < additional_data.max_recursion_depth)
               {
+                // the children share the midpoint, and the values at the
+                // other end points are already known
+                const BoundingBox<1> left_child  = interval.child(0);
+                const BoundingBox<1> right_child = interval.child(1);
+                const double         center_value =
+                  function.value(left_child.vertex(1));
+
                 find_roots(function,
-                           interval.child(0),
+                           left_child,
+                           left_value,
+                           center_value,
                            recursion_depth + 1,
                            roots);
                 find_roots(function,
-                           interval.child(1),
+                           right_child,
+                           center_value,
+                           right_value,
                            recursion_depth + 1,
                            roots);
               }
@@ -732,6 +783,11 @@ namespace NonMatching
       {
         const Quadrature<1> &quadrature1D = (*q_collection1D)[q_index];
 
+        evaluate_at_end_points(level_sets,
+                               box,
+                               low_dim_quadrature,
+                               height_function_direction);
+
         for (unsigned int q = 0; q < low_dim_quadrature.size(); ++q)
           {
             const Point<dim - 1> &point  = low_dim_quadrature.point(q);
@@ -749,8 +805,17 @@ namespace NonMatching
             const BoundingBox<1> bounds_in_direction =
               box.bounds(height_function_direction);
 
+            interval_end_point_values.resize(level_sets.size());
+            for (unsigned int j = 0; j < level_sets.size(); ++j)
+              interval_end_point_values[j] = std::make_pair(
+                end_point_values[j * end_points.size() + 2 * q],
+                end_point_values[j * end_points.size() + 2 * q + 1]);
+
             roots.clear();
-            root_finder.find_roots(restrictions, bounds_in_direction, roots);
+            root_finder.find_roots(restrictions,
+                                   bounds_in_direction,
+                                   interval_end_point_values,
+                                   roots);
 
             distribute_points_between_roots(quadrature1D,
                                             bounds_in_direction,
@@ -763,29 +828,66 @@ namespace NonMatching
                                             q_partitioning);
 
             if (dim == spacedim)
-              create_surface_point(point,
-                                   weight,
-                                   level_sets,
-                                   box,
-                                   height_function_direction,
-                                   q_partitioning.surface);
+              create_surface_point(
+                point, weight, level_sets, box, height_function_direction);
           }
 
+        if (dim == spacedim && surface_points.size() > 0)
+          add_surface_points(level_sets.at(0),
+                             height_function_direction,
+                             q_partitioning.surface);
+
         point_restrictions.clear();
       }
 
 
 
+      template <int dim, int spacedim>
+      void
+      UpThroughDimensionCreator<dim, spacedim>::evaluate_at_end_points(
+        const std::vector<std::reference_wrapper<const Function<dim>>>
+          &                        level_sets,
+        const BoundingBox<dim> &   box,
+        const Quadrature<dim - 1> &low_dim_quadrature,
+        const unsigned int         height_function_direction)
+      {
+        end_points.resize(2 * low_dim_quadrature.size());
+        for (unsigned int q = 0; q < low_dim_quadrature.size(); ++q)
+          {
+            end_points[2 * q] = dealii::internal::create_higher_dim_point(
+              low_dim_quadrature.point(q),
+              height_function_direction,
+              box.lower_bound(height_function_direction));
+            end_points[2 * q + 1] = dealii::internal::create_higher_dim_point(
+              low_dim_quadrature.point(q),
+              height_function_direction,
+              box.upper_bound(height_function_direction));
+          }
+
+        // Evaluate each level set function at all end points at once and
+        // store the values consecutively
+        end_point_values.resize(level_sets.size() * end_points.size());
+        std::vector<double> values(end_points.size());
+        for (unsigned int j = 0; j < level_sets.size(); ++j)
+          {
+            level_sets[j].get().value_list(end_points, values);
+            std::copy(values.begin(),
+                      values.end(),
+                      end_point_values.begin() + j * end_points.size());
+          }
+      }
+
+
+
       template <int dim, int spacedim>
       void
       UpThroughDimensionCreator<dim, spacedim>::create_surface_point(
         const Point<dim - 1> &point,
         const double          weight,
         const std::vector<std::reference_wrapper<const Function<dim>>>
-          &                             level_sets,
-        const BoundingBox<dim> &        box,
-        const unsigned int              height_function_direction,
-        ImmersedSurfaceQuadrature<dim> &surface_quadrature)
+          &                     level_sets,
+        const BoundingBox<dim> &box,
+        const unsigned int      height_function_direction)
       {
         AssertIndexRange(roots.size(), 2);
         Assert(level_sets.size() == 1, ExcInternalError());
@@ -816,16 +918,42 @@ namespace NonMatching
               point, height_function_direction, box, level_set);
           }
 
-        const Tensor<1, dim> gradient = level_set.gradient(surface_point);
-        Tensor<1, dim>       normal   = gradient;
-        normal *= 1. / normal.norm();
+        surface_points.push_back(surface_point);
+        surface_weights.push_back(weight);
+      }
+
+
+
+      template <int dim, int spacedim>
+      void
+      UpThroughDimensionCreator<dim, spacedim>::add_surface_points(
+        const Function<dim> &           level_set,
+        const unsigned int              height_function_direction,
+        ImmersedSurfaceQuadrature<dim> &surface_quadrature)
+      {
+        AssertDimension(surface_points.size(), surface_weights.size());
+
+        surface_gradients.resize(surface_points.size());
+        level_set.gradient_list(surface_points, surface_gradients);
+
+        for (unsigned int i = 0; i < surface_points.size(); ++i)
+          {
+            const Tensor<1, dim> &gradient = surface_gradients[i];
+            Tensor<1, dim>        normal   = gradient;
+            normal *= 1. / normal.norm();
+
+            // Note that gradient[height_function_direction] is non-zero
+            // because of the implicit function theorem.
+            const double surface_weight =
+              surface_weights[i] * gradient.norm() /
+              std::abs(gradient[height_function_direction]);
+            surface_quadrature.push_back(surface_points[i],
+                                         surface_weight,
+                                         normal);
+          }
 
-        // Note that gradient[height_function_direction] is non-zero
-        // because of the implicit function theorem.
-        const double surface_weight =
-          weight * gradient.norm() /
-          std::abs(gradient[height_function_direction]);
-        surface_quadrature.push_back(surface_point, surface_weight, normal);
+        surface_points.clear();
+        surface_weights.clear();
       }
 
 
@@ -894,7 +1022,11 @@ namespace NonMatching
         const unsigned int      n_box_splits)
       {
         std::vector<FunctionBounds<dim>> all_function_bounds;
-        estimate_function_bounds(level_sets, box, all_function_bounds);
+        estimate_function_bounds(level_sets,
+                                 box,
+                                 box_vertices,
+                                 box_vertex_values,
+                                 all_function_bounds);
 
         const std::pair<double, double> extreme_values =
           find_extreme_values(all_function_bounds);
@@ -1283,6 +1415,57 @@ namespace NonMatching
         "The reference cell of the incoming cell must be a hypercube.");
 
 
+      /**
+       * Evaluate the tensor product polynomial with the 1d polynomials
+       * @p poly and the coefficients @p values at all @p points, and write
+       * the values and gradients into @p point_values and @p point_gradients,
+       * unless these are null pointers. The points are packed into the lanes
+       * of VectorizedArray<double>, so that the evaluation of several points
+       * shares the same operations. The unused lanes of the last batch are
+       * filled with the last point.
+       */
+      template <int dim>
+      void
+      evaluate_tensor_product_at_points(
+        const std::vector<Polynomials::Polynomial<double>> &poly,
+        const std::vector<double> &                         values,
+        const std::vector<unsigned int> &                   renumber,
+        const bool                                          d_linear,
+        const std::vector<Point<dim>> &                     points,
+        std::vector<double> *                               point_values,
+        std::vector<Tensor<1, dim>> *                       point_gradients)
+      {
+        using VectorizedArrayType      = VectorizedArray<double>;
+        constexpr unsigned int n_lanes = VectorizedArrayType::size();
+
+        for (unsigned int q = 0; q < points.size(); q += n_lanes)
+          {
+            const unsigned int n_filled =
+              std::min<unsigned int>(n_lanes, points.size() - q);
+
+            Point<dim, VectorizedArrayType> point_batch;
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              for (unsigned int d = 0; d < dim; ++d)
+                point_batch[d][v] = points[q + std::min(v, n_filled - 1)][d];
+
+            const auto value_and_gradient =
+              dealii::internal::evaluate_tensor_product_value_and_gradient(
+                poly, values, point_batch, d_linear, renumber);
+
+            for (unsigned int v = 0; v < n_filled; ++v)
+              {
+                if (point_values != nullptr)
+                  (*point_values)[q + v] = value_and_gradient.first[v];
+                if (point_gradients != nullptr)
+                  for (unsigned int d = 0; d < dim; ++d)
+                    (*point_gradients)[q + v][d] =
+                      value_and_gradient.second[d][v];
+              }
+          }
+      }
+
+
+
       /**
        * This class evaluates a function defined by a solution vector and a
        * DoFHandler transformed to reference space. To be precise, if we let
@@ -1362,6 +1545,36 @@ namespace NonMatching
         hessian(const Point<dim> & point,
                 const unsigned int component = 0) const override;
 
+        /**
+         * @copydoc Function::value_list()
+         *
+         * For tensor product elements, the points are evaluated in batches
+         * with the width of VectorizedArray<double>.
+         *
+         * @note The set_active_cell function must be called before this function.
+         * The incoming points should be on the reference cell, but this is not
+         * checked.
+         */
+        void
+        value_list(const std::vector<Point<dim>> &points,
+                   std::vector<double> &          values,
+                   const unsigned int             component = 0) const override;
+
+        /**
+         * @copydoc Function::gradient_list()
+         *
+         * For tensor product elements, the points are evaluated in batches
+         * with the width of VectorizedArray<double>.
+         *
+         * @note The set_active_cell function must be called before this function.
+         * The incoming points should be on the reference cell, but this is not
+         * checked.
+         */
+        void
+        gradient_list(const std::vector<Point<dim>> &points,
+                      std::vector<Tensor<1, dim>> &  gradients,
+                      const unsigned int component = 0) const override;
+
       private:
         /**
          * Return whether the set_active_cell function has been called.
@@ -1393,9 +1606,13 @@ namespace NonMatching
 
         /**
          * Local solution values of the cell in the last call to
-         * set_active_cell()
+         * set_active_cell(), converted to double. Since all values of this
+         * function are computed in double precision anyway, this does not
+         * change the result, but allows the values to be passed to the
+         * vectorized evaluation of several points at once without another
+         * conversion.
          */
-        std::vector<typename VectorType::value_type> local_dof_values;
+        std::vector<double> local_dof_values;
 
         /**
          * Description of the 1d polynomial basis for tensor product elements
@@ -1596,6 +1813,56 @@ namespace NonMatching
             return symmetrize(hessian);
           }
       }
+
+
+
+      template <int dim, class VectorType>
+      void
+      RefSpaceFEFieldFunction<dim, VectorType>::value_list(
+        const std::vector<Point<dim>> &points,
+        std::vector<double> &          values,
+        const unsigned int             component) const
+      {
+        AssertIndexRange(component, this->n_components);
+        AssertDimension(points.size(), values.size());
+        Assert(cell_is_set(), ExcCellNotSet());
+
+        if (!poly.empty() && component == 0)
+          evaluate_tensor_product_at_points<dim>(poly,
+                                                 local_dof_values,
+                                                 renumber,
+                                                 polynomials_are_hat_functions,
+                                                 points,
+                                                 &values,
+                                                 nullptr);
+        else
+          CellWiseFunction<dim>::value_list(points, values, component);
+      }
+
+
+
+      template <int dim, class VectorType>
+      void
+      RefSpaceFEFieldFunction<dim, VectorType>::gradient_list(
+        const std::vector<Point<dim>> &points,
+        std::vector<Tensor<1, dim>> &  gradients,
+        const unsigned int             component) const
+      {
+        AssertIndexRange(component, this->n_components);
+        AssertDimension(points.size(), gradients.size());
+        Assert(cell_is_set(), ExcCellNotSet());
+
+        if (!poly.empty() && component == 0)
+          evaluate_tensor_product_at_points<dim>(poly,
+                                                 local_dof_values,
+                                                 renumber,
+                                                 polynomials_are_hat_functions,
+                                                 points,
+                                                 nullptr,
+                                                 &gradients);
+        else
+          CellWiseFunction<dim>::gradient_list(points, gradients, component);
+      }
     } // namespace DiscreteQuadratureGeneratorImplementation
   }   // namespace internal
 
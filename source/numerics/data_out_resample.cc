@@ -48,6 +48,7 @@ DataOutResample<dim, patch_dim, spacedim>::update_mapping(
 {
   this->mapping = &mapping;
   this->point_to_local_vector_indices.clear();
+  this->interpolation_operators.clear();
 
   FE_Q_iso_Q1<patch_dim, spacedim> fe(
     std::max<unsigned int>(1, n_subdivisions));
@@ -139,7 +140,8 @@ DataOutResample<dim, patch_dim, spacedim>::build_patches(
 
   patch_data_out.attach_dof_handler(patch_dof_handler);
 
-  unsigned int counter = 0;
+  unsigned int        counter = 0;
+  std::vector<double> values;
 
   for (const auto &data : this->dof_data)
     {
@@ -163,8 +165,18 @@ DataOutResample<dim, patch_dim, spacedim>::build_patches(
       for (unsigned int comp = 0; comp < dh.get_fe_collection().n_components();
            ++comp)
         {
-          const auto values = VectorTools::point_values<1>(
-            rpe, dh, data_ptr->vector, VectorTools::EvaluationFlags::avg, comp);
+          // set up the interpolation anew if the degrees of freedom have been
+          // distributed anew or renumbered since it was computed
+          auto &interpolation = interpolation_operators[{&dh, comp}];
+          if (interpolation == nullptr || interpolation->dof_indices_changed())
+            {
+              interpolation = std::make_unique<
+                PointInterpolationOperator<1, dim, spacedim>>();
+              interpolation->reinit(rpe, dh, comp);
+            }
+          interpolation->vmult(values,
+                               data_ptr->vector,
+                               VectorTools::EvaluationFlags::avg);
 
           vectors.emplace_back(
             std::make_shared<LinearAlgebra::distributed::Vector<double>>(
@@ -154,6 +154,7 @@ PointValueHistory<dim>::operator=(const PointValueHistory &point_value_history)
   triangulation_changed = point_value_history.triangulation_changed;
   have_dof_handler      = point_value_history.have_dof_handler;
   n_indep               = point_value_history.n_indep;
+  interpolation_operators.clear();
 
   // What to do with tria_listener?
   // Presume subscribe new instance?
@@ -562,6 +563,7 @@ PointValueHistory<dim>::clear()
   cleared          = true;
   dof_handler      = nullptr;
   have_dof_handler = false;
+  interpolation_operators.clear();
 }
 
 // Need to test that the internal data has a full and complete dataset for
@@ -930,35 +932,42 @@ PointValueHistory<dim>::evaluate_field_at_requested_location(
   unsigned int n_stored =
     mask->second.n_selected_components(dof_handler->get_fe(0).n_components());
 
-  typename std::vector<
-    internal::PointValueHistoryImplementation::PointGeometryData<dim>>::iterator
-                 point = point_geometry_data.begin();
-  Vector<number> value(dof_handler->get_fe(0).n_components());
-  for (unsigned int data_store_index = 0; point != point_geometry_data.end();
-       ++point, ++data_store_index)
+  // Set up the interpolation operator for the selected components, unless
+  // this has already been done for the current mesh and degrees of freedom.
+  // The operator locates the requested points and evaluates the shape
+  // functions there, so all subsequent calls only need to multiply with the
+  // stored interpolation weights. Changes of the mesh are caught by
+  // tria_change_listener(), changes of the degrees of freedom (e.g., a
+  // renumbering) by comparing the DoF indices of the cells around the points.
+  std::unique_ptr<PointInterpolationOperator<1, dim>> &interpolation =
+    interpolation_operators[vector_name];
+  if (interpolation == nullptr || interpolation->dof_indices_changed())
     {
-      // Make a Vector <double> for the value
-      // at the point. It will have as many
-      // components as there are in the fe.
-      VectorTools::point_value(*dof_handler,
-                               solution,
-                               point->requested_location,
-                               value);
-
-      // Look up the component_mask and add
-      // in components according to that mask
-      for (unsigned int store_index = 0, comp = 0; comp < mask->second.size();
-           comp++)
-        {
-          if (mask->second[comp])
-            {
-              data_store_field
-                ->second[data_store_index * n_stored + store_index]
-                .push_back(value(comp));
-              store_index++;
-            }
-        }
+      std::vector<Point<dim>> requested_locations;
+      requested_locations.reserve(point_geometry_data.size());
+      for (const auto &point : point_geometry_data)
+        requested_locations.push_back(point.requested_location);
+
+      interpolation = std::make_unique<PointInterpolationOperator<1, dim>>();
+      interpolation->reinit(requested_locations,
+                            *dof_handler,
+                            get_default_linear_mapping(
+                              dof_handler->get_triangulation()),
+                            mask->second);
     }
+  AssertDimension(interpolation->n_selected_components(), n_stored);
+
+  std::vector<number> values;
+  interpolation->vmult_selected_components(values, solution);
+
+  // Add in the values at all points according to the component_mask
+  for (unsigned int data_store_index = 0, i = 0;
+       data_store_index < point_geometry_data.size();
+       ++data_store_index)
+    for (unsigned int store_index = 0; store_index < n_stored;
+         ++store_index, ++i)
+      data_store_field->second[data_store_index * n_stored + store_index]
+        .push_back(values[i]);
 }
 
 
@@ -1502,6 +1511,9 @@ PointValueHistory<dim>::tria_change_listener()
   // this into account next time we
   // evaluate the solution
   triangulation_changed = true;
+
+  // the points need to be located anew in the changed mesh
+  interpolation_operators.clear();
 }
 
 
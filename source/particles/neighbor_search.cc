@@ -0,0 +1,372 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/particles/neighbor_search.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Particles
+{
+  namespace
+  {
+    /**
+     * Fill a vector with the locations of the given particles.
+     */
+    template <int dim, int spacedim>
+    void
+    read_positions(const std::vector<ParticleIterator<dim, spacedim>> &particles,
+                   std::vector<Point<spacedim>> &                      positions)
+    {
+      positions.resize(particles.size());
+      parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(particles.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int i = begin; i < end; ++i)
+            positions[i] = particles[i]->get_location();
+        },
+        1000);
+    }
+
+
+
+    /**
+     * Compute a list in compressed row storage for the first
+     * @p n_rows particles, where @p visit_row(i, f) calls f(j) for all
+     * entries j of row i. The function works in two passes over all rows,
+     * the first one counting the entries and the second one filling them
+     * in, both of which run in parallel. The entries of each row are sorted.
+     */
+    template <typename VisitRow>
+    void
+    compute_compressed_rows(const unsigned int         n_rows,
+                            const VisitRow &           visit_row,
+                            std::vector<unsigned int> &row_start,
+                            std::vector<unsigned int> &entries)
+    {
+      row_start.assign(n_rows + 1, 0);
+      parallel::apply_to_subranges(
+        0U,
+        n_rows,
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int i = begin; i < end; ++i)
+            {
+              unsigned int n_entries = 0;
+              visit_row(i, [&n_entries](const unsigned int) { ++n_entries; });
+              row_start[i + 1] = n_entries;
+            }
+        },
+        64);
+      std::partial_sum(row_start.begin(), row_start.end(), row_start.begin());
+
+      entries.resize(row_start.back());
+      parallel::apply_to_subranges(
+        0U,
+        n_rows,
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int i = begin; i < end; ++i)
+            {
+              auto entry = entries.begin() + row_start[i];
+              visit_row(i, [&entry](const unsigned int j) { *entry++ = j; });
+              std::sort(entries.begin() + row_start[i],
+                        entries.begin() + row_start[i + 1]);
+            }
+        },
+        64);
+    }
+  } // namespace
+
+
+
+  template <int dim, int spacedim>
+  NeighborSearch<dim, spacedim>::NeighborSearch()
+    : cutoff_radius(0.)
+    , skin(0.)
+    , n_owned_particles(0)
+    , bin_size(0.)
+  {
+    n_bins.fill(0);
+  }
+
+
+
+  template <int dim, int spacedim>
+  NeighborSearch<dim, spacedim>::NeighborSearch(
+    const ParticleHandler<dim, spacedim> &particle_handler,
+    const double                          cutoff_radius,
+    const double                          skin)
+    : NeighborSearch()
+  {
+    reinit(particle_handler, cutoff_radius, skin);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  NeighborSearch<dim, spacedim>::reinit(
+    const ParticleHandler<dim, spacedim> &particle_handler,
+    const double                          cutoff_radius,
+    const double                          skin)
+  {
+    Assert(cutoff_radius > 0.,
+           ExcMessage("The cutoff radius needs to be positive."));
+    Assert(skin >= 0., ExcMessage("The skin must not be negative."));
+
+    this->particle_handler = &particle_handler;
+    this->cutoff_radius    = cutoff_radius;
+    this->skin             = skin;
+
+    particles.clear();
+    particles.reserve(particle_handler.n_locally_owned_particles());
+    for (auto particle = particle_handler.begin();
+         particle != particle_handler.end();
+         ++particle)
+      particles.push_back(particle);
+    n_owned_particles = particles.size();
+    for (auto particle = particle_handler.begin_ghost();
+         particle != particle_handler.end_ghost();
+         ++particle)
+      particles.push_back(particle);
+
+    build();
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  NeighborSearch<dim, spacedim>::update()
+  {
+    Assert(particle_handler != nullptr, ExcNotInitialized());
+    Assert(particle_handler->n_locally_owned_particles() == n_owned_particles,
+           ExcMessage("The number of particles has changed since the last "
+                      "call to reinit(). You need to call reinit() again."));
+
+    std::vector<Point<spacedim>> positions;
+    read_positions(particles, positions);
+
+    double max_displacement_square = 0.;
+    for (unsigned int i = 0; i < positions.size(); ++i)
+      max_displacement_square =
+        std::max(max_displacement_square,
+                 positions[i].distance_square(positions_at_build[i]));
+
+    // the candidates contain all neighbors as long as two particles have not
+    // approached each other by more than the skin
+    if (4. * max_displacement_square > skin * skin)
+      {
+        build();
+        return true;
+      }
+    else
+      {
+        filter_candidates(positions);
+        return false;
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::array<unsigned int, spacedim>
+  NeighborSearch<dim, spacedim>::get_bin(const Point<spacedim> &point) const
+  {
+    std::array<unsigned int, spacedim> bin;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      bin[d] = std::min(
+        n_bins[d] - 1,
+        static_cast<unsigned int>(
+          std::max(0., std::floor((point[d] - bin_origin[d]) / bin_size))));
+    return bin;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  NeighborSearch<dim, spacedim>::build()
+  {
+    const unsigned int n_all_particles = particles.size();
+    read_positions(particles, positions_at_build);
+
+    const double search_radius = cutoff_radius + skin;
+
+    // Set up the grid of bins around all particles. Bins may be larger than
+    // the search radius, so limit their number to a few per particle to
+    // bound the memory for sparse particle clouds
+    Point<spacedim> upper;
+    if (n_all_particles > 0)
+      {
+        bin_origin = positions_at_build[0];
+        upper      = positions_at_build[0];
+      }
+    for (const auto &position : positions_at_build)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          bin_origin[d] = std::min(bin_origin[d], position[d]);
+          upper[d]      = std::max(upper[d], position[d]);
+        }
+
+    const double max_n_bins = std::max(1., 8. * n_all_particles);
+    bin_size                = search_radius;
+    while (true)
+      {
+        double n_total_bins = 1.;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          n_total_bins *= std::floor((upper[d] - bin_origin[d]) / bin_size) + 1;
+        if (n_total_bins <= max_n_bins)
+          break;
+        bin_size *= 2.;
+      }
+
+    unsigned int n_total_bins = 1;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      {
+        n_bins[d] = static_cast<unsigned int>(
+                      std::floor((upper[d] - bin_origin[d]) / bin_size)) +
+                    1;
+        n_total_bins *= n_bins[d];
+      }
+
+    const auto flatten = [this](const std::array<unsigned int, spacedim> &bin) {
+      unsigned int index = 0, stride = 1;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          index += bin[d] * stride;
+          stride *= n_bins[d];
+        }
+      return index;
+    };
+
+    // counting sort of the particles into the bins
+    std::vector<unsigned int> particle_bins(n_all_particles);
+    bin_start.assign(n_total_bins + 1, 0);
+    for (unsigned int i = 0; i < n_all_particles; ++i)
+      {
+        particle_bins[i] = flatten(get_bin(positions_at_build[i]));
+        ++bin_start[particle_bins[i] + 1];
+      }
+    std::partial_sum(bin_start.begin(), bin_start.end(), bin_start.begin());
+
+    bin_particles.resize(n_all_particles);
+    std::vector<unsigned int> next_in_bin(bin_start.begin(),
+                                          bin_start.end() - 1);
+    for (unsigned int i = 0; i < n_all_particles; ++i)
+      bin_particles[next_in_bin[particle_bins[i]]++] = i;
+
+    // the candidates of a particle are the particles within the search
+    // radius in its own bin and the adjacent ones
+    const double search_radius_square = search_radius * search_radius;
+    const auto   visit_candidates     = [&](const unsigned int i,
+                                      const auto &       add_candidate) {
+      const auto                         bin = get_bin(positions_at_build[i]);
+      std::array<unsigned int, spacedim> lower_bin, upper_bin, current_bin;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          lower_bin[d] = (bin[d] > 0 ? bin[d] - 1 : 0);
+          upper_bin[d] = std::min(bin[d] + 1, n_bins[d] - 1);
+        }
+      current_bin = lower_bin;
+
+      while (true)
+        {
+          const unsigned int index = flatten(current_bin);
+          for (unsigned int k = bin_start[index]; k < bin_start[index + 1]; ++k)
+            {
+              const unsigned int j = bin_particles[k];
+              if (j != i && positions_at_build[i].distance_square(
+                              positions_at_build[j]) <= search_radius_square)
+                add_candidate(j);
+            }
+
+          unsigned int d = 0;
+          for (; d < spacedim; ++d)
+            if (current_bin[d] < upper_bin[d])
+              {
+                ++current_bin[d];
+                break;
+              }
+            else
+              current_bin[d] = lower_bin[d];
+          if (d == spacedim)
+            break;
+        }
+    };
+
+    compute_compressed_rows(n_owned_particles,
+                            visit_candidates,
+                            candidate_start,
+                            candidates);
+
+    filter_candidates(positions_at_build);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  NeighborSearch<dim, spacedim>::filter_candidates(
+    const std::vector<Point<spacedim>> &positions)
+  {
+    if (skin == 0.)
+      {
+        neighbor_start = candidate_start;
+        neighbors      = candidates;
+        return;
+      }
+
+    const double cutoff_radius_square = cutoff_radius * cutoff_radius;
+    compute_compressed_rows(
+      n_owned_particles,
+      [&](const unsigned int i, const auto &add_neighbor) {
+        for (unsigned int k = candidate_start[i]; k < candidate_start[i + 1];
+             ++k)
+          if (positions[i].distance_square(positions[candidates[k]]) <=
+              cutoff_radius_square)
+            add_neighbor(candidates[k]);
+      },
+      neighbor_start,
+      neighbors);
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  NeighborSearch<dim, spacedim>::memory_consumption() const
+  {
+    return sizeof(*this) +
+           particles.capacity() * sizeof(ParticleIterator<dim, spacedim>) +
+           MemoryConsumption::memory_consumption(positions_at_build) +
+           MemoryConsumption::memory_consumption(bin_start) +
+           MemoryConsumption::memory_consumption(bin_particles) +
+           MemoryConsumption::memory_consumption(candidate_start) +
+           MemoryConsumption::memory_consumption(candidates) +
+           MemoryConsumption::memory_consumption(neighbor_start) +
+           MemoryConsumption::memory_consumption(neighbors);
+  }
+} // namespace Particles
+
+#include "neighbor_search.inst"
+
+DEAL_II_NAMESPACE_CLOSE
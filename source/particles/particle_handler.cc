@@ -1,6 +1,6 @@
 // ---------------------------------------------------------------------
 //
-// Copyright (C) 2017 - 2022 by the deal.II authors
+// Copyright (C) 2017 - 2023 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -13,6 +13,8 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/parallel.h>
+
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/grid_tools_cache.h>
 
@@ -22,6 +24,7 @@
 
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 DEAL_II_NAMESPACE_OPEN
@@ -1221,6 +1224,76 @@ namespace Particles
     // TODO: Extend this function to allow keeping particles on other
     // processes around (with an invalid cell).
 
+    // Collect the locally owned cells that contain particles, together with
+    // the offsets of their particles within the list of all particles sorted
+    // by cell. Particles can be inserted into arbitrary cells, e.g. if their
+    // cell is not known. However, for artificial cells we can not evaluate
+    // the reference position of particles. Do not sort particles that are
+    // not locally owned, because they will be sorted by the process that
+    // owns them.
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+                              cells_with_particles;
+    std::vector<unsigned int> cell_particle_offsets(1, 0);
+    for (const auto &cell : triangulation->active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          const unsigned int n_pic = n_particles_in_cell(cell);
+          if (n_pic > 0)
+            {
+              cells_with_particles.push_back(cell);
+              cell_particle_offsets.push_back(cell_particle_offsets.back() +
+                                              n_pic);
+            }
+        }
+
+    // Work on chunks of roughly the same number of particles
+    const unsigned int cell_grainsize =
+      std::max<unsigned int>(1,
+                             (cells_with_particles.size() * 1000) /
+                               std::max(1U, cell_particle_offsets.back()));
+
+    // Now update the reference locations of the particles. The cells are
+    // independent of each other, so work on them in parallel and only
+    // record which particles are no longer inside their cell.
+    std::vector<char> particle_left_cell(cell_particle_offsets.back(), 0);
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(cells_with_particles.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<Point<spacedim>> real_locations;
+        std::vector<Point<dim>>      reference_locations;
+        real_locations.reserve(global_max_particles_per_cell);
+        reference_locations.reserve(global_max_particles_per_cell);
+
+        for (unsigned int c = begin; c < end; ++c)
+          {
+            const auto &cell = cells_with_particles[c];
+            auto        pic  = particles_in_cell(cell);
+
+            real_locations.clear();
+            for (const auto &particle : pic)
+              real_locations.push_back(particle.get_location());
+
+            reference_locations.resize(real_locations.size());
+            mapping->transform_points_real_to_unit_cell(cell,
+                                                        real_locations,
+                                                        reference_locations);
+
+            auto particle = pic.begin();
+            for (unsigned int i = 0; i < reference_locations.size();
+                 ++i, ++particle)
+              {
+                const Point<dim> &p_unit = reference_locations[i];
+                if (p_unit[0] == std::numeric_limits<double>::infinity() ||
+                    !GeometryInfo<dim>::is_inside_unit_cell(p_unit))
+                  particle_left_cell[cell_particle_offsets[c] + i] = 1;
+                else
+                  particle->set_reference_location(p_unit);
+              }
+          }
+      },
+      cell_grainsize);
+
     std::vector<particle_iterator> particles_out_of_cell;
 
     // Reserve some space for particles that need sorting to avoid frequent
@@ -1228,47 +1301,14 @@ namespace Particles
     // overhead and performance.
     particles_out_of_cell.reserve(n_locally_owned_particles() / 4);
 
-    // Now update the reference locations of the moved particles
-    std::vector<Point<spacedim>> real_locations;
-    std::vector<Point<dim>>      reference_locations;
-    real_locations.reserve(global_max_particles_per_cell);
-    reference_locations.reserve(global_max_particles_per_cell);
-
-    for (const auto &cell : triangulation->active_cell_iterators())
+    for (unsigned int c = 0; c < cells_with_particles.size(); ++c)
       {
-        // Particles can be inserted into arbitrary cells, e.g. if their cell is
-        // not known. However, for artificial cells we can not evaluate
-        // the reference position of particles. Do not sort particles that are
-        // not locally owned, because they will be sorted by the process that
-        // owns them.
-        if (cell->is_locally_owned() == false)
-          {
-            continue;
-          }
-
-        const unsigned int n_pic = n_particles_in_cell(cell);
-        auto               pic   = particles_in_cell(cell);
-
-        real_locations.clear();
-        for (const auto &particle : pic)
-          real_locations.push_back(particle.get_location());
-
-        reference_locations.resize(n_pic);
-        mapping->transform_points_real_to_unit_cell(cell,
-                                                    real_locations,
-                                                    reference_locations);
-
-        auto particle = pic.begin();
-        for (const auto &p_unit : reference_locations)
-          {
-            if (p_unit[0] == std::numeric_limits<double>::infinity() ||
-                !GeometryInfo<dim>::is_inside_unit_cell(p_unit))
-              particles_out_of_cell.push_back(particle);
-            else
-              particle->set_reference_location(p_unit);
-
-            ++particle;
-          }
+        auto particle = particles_in_cell(cells_with_particles[c]).begin();
+        for (unsigned int i = cell_particle_offsets[c];
+             i < cell_particle_offsets[c + 1];
+             ++i, ++particle)
+          if (particle_left_cell[i] != 0)
+            particles_out_of_cell.push_back(particle);
       }
 
     // There are three reasons why a particle is not in its old cell:
@@ -1305,6 +1345,15 @@ namespace Particles
     for (const auto &ghost_owner : ghost_owners)
       moved_cells[ghost_owner].reserve(particles_out_of_cell.size() / 4);
 
+    // Find the cells that the particles moved to. The search only reads the
+    // triangulation and the particles, so it is done in parallel. Its results
+    // are applied afterwards in the original order of the particles, because
+    // inserting particles into their new cells modifies the particle
+    // container.
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+                            new_cells(particles_out_of_cell.size());
+    std::vector<Point<dim>> new_reference_locations(
+      particles_out_of_cell.size());
     {
       // Create a map from vertices to adjacent cells using grid cache
       const std::vector<
@@ -1317,168 +1366,197 @@ namespace Particles
         &vertex_to_cell_centers =
           triangulation_cache->get_vertex_to_cell_centers_directions();
 
-      std::vector<unsigned int> neighbor_permutation;
-
-      // Reuse these vectors below, but only with a single element.
-      // Avoid resizing for every particle.
-      Point<dim>      invalid_reference_point;
-      Point<spacedim> invalid_point;
-      invalid_reference_point[0] = std::numeric_limits<double>::infinity();
-      invalid_point[0]           = std::numeric_limits<double>::infinity();
-      reference_locations.resize(1, invalid_reference_point);
-      real_locations.resize(1, invalid_point);
-
-      // Find the cells that the particles moved to.
-      for (auto &out_particle : particles_out_of_cell)
-        {
-          // make a copy of the current cell, since we will modify the
-          // variable current_cell below, but we need the original in
-          // the case the particle is not found
-          auto current_cell = out_particle->get_surrounding_cell();
-
-          real_locations[0] = out_particle->get_location();
-
-          // Record if the new cell was found
-          bool found_cell = false;
-
-          // Check if the particle is in one of the old cell's neighbors
-          // that are adjacent to the closest vertex
-          const unsigned int closest_vertex =
-            GridTools::find_closest_vertex_of_cell<dim, spacedim>(
-              current_cell, out_particle->get_location(), *mapping);
-          Tensor<1, spacedim> vertex_to_particle =
-            out_particle->get_location() - current_cell->vertex(closest_vertex);
-          vertex_to_particle /= vertex_to_particle.norm();
-
-          const unsigned int closest_vertex_index =
-            current_cell->vertex_index(closest_vertex);
-          const unsigned int n_neighbor_cells =
-            vertex_to_cells[closest_vertex_index].size();
-
-          neighbor_permutation.resize(n_neighbor_cells);
-          for (unsigned int i = 0; i < n_neighbor_cells; ++i)
-            neighbor_permutation[i] = i;
-
-          const auto &cell_centers =
-            vertex_to_cell_centers[closest_vertex_index];
-          std::sort(neighbor_permutation.begin(),
-                    neighbor_permutation.end(),
-                    [&vertex_to_particle, &cell_centers](const unsigned int a,
-                                                         const unsigned int b) {
-                      return compare_particle_association(a,
-                                                          b,
-                                                          vertex_to_particle,
-                                                          cell_centers);
-                    });
-
-          // Search all of the cells adjacent to the closest vertex of the
-          // previous cell. Most likely we will find the particle in them.
-          for (unsigned int i = 0; i < n_neighbor_cells; ++i)
+      // The tree of all vertices is only needed for particles that did not
+      // move into a neighbor of their old cell, and is created on first use
+      std::mutex rtree_mutex;
+      (void)rtree_mutex;
+
+      parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(particles_out_of_cell.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          std::vector<unsigned int> neighbor_permutation;
+
+          // Reuse these vectors below, but only with a single element.
+          // Avoid resizing for every particle.
+          Point<dim>      invalid_reference_point;
+          Point<spacedim> invalid_point;
+          invalid_reference_point[0] = std::numeric_limits<double>::infinity();
+          invalid_point[0]           = std::numeric_limits<double>::infinity();
+          std::vector<Point<dim>> reference_locations(1,
+                                                      invalid_reference_point);
+          std::vector<Point<spacedim>> real_locations(1, invalid_point);
+
+          for (unsigned int p = begin; p < end; ++p)
             {
-              typename std::set<typename Triangulation<dim, spacedim>::
-                                  active_cell_iterator>::const_iterator cell =
-                vertex_to_cells[closest_vertex_index].begin();
-
-              std::advance(cell, neighbor_permutation[i]);
-              mapping->transform_points_real_to_unit_cell(*cell,
-                                                          real_locations,
-                                                          reference_locations);
+              const auto &out_particle = particles_out_of_cell[p];
+
+              // make a copy of the current cell, since we will modify the
+              // variable current_cell below, but we need the original in
+              // the case the particle is not found
+              auto current_cell = out_particle->get_surrounding_cell();
+
+              real_locations[0] = out_particle->get_location();
+
+              // Record if the new cell was found
+              bool found_cell = false;
+
+              // Check if the particle is in one of the old cell's neighbors
+              // that are adjacent to the closest vertex
+              const unsigned int closest_vertex =
+                GridTools::find_closest_vertex_of_cell<dim, spacedim>(
+                  current_cell, out_particle->get_location(), *mapping);
+              Tensor<1, spacedim> vertex_to_particle =
+                out_particle->get_location() -
+                current_cell->vertex(closest_vertex);
+              vertex_to_particle /= vertex_to_particle.norm();
+
+              const unsigned int closest_vertex_index =
+                current_cell->vertex_index(closest_vertex);
+              const unsigned int n_neighbor_cells =
+                vertex_to_cells[closest_vertex_index].size();
+
+              neighbor_permutation.resize(n_neighbor_cells);
+              for (unsigned int i = 0; i < n_neighbor_cells; ++i)
+                neighbor_permutation[i] = i;
+
+              const auto &cell_centers =
+                vertex_to_cell_centers[closest_vertex_index];
+              std::sort(neighbor_permutation.begin(),
+                        neighbor_permutation.end(),
+                        [&vertex_to_particle,
+                         &cell_centers](const unsigned int a,
+                                        const unsigned int b) {
+                          return compare_particle_association(
+                            a, b, vertex_to_particle, cell_centers);
+                        });
 
-              if (GeometryInfo<dim>::is_inside_unit_cell(
-                    reference_locations[0]))
+              // Search all of the cells adjacent to the closest vertex of the
+              // previous cell. Most likely we will find the particle in them.
+              for (unsigned int i = 0; i < n_neighbor_cells; ++i)
                 {
-                  current_cell = *cell;
-                  found_cell   = true;
-                  break;
+                  typename std::set<typename Triangulation<dim, spacedim>::
+                                      active_cell_iterator>::const_iterator
+                    cell = vertex_to_cells[closest_vertex_index].begin();
+
+                  std::advance(cell, neighbor_permutation[i]);
+                  mapping->transform_points_real_to_unit_cell(
+                    *cell, real_locations, reference_locations);
+
+                  if (GeometryInfo<dim>::is_inside_unit_cell(
+                        reference_locations[0]))
+                    {
+                      current_cell = *cell;
+                      found_cell   = true;
+                      break;
+                    }
                 }
-            }
 
-          if (!found_cell)
-            {
-              // For some clang-based compilers and boost versions the call to
-              // RTree::query doesn't compile. We use a slower implementation as
-              // workaround.
-              // This is fixed in boost in
-              // https://github.com/boostorg/numeric_conversion/commit/50a1eae942effb0a9b90724323ef8f2a67e7984a
+              if (!found_cell)
+                {
+                  // For some clang-based compilers and boost versions the call
+                  // to RTree::query doesn't compile. We use a slower
+                  // implementation as workaround.
+                  // This is fixed in boost in
+                  // https://github.com/boostorg/numeric_conversion/commit/50a1eae942effb0a9b90724323ef8f2a67e7984a
 #if defined(DEAL_II_WITH_BOOST_BUNDLED) ||                \
   !(defined(__clang_major__) && __clang_major__ >= 16) || \
   BOOST_VERSION >= 108100
-              // The particle is not in a neighbor of the old cell.
-              // Look for the new cell in the whole local domain.
-              // This case is rare.
-              std::vector<std::pair<Point<spacedim>, unsigned int>>
-                closest_vertex_in_domain;
-              triangulation_cache->get_used_vertices_rtree().query(
-                boost::geometry::index::nearest(out_particle->get_location(),
-                                                1),
-                std::back_inserter(closest_vertex_in_domain));
-
-              // We should have one and only one result
-              AssertDimension(closest_vertex_in_domain.size(), 1);
-              const unsigned int closest_vertex_index_in_domain =
-                closest_vertex_in_domain[0].second;
+                  // The particle is not in a neighbor of the old cell.
+                  // Look for the new cell in the whole local domain.
+                  // This case is rare.
+                  std::unique_lock<std::mutex> lock(rtree_mutex);
+                  const auto &used_vertices_rtree =
+                    triangulation_cache->get_used_vertices_rtree();
+                  lock.unlock();
+
+                  std::vector<std::pair<Point<spacedim>, unsigned int>>
+                    closest_vertex_in_domain;
+                  used_vertices_rtree.query(
+                    boost::geometry::index::nearest(
+                      out_particle->get_location(), 1),
+                    std::back_inserter(closest_vertex_in_domain));
+
+                  // We should have one and only one result
+                  AssertDimension(closest_vertex_in_domain.size(), 1);
+                  const unsigned int closest_vertex_index_in_domain =
+                    closest_vertex_in_domain[0].second;
 #else
-              const unsigned int closest_vertex_index_in_domain =
-                GridTools::find_closest_vertex(*mapping,
-                                               *triangulation,
-                                               out_particle->get_location());
+                  const unsigned int closest_vertex_index_in_domain =
+                    GridTools::find_closest_vertex(
+                      *mapping, *triangulation, out_particle->get_location());
 #endif
 
-              // Search all of the cells adjacent to the closest vertex of the
-              // domain. Most likely we will find the particle in them.
-              for (const auto &cell :
-                   vertex_to_cells[closest_vertex_index_in_domain])
-                {
-                  mapping->transform_points_real_to_unit_cell(
-                    cell, real_locations, reference_locations);
-
-                  if (GeometryInfo<dim>::is_inside_unit_cell(
-                        reference_locations[0]))
+                  // Search all of the cells adjacent to the closest vertex of
+                  // the domain. Most likely we will find the particle in them.
+                  for (const auto &cell :
+                       vertex_to_cells[closest_vertex_index_in_domain])
                     {
-                      current_cell = cell;
-                      found_cell   = true;
-                      break;
+                      mapping->transform_points_real_to_unit_cell(
+                        cell, real_locations, reference_locations);
+
+                      if (GeometryInfo<dim>::is_inside_unit_cell(
+                            reference_locations[0]))
+                        {
+                          current_cell = cell;
+                          found_cell   = true;
+                          break;
+                        }
                     }
                 }
-            }
 
-          if (!found_cell)
-            {
-              // We can find no cell for this particle. It has left the
-              // domain due to an integration error or an open boundary.
-              // Signal the loss and move on.
-              signals.particle_lost(out_particle,
-                                    out_particle->get_surrounding_cell());
-              continue;
+              // Leave the cell of particles that could not be found invalid
+              if (found_cell)
+                {
+                  new_cells[p]               = current_cell;
+                  new_reference_locations[p] = reference_locations[0];
+                }
             }
+        },
+        64);
+    }
 
-          // If we are here, we found a cell and reference position for this
-          // particle
-          out_particle->set_reference_location(reference_locations[0]);
+    for (unsigned int p = 0; p < particles_out_of_cell.size(); ++p)
+      {
+        auto &out_particle = particles_out_of_cell[p];
 
-          // Reinsert the particle into our domain if we own its cell.
-          // Mark it for MPI transfer otherwise
-          if (current_cell->is_locally_owned())
-            {
-              typename PropertyPool<dim, spacedim>::Handle &old =
-                out_particle->particles_in_cell
-                  ->particles[out_particle->particle_index_within_cell];
+        if (new_cells[p].state() != IteratorState::valid)
+          {
+            // We can find no cell for this particle. It has left the
+            // domain due to an integration error or an open boundary.
+            // Signal the loss and move on.
+            signals.particle_lost(out_particle,
+                                  out_particle->get_surrounding_cell());
+            continue;
+          }
 
-              // Avoid deallocating the memory of this particle
-              const auto old_value = old;
-              old = PropertyPool<dim, spacedim>::invalid_handle;
+        // If we are here, we found a cell and reference position for this
+        // particle
+        out_particle->set_reference_location(new_reference_locations[p]);
 
-              // Allocate particle with the old handle
-              insert_particle(old_value, current_cell);
-            }
-          else
-            {
-              moved_particles[current_cell->subdomain_id()].push_back(
-                out_particle);
-              moved_cells[current_cell->subdomain_id()].push_back(current_cell);
-            }
-        }
-    }
+        // Reinsert the particle into our domain if we own its cell.
+        // Mark it for MPI transfer otherwise
+        const auto &current_cell = new_cells[p];
+        if (current_cell->is_locally_owned())
+          {
+            typename PropertyPool<dim, spacedim>::Handle &old =
+              out_particle->particles_in_cell
+                ->particles[out_particle->particle_index_within_cell];
+
+            // Avoid deallocating the memory of this particle
+            const auto old_value = old;
+            old = PropertyPool<dim, spacedim>::invalid_handle;
+
+            // Allocate particle with the old handle
+            insert_particle(old_value, current_cell);
+          }
+        else
+          {
+            moved_particles[current_cell->subdomain_id()].push_back(
+              out_particle);
+            moved_cells[current_cell->subdomain_id()].push_back(current_cell);
+          }
+      }
 
     // Exchange particles between processors if we have more than one process
 #ifdef DEAL_II_WITH_MPI
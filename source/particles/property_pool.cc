@@ -1,6 +1,6 @@
 // ---------------------------------------------------------------------
 //
-// Copyright (C) 2017 - 2021 by the deal.II authors
+// Copyright (C) 2017 - 2023 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/signaling_nan.h>
 
 #include <deal.II/particles/property_pool.h>
@@ -195,38 +196,45 @@ namespace Particles
   PropertyPool<dim, spacedim>::sort_memory_slots(
     const std::vector<Handle> &handles_to_sort)
   {
-    std::vector<Point<spacedim>>       sorted_locations;
-    std::vector<Point<dim>>            sorted_reference_locations;
-    std::vector<types::particle_index> sorted_ids;
-    std::vector<double>                sorted_properties;
-
-    sorted_locations.reserve(locations.size());
-    sorted_reference_locations.reserve(reference_locations.size());
-    sorted_ids.reserve(ids.size());
-    sorted_properties.reserve(properties.size());
-
-    for (auto &handle : handles_to_sort)
-      {
-        Assert(handle != invalid_handle,
-               ExcMessage(
-                 "Invalid handle detected during sorting particle memory."));
-
-        sorted_locations.push_back(locations[handle]);
-        sorted_reference_locations.push_back(reference_locations[handle]);
-        sorted_ids.push_back(ids[handle]);
-
-        for (unsigned int j = 0; j < n_properties; ++j)
-          sorted_properties.push_back(properties[handle * n_properties + j]);
-      }
-
-    Assert(sorted_locations.size() ==
+    Assert(handles_to_sort.size() ==
              locations.size() - currently_available_handles.size(),
            ExcMessage("Number of sorted property handles is not equal to "
                       "number of currently registered handles: " +
-                      std::to_string(sorted_locations.size()) + " vs " +
+                      std::to_string(handles_to_sort.size()) + " vs " +
                       std::to_string(locations.size()) + " - " +
                       std::to_string(currently_available_handles.size())));
 
+    const std::size_t n_handles = handles_to_sort.size();
+
+    std::vector<Point<spacedim>>       sorted_locations(n_handles);
+    std::vector<Point<dim>>            sorted_reference_locations(n_handles);
+    std::vector<types::particle_index> sorted_ids(n_handles);
+    std::vector<double> sorted_properties(n_handles * n_properties);
+
+    // Every slot is copied to a position known in advance, so the slots can
+    // be gathered in parallel
+    parallel::apply_to_subranges(
+      std::size_t(0),
+      n_handles,
+      [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+          {
+            const Handle handle = handles_to_sort[i];
+            Assert(handle != invalid_handle,
+                   ExcMessage(
+                     "Invalid handle detected during sorting particle memory."));
+
+            sorted_locations[i]           = locations[handle];
+            sorted_reference_locations[i] = reference_locations[handle];
+            sorted_ids[i]                 = ids[handle];
+
+            for (unsigned int j = 0; j < n_properties; ++j)
+              sorted_properties[i * n_properties + j] =
+                properties[handle * n_properties + j];
+          }
+      },
+      1000);
+
     locations           = std::move(sorted_locations);
     reference_locations = std::move(sorted_reference_locations);
     ids                 = std::move(sorted_ids);
@@ -0,0 +1,160 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check ContiguousCellDataStorage: initialize(), get_data(), try_get_data()
+// and erase(), the contiguous layout of the data, and that the data of the
+// cells that remain active is kept when the triangulation is refined.
+
+
+#include <deal.II/base/quadrature_point_data.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+
+#include "../tests.h"
+
+
+struct MyQData
+{
+  double       value = -1.;
+  unsigned int q     = 0;
+};
+
+
+
+template <int dim>
+bool
+check_values(
+  const Triangulation<dim> &tria,
+  const ContiguousCellDataStorage<typename Triangulation<dim>::cell_iterator,
+                                  MyQData> &data_storage)
+{
+  bool ok = true;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (const auto data = data_storage.try_get_data(cell))
+      for (unsigned int q = 0; q < data->size(); ++q)
+        ok &= ((*data)[q].value == cell->center()[0] && (*data)[q].q == q);
+  return ok;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  deallog << "dim = " << dim << std::endl;
+
+  const unsigned int n_q_points = 4;
+
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube(tria, 2);
+  tria.refine_global(1);
+
+  ContiguousCellDataStorage<typename Triangulation<dim>::cell_iterator,
+                            MyQData>
+    data_storage;
+  data_storage.initialize(tria.begin_active(), tria.end(), n_q_points);
+  deallog << "data points: " << data_storage.n_data_points() << std::endl;
+
+  // fill the data and check that the data of consecutive cells is stored
+  // next to each other
+  bool           contiguous = true;
+  const MyQData *previous   = nullptr;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      const ArrayView<MyQData> data = data_storage.get_data(cell);
+      AssertThrow(data.size() == n_q_points, ExcInternalError());
+      if (previous != nullptr)
+        contiguous &= (data.data() == previous + n_q_points);
+      previous = data.data();
+      for (unsigned int q = 0; q < data.size(); ++q)
+        {
+          data[q].value = cell->center()[0];
+          data[q].q     = q;
+        }
+    }
+  deallog << "contiguous: " << (contiguous ? "OK" : "FAILED") << std::endl;
+  deallog << "values: " << (check_values(tria, data_storage) ? "OK" : "FAILED")
+          << std::endl;
+
+  // erase the data of the first cell
+  AssertThrow(data_storage.erase(tria.begin_active()), ExcInternalError());
+  AssertThrow(!data_storage.erase(tria.begin_active()), ExcInternalError());
+  AssertThrow(!data_storage.try_get_data(tria.begin_active()),
+              ExcInternalError());
+  deallog << "data points after erase: " << data_storage.n_data_points()
+          << std::endl;
+  deallog << "values: " << (check_values(tria, data_storage) ? "OK" : "FAILED")
+          << std::endl;
+
+  // refine some cells: the data of the cells that remain active needs to be
+  // kept, and the new cells do not have any data
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.5)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  unsigned int n_cells_with_data = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (data_storage.try_get_data(cell))
+      {
+        AssertThrow(cell->level() == 1, ExcInternalError());
+        ++n_cells_with_data;
+      }
+    else
+      AssertThrow(cell->level() == 2, ExcInternalError());
+  deallog << "cells with data after refinement: " << n_cells_with_data
+          << std::endl;
+  deallog << "data points after refinement: " << data_storage.n_data_points()
+          << std::endl;
+  deallog << "values: " << (check_values(tria, data_storage) ? "OK" : "FAILED")
+          << std::endl;
+
+  // initialize the new cells
+  data_storage.initialize(tria.begin_active(), tria.end(), n_q_points);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->level() == 2)
+      {
+        const ArrayView<MyQData> data = data_storage.get_data(cell);
+        for (unsigned int q = 0; q < data.size(); ++q)
+          {
+            AssertThrow(data[q].value == -1., ExcInternalError());
+            data[q].value = cell->center()[0];
+            data[q].q     = q;
+          }
+      }
+  deallog << "data points: " << data_storage.n_data_points() << std::endl;
+  deallog << "values: " << (check_values(tria, data_storage) ? "OK" : "FAILED")
+          << std::endl;
+
+  data_storage.clear();
+  deallog << "data points after clear: " << data_storage.n_data_points()
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
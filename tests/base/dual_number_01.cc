@@ -0,0 +1,190 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check the arithmetic operations and mathematical functions of
+// Differentiation::AD::DualNumber for double and VectorizedArray number
+// types, including second derivatives with nested dual numbers and the use
+// as number type of tensors.
+
+#include <deal.II/base/symmetric_tensor.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/differentiation/ad/dual_number.h>
+
+#include "../tests.h"
+
+
+template <typename NumberType>
+NumberType
+function(const NumberType &x, const NumberType &y)
+{
+  return std::sin(x) * std::exp(y) / (2. + x * y) + std::pow(x, 3.) -
+         std::sqrt(1. + y * y) * std::log(x) + std::cos(y) / 2. - 3. * x +
+         (x - y) * 0.5;
+}
+
+
+
+template <typename Number>
+void
+test_function()
+{
+  namespace AD = Differentiation::AD;
+  using Dual1  = AD::DualNumber<Number, 2>;
+  using Dual2  = AD::DualNumber<Dual1, 2>;
+
+  Number x_value, y_value;
+  for (unsigned int v = 0; v < internal::VectorizedArrayTrait<Number>::width;
+       ++v)
+    {
+      internal::VectorizedArrayTrait<Number>::get(x_value, v) = 0.7 + 0.1 * v;
+      internal::VectorizedArrayTrait<Number>::get(y_value, v) = 0.3 - 0.2 * v;
+    }
+
+  const Dual2 x(Dual1(x_value, 0), 0);
+  const Dual2 y(Dual1(y_value, 1), 1);
+  const Dual2 f = function(x, y);
+
+  // compare with central finite differences of the function evaluated with
+  // plain numbers
+  const double h       = 1e-4;
+  double       error_1 = 0, error_2 = 0;
+  for (unsigned int v = 0; v < internal::VectorizedArrayTrait<Number>::width;
+       ++v)
+    {
+      const double xv = internal::VectorizedArrayTrait<Number>::get(x_value, v);
+      const double yv = internal::VectorizedArrayTrait<Number>::get(y_value, v);
+      const auto   value = [&](const unsigned int d, const double step) {
+        return d == 0 ? function(xv + step, yv) : function(xv, yv + step);
+      };
+      const auto get = [&](const Number &number) {
+        return internal::VectorizedArrayTrait<Number>::get(number, v);
+      };
+
+      error_1 = std::max(error_1, std::abs(get(f.value().value()) -
+                                           function(xv, yv)));
+      for (unsigned int d = 0; d < 2; ++d)
+        {
+          const double derivative = (value(d, h) - value(d, -h)) / (2. * h);
+          error_1 = std::max(error_1,
+                             std::abs(get(f.value().derivative(d)) -
+                                      derivative));
+          error_1 = std::max(error_1,
+                             std::abs(get(f.derivative(d).value()) -
+                                      derivative));
+        }
+
+      const double d2f_dx2 =
+        (value(0, h) - 2. * function(xv, yv) + value(0, -h)) / (h * h);
+      const double d2f_dxdy = (function(xv + h, yv + h) -
+                               function(xv + h, yv - h) -
+                               function(xv - h, yv + h) +
+                               function(xv - h, yv - h)) /
+                              (4. * h * h);
+      error_2 = std::max(error_2,
+                         std::abs(get(f.derivative(0).derivative(0)) -
+                                  d2f_dx2));
+      error_2 = std::max(error_2,
+                         std::abs(get(f.derivative(0).derivative(1)) -
+                                  d2f_dxdy));
+      error_2 = std::max(error_2,
+                         std::abs(get(f.derivative(1).derivative(0)) -
+                                  d2f_dxdy));
+    }
+
+  deallog << "First derivatives: " << (error_1 < 1e-7 ? "OK" : "FAILED")
+          << std::endl;
+  deallog << "Second derivatives: " << (error_2 < 1e-5 ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+template <typename Number>
+void
+test_tensor()
+{
+  // the derivative of det(A) with respect to A is det(A) A^{-T}
+  namespace AD      = Differentiation::AD;
+  constexpr int dim = 3;
+  using Dual        = AD::DualNumber<Number, dim * dim>;
+
+  Tensor<2, dim, Number> A;
+  for (unsigned int i = 0; i < dim; ++i)
+    for (unsigned int j = 0; j < dim; ++j)
+      A[i][j] = (i == j ? 2. : 0.) + 0.1 * (i + 1) * (j + 2);
+
+  Tensor<2, dim, Dual> A_dual;
+  for (unsigned int i = 0; i < dim * dim; ++i)
+    A_dual[Tensor<2, dim>::unrolled_to_component_indices(i)] =
+      Dual(A[Tensor<2, dim>::unrolled_to_component_indices(i)], i);
+
+  const Dual                   det = determinant(A_dual);
+  const Tensor<2, dim, Number> reference =
+    determinant(A) * transpose(invert(A));
+
+  Number error = 0.;
+  for (unsigned int i = 0; i < dim * dim; ++i)
+    error = std::max(
+      error,
+      std::abs(det.derivative(i) -
+               reference[Tensor<2, dim>::unrolled_to_component_indices(i)]));
+  deallog << "Tensor: "
+          << (internal::VectorizedArrayTrait<Number>::get(error, 0) < 1e-12 ?
+                "OK" :
+                "FAILED")
+          << std::endl;
+
+  // the same for the double contraction of a symmetric tensor with itself
+  SymmetricTensor<2, dim, Dual> S;
+  for (unsigned int i = 0; i < S.n_independent_components; ++i)
+    S.access_raw_entry(i) = Dual(Number(1. + i), i);
+  const Dual S_S = S * S;
+  error          = 0.;
+  for (unsigned int i = 0; i < S.n_independent_components; ++i)
+    {
+      const TableIndices<2> indices =
+        SymmetricTensor<2, dim>::unrolled_to_component_indices(i);
+      // d (S:S) / d S_ij = 2 S_ij, counted twice for off-diagonal entries
+      const double reference =
+        (indices[0] == indices[1] ? 2. : 4.) * (1. + i);
+      error = std::max(error, std::abs(S_S.derivative(i) - reference));
+    }
+  deallog << "SymmetricTensor: "
+          << (internal::VectorizedArrayTrait<Number>::get(error, 0) < 1e-12 ?
+                "OK" :
+                "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("double");
+  test_function<double>();
+  test_tensor<double>();
+  deallog.pop();
+
+  deallog.push("VectorizedArray");
+  test_function<VectorizedArray<double>>();
+  test_tensor<VectorizedArray<double>>();
+  deallog.pop();
+}
@@ -0,0 +1,92 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check that the batched evaluation functions of FunctionParser, i.e.,
+// value_list(), vector_value_list(), vector_value() and value() for points
+// with VectorizedArray coordinates, as well as TensorFunctionParser::
+// value_list() give the same results as the evaluation point by point.
+
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/tensor_function_parser.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+int
+main()
+{
+  initlog();
+
+  FunctionParser<2> fp(2);
+  fp.initialize("x,y,t", "sin(x)*exp(y)+t; x^2-y*t", {}, true);
+  fp.set_time(0.5);
+
+  std::vector<Point<2>> points;
+  for (unsigned int i = 0; i < 11; ++i)
+    points.emplace_back(0.1 * i, std::cos(1. + i));
+
+  bool ok = true;
+
+  std::vector<double> values(points.size());
+  fp.value_list(points, values, 1);
+  for (unsigned int q = 0; q < points.size(); ++q)
+    ok &= std::abs(values[q] - fp.value(points[q], 1)) < 1e-14;
+  deallog << "value_list: " << (ok ? "OK" : "FAILED") << std::endl;
+
+  ok = true;
+  std::vector<Vector<double>> vector_values(points.size(), Vector<double>(2));
+  fp.vector_value_list(points, vector_values);
+  Vector<double> vector_value(2);
+  for (unsigned int q = 0; q < points.size(); ++q)
+    {
+      fp.vector_value(points[q], vector_value);
+      for (unsigned int c = 0; c < 2; ++c)
+        {
+          ok &= std::abs(vector_values[q][c] - fp.value(points[q], c)) < 1e-14;
+          ok &= std::abs(vector_value[c] - fp.value(points[q], c)) < 1e-14;
+        }
+    }
+  deallog << "vector_value_list: " << (ok ? "OK" : "FAILED") << std::endl;
+
+  ok = true;
+  constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+  for (unsigned int q = 0; q + n_lanes <= points.size(); q += n_lanes)
+    {
+      Point<2, VectorizedArray<double>> p;
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        for (unsigned int d = 0; d < 2; ++d)
+          p[d][v] = points[q + v][d];
+      const VectorizedArray<double> result = fp.value(p, 0);
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        ok &= std::abs(result[v] - fp.value(points[q + v], 0)) < 1e-14;
+    }
+  deallog << "VectorizedArray: " << (ok ? "OK" : "FAILED") << std::endl;
+
+  ok = true;
+  TensorFunctionParser<2, 2> tfp;
+  tfp.initialize("x,y,t", "x; y*t; x*y; t", {}, true);
+  tfp.set_time(0.25);
+  std::vector<Tensor<2, 2>> tensor_values(points.size());
+  tfp.value_list(points, tensor_values);
+  for (unsigned int q = 0; q < points.size(); ++q)
+    ok &= (tensor_values[q] - tfp.value(points[q])).norm() < 1e-14;
+  deallog << "TensorFunctionParser::value_list: " << (ok ? "OK" : "FAILED")
+          << std::endl;
+}
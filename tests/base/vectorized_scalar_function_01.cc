@@ -0,0 +1,198 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Compute the stress and the tangent of a compressible Neo-Hookean material
+// with Differentiation::AD::VectorizedScalarFunction at a batch of points
+// and compare them with the analytical expressions, lane by lane. The energy
+// is extended by terms that couple the right Cauchy-Green tensor to a scalar
+// and a vector field to check the extraction of mixed derivatives.
+
+#include <deal.II/base/symmetric_tensor.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/differentiation/ad/vectorized_ad_helpers.h>
+
+#include <deal.II/fe/fe_values_extractors.h>
+
+#include "../tests.h"
+
+
+template <int dim, typename Number>
+void
+test()
+{
+  namespace AD          = Differentiation::AD;
+  constexpr int n_C     = SymmetricTensor<2, dim>::n_independent_components;
+  using ADHelper        = AD::VectorizedScalarFunction<dim, n_C + 1 + dim>;
+  using ADNumberType    = typename ADHelper::ad_type;
+  const double mu       = 1.5;
+  const double lambda   = 4.;
+  const double alpha    = 0.3;
+  const double beta     = 0.7;
+  const unsigned int nv = Number::size();
+
+  const FEValuesExtractors::SymmetricTensor<2> C_dofs(0);
+  const FEValuesExtractors::Scalar             theta_dofs(n_C);
+  const FEValuesExtractors::Vector             v_dofs(n_C + 1);
+
+  // set up a different state in each lane
+  SymmetricTensor<2, dim, Number> C;
+  Number                          theta;
+  Tensor<1, dim, Number>          v;
+  for (unsigned int l = 0; l < nv; ++l)
+    {
+      Tensor<2, dim> F = unit_symmetric_tensor<dim>();
+      for (unsigned int i = 0; i < dim; ++i)
+        {
+          for (unsigned int j = 0; j < dim; ++j)
+            F[i][j] += 0.05 * (l + 1) * (i + 1) / (j + 2.);
+          v[i][l] = 0.2 * i - 0.1 * l;
+        }
+      const SymmetricTensor<2, dim> C_l = symmetrize(transpose(F) * F);
+      for (unsigned int i = 0; i < n_C; ++i)
+        C.access_raw_entry(i)[l] = C_l.access_raw_entry(i);
+      theta[l] = 0.5 + 0.25 * l;
+    }
+
+  ADHelper ad_helper;
+  ad_helper.register_independent_variable(C, C_dofs);
+  ad_helper.register_independent_variable(theta, theta_dofs);
+  ad_helper.register_independent_variable(v, v_dofs);
+
+  const SymmetricTensor<2, dim, ADNumberType> C_AD =
+    ad_helper.get_sensitive_variables(C_dofs);
+  const ADNumberType theta_AD = ad_helper.get_sensitive_variables(theta_dofs);
+  const Tensor<1, dim, ADNumberType> v_AD =
+    ad_helper.get_sensitive_variables(v_dofs);
+
+  const ADNumberType ln_J = 0.5 * std::log(determinant(C_AD));
+  const ADNumberType psi  = 0.5 * mu * (trace(C_AD) - double(dim)) -
+                           mu * ln_J + 0.5 * lambda * ln_J * ln_J +
+                           alpha * theta_AD * trace(C_AD) +
+                           beta * theta_AD * theta_AD +
+                           0.5 * v_AD * C_AD * v_AD;
+  ad_helper.register_dependent_variable(psi);
+
+  const Number psi_value = ad_helper.compute_value();
+  const auto   Dpsi      = ad_helper.compute_gradient();
+  const auto   D2psi     = ad_helper.compute_hessian();
+
+  const SymmetricTensor<2, dim, Number> S =
+    2. * ADHelper::extract_gradient_component(Dpsi, C_dofs);
+  const Number Dpsi_theta =
+    ADHelper::extract_gradient_component(Dpsi, theta_dofs);
+  const Tensor<1, dim, Number> Dpsi_v =
+    ADHelper::extract_gradient_component(Dpsi, v_dofs);
+  const SymmetricTensor<4, dim, Number> HH =
+    4. * ADHelper::extract_hessian_component(D2psi, C_dofs, C_dofs);
+  const SymmetricTensor<2, dim, Number> D2psi_C_theta =
+    ADHelper::extract_hessian_component(D2psi, C_dofs, theta_dofs);
+  const Number D2psi_theta_theta =
+    ADHelper::extract_hessian_component(D2psi, theta_dofs, theta_dofs);
+  const Tensor<3, dim, Number> D2psi_v_C =
+    ADHelper::extract_hessian_component(D2psi, v_dofs, C_dofs);
+  const Tensor<2, dim, Number> D2psi_v_v =
+    ADHelper::extract_hessian_component(D2psi, v_dofs, v_dofs);
+
+  double error_value = 0, error_gradient = 0, error_hessian = 0;
+  for (unsigned int l = 0; l < nv; ++l)
+    {
+      SymmetricTensor<2, dim> C_l;
+      Tensor<1, dim>          v_l;
+      for (unsigned int i = 0; i < n_C; ++i)
+        C_l.access_raw_entry(i) = C.access_raw_entry(i)[l];
+      for (unsigned int i = 0; i < dim; ++i)
+        v_l[i] = v[i][l];
+      const double                  theta_l = theta[l];
+      const SymmetricTensor<2, dim> C_inv   = invert(C_l);
+      const SymmetricTensor<2, dim> I       = unit_symmetric_tensor<dim>();
+      const double ln_J_l = 0.5 * std::log(determinant(C_l));
+
+      const double psi_ref = 0.5 * mu * (trace(C_l) - dim) - mu * ln_J_l +
+                             0.5 * lambda * ln_J_l * ln_J_l +
+                             alpha * theta_l * trace(C_l) +
+                             beta * theta_l * theta_l + 0.5 * v_l * C_l * v_l;
+      error_value = std::max(error_value, std::abs(psi_value[l] - psi_ref));
+
+      const SymmetricTensor<2, dim> S_ref = mu * (I - C_inv) +
+                                            lambda * ln_J_l * C_inv +
+                                            2. * alpha * theta_l * I +
+                                            symmetrize(outer_product(v_l, v_l));
+      const Tensor<1, dim> Dpsi_v_ref = C_l * v_l;
+      for (unsigned int i = 0; i < dim; ++i)
+        {
+          error_gradient = std::max(error_gradient,
+                                    std::abs(Dpsi_v[i][l] - Dpsi_v_ref[i]));
+          for (unsigned int j = 0; j < dim; ++j)
+            error_gradient =
+              std::max(error_gradient, std::abs(S[i][j][l] - S_ref[i][j]));
+        }
+      error_gradient =
+        std::max(error_gradient,
+                 std::abs(Dpsi_theta[l] -
+                          (alpha * trace(C_l) + 2. * beta * theta_l)));
+
+      error_hessian = std::max(error_hessian,
+                               std::abs(D2psi_theta_theta[l] - 2. * beta));
+      for (unsigned int i = 0; i < dim; ++i)
+        for (unsigned int j = 0; j < dim; ++j)
+          {
+            error_hessian =
+              std::max(error_hessian,
+                       std::abs(D2psi_C_theta[i][j][l] - alpha * I[i][j]));
+            error_hessian = std::max(error_hessian,
+                                     std::abs(D2psi_v_v[i][j][l] - C_l[i][j]));
+            for (unsigned int k = 0; k < dim; ++k)
+              {
+                // d^2 psi / dv_k dC_ij = 1/2 (delta_ki v_j + delta_kj v_i)
+                const double D2psi_v_C_ref =
+                  0.5 * ((k == i ? v_l[j] : 0.) + (k == j ? v_l[i] : 0.));
+                error_hessian =
+                  std::max(error_hessian,
+                           std::abs(D2psi_v_C[k][i][j][l] - D2psi_v_C_ref));
+                for (unsigned int m = 0; m < dim; ++m)
+                  {
+                    const double HH_ref =
+                      lambda * C_inv[i][j] * C_inv[k][m] +
+                      (mu - lambda * ln_J_l) * (C_inv[i][k] * C_inv[j][m] +
+                                                C_inv[i][m] * C_inv[j][k]);
+                    error_hessian =
+                      std::max(error_hessian,
+                               std::abs(HH[i][j][k][m][l] - HH_ref));
+                  }
+              }
+          }
+    }
+
+  deallog << "dim=" << dim << std::endl;
+  deallog << "Value: " << (error_value < 1e-12 ? "OK" : "FAILED") << std::endl;
+  deallog << "Gradient: " << (error_gradient < 1e-12 ? "OK" : "FAILED")
+          << std::endl;
+  deallog << "Hessian: " << (error_hessian < 1e-12 ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, VectorizedArray<double>>();
+  test<3, VectorizedArray<double>>();
+}
@@ -0,0 +1,136 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that DoFTools::make_compressed_sparsity_pattern(), which writes
+// directly into a SparsityPattern, produces the same pattern as
+// DoFTools::make_sparsity_pattern() through a DynamicSparsityPattern, with
+// and without keeping the constrained degrees of freedom, also when the
+// SparsityPattern already holds a pattern. A SparsityPattern that has been
+// sized by the caller and is passed to DoFTools::make_sparsity_pattern()
+// only gets the entries added and is compressed by the caller.
+
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+check()
+{
+  Triangulation<dim> tr;
+  if (dim == 2)
+    GridGenerator::hyper_ball(tr, Point<dim>(), 1);
+  else
+    GridGenerator::hyper_cube(tr, -1, 1);
+  tr.refine_global(1);
+  tr.begin_active()->set_refine_flag();
+  tr.execute_coarsening_and_refinement();
+  tr.begin_active(2)->set_refine_flag();
+  tr.execute_coarsening_and_refinement();
+  if (dim == 1)
+    tr.refine_global(2);
+
+  FESystem<dim>   element(FE_Q<dim>(1), 1, FE_Q<dim>(2), 1);
+  DoFHandler<dim> dof(tr);
+  dof.distribute_dofs(element);
+
+  // use hanging node constraints and additionally constrain the first
+  // degree of freedom to the last two ones
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  if (!constraints.is_constrained(0))
+    {
+      constraints.add_line(0);
+      constraints.add_entry(0, dof.n_dofs() - 1, 0.5);
+      constraints.add_entry(0, dof.n_dofs() - 2, 0.5);
+    }
+  constraints.close();
+
+  for (const bool keep_constrained_dofs : {true, false})
+    {
+      // build the pattern twice to check that the previous content is
+      // discarded
+      SparsityPattern sparsity_1;
+      for (unsigned int i = 0; i < 2; ++i)
+        DoFTools::make_compressed_sparsity_pattern(dof,
+                                                   sparsity_1,
+                                                   constraints,
+                                                   keep_constrained_dofs);
+
+      SparsityPattern        sparsity_2;
+      DynamicSparsityPattern dsp(dof.n_dofs());
+      DoFTools::make_sparsity_pattern(dof,
+                                      dsp,
+                                      constraints,
+                                      keep_constrained_dofs);
+      sparsity_2.copy_from(dsp);
+
+      // a pattern sized by the caller only gets the entries added
+      SparsityPattern sparsity_3(dof.n_dofs(), dof.n_dofs(), dof.n_dofs());
+      DoFTools::make_sparsity_pattern(dof,
+                                      sparsity_3,
+                                      constraints,
+                                      keep_constrained_dofs);
+      const bool presized_is_compressed = sparsity_3.is_compressed();
+      sparsity_3.compress();
+
+      deallog << "keep_constrained_dofs=" << keep_constrained_dofs << " -- "
+              << (sparsity_1.is_compressed() && sparsity_1 == sparsity_2 ?
+                    "ok" :
+                    "failed")
+              << std::endl;
+      deallog << "presized pattern -- "
+              << (!presized_is_compressed && sparsity_3 == sparsity_2 ?
+                    "ok" :
+                    "failed")
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("1d");
+  check<1>();
+  deallog.pop();
+  deallog.push("2d");
+  check<2>();
+  deallog.pop();
+  deallog.push("3d");
+  check<3>();
+  deallog.pop();
+}
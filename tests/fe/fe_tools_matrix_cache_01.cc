@@ -0,0 +1,122 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check FETools::MatrixCache: the prolongation and restriction matrices of
+// elements that take their matrices from the cache must be the same as the
+// ones computed directly, also after saving the cache to a file, clearing
+// it and loading it again, for elements with the same name but different
+// shape functions, and after limiting the number of entries.
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_nedelec.h>
+#include <deal.II/fe/fe_tools.h>
+
+#include <deal.II/lac/full_matrix.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+bool
+compare(const FiniteElement<dim> &fe)
+{
+  std::vector<std::vector<FullMatrix<double>>> embedding(
+    RefinementCase<dim>::isotropic_refinement);
+  std::vector<std::vector<FullMatrix<double>>> projection(
+    RefinementCase<dim>::isotropic_refinement);
+  const unsigned int ref_case = RefinementCase<dim>::isotropic_refinement;
+  embedding[ref_case - 1].resize(
+    GeometryInfo<dim>::n_children(RefinementCase<dim>(ref_case)),
+    FullMatrix<double>(fe.n_dofs_per_cell(), fe.n_dofs_per_cell()));
+  projection[ref_case - 1] = embedding[ref_case - 1];
+  FETools::compute_embedding_matrices(fe, embedding, true);
+  FETools::compute_projection_matrices(fe, projection, true);
+
+  bool ok = true;
+  for (unsigned int c = 0; c < GeometryInfo<dim>::max_children_per_cell; ++c)
+    {
+      FullMatrix<double> difference = fe.get_prolongation_matrix(c);
+      difference.add(-1., embedding[ref_case - 1][c]);
+      ok &= difference.frobenius_norm() < 1e-12;
+
+      difference = fe.get_restriction_matrix(c);
+      difference.add(-1., projection[ref_case - 1][c]);
+      ok &= difference.frobenius_norm() < 1e-12;
+    }
+  return ok;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  FETools::MatrixCache::clear();
+  deallog << "entries: " << FETools::MatrixCache::n_entries() << std::endl;
+
+  // the first call computes the matrices, the second one takes them from
+  // the cache
+  deallog << "FE_DGQ<2>(3): " << (compare(FE_DGQ<2>(3)) ? "OK" : "FAILED")
+          << std::endl;
+  deallog << "entries: " << FETools::MatrixCache::n_entries() << std::endl;
+  deallog << "FE_DGQ<2>(3): " << (compare(FE_DGQ<2>(3)) ? "OK" : "FAILED")
+          << std::endl;
+  deallog << "entries: " << FETools::MatrixCache::n_entries() << std::endl;
+
+  // FE_Nedelec only uses the cache for the prolongation matrices
+  {
+    const FE_Nedelec<2> fe(1);
+    fe.get_prolongation_matrix(0);
+    deallog << "entries: " << FETools::MatrixCache::n_entries() << std::endl;
+  }
+
+  FETools::MatrixCache::save("matrix_cache.bin");
+  FETools::MatrixCache::clear();
+  deallog << "entries after clear: " << FETools::MatrixCache::n_entries()
+          << std::endl;
+  FETools::MatrixCache::load("matrix_cache.bin");
+  deallog << "entries after load: " << FETools::MatrixCache::n_entries()
+          << std::endl;
+  std::remove("matrix_cache.bin");
+
+  deallog << "FE_DGQ<2>(3): " << (compare(FE_DGQ<2>(3)) ? "OK" : "FAILED")
+          << std::endl;
+  deallog << "FE_DGQ<3>(2): " << (compare(FE_DGQ<3>(2)) ? "OK" : "FAILED")
+          << std::endl;
+  deallog << "entries: " << FETools::MatrixCache::n_entries() << std::endl;
+
+  // both elements are called FE_DGQArbitraryNodes<2>(QUnknownNodes(3)), but
+  // must not share their matrices
+  const FE_DGQArbitraryNodes<2> fe_a(Quadrature<1>(
+    std::vector<Point<1>>{Point<1>(0.), Point<1>(0.3), Point<1>(1.)}));
+  const FE_DGQArbitraryNodes<2> fe_b(Quadrature<1>(
+    std::vector<Point<1>>{Point<1>(0.), Point<1>(0.6), Point<1>(1.)}));
+  deallog << "same names: " << (fe_a.get_name() == fe_b.get_name())
+          << std::endl;
+  deallog << fe_a.get_name() << ": " << (compare(fe_a) ? "OK" : "FAILED")
+          << std::endl;
+  deallog << fe_b.get_name() << ": " << (compare(fe_b) ? "OK" : "FAILED")
+          << std::endl;
+  deallog << "entries: " << FETools::MatrixCache::n_entries() << std::endl;
+
+  FETools::MatrixCache::set_max_n_entries(4);
+  deallog << "entries after limiting: " << FETools::MatrixCache::n_entries()
+          << std::endl;
+  deallog << "FE_DGQ<2>(3): " << (compare(FE_DGQ<2>(3)) ? "OK" : "FAILED")
+          << std::endl;
+  deallog << "entries: " << FETools::MatrixCache::n_entries() << std::endl;
+}
@@ -0,0 +1,130 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// FEValues::get_function_values() and get_function_gradients() use sum
+// factorization for tensor product elements with tensor product quadrature
+// formulas. Check that the result is the same as the sum over the shape
+// functions on a deformed mesh, for scalar and vector-valued elements.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe)
+{
+  deallog << fe.get_name() << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1.);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  for (auto &entry : solution)
+    entry = random_value<double>();
+
+  const MappingQ<dim> mapping(3);
+  FEValues<dim>       fe_values(mapping,
+                          fe,
+                          QGauss<dim>(fe.degree + 1),
+                          update_values | update_gradients);
+
+  const unsigned int n_q_points   = fe_values.n_quadrature_points;
+  const unsigned int n_components = fe.n_components();
+
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+  std::vector<double>                  values(n_q_points);
+  std::vector<Tensor<1, dim>>          gradients(n_q_points);
+  std::vector<Vector<double>> values_system(n_q_points,
+                                            Vector<double>(n_components));
+  std::vector<std::vector<Tensor<1, dim>>> gradients_system(
+    n_q_points, std::vector<Tensor<1, dim>>(n_components));
+
+  double max_error = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      cell->get_dof_indices(dof_indices);
+
+      if (n_components == 1)
+        {
+          fe_values.get_function_values(solution, values);
+          fe_values.get_function_gradients(solution, gradients);
+        }
+      fe_values.get_function_values(solution, values_system);
+      fe_values.get_function_gradients(solution, gradients_system);
+
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        for (unsigned int c = 0; c < n_components; ++c)
+          {
+            double         value = 0;
+            Tensor<1, dim> gradient;
+            for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+              {
+                value +=
+                  solution(dof_indices[i]) * fe_values.shape_value_component(
+                                               i, q, c);
+                gradient +=
+                  solution(dof_indices[i]) * fe_values.shape_grad_component(
+                                               i, q, c);
+              }
+
+            if (n_components == 1)
+              {
+                max_error = std::max(max_error, std::abs(values[q] - value));
+                max_error =
+                  std::max(max_error, (gradients[q] - gradient).norm());
+              }
+            max_error =
+              std::max(max_error, std::abs(values_system[q][c] - value));
+            max_error =
+              std::max(max_error, (gradients_system[q][c] - gradient).norm());
+          }
+    }
+
+  deallog << (max_error < 1e-10 ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test(FE_Q<2>(4));
+  test(FE_DGQ<2>(3));
+  test(FESystem<2>(FE_Q<2>(3), 2));
+  test(FE_Q<3>(3));
+  test(FE_DGQ<3>(2));
+  test(FESystem<3>(FE_Q<3>(2), 3));
+}
@@ -0,0 +1,137 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check the joint DoF indices of FEInterfaceValues on all interior faces
+// and subfaces of an adaptively refined mesh against the indices obtained
+// from sorting the DoF indices of the two cells, for discontinuous elements
+// (where the DoFs of each cell are sorted) as well as continuous elements
+// and a renumbered DoFHandler (where they are not).
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_interface_values.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <map>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe, const bool renumber)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  if (renumber)
+    DoFRenumbering::random(dof_handler);
+
+  FEInterfaceValues<dim> fiv(fe, QGauss<dim - 1>(2), update_values);
+
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+  std::vector<types::global_dof_index> dof_indices_neighbor(
+    fe.n_dofs_per_cell());
+
+  unsigned int n_faces = 0;
+  bool         ok      = true;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    for (const unsigned int f : cell->face_indices())
+      if (!cell->at_boundary(f) && !cell->neighbor_is_coarser(f))
+        {
+          const unsigned int n_subfaces =
+            cell->face(f)->has_children() ? cell->face(f)->n_children() : 1;
+          for (unsigned int sf = 0; sf < n_subfaces; ++sf)
+            {
+              const auto neighbor = cell->face(f)->has_children() ?
+                                      cell->neighbor_child_on_subface(f, sf) :
+                                      cell->neighbor(f);
+              fiv.reinit(cell,
+                         f,
+                         cell->face(f)->has_children() ?
+                           sf :
+                           numbers::invalid_unsigned_int,
+                         neighbor,
+                         cell->neighbor_of_neighbor(f),
+                         numbers::invalid_unsigned_int);
+              cell->get_dof_indices(dof_indices);
+              neighbor->get_dof_indices(dof_indices_neighbor);
+              ++n_faces;
+
+              std::map<types::global_dof_index, std::array<unsigned int, 2>>
+                reference;
+              for (unsigned int i = 0; i < dof_indices.size(); ++i)
+                reference
+                  .emplace(dof_indices[i],
+                           std::array<unsigned int, 2>{
+                             {numbers::invalid_unsigned_int,
+                              numbers::invalid_unsigned_int}})
+                  .first->second[0] = i;
+              for (unsigned int i = 0; i < dof_indices_neighbor.size(); ++i)
+                reference
+                  .emplace(dof_indices_neighbor[i],
+                           std::array<unsigned int, 2>{
+                             {numbers::invalid_unsigned_int,
+                              numbers::invalid_unsigned_int}})
+                  .first->second[1] = i;
+
+              const std::vector<types::global_dof_index> interface_indices =
+                fiv.get_interface_dof_indices();
+              ok &= (interface_indices.size() == reference.size() &&
+                     fiv.n_current_interface_dofs() == reference.size());
+              unsigned int idx = 0;
+              for (const auto &entry : reference)
+                {
+                  if (idx < interface_indices.size())
+                    ok &= (interface_indices[idx] == entry.first &&
+                           fiv.interface_dof_to_dof_indices(idx) ==
+                             entry.second);
+                  ++idx;
+                }
+            }
+        }
+
+  deallog << fe.get_name() << (renumber ? " renumbered" : "") << ", "
+          << n_faces << " faces: " << (ok ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test(FE_DGQ<2>(2), false);
+  test(FE_DGQ<2>(2), true);
+  test(FE_Q<2>(2), false);
+  test(FESystem<2>(FE_Q<2>(2), 2), false);
+  test(FE_DGQ<3>(1), false);
+  test(FE_Q<3>(2), true);
+}
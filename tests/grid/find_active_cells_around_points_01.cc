@@ -0,0 +1,104 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Test GridTools::find_active_cells_around_points on a curved mesh with a
+// high-order mapping: every point found by find_active_cell_around_point()
+// must also be found by the batched search, and the returned cells and
+// reference positions must map back to the points.
+
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(dim == 2 ? 3 : 2);
+
+  MappingQ<dim>         mapping(3);
+  GridTools::Cache<dim> cache(tria, mapping);
+
+  // points inside the ball, some of them close to its curved boundary, and
+  // points outside of it, as well as the vertices of the mesh
+  std::vector<Point<dim>> points;
+  for (unsigned int i = 0; i < 2000; ++i)
+    points.push_back(random_point<dim>(-1.05, 1.05));
+  for (const auto &vertex : tria.get_vertices())
+    points.push_back(vertex);
+
+  const auto result = GridTools::find_active_cells_around_points(cache, points);
+  const auto &cells            = result.first;
+  const auto &reference_points = result.second;
+
+  deallog << "Number of results: "
+          << (cells.size() == points.size() &&
+                  reference_points.size() == points.size() ?
+                "OK" :
+                "FAILED")
+          << std::endl;
+
+  bool         same_points_found = true;
+  bool         points_match      = true;
+  unsigned int n_found           = 0;
+  for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      const auto reference =
+        GridTools::find_active_cell_around_point(cache, points[i]);
+      const bool found = (cells[i] != tria.end());
+      if (reference.first.state() == IteratorState::valid && !found)
+        same_points_found = false;
+
+      if (found)
+        {
+          ++n_found;
+          points_match &=
+            mapping.transform_unit_to_real_cell(cells[i], reference_points[i])
+              .distance(points[i]) < 1e-10;
+          points_match &=
+            GeometryInfo<dim>::is_inside_unit_cell(reference_points[i], 1e-10);
+        }
+    }
+
+  deallog << "Points found by find_active_cell_around_point: "
+          << (same_points_found ? "OK" : "FAILED") << std::endl;
+  deallog << "Points in cells: " << (points_match ? "OK" : "FAILED")
+          << std::endl;
+  deallog << "Found all vertices: "
+          << (n_found >= tria.n_vertices() ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
@@ -0,0 +1,139 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// AffineConstraints applies closed constraints to vectors through a
+// compressed row copy of its lines. Check that distribute(), set_zero(),
+// get_dof_values() and distribute_local_to_global() give the same results
+// as a direct evaluation of the constraint lines, also for enough lines to
+// run distribute() in parallel, and after modifying the object through
+// set_inhomogeneity() and shift() after close().
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <typename number>
+void
+check_distribute(const AffineConstraints<number> &constraints,
+                 const Vector<number> &           src)
+{
+  Vector<number> vec(src);
+  constraints.distribute(vec);
+
+  Vector<number> reference(src);
+  for (const auto &line : constraints.get_lines())
+    {
+      number value = line.inhomogeneity;
+      for (const auto &entry : line.entries)
+        value += src(entry.first) * entry.second;
+      reference(line.index) = value;
+    }
+
+  reference -= vec;
+  deallog << "distribute error: " << reference.linfty_norm() << std::endl;
+}
+
+
+
+template <typename number>
+void
+test()
+{
+  const unsigned int n_dofs = 20001;
+
+  // constrain every odd dof to the average of its neighbors, and every
+  // seventh of them inhomogeneously. chain some of the constraints to
+  // exercise the resolution in close()
+  AffineConstraints<number> constraints;
+  for (unsigned int i = 1; i < n_dofs - 1; i += 2)
+    {
+      constraints.add_line(i);
+      if (i % 10 == 5)
+        constraints.add_entry(i, i - 4, 1.);
+      else
+        {
+          constraints.add_entry(i, i - 1, 0.5);
+          constraints.add_entry(i, i + 1, 0.5);
+        }
+      if (i % 7 == 0)
+        constraints.set_inhomogeneity(i, 1.);
+    }
+  for (unsigned int i = 2; i < n_dofs - 1; i += 10)
+    {
+      constraints.add_line(i);
+      constraints.add_entry(i, i + 2, 1.);
+    }
+  constraints.close();
+  deallog << "n_constraints: " << constraints.n_constraints() << std::endl;
+
+  Vector<number> src(n_dofs);
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    src(i) = 1. + (i % 13);
+
+  check_distribute(constraints, src);
+
+  // set_zero() must only touch the constrained entries
+  {
+    Vector<number> vec(src);
+    constraints.set_zero(vec);
+    unsigned int n_errors = 0;
+    for (unsigned int i = 0; i < n_dofs; ++i)
+      if (vec(i) != (constraints.is_constrained(i) ? number(0.) : src(i)))
+        ++n_errors;
+    deallog << "set_zero errors: " << n_errors << std::endl;
+  }
+
+  // get_dof_values() and distribute_local_to_global()
+  {
+    const std::vector<types::global_dof_index> indices = {0, 1, 2, 3, 7, 21};
+    Vector<number> local(indices.size());
+    constraints.get_dof_values(src, indices.begin(), local.begin(), local.end());
+    for (unsigned int i = 0; i < indices.size(); ++i)
+      deallog << "value " << indices[i] << ": " << local(i) << std::endl;
+
+    Vector<number> dst(n_dofs);
+    constraints.distribute_local_to_global(local, indices, dst);
+    for (unsigned int i = 0; i < 10; ++i)
+      deallog << dst(i) << ' ';
+    deallog << std::endl;
+  }
+
+  // changing an inhomogeneity of a closed object must be seen by
+  // distribute()
+  constraints.set_inhomogeneity(3, 5.);
+  check_distribute(constraints, src);
+
+  // so must shifting all indices
+  AffineConstraints<number> shifted;
+  shifted.copy_from(constraints);
+  shifted.shift(n_dofs);
+  Vector<number> shifted_src(2 * n_dofs);
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    shifted_src(n_dofs + i) = src(i);
+  check_distribute(shifted, shifted_src);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<double>();
+  test<float>();
+}
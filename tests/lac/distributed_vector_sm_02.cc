@@ -0,0 +1,144 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Test that update_ghost_values() and compress() of
+// LinearAlgebra::distributed::Vector give the same results when the ghost
+// data is exchanged through shared memory as when it is sent as MPI
+// messages, also when mixing them with modifications of the vector and for
+// a shared-memory communicator that only contains part of the processes.
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include "../tests.h"
+
+
+
+template <typename Number>
+void
+test(const MPI_Comm comm_sm)
+{
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+  const unsigned int n_local = 10;
+  const unsigned int size    = n_local * n_procs;
+
+  IndexSet owned(size);
+  owned.add_range(my_rank * n_local, (my_rank + 1) * n_local);
+
+  // ghosts from both neighbors and from the first process
+  IndexSet ghosts(size);
+  for (unsigned int i = 1; i < 4; ++i)
+    {
+      ghosts.add_index((my_rank * n_local + size - i) % size);
+      ghosts.add_index(((my_rank + 1) * n_local + i - 1) % size);
+    }
+  if (my_rank > 1)
+    ghosts.add_range(0, 2);
+
+  const auto partitioner =
+    std::make_shared<Utilities::MPI::Partitioner>(owned,
+                                                  ghosts,
+                                                  MPI_COMM_WORLD);
+
+  LinearAlgebra::distributed::Vector<Number> reference(partitioner);
+  LinearAlgebra::distributed::Vector<Number> vector;
+  vector.reinit(partitioner, comm_sm);
+
+  bool ok = true;
+  for (unsigned int round = 0; round < 3; ++round)
+    {
+      for (const auto i : owned)
+        {
+          reference(i) = i + round;
+          vector(i)    = i + round;
+        }
+
+      reference.update_ghost_values();
+      vector.update_ghost_values();
+      for (const auto i : ghosts)
+        ok &= (vector(i) == reference(i)) && (vector(i) == Number(i + round));
+
+      // change the owned values right away, the neighbors must have
+      // finished reading the old ones
+      reference.zero_out_ghost_values();
+      vector.zero_out_ghost_values();
+      reference *= Number(2.);
+      vector *= Number(2.);
+
+      for (const auto i : ghosts)
+        {
+          reference(i) += Number(1. + round);
+          vector(i) += Number(1. + round);
+        }
+      reference.compress(VectorOperation::add);
+      vector.compress(VectorOperation::add);
+      for (const auto i : owned)
+        ok &= (vector(i) == reference(i));
+      for (const auto i : ghosts)
+        ok &= (vector(i) == Number(0.));
+
+      // insert is not done through shared memory, but must still work
+      for (const auto i : ghosts)
+        {
+          reference(i) = Number(i);
+          vector(i)    = Number(i);
+        }
+      reference.compress(VectorOperation::insert);
+      vector.compress(VectorOperation::insert);
+      for (const auto i : owned)
+        ok &= (vector(i) == reference(i));
+    }
+
+  // a copy shares the exchange with the original vector
+  LinearAlgebra::distributed::Vector<Number> copy(vector);
+  copy.update_ghost_values();
+  vector.update_ghost_values();
+  for (const auto i : ghosts)
+    ok &= (copy(i) == vector(i));
+
+  deallog << (Utilities::MPI::min(ok ? 1 : 0, MPI_COMM_WORLD) == 1 ? "OK" :
+                                                                      "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  const auto my_rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  MPI_Comm comm_sm;
+  MPI_Comm_split_type(
+    MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, my_rank, MPI_INFO_NULL, &comm_sm);
+
+  // shared-memory communicators containing only some of the processes
+  MPI_Comm comm_pairs;
+  MPI_Comm_split(comm_sm, my_rank / 2, my_rank, &comm_pairs);
+
+  for (const auto comm : {comm_sm, comm_pairs})
+    {
+      test<double>(comm);
+      test<float>(comm);
+    }
+
+  MPI_Comm_free(&comm_pairs);
+  MPI_Comm_free(&comm_sm);
+}
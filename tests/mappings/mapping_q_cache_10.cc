@@ -0,0 +1,128 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Test MappingQCache with the storage format
+// MappingQCache::StorageFormat::float_offsets: the mapped quadrature points,
+// the JxW values and the vertices must agree with the ones of the cache in
+// full precision up to the precision of the offsets, while the cache takes
+// less memory. On a mesh with straight-sided cells, only the vertices are
+// stored.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_nothing.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/fe/mapping_q_cache.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+compare(const Triangulation<dim> &tria, const unsigned int degree)
+{
+  const MappingQ<dim> mapping(degree);
+  MappingQCache<dim>  mapping_full(degree);
+  MappingQCache<dim>  mapping_float(
+    degree, MappingQCache<dim>::StorageFormat::float_offsets);
+  mapping_full.initialize(mapping, tria);
+  mapping_float.initialize(mapping, tria);
+
+  const FE_Nothing<dim> fe;
+  const QGauss<dim>     quadrature(degree + 1);
+  const UpdateFlags     flags = update_quadrature_points | update_JxW_values;
+  FEValues<dim>         fe_values_full(mapping_full, fe, quadrature, flags);
+  FEValues<dim>         fe_values_float(mapping_float, fe, quadrature, flags);
+
+  double error_points = 0, error_jxw = 0, error_vertices = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      fe_values_full.reinit(cell);
+      fe_values_float.reinit(cell);
+      const double h = cell->diameter();
+      for (const unsigned int q : fe_values_full.quadrature_point_indices())
+        {
+          error_points = std::max(error_points,
+                                  fe_values_full.quadrature_point(q).distance(
+                                    fe_values_float.quadrature_point(q)) /
+                                    h);
+          error_jxw =
+            std::max(error_jxw,
+                     std::abs(fe_values_full.JxW(q) - fe_values_float.JxW(q)) /
+                       fe_values_full.JxW(q));
+        }
+
+      const auto vertices_full  = mapping_full.get_vertices(cell);
+      const auto vertices_float = mapping_float.get_vertices(cell);
+      for (const unsigned int v : cell->vertex_indices())
+        error_vertices =
+          std::max(error_vertices,
+                   vertices_full[v].distance(vertices_float[v]));
+    }
+
+  deallog << "dim=" << dim << " degree=" << degree
+          << " cells=" << tria.n_cells() << std::endl;
+  deallog << "Quadrature points: " << (error_points < 1e-8 ? "OK" : "FAILED")
+          << std::endl;
+  deallog << "JxW: " << (error_jxw < 1e-7 ? "OK" : "FAILED") << std::endl;
+  deallog << "Vertices: " << (error_vertices == 0. ? "OK" : "FAILED")
+          << std::endl;
+  deallog << "Memory reduced: "
+          << (mapping_float.memory_consumption() <
+                  0.7 * mapping_full.memory_consumption() ?
+                "OK" :
+                "FAILED")
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  {
+    // curved mesh, all cells have offsets
+    Triangulation<dim> tria;
+    GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1., 0, true);
+    tria.refine_global(1);
+    compare(tria, 4);
+  }
+  {
+    // straight-sided cells, only the vertices are stored
+    Triangulation<dim> tria;
+    Point<dim>         upper_right;
+    for (unsigned int d = 0; d < dim; ++d)
+      upper_right[d] = 1. + d;
+    GridGenerator::subdivided_hyper_rectangle(
+      tria, std::vector<unsigned int>(dim, 3), Point<dim>(), upper_right);
+    compare(tria, 3);
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
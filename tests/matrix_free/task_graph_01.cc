@@ -0,0 +1,194 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// The threaded matrix-free loops are run as a graph of tasks. For all three
+// threaded schemes, check that the graph is acyclic, that every range of
+// cells is visited exactly once, and that the result of a matrix-vector
+// product agrees with the serial loop.
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+#include "matrix_vector_mf.h"
+
+
+void
+check_graph(const internal::MatrixFreeFunctions::TaskInfo &task_info)
+{
+  using NodeType = internal::MatrixFreeFunctions::TaskGraph::NodeType;
+  const auto &graph = task_info.task_graph;
+
+  // topological sort
+  std::vector<unsigned int> n_predecessors = graph.n_predecessors;
+  std::vector<unsigned int> ready;
+  for (unsigned int i = 0; i < graph.nodes.size(); ++i)
+    if (n_predecessors[i] == 0)
+      ready.push_back(i);
+  unsigned int n_visited = 0;
+  while (ready.empty() == false)
+    {
+      const unsigned int node = ready.back();
+      ready.pop_back();
+      ++n_visited;
+      for (unsigned int j = graph.successor_start[node];
+           j < graph.successor_start[node + 1];
+           ++j)
+        if (--n_predecessors[graph.successors[j]] == 0)
+          ready.push_back(graph.successors[j]);
+    }
+  deallog << "acyclic: " << (n_visited == graph.nodes.size() ? "yes" : "no")
+          << std::endl;
+
+  // all cell batches must be covered exactly once
+  const unsigned int n_batches = task_info.cell_partition_data
+    [task_info.partition_row_index.back()];
+  std::vector<unsigned int> n_touched(n_batches, 0);
+  for (const auto &node : graph.nodes)
+    if (node.type == NodeType::range_index)
+      {
+        for (unsigned int i = task_info.cell_partition_data[node.first];
+             i < task_info.cell_partition_data[node.first + 1];
+             ++i)
+          ++n_touched[i];
+      }
+    else if (node.type == NodeType::cell_range)
+      {
+        for (unsigned int i = node.first; i < node.second; ++i)
+          ++n_touched[i];
+      }
+  deallog << "cells covered once: "
+          << (std::count(n_touched.begin(), n_touched.end(), 1U) ==
+                  static_cast<long>(n_batches) ?
+                "yes" :
+                "no")
+          << std::endl;
+}
+
+
+
+template <int dim, int fe_degree>
+void
+test()
+{
+  using number = double;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(5 - dim);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center().norm() < 0.4)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  VectorTools::interpolate_boundary_values(dof,
+                                           0,
+                                           Functions::ZeroFunction<dim>(),
+                                           constraints);
+  constraints.close();
+
+  Vector<number> in(dof.n_dofs()), reference(dof.n_dofs());
+  for (unsigned int i = 0; i < dof.n_dofs(); ++i)
+    if (constraints.is_constrained(i) == false)
+      in(i) = random_value<double>();
+
+  const QGauss<1> quad(fe_degree + 1);
+  {
+    MatrixFree<dim, number> mf_data;
+    mf_data.reinit(MappingQ1<dim>{},
+                   dof,
+                   constraints,
+                   quad,
+                   typename MatrixFree<dim, number>::AdditionalData(
+                     MatrixFree<dim, number>::AdditionalData::none));
+    MatrixFreeTest<dim, fe_degree, number> mf(mf_data);
+    mf.vmult(reference, in);
+  }
+
+  const std::vector<
+    std::pair<typename MatrixFree<dim, number>::AdditionalData::
+                TasksParallelScheme,
+              std::string>>
+    schemes = {
+      {MatrixFree<dim, number>::AdditionalData::partition_partition,
+       "partition_partition"},
+      {MatrixFree<dim, number>::AdditionalData::partition_color,
+       "partition_color"},
+      {MatrixFree<dim, number>::AdditionalData::color, "color"}};
+
+  for (const auto &scheme : schemes)
+    {
+      deallog << "Scheme " << scheme.second << std::endl;
+      MatrixFree<dim, number> mf_data;
+      mf_data.reinit(MappingQ1<dim>{},
+                     dof,
+                     constraints,
+                     quad,
+                     typename MatrixFree<dim, number>::AdditionalData(
+                       scheme.first, 3));
+      check_graph(mf_data.get_task_info());
+
+      MatrixFreeTest<dim, fe_degree, number> mf(mf_data);
+      Vector<number>                         out(dof.n_dofs());
+      for (unsigned int sweep = 0; sweep < 5; ++sweep)
+        {
+          mf.vmult(out, in);
+          out -= reference;
+          deallog << "Sweep " << sweep << ": "
+                  << (out.linfty_norm() < 1e-12 * reference.linfty_norm() ?
+                        "ok" :
+                        "FAILED")
+                  << std::endl;
+        }
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2, 1>();
+  test<2, 2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3, 1>();
+  deallog.pop();
+}
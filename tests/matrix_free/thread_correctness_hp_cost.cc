@@ -0,0 +1,186 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check the cost model of the cell batches in the hp-case: the estimated
+// cost must increase with the polynomial degree, the thread-parallel cell
+// loop with the coloring schemes, which merges blocks of cheap cells into
+// larger tasks, must give the same result as the serial loop, and the
+// weights of MatrixFreeTools::make_cell_weights() must follow the costs
+// given by the user.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/hp/fe_collection.h>
+#include <deal.II/hp/q_collection.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+apply(const MatrixFree<dim, double> &matrix_free,
+      Vector<double> &               dst,
+      const Vector<double> &         src)
+{
+  dst = 0;
+  matrix_free.template cell_loop<Vector<double>, Vector<double>>(
+    [](const auto &data, auto &dst, const auto &src, const auto range) {
+      FEEvaluation<dim, -1, 0, 1, double> phi(data, range);
+      for (unsigned int cell = range.first; cell < range.second; ++cell)
+        {
+          phi.reinit(cell);
+          phi.gather_evaluate(src,
+                              EvaluationFlags::values |
+                                EvaluationFlags::gradients);
+          for (const unsigned int q : phi.quadrature_point_indices())
+            {
+              phi.submit_value(phi.get_value(q), q);
+              phi.submit_gradient(phi.get_gradient(q), q);
+            }
+          phi.integrate_scatter(EvaluationFlags::values |
+                                  EvaluationFlags::gradients,
+                                dst);
+        }
+    },
+    dst,
+    src);
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube(tria, 8);
+
+  const unsigned int    max_degree = 4;
+  hp::FECollection<dim> fe_collection;
+  hp::QCollection<dim>  q_collection;
+  for (unsigned int degree = 1; degree <= max_degree; ++degree)
+    {
+      fe_collection.push_back(FE_Q<dim>(degree));
+      q_collection.push_back(QGauss<dim>(degree + 1));
+    }
+
+  DoFHandler<dim> dof_handler(tria);
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    cell->set_active_fe_index(Testing::rand() % max_degree);
+  dof_handler.distribute_dofs(fe_collection);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags = update_values | update_gradients;
+  additional_data.tasks_parallel_scheme =
+    MatrixFree<dim, double>::AdditionalData::none;
+
+  MatrixFree<dim, double> matrix_free_serial;
+  matrix_free_serial.reinit(
+    MappingQ1<dim>(), dof_handler, constraints, q_collection, additional_data);
+
+  bool cost_increases = true;
+  for (unsigned int i = 1; i < max_degree; ++i)
+    cost_increases &= matrix_free_serial.get_cell_batch_cost(i) >
+                      matrix_free_serial.get_cell_batch_cost(i - 1);
+  deallog << "Estimated cost increases with degree: "
+          << (cost_increases ? "OK" : "FAILED") << std::endl;
+
+  Vector<double> src(dof_handler.n_dofs()), dst(dof_handler.n_dofs()),
+    dst_ref(dof_handler.n_dofs());
+  for (auto &entry : src)
+    entry = random_value<double>();
+  apply(matrix_free_serial, dst_ref, src);
+
+  for (const auto scheme : {MatrixFree<dim, double>::AdditionalData::color,
+                            MatrixFree<dim, double>::AdditionalData::
+                              partition_color})
+    {
+      additional_data.tasks_parallel_scheme = scheme;
+      MatrixFree<dim, double> matrix_free;
+      matrix_free.reinit(MappingQ1<dim>(),
+                         dof_handler,
+                         constraints,
+                         q_collection,
+                         additional_data);
+
+      bool ok = true;
+      for (unsigned int i = 0; i < 10; ++i)
+        {
+          apply(matrix_free, dst, src);
+          dst -= dst_ref;
+          ok &= dst.linfty_norm() < 1e-12 * dst_ref.linfty_norm();
+        }
+      deallog << "Scheme " << static_cast<unsigned int>(scheme) << ": "
+              << (ok ? "OK" : "FAILED") << std::endl;
+    }
+
+  // costs measured by the user
+  additional_data.tasks_parallel_scheme =
+    MatrixFree<dim, double>::AdditionalData::color;
+  additional_data.active_fe_index_cost = {1., 2.5, 4., 8.};
+  MatrixFree<dim, double> matrix_free;
+  matrix_free.reinit(
+    MappingQ1<dim>(), dof_handler, constraints, q_collection, additional_data);
+  apply(matrix_free, dst, src);
+  dst -= dst_ref;
+  deallog << "Scheme with given costs: "
+          << (dst.linfty_norm() < 1e-12 * dst_ref.linfty_norm() ? "OK" :
+                                                                  "FAILED")
+          << std::endl;
+
+  const auto weighting_function =
+    MatrixFreeTools::make_cell_weights(matrix_free, 100);
+  deallog << "Cell weights:";
+  for (unsigned int i = 0; i < fe_collection.size(); ++i)
+    deallog << ' '
+            << weighting_function(dof_handler.begin_active(),
+                                  dof_handler.get_fe(i));
+  deallog << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  MultithreadInfo::set_thread_limit(4);
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
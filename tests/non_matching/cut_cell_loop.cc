@@ -0,0 +1,313 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Apply the bulk and Nitsche terms of a Poisson problem on the cut cells
+// with NonMatching::CutCellLoop, NonMatching::MappingInfo and
+// FEPointEvaluation, and compare with the result of a cell matrix
+// assembled with FEValues and NonMatching::FEImmersedSurfaceValues on a
+// mesh with hanging nodes. Also check that the cells of a color do not
+// share degrees of freedom, and that the loop gives the same result for a
+// BlockVector.
+
+#include <deal.II/base/function_signed_distance.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/filtered_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_point_evaluation.h>
+
+#include <deal.II/non_matching/cut_cell_loop.h>
+#include <deal.II/non_matching/fe_immersed_values.h>
+#include <deal.II/non_matching/mapping_info.h>
+#include <deal.II/non_matching/mesh_classifier.h>
+#include <deal.II/non_matching/quadrature_generator.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include <set>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int degree)
+{
+  deallog << "dim = " << dim << ", degree = " << degree << std::endl;
+
+  const double penalty = 10.;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, -1.21, 1.21);
+  tria.refine_global(dim == 2 ? 3 : 2);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] > 0)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  const FE_Q<dim>     fe(degree);
+  const MappingQ<dim> mapping(1);
+  DoFHandler<dim>     dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+
+  const Functions::SignedDistance::Sphere<dim> sphere(Point<dim>(), 0.7);
+  Vector<double> level_set(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler, sphere, level_set);
+
+  NonMatching::MeshClassifier<dim> mesh_classifier(dof_handler, level_set);
+  mesh_classifier.reclassify();
+
+  const hp::QCollection<1> q_collection1D(QGauss<1>(degree + 1));
+  NonMatching::DiscreteQuadratureGenerator<dim> quadrature_generator(
+    q_collection1D, dof_handler, level_set);
+
+  const auto cut_cells =
+    dof_handler.active_cell_iterators() |
+    [&](const typename DoFHandler<dim>::active_cell_iterator &cell) {
+      return mesh_classifier.location_to_level_set(cell) ==
+             NonMatching::LocationToLevelSet::intersected;
+    };
+
+  std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
+  std::vector<Quadrature<dim>>                                quadratures;
+  std::vector<NonMatching::ImmersedSurfaceQuadrature<dim>>    surfaces;
+  for (const auto &cell : cut_cells)
+    {
+      quadrature_generator.generate(cell);
+      cells.push_back(cell);
+      quadratures.push_back(quadrature_generator.get_inside_quadrature());
+      surfaces.push_back(quadrature_generator.get_surface_quadrature());
+    }
+
+  NonMatching::MappingInfo<dim> mapping_info_cell(mapping,
+                                                  update_values |
+                                                    update_gradients |
+                                                    update_JxW_values);
+  NonMatching::MappingInfo<dim> mapping_info_surface(
+    mapping,
+    update_values | update_gradients | update_JxW_values |
+      update_normal_vectors);
+  mapping_info_cell.reinit_cells(cut_cells, quadratures);
+  mapping_info_surface.reinit_surface(cut_cells, surfaces);
+
+  NonMatching::CutCellLoop<dim> cut_cell_loop;
+  cut_cell_loop.reinit(dof_handler,
+                       constraints,
+                       cut_cells,
+                       typename NonMatching::CutCellLoop<dim>::AdditionalData(
+                         2));
+
+  // the cells of each color must not share any degree of freedom
+  bool         coloring_ok = true;
+  unsigned int n_colored   = 0;
+  for (unsigned int c = 0; c < cut_cell_loop.n_colors(); ++c)
+    {
+      std::set<types::global_dof_index> dofs_of_color;
+      for (const unsigned int cell_index : cut_cell_loop.get_cells_of_color(c))
+        {
+          ++n_colored;
+          for (const auto index : cut_cell_loop.get_dof_indices(cell_index))
+            {
+              coloring_ok &= (dofs_of_color.count(index) == 0);
+              if (const auto *entries =
+                    constraints.get_constraint_entries(index))
+                for (const auto &entry : *entries)
+                  coloring_ok &= (dofs_of_color.count(entry.first) == 0);
+            }
+          for (const auto index : cut_cell_loop.get_dof_indices(cell_index))
+            {
+              dofs_of_color.insert(index);
+              if (const auto *entries =
+                    constraints.get_constraint_entries(index))
+                for (const auto &entry : *entries)
+                  dofs_of_color.insert(entry.first);
+            }
+        }
+    }
+  coloring_ok &= (n_colored == cells.size());
+  deallog << "coloring: " << (coloring_ok ? "OK" : "FAILED") << std::endl;
+
+  Vector<double> src(dof_handler.n_dofs()), dst(dof_handler.n_dofs()),
+    dst_ref(dof_handler.n_dofs());
+  for (auto &v : src)
+    v = random_value<double>();
+  constraints.set_zero(src);
+
+  const auto worker = [&](const NonMatching::CutCellLoop<dim> &data,
+                          auto &                               dst,
+                          const auto &                         src,
+                          const ArrayView<const unsigned int> &cell_indices) {
+    FEPointEvaluation<1, dim> phi_cell(mapping_info_cell, fe);
+    FEPointEvaluation<1, dim> phi_surface(mapping_info_surface, fe);
+    std::vector<double>       src_values(fe.n_dofs_per_cell());
+    std::vector<double>       dst_values(fe.n_dofs_per_cell());
+    std::vector<double>       surface_values(fe.n_dofs_per_cell());
+
+    for (const unsigned int cell_index : cell_indices)
+      {
+        data.read_dof_values(cell_index, src, make_array_view(src_values));
+
+        phi_cell.reinit(cell_index);
+        phi_cell.evaluate(src_values,
+                          EvaluationFlags::values | EvaluationFlags::gradients);
+        for (const unsigned int q : phi_cell.quadrature_point_indices())
+          {
+            phi_cell.submit_value(phi_cell.JxW(q) * phi_cell.get_value(q), q);
+            phi_cell.submit_gradient(phi_cell.JxW(q) *
+                                       phi_cell.get_gradient(q),
+                                     q);
+          }
+        phi_cell.integrate(dst_values,
+                           EvaluationFlags::values |
+                             EvaluationFlags::gradients);
+
+        phi_surface.reinit(cell_index);
+        phi_surface.evaluate(src_values,
+                             EvaluationFlags::values |
+                               EvaluationFlags::gradients);
+        for (const unsigned int q : phi_surface.quadrature_point_indices())
+          {
+            const auto normal = phi_surface.normal_vector(q);
+            const auto value  = phi_surface.get_value(q);
+            phi_surface.submit_value(phi_surface.JxW(q) *
+                                       (penalty * value -
+                                        normal * phi_surface.get_gradient(q)),
+                                     q);
+            phi_surface.submit_gradient(-phi_surface.JxW(q) * value * normal,
+                                        q);
+          }
+        phi_surface.integrate(surface_values,
+                              EvaluationFlags::values |
+                                EvaluationFlags::gradients);
+
+        for (unsigned int i = 0; i < dst_values.size(); ++i)
+          dst_values[i] += surface_values[i];
+
+        data.distribute_local_to_global(cell_index,
+                                        make_array_view(dst_values),
+                                        dst);
+      }
+  };
+  cut_cell_loop.loop(worker, dst, src, true);
+
+  // reference with cell matrices
+  const unsigned int                   dofs_per_cell = fe.n_dofs_per_cell();
+  FullMatrix<double>                   cell_matrix(dofs_per_cell);
+  Vector<double>                       local_src(dofs_per_cell);
+  Vector<double>                       local_dst(dofs_per_cell);
+  std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+  for (unsigned int c = 0; c < cells.size(); ++c)
+    {
+      const auto &cell = cells[c];
+      cell_matrix      = 0;
+
+      FEValues<dim> fe_values(mapping,
+                              fe,
+                              quadratures[c],
+                              update_values | update_gradients |
+                                update_JxW_values);
+      fe_values.reinit(cell);
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          for (unsigned int j = 0; j < dofs_per_cell; ++j)
+            cell_matrix(i, j) +=
+              (fe_values.shape_value(i, q) * fe_values.shape_value(j, q) +
+               fe_values.shape_grad(i, q) * fe_values.shape_grad(j, q)) *
+              fe_values.JxW(q);
+
+      NonMatching::FEImmersedSurfaceValues<dim> fe_surface_values(
+        mapping,
+        fe,
+        surfaces[c],
+        update_values | update_gradients | update_JxW_values |
+          update_normal_vectors);
+      fe_surface_values.reinit(cell);
+      for (const unsigned int q : fe_surface_values.quadrature_point_indices())
+        {
+          const Tensor<1, dim> normal = fe_surface_values.normal_vector(q);
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            for (unsigned int j = 0; j < dofs_per_cell; ++j)
+              cell_matrix(i, j) +=
+                (penalty * fe_surface_values.shape_value(i, q) *
+                   fe_surface_values.shape_value(j, q) -
+                 fe_surface_values.shape_value(i, q) * normal *
+                   fe_surface_values.shape_grad(j, q) -
+                 normal * fe_surface_values.shape_grad(i, q) *
+                   fe_surface_values.shape_value(j, q)) *
+                fe_surface_values.JxW(q);
+        }
+
+      cell->get_dof_indices(dof_indices);
+      constraints.get_dof_values(src,
+                                 dof_indices.begin(),
+                                 local_src.begin(),
+                                 local_src.end());
+      cell_matrix.vmult(local_dst, local_src);
+      constraints.distribute_local_to_global(local_dst, dof_indices, dst_ref);
+    }
+
+  dst_ref -= dst;
+  deallog << "result: "
+          << (dst_ref.l2_norm() < 1e-12 * dst.l2_norm() ? "OK" : "FAILED")
+          << std::endl;
+
+  // the same loop with block vectors, which have no ghost values
+  const std::vector<types::global_dof_index> block_sizes = {
+    dof_handler.n_dofs() / 2, dof_handler.n_dofs() - dof_handler.n_dofs() / 2};
+  BlockVector<double> block_src(block_sizes), block_dst(block_sizes);
+  block_src = src;
+  block_dst = 1.;
+  cut_cell_loop.loop(worker, block_dst, block_src, true);
+  Vector<double> dst_from_block;
+  dst_from_block = block_dst;
+  dst_from_block -= dst;
+  deallog << "block vector: "
+          << (dst_from_block.l2_norm() < 1e-12 * dst.l2_norm() ? "OK" :
+                                                                 "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  MultithreadInfo::set_thread_limit(4);
+
+  for (const unsigned int degree : {1, 2})
+    {
+      test<2>(degree);
+      test<3>(degree);
+    }
+}
@@ -0,0 +1,171 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check that the quadratures of DiscreteQuadratureGenerator, which evaluates
+// the level set function at many points at once, agree with the ones of
+// QuadratureGenerator for a function that evaluates the same finite element
+// field on the reference cell one point at a time.
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/function_level_set.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/non_matching/quadrature_generator.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+// The finite element field on the reference cell with the given local
+// coefficients, evaluated through the shape functions of the element.
+template <int dim>
+class ReferenceCellField : public Function<dim>
+{
+public:
+  ReferenceCellField(const FiniteElement<dim> &fe,
+                     const Vector<double> &    local_values)
+    : fe(fe)
+    , local_values(local_values)
+  {}
+
+  double
+  value(const Point<dim> &point, const unsigned int = 0) const override
+  {
+    double value = 0;
+    for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+      value += local_values[i] * fe.shape_value(i, point);
+    return value;
+  }
+
+  Tensor<1, dim>
+  gradient(const Point<dim> &point, const unsigned int = 0) const override
+  {
+    Tensor<1, dim> gradient;
+    for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+      gradient += local_values[i] * fe.shape_grad(i, point);
+    return gradient;
+  }
+
+  SymmetricTensor<2, dim>
+  hessian(const Point<dim> &point, const unsigned int = 0) const override
+  {
+    Tensor<2, dim> hessian;
+    for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+      hessian += local_values[i] * fe.shape_grad_grad(i, point);
+    return symmetrize(hessian);
+  }
+
+private:
+  const FiniteElement<dim> &fe;
+  const Vector<double> &    local_values;
+};
+
+
+
+template <typename QuadratureType>
+bool
+quadratures_agree(const QuadratureType &a, const QuadratureType &b)
+{
+  if (a.size() != b.size())
+    return false;
+  for (unsigned int q = 0; q < a.size(); ++q)
+    if (a.point(q).distance(b.point(q)) > 1e-10 ||
+        std::abs(a.weight(q) - b.weight(q)) > 1e-10)
+      return false;
+  return true;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int fe_degree)
+{
+  deallog << "dim = " << dim << ", degree = " << fe_degree << std::endl;
+
+  Triangulation<dim> triangulation;
+  GridGenerator::hyper_cube(triangulation, -1, 1);
+  triangulation.refine_global(dim == 2 ? 3 : 2);
+
+  const FE_Q<dim> fe(fe_degree);
+  DoFHandler<dim> dof_handler(triangulation);
+  dof_handler.distribute_dofs(fe);
+
+  const Functions::SignedDistance::Sphere<dim> sphere(Point<dim>(), 0.6);
+  Vector<double> level_set(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler, sphere, level_set);
+
+  const hp::QCollection<1> q_collection1D(QGauss<1>(3));
+
+  NonMatching::DiscreteQuadratureGenerator<dim> discrete_generator(
+    q_collection1D, dof_handler, level_set);
+  NonMatching::QuadratureGenerator<dim> generator(q_collection1D);
+
+  const BoundingBox<dim> unit_box = create_unit_bounding_box<dim>();
+
+  bool           inside_ok = true, outside_ok = true, surface_ok = true;
+  Vector<double> local_values(fe.n_dofs_per_cell());
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      cell->get_dof_values(level_set, local_values);
+      const ReferenceCellField<dim> field(fe, local_values);
+
+      discrete_generator.generate(cell);
+      generator.generate(field, unit_box);
+
+      const auto &surface = discrete_generator.get_surface_quadrature();
+
+      inside_ok &= quadratures_agree(discrete_generator.get_inside_quadrature(),
+                                     generator.get_inside_quadrature());
+      outside_ok &=
+        quadratures_agree(discrete_generator.get_outside_quadrature(),
+                          generator.get_outside_quadrature());
+      surface_ok &=
+        quadratures_agree(surface, generator.get_surface_quadrature());
+      if (surface.size() == generator.get_surface_quadrature().size())
+        for (unsigned int q = 0; q < surface.size(); ++q)
+          surface_ok &= (surface.normal_vector(q) -
+                         generator.get_surface_quadrature().normal_vector(q))
+                          .norm() < 1e-10;
+    }
+
+  deallog << "inside: " << (inside_ok ? "OK" : "FAILED") << std::endl;
+  deallog << "outside: " << (outside_ok ? "OK" : "FAILED") << std::endl;
+  deallog << "surface: " << (surface_ok ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  for (const unsigned int fe_degree : {1, 2})
+    {
+      test<2>(fe_degree);
+      test<3>(fe_degree);
+    }
+}
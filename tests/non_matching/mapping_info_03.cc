@@ -0,0 +1,204 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+/*
+ * Test that NonMatching::MappingInfo::reinit() for a single cell gives the
+ * same mapping data as FEValues, both on affine cells, where the mapping is
+ * only evaluated at the cell center, and on general cells. Also evaluate a
+ * finite element function with FEPointEvaluation on the computed data.
+ */
+
+#include <deal.II/base/function_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_cartesian.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_point_evaluation.h>
+
+#include <deal.II/non_matching/mapping_info.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const Mapping<dim> &mapping,
+     const std::string & mapping_name,
+     const bool          affine_mesh)
+{
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube(tria, 2, 0, 1);
+  if (dynamic_cast<const MappingCartesian<dim> *>(&mapping) != nullptr)
+    GridTools::transform(
+      [](const Point<dim> &p) {
+        Point<dim> q;
+        for (unsigned int d = 0; d < dim; ++d)
+          q[d] = (d + 1) * p[d] + 0.25;
+        return q;
+      },
+      tria);
+  else if (affine_mesh)
+    GridTools::transform(
+      [](const Point<dim> &p) {
+        Point<dim> q = p;
+        for (unsigned int d = 1; d < dim; ++d)
+          q[0] += 0.3 * d * p[d];
+        q[dim - 1] += 0.2 * p[0] + 0.5;
+        return q;
+      },
+      tria);
+  else
+    GridTools::transform(
+      [](const Point<dim> &p) {
+        Point<dim> q = p;
+        q[0] += 0.1 * p.square();
+        return q;
+      },
+      tria);
+
+  const FE_Q<dim> fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> vector(dof_handler.n_dofs());
+  Tensor<1, dim> exponents;
+  exponents[0] = 2.;
+  VectorTools::interpolate(mapping,
+                           dof_handler,
+                           Functions::Monomial<dim>(exponents),
+                           vector);
+
+  std::vector<Point<dim>> unit_points;
+  std::vector<double>     weights;
+  for (unsigned int i = 0; i < 7; ++i)
+    {
+      Point<dim> p;
+      for (unsigned int d = 0; d < dim; ++d)
+        p[d] = (i + 0.5 * d) / 8.;
+      unit_points.push_back(p);
+      weights.push_back(1. + 0.1 * i);
+    }
+  const Quadrature<dim> quadrature(unit_points, weights);
+
+  FEValues<dim> fe_values(mapping,
+                          fe,
+                          quadrature,
+                          update_values | update_gradients |
+                            update_JxW_values | update_jacobians |
+                            update_quadrature_points);
+
+  NonMatching::MappingInfo<dim> mapping_info(mapping,
+                                             update_values |
+                                               update_gradients |
+                                               update_JxW_values |
+                                               update_jacobians);
+  FEPointEvaluation<1, dim> evaluator(mapping_info, fe);
+
+  std::vector<double>         solution_values(fe.n_dofs_per_cell());
+  std::vector<double>         function_values(unit_points.size());
+  std::vector<Tensor<1, dim>> function_gradients(unit_points.size());
+
+  bool quadrature_ok = true, points_ok = true;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      fe_values.get_function_values(vector, function_values);
+      fe_values.get_function_gradients(vector, function_gradients);
+      cell->get_dof_values(vector,
+                           solution_values.begin(),
+                           solution_values.end());
+
+      // with a quadrature, all data including JxW is available
+      mapping_info.reinit(cell, quadrature);
+      evaluator.reinit();
+      evaluator.evaluate(solution_values,
+                         EvaluationFlags::values | EvaluationFlags::gradients);
+      for (unsigned int q = 0; q < unit_points.size(); ++q)
+        {
+          quadrature_ok &=
+            std::abs(evaluator.get_value(q) - function_values[q]) < 1e-12;
+          quadrature_ok &=
+            (evaluator.get_gradient(q) - function_gradients[q]).norm() < 1e-11;
+          quadrature_ok &=
+            evaluator.real_point(q).distance(fe_values.quadrature_point(q)) <
+            1e-12;
+          quadrature_ok &=
+            std::abs(evaluator.JxW(q) - fe_values.JxW(q)) < 1e-12;
+          quadrature_ok &=
+            (Tensor<2, dim>(evaluator.jacobian(q)) -
+             Tensor<2, dim>(fe_values.jacobian(q)))
+              .norm() < 1e-12;
+        }
+
+      // with points only, as used for particles and remote points
+      mapping_info.reinit(cell, make_array_view(unit_points));
+      evaluator.reinit();
+      evaluator.evaluate(solution_values,
+                         EvaluationFlags::values | EvaluationFlags::gradients);
+      for (unsigned int q = 0; q < unit_points.size(); ++q)
+        {
+          points_ok &=
+            std::abs(evaluator.get_value(q) - function_values[q]) < 1e-12;
+          points_ok &=
+            (evaluator.get_gradient(q) - function_gradients[q]).norm() < 1e-11;
+          points_ok &=
+            evaluator.real_point(q).distance(fe_values.quadrature_point(q)) <
+            1e-12;
+        }
+    }
+
+  deallog << "dim = " << dim << ", " << mapping_name << ", "
+          << (affine_mesh ? "affine" : "deformed") << " cells: "
+          << (quadrature_ok ? "OK" : "FAILED") << ' '
+          << (points_ok ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  test<dim>(MappingCartesian<dim>(), "MappingCartesian", true);
+  for (const unsigned int degree : {1, 3})
+    for (const bool affine_mesh : {true, false})
+      test<dim>(MappingQ<dim>(degree),
+                "MappingQ(" + std::to_string(degree) + ")",
+                affine_mesh);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<1>();
+  test<2>();
+  test<3>();
+}
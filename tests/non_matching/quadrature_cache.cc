@@ -0,0 +1,246 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+/*
+ * Test NonMatching::QuadratureCache: Check that the cached quadratures are
+ * the same as the ones generated by DiscreteQuadratureGenerator, that only
+ * the quadratures of cells with changed level set values are regenerated,
+ * and that NonMatching::FEValues gives the same results with and without
+ * the cache. Also check that the accessors for ranges of cells return the
+ * same quadratures as the accessors for single cells.
+ */
+
+#include <deal.II/base/function_signed_distance.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/non_matching/fe_values.h>
+#include <deal.II/non_matching/mesh_classifier.h>
+#include <deal.II/non_matching/quadrature_cache.h>
+#include <deal.II/non_matching/quadrature_generator.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+using namespace dealii;
+
+
+template <int dim>
+bool
+quadratures_are_equal(const Quadrature<dim> &q1, const Quadrature<dim> &q2)
+{
+  return q1.get_points() == q2.get_points() &&
+         q1.get_weights() == q2.get_weights();
+}
+
+
+
+template <int dim>
+void
+check_against_generator(const NonMatching::QuadratureCache<dim> &cache,
+                        const NonMatching::MeshClassifier<dim> & classifier,
+                        const DoFHandler<dim> &                  dof_handler,
+                        const hp::QCollection<1> &               q_collection,
+                        const Vector<double> &                   level_set)
+{
+  NonMatching::DiscreteQuadratureGenerator<dim> generator(q_collection,
+                                                          dof_handler,
+                                                          level_set);
+
+  bool         ok      = true;
+  unsigned int n_cells = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    if (classifier.location_to_level_set(cell) ==
+        NonMatching::LocationToLevelSet::intersected)
+      {
+        ++n_cells;
+        generator.generate(cell);
+        const auto *quadratures = cache.get_quadratures(cell);
+        ok &=
+          quadratures != nullptr &&
+          quadratures_are_equal(quadratures->inside,
+                                generator.get_inside_quadrature()) &&
+          quadratures_are_equal(quadratures->outside,
+                                generator.get_outside_quadrature()) &&
+          quadratures_are_equal<dim>(quadratures->surface,
+                                     generator.get_surface_quadrature()) &&
+          quadratures->surface.get_normal_vectors() ==
+            generator.get_surface_quadrature().get_normal_vectors();
+      }
+    else
+      ok &= (cache.get_quadratures(cell) == nullptr);
+
+  ok &= (n_cells == cache.n_cells());
+  deallog << "Same as generator: " << (ok ? "OK" : "FAILED") << std::endl;
+
+  const auto cells = dof_handler.active_cell_iterators();
+  const std::vector<Quadrature<dim>> inside =
+    cache.get_inside_quadratures(cells);
+  const std::vector<Quadrature<dim>> outside =
+    cache.get_outside_quadratures(cells);
+  const std::vector<NonMatching::ImmersedSurfaceQuadrature<dim>> surface =
+    cache.get_surface_quadratures(cells);
+  const unsigned int n_active_cells =
+    dof_handler.get_triangulation().n_active_cells();
+  bool range_ok = inside.size() == n_active_cells &&
+                  outside.size() == n_active_cells &&
+                  surface.size() == n_active_cells;
+  unsigned int i = 0;
+  for (const auto &cell : cells)
+    {
+      if (i < inside.size())
+        range_ok &=
+          quadratures_are_equal(inside[i],
+                                cache.get_inside_quadrature(cell)) &&
+          quadratures_are_equal(outside[i],
+                                cache.get_outside_quadrature(cell)) &&
+          quadratures_are_equal<dim>(surface[i],
+                                     cache.get_surface_quadrature(cell));
+      ++i;
+    }
+  deallog << "Range accessors: " << (range_ok ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+template <int dim>
+double
+compute_inside_volume_and_surface_area(NonMatching::FEValues<dim> &fe_values,
+                                       const DoFHandler<dim> &     dof_handler)
+{
+  double result = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      if (const auto &inside = fe_values.get_inside_fe_values())
+        for (const unsigned int q : inside->quadrature_point_indices())
+          result += inside->JxW(q);
+      if (const auto &surface = fe_values.get_surface_fe_values())
+        for (const unsigned int q : surface->quadrature_point_indices())
+          result += 10. * surface->JxW(q);
+    }
+  return result;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, -1.21, 1.21);
+  tria.refine_global(dim == 2 ? 4 : 3);
+
+  hp::FECollection<dim> fe_collection(FE_Q<dim>(1));
+  DoFHandler<dim>       dof_handler(tria);
+  dof_handler.distribute_dofs(fe_collection);
+
+  const Functions::SignedDistance::Sphere<dim> sphere;
+  Vector<double>                               level_set(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler, sphere, level_set);
+
+  NonMatching::MeshClassifier<dim> classifier(dof_handler, level_set);
+  classifier.reclassify();
+
+  const hp::QCollection<1>          q_collection(QGauss<1>(2));
+  NonMatching::QuadratureCache<dim> cache(q_collection, dof_handler, level_set);
+
+  cache.update(classifier);
+  deallog << "First update generates all: "
+          << (cache.n_cells() > 0 &&
+                  cache.n_generated_cells() == cache.n_cells() ?
+                "OK" :
+                "FAILED")
+          << std::endl;
+  check_against_generator(
+    cache, classifier, dof_handler, q_collection, level_set);
+
+  cache.update(classifier);
+  deallog << "Unchanged level set generates none: "
+          << (cache.n_generated_cells() == 0 ? "OK" : "FAILED") << std::endl;
+
+  // change the level set only on the right half of the domain, such that
+  // only some of the intersected cells need to be regenerated
+  std::map<types::global_dof_index, Point<dim>> support_points;
+  DoFTools::map_dofs_to_support_points(MappingQ1<dim>(),
+                                       dof_handler,
+                                       support_points);
+  for (const auto &entry : support_points)
+    if (entry.second[0] > 0.5)
+      level_set[entry.first] -= 0.05;
+  classifier.reclassify();
+
+  // the cache detects the outdated quadratures even before update()
+  bool outdated_detected = false;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    if (cell->center()[0] > 0.7 &&
+        classifier.location_to_level_set(cell) ==
+          NonMatching::LocationToLevelSet::intersected)
+      outdated_detected |= (cache.get_quadratures(cell) == nullptr);
+  deallog << "Outdated quadratures detected: "
+          << (outdated_detected ? "OK" : "FAILED") << std::endl;
+
+  cache.update(classifier);
+  deallog << "Changed level set regenerates some: "
+          << (cache.n_generated_cells() > 0 &&
+                  cache.n_generated_cells() < cache.n_cells() ?
+                "OK" :
+                "FAILED")
+          << std::endl;
+  check_against_generator(
+    cache, classifier, dof_handler, q_collection, level_set);
+
+  NonMatching::RegionUpdateFlags region_update_flags;
+  region_update_flags.inside  = update_JxW_values;
+  region_update_flags.surface = update_JxW_values;
+
+  NonMatching::FEValues<dim> fe_values(fe_collection,
+                                       q_collection[0],
+                                       region_update_flags,
+                                       classifier,
+                                       dof_handler,
+                                       level_set);
+  const double reference =
+    compute_inside_volume_and_surface_area(fe_values, dof_handler);
+  fe_values.set_quadrature_cache(cache);
+  const double with_cache =
+    compute_inside_volume_and_surface_area(fe_values, dof_handler);
+  deallog << "FEValues with cache: "
+          << (reference == with_cache ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
@@ -0,0 +1,134 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check that PointInterpolationOperator, set up for points located in the
+// local mesh, gives the same values as VectorTools::point_value for
+// several vectors, both for all components of a vector-valued element and
+// for a single selected component. Also check that a renumbering of the
+// degrees of freedom is detected and that the components selected by a
+// ComponentMask are interpolated correctly.
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/point_interpolation_operator.h>
+#include <deal.II/numerics/vector_tools_point_value.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test()
+{
+  deallog << "dim = " << dim << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(dim == 2 ? 3 : 1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  const FESystem<dim> fe(FE_Q<dim>(2), 2);
+  DoFHandler<dim>     dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  const MappingQ<dim> mapping(2);
+
+  std::vector<Point<dim>> points;
+  for (unsigned int i = 0; i < 20; ++i)
+    {
+      Point<dim> point;
+      for (unsigned int d = 0; d < dim; ++d)
+        point[d] = 0.5 * std::sin(1. + i + 2. * d + 0.3 * i * d);
+      points.push_back(point);
+    }
+
+  PointInterpolationOperator<2, dim> interpolation;
+  interpolation.reinit(points, dof_handler, mapping);
+  PointInterpolationOperator<1, dim> interpolation_component;
+  interpolation_component.reinit(points, dof_handler, mapping, 1);
+  deallog << "points: " << interpolation.n_points() << std::endl;
+
+  bool                      all_ok = true, component_ok = true;
+  std::vector<Tensor<1, 2>> values;
+  std::vector<double>       component_values;
+  Vector<double>            solution(dof_handler.n_dofs());
+  Vector<double>            reference(2);
+  for (unsigned int v = 0; v < 3; ++v)
+    {
+      for (auto &entry : solution)
+        entry = random_value<double>();
+
+      interpolation.vmult(values, solution);
+      interpolation_component.vmult(component_values, solution);
+      for (unsigned int p = 0; p < points.size(); ++p)
+        {
+          VectorTools::point_value(
+            mapping, dof_handler, solution, points[p], reference);
+          for (unsigned int c = 0; c < 2; ++c)
+            all_ok &= std::abs(values[p][c] - reference[c]) < 1e-10;
+          component_ok &= std::abs(component_values[p] - reference[1]) < 1e-10;
+        }
+    }
+
+  deallog << "all components: " << (all_ok ? "OK" : "FAILED") << std::endl;
+  deallog << "selected component: " << (component_ok ? "OK" : "FAILED")
+          << std::endl;
+
+  deallog << "DoF indices changed: " << interpolation.dof_indices_changed()
+          << std::endl;
+  DoFRenumbering::random(dof_handler);
+  deallog << "DoF indices changed after renumbering: "
+          << interpolation.dof_indices_changed() << std::endl;
+
+  PointInterpolationOperator<1, dim> interpolation_mask;
+  interpolation_mask.reinit(points,
+                            dof_handler,
+                            mapping,
+                            ComponentMask(std::vector<bool>{true, true}));
+  deallog << "selected components: "
+          << interpolation_mask.n_selected_components() << std::endl;
+
+  bool mask_ok = true;
+  interpolation_mask.vmult_selected_components(component_values, solution);
+  for (unsigned int p = 0; p < points.size(); ++p)
+    {
+      VectorTools::point_value(
+        mapping, dof_handler, solution, points[p], reference);
+      for (unsigned int c = 0; c < 2; ++c)
+        mask_ok &= std::abs(component_values[p * 2 + c] - reference[c]) < 1e-10;
+    }
+  deallog << "component mask: " << (mask_ok ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  test<2>();
+  test<3>();
+}
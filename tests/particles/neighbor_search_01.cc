@@ -0,0 +1,126 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Compare the neighbor lists of Particles::NeighborSearch with a brute-force
+// search, for different cutoff radii and after small and large
+// displacements of the particles that do or do not require rebuilding the
+// data structures.
+
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/particles/neighbor_search.h>
+#include <deal.II/particles/particle_handler.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+check(const Particles::NeighborSearch<dim> &   search,
+      const Particles::ParticleHandler<dim> &particle_handler,
+      const double                           cutoff_radius)
+{
+  std::vector<Point<dim>> locations;
+  for (const auto &particle : particle_handler)
+    locations.push_back(particle.get_location());
+
+  bool ok = (search.n_particles() == locations.size());
+  for (unsigned int i = 0; i < locations.size(); ++i)
+    {
+      std::vector<unsigned int> expected;
+      for (unsigned int j = 0; j < locations.size(); ++j)
+        if (j != i && locations[i].distance(locations[j]) <= cutoff_radius)
+          expected.push_back(j);
+
+      const auto neighbors = search.get_neighbors(i);
+      ok &= (std::vector<unsigned int>(neighbors.begin(), neighbors.end()) ==
+             expected);
+      ok &= (search.get_particle(i)->get_id() ==
+             std::next(particle_handler.begin(), i)->get_id());
+    }
+  deallog << "neighbors: " << (ok ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+template <int dim>
+void
+move_particles(Particles::ParticleHandler<dim> &particle_handler,
+               const double                     distance)
+{
+  for (auto &particle : particle_handler)
+    {
+      Point<dim> location = particle.get_location();
+      for (unsigned int d = 0; d < dim; ++d)
+        location[d] += distance * std::sin(10. * particle.get_id() + d);
+      particle.set_location(location);
+    }
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  MappingQ1<dim> mapping;
+
+  Particles::ParticleHandler<dim> particle_handler(tria, mapping);
+  std::vector<Point<dim>>         points(dim == 2 ? 2000 : 3000);
+  for (auto &point : points)
+    point = random_point<dim>(0.1, 0.9);
+  particle_handler.insert_particles(points);
+
+  for (const double cutoff_radius : {0.02, 0.1, 0.7})
+    {
+      deallog << "cutoff radius " << cutoff_radius << std::endl;
+      Particles::NeighborSearch<dim> search(particle_handler, cutoff_radius);
+      check(search, particle_handler, cutoff_radius);
+    }
+
+  // with a skin, small displacements only filter the candidates. The third
+  // displacement exceeds half of the skin and requires a rebuild
+  const double                   cutoff_radius = 0.05;
+  Particles::NeighborSearch<dim> search(particle_handler, cutoff_radius, 0.02);
+  check(search, particle_handler, cutoff_radius);
+  for (const double distance : {0.003, 0.002, 0.02, 0.001})
+    {
+      move_particles(particle_handler, distance);
+      deallog << "move by " << distance << ", rebuilt: " << search.update()
+              << std::endl;
+      check(search, particle_handler, cutoff_radius);
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
@@ -0,0 +1,147 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// ParticleHandler::sort_particles_into_subdomains_and_cells() locates the
+// particles in parallel and afterwards stores the data of the particles
+// contiguously in the order of the cells. Move many particles by different
+// distances, some of them out of the domain, and check that every particle
+// ends up in the right cell with the right reference location and its
+// properties, and that the particle data is contiguous in memory.
+
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/particles/particle_handler.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+Point<dim>
+displacement(const Point<dim> &p, const unsigned int step)
+{
+  // particles near the origin move by less than a cell, the others by up
+  // to a quarter of the domain
+  Point<dim> shift;
+  for (unsigned int d = 0; d < dim; ++d)
+    shift[d] = (step % 2 == 0 ? 0.25 : -0.2) * p[(d + 1) % dim] * p[d];
+  return shift;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+  MappingQ<dim> mapping(1);
+
+  Particles::ParticleHandler<dim> particle_handler(tria, mapping, 1);
+
+  unsigned int n_lost = 0;
+  particle_handler.signals.particle_lost.connect(
+    [&](const typename Particles::ParticleIterator<dim> &,
+        const typename Triangulation<dim>::active_cell_iterator &) {
+      ++n_lost;
+    });
+
+  // place the particles on a regular lattice
+  const unsigned int n_points_1d = (dim == 2 ? 60 : 16);
+  std::vector<Point<dim>> points;
+  for (unsigned int i = 0; i < Utilities::pow(n_points_1d, dim); ++i)
+    {
+      Point<dim>   p;
+      unsigned int index = i;
+      for (unsigned int d = 0; d < dim; ++d, index /= n_points_1d)
+        p[d] = (0.5 + index % n_points_1d) / n_points_1d;
+      points.push_back(p);
+    }
+  particle_handler.insert_particles(points);
+  for (auto &particle : particle_handler)
+    particle.get_properties()[0] = particle.get_id();
+
+  std::vector<Point<dim>> expected_locations(points);
+  for (unsigned int step = 0; step < 3; ++step)
+    {
+      n_lost                   = 0;
+      unsigned int n_left_mesh = 0;
+      for (auto &particle : particle_handler)
+        {
+          Point<dim> &location = expected_locations[particle.get_id()];
+          location += displacement(location, step);
+          particle.set_location(location);
+          for (unsigned int d = 0; d < dim; ++d)
+            if (location[d] < 0. || location[d] > 1.)
+              {
+                ++n_left_mesh;
+                break;
+              }
+        }
+
+      particle_handler.sort_particles_into_subdomains_and_cells();
+
+      deallog << "Step " << step << ": " << particle_handler.n_global_particles()
+              << " particles, " << n_lost << " lost"
+              << (n_lost == n_left_mesh ? "" : " (wrong)") << std::endl;
+
+      bool          locations_ok  = true;
+      bool          properties_ok = true;
+      bool          contiguous    = true;
+      const double *previous      = nullptr;
+      for (const auto &particle : particle_handler)
+        {
+          const auto cell = particle.get_surrounding_cell();
+          locations_ok &=
+            cell->point_inside(particle.get_location()) &&
+            GeometryInfo<dim>::is_inside_unit_cell(
+              particle.get_reference_location()) &&
+            mapping.transform_unit_to_real_cell(
+                     cell, particle.get_reference_location())
+                .distance(expected_locations[particle.get_id()]) < 1e-12;
+          properties_ok &=
+            particle.get_properties()[0] == double(particle.get_id());
+
+          const double *current = particle.get_properties().data();
+          contiguous &= (previous == nullptr || current == previous + 1);
+          previous = current;
+        }
+      deallog << "locations: " << (locations_ok ? "OK" : "FAILED")
+              << ", properties: " << (properties_ok ? "OK" : "FAILED")
+              << ", contiguous: " << (contiguous ? "OK" : "FAILED")
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
@@ -0,0 +1,209 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Test Particles::Utilities::evaluate_field_at_particles() and
+// Particles::Utilities::integrate_field_from_particles(): evaluate a
+// quadratic function, which is represented exactly, and its gradient at the
+// particles, and check that integration is the transpose of evaluation.
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include <deal.II/particles/particle_handler.h>
+#include <deal.II/particles/utilities.h>
+
+#include "../tests.h"
+
+
+// access the components of the values and gradients returned by
+// FEPointEvaluation, which are scalars for a single component
+double &
+component(double &value, const unsigned int)
+{
+  return value;
+}
+
+
+
+template <int n_components>
+double &
+component(Tensor<1, n_components> &value, const unsigned int c)
+{
+  return value[c];
+}
+
+
+
+template <int dim>
+Tensor<1, dim>
+gradient_component(const Tensor<1, dim> &gradient, const unsigned int)
+{
+  return gradient;
+}
+
+
+
+template <int dim>
+Tensor<1, dim>
+gradient_component(const Tensor<2, dim> &gradient, const unsigned int c)
+{
+  return gradient[c];
+}
+
+
+
+template <int dim>
+class QuadraticFunction : public Function<dim>
+{
+public:
+  QuadraticFunction(const unsigned int n_components)
+    : Function<dim>(n_components)
+  {}
+
+  double
+  value(const Point<dim> &p, const unsigned int component) const override
+  {
+    return (component + 1) * p[0] * p[dim - 1] + p[0] - 0.5 * component;
+  }
+
+  Tensor<1, dim>
+  gradient(const Point<dim> &p, const unsigned int component) const override
+  {
+    Tensor<1, dim> grad;
+    grad[0] += (component + 1) * p[dim - 1] + 1.;
+    grad[dim - 1] += (component + 1) * p[0];
+    return grad;
+  }
+};
+
+
+
+template <int n_components, int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, -1, 1);
+  tria.refine_global(2);
+  MappingQ<dim> mapping(1);
+
+  FESystem<dim>   fe(FE_Q<dim>(2), n_components);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  const QuadraticFunction<dim> function(n_components);
+  Vector<double>               field(dof_handler.n_dofs());
+  VectorTools::interpolate(mapping, dof_handler, function, field);
+
+  Particles::ParticleHandler<dim> particle_handler(tria, mapping);
+  std::vector<Point<dim>>         points;
+  const unsigned int              n_points_1d = 11;
+  for (unsigned int i = 0; i < Utilities::pow(n_points_1d, dim); ++i)
+    {
+      Point<dim>   p;
+      unsigned int index = i;
+      for (unsigned int d = 0; d < dim; ++d, index /= n_points_1d)
+        p[d] = -0.95 + 1.9 * (index % n_points_1d) / (n_points_1d - 1);
+      points.push_back(p);
+    }
+  particle_handler.insert_particles(points);
+
+  using Evaluator = FEPointEvaluation<n_components, dim>;
+  std::vector<typename Evaluator::value_type>    values;
+  std::vector<typename Evaluator::gradient_type> gradients;
+  Particles::Utilities::evaluate_field_at_particles<n_components>(
+    mapping,
+    dof_handler,
+    field,
+    particle_handler,
+    values,
+    gradients,
+    EvaluationFlags::values | EvaluationFlags::gradients);
+
+  deallog << "Evaluated at " << values.size() << " of "
+          << particle_handler.n_locally_owned_particles() << " particles"
+          << std::endl;
+
+  double       value_error = 0, gradient_error = 0;
+  unsigned int i           = 0;
+  for (const auto &particle : particle_handler)
+    {
+      const Point<dim> p = particle.get_location();
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          value_error =
+            std::max(value_error,
+                     std::abs(component(values[i], c) - function.value(p, c)));
+          gradient_error =
+            std::max(gradient_error,
+                     (gradient_component(gradients[i], c) -
+                      function.gradient(p, c))
+                       .norm());
+        }
+      ++i;
+    }
+  deallog << "Value error: " << (value_error < 1e-12 ? "ok" : "FAILED")
+          << std::endl;
+  deallog << "Gradient error: " << (gradient_error < 1e-12 ? "ok" : "FAILED")
+          << std::endl;
+
+  // integration must be the transpose of evaluation, (I^T f, u) = (f, I u)
+  std::vector<typename Evaluator::value_type> particle_data(values.size());
+  double                                      reference = 0;
+  for (unsigned int k = 0; k < values.size(); ++k)
+    for (unsigned int c = 0; c < n_components; ++c)
+      {
+        component(particle_data[k], c) = std::sin(1. + k + 3. * c);
+        reference += component(particle_data[k], c) * component(values[k], c);
+      }
+  Vector<double> deposited(dof_handler.n_dofs());
+  Particles::Utilities::integrate_field_from_particles<n_components>(
+    mapping, dof_handler, particle_handler, particle_data, deposited);
+  deallog << "Transpose: "
+          << (std::abs(deposited * field - reference) <
+                  1e-12 * std::abs(reference) ?
+                "ok" :
+                "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<1, 2>();
+  test<2, 2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<1, 3>();
+  test<3, 3>();
+  deallog.pop();
+}
@@ -0,0 +1,161 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Test Utilities::MPI::RemotePointEvaluation::update_points(): move the
+// points by small distances, which keeps the communication pattern, and by
+// large distances, which requires a new setup, and check that the values
+// evaluated with persistent (for double) and non-persistent (for
+// std::vector<double>) communication match the new positions.
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+check(const Utilities::MPI::RemotePointEvaluation<dim> &eval,
+      const Mapping<dim> &                              mapping,
+      const Triangulation<dim> &                        tria,
+      const std::vector<Point<dim>> &                   points)
+{
+  const auto evaluate_position =
+    [&](const typename Utilities::MPI::RemotePointEvaluation<dim>::CellData
+          &                cell_data,
+        const unsigned int i) {
+      const typename Triangulation<dim>::active_cell_iterator cell(
+        &tria, cell_data.cells[i].first, cell_data.cells[i].second);
+      std::vector<Point<dim>> positions;
+      for (unsigned int q = cell_data.reference_point_ptrs[i];
+           q < cell_data.reference_point_ptrs[i + 1];
+           ++q)
+        positions.push_back(mapping.transform_unit_to_real_cell(
+          cell, cell_data.reference_point_values[q]));
+      return positions;
+    };
+
+  std::vector<double> values, buffer;
+  eval.template evaluate_and_process<double>(
+    values,
+    buffer,
+    [&](const ArrayView<double> &values, const auto &cell_data) {
+      for (unsigned int i = 0, c = 0; i < cell_data.cells.size(); ++i)
+        for (const auto &p : evaluate_position(cell_data, i))
+          values[c++] = p[0] + 2. * p[dim - 1];
+    });
+
+  std::vector<std::vector<double>> vector_values, vector_buffer;
+  eval.template evaluate_and_process<std::vector<double>>(
+    vector_values,
+    vector_buffer,
+    [&](const ArrayView<std::vector<double>> &values, const auto &cell_data) {
+      for (unsigned int i = 0, c = 0; i < cell_data.cells.size(); ++i)
+        for (const auto &p : evaluate_position(cell_data, i))
+          values[c++] = std::vector<double>(&p[0], &p[0] + dim);
+    });
+
+  bool ok = eval.is_map_unique() && values.size() == points.size() &&
+            vector_values.size() == points.size();
+  for (unsigned int i = 0; ok && i < points.size(); ++i)
+    {
+      ok &= std::abs(values[i] - (points[i][0] + 2. * points[i][dim - 1])) <
+            1e-12;
+      for (unsigned int d = 0; d < dim; ++d)
+        ok &= std::abs(vector_values[i][d] - points[i][d]) < 1e-12;
+    }
+
+  deallog << (Utilities::MPI::min(ok ? 1 : 0, MPI_COMM_WORLD) == 1 ? "OK" :
+                                                                       "FAILED")
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  parallel::shared::Triangulation<dim> tria(MPI_COMM_WORLD);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+  MappingQ1<dim> mapping;
+
+  // place the points close to the centers of some cells of size 1/8, with
+  // different points on each process
+  const unsigned int rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  std::vector<Point<dim>> points;
+  for (unsigned int i = 0; i < 20; ++i)
+    {
+      Point<dim>   p;
+      unsigned int index = 7 * i + 3 * rank;
+      for (unsigned int d = 0; d < dim; ++d, index /= 8)
+        p[d] = (0.5 + index % 8) / 8. + 0.02 * std::sin(i + rank + d);
+      points.push_back(p);
+    }
+
+  const auto move = [&](const double distance) {
+    for (unsigned int i = 0; i < points.size(); ++i)
+      for (unsigned int d = 0; d < dim; ++d)
+        points[i][d] += distance * std::cos(3. * i + d);
+  };
+
+  Utilities::MPI::RemotePointEvaluation<dim> eval;
+  eval.reinit(points, tria, mapping);
+  check(eval, mapping, tria, points);
+
+  // moving by less than a quarter of a cell keeps the points in their cells
+  for (const double distance : {0.02, -0.03})
+    {
+      move(distance);
+      deallog << "move by " << distance
+              << ", pattern kept: " << eval.update_points(points) << std::endl;
+      check(eval, mapping, tria, points);
+    }
+
+  // moving the points into the neighboring cells requires a new setup
+  for (auto &p : points)
+    p[0] = (p[0] > 0.875 ? p[0] - 0.875 : p[0] + 0.125);
+  deallog << "shift by a cell, pattern kept: " << eval.update_points(points)
+          << std::endl;
+  check(eval, mapping, tria, points);
+
+  move(0.01);
+  deallog << "move by " << 0.01
+          << ", pattern kept: " << eval.update_points(points) << std::endl;
+  check(eval, mapping, tria, points);
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
@@ -0,0 +1,189 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check the evaluation and integration kernels of FEEvaluation for
+// simplex, wedge and pyramid elements for all combinations of values and
+// gradients, with and without adding into the result vector, by comparing
+// a matrix-free operator with the same operator computed with FEValues.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_pyramid_p.h>
+#include <deal.II/fe/fe_simplex_p.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_wedge_p.h>
+#include <deal.II/fe/mapping_fe.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+#include "./simplex_grids.h"
+
+
+template <int dim>
+void
+test(const unsigned int v, const unsigned int degree)
+{
+  Triangulation<dim> tria;
+
+  std::shared_ptr<FiniteElement<dim>> fe;
+  std::shared_ptr<Quadrature<dim>>    quad;
+  std::shared_ptr<FiniteElement<dim>> fe_mapping;
+
+  if (v == 0)
+    {
+      GridGenerator::subdivided_hyper_cube_with_simplices(tria, 2);
+      fe         = std::make_shared<FE_SimplexP<dim>>(degree);
+      quad       = std::make_shared<QGaussSimplex<dim>>(degree + 1);
+      fe_mapping = std::make_shared<FE_SimplexP<dim>>(1);
+    }
+  else if (v == 1)
+    {
+      GridGenerator::subdivided_hyper_cube_with_wedges(tria, 2);
+      fe         = std::make_shared<FE_WedgeP<dim>>(degree);
+      quad       = std::make_shared<QGaussWedge<dim>>(degree + 1);
+      fe_mapping = std::make_shared<FE_WedgeP<dim>>(1);
+    }
+  else
+    {
+      GridGenerator::subdivided_hyper_cube_with_pyramids(tria, 2);
+      fe         = std::make_shared<FE_PyramidP<dim>>(degree);
+      quad       = std::make_shared<QGaussPyramid<dim>>(degree + 1);
+      fe_mapping = std::make_shared<FE_PyramidP<dim>>(1);
+    }
+
+  deallog << fe->get_name() << std::endl;
+
+  const MappingFE<dim> mapping(*fe_mapping);
+  DoFHandler<dim>      dof_handler(tria);
+  dof_handler.distribute_dofs(*fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags = update_values | update_gradients;
+  MatrixFree<dim, double> matrix_free;
+  matrix_free.reinit(mapping, dof_handler, constraints, *quad, additional_data);
+
+  Vector<double> src(dof_handler.n_dofs()), dst(dof_handler.n_dofs()),
+    dst_ref(dof_handler.n_dofs());
+  for (auto &entry : src)
+    entry = random_value<double>();
+
+  FEValues<dim>                        fe_values(mapping,
+                          *fe,
+                          *quad,
+                          update_values | update_gradients |
+                            update_JxW_values);
+  std::vector<types::global_dof_index> dof_indices(fe->n_dofs_per_cell());
+  std::vector<double>                  values(quad->size());
+  std::vector<Tensor<1, dim>>          gradients(quad->size());
+
+  for (const auto flags : {EvaluationFlags::values,
+                           EvaluationFlags::gradients,
+                           EvaluationFlags::values | EvaluationFlags::gradients})
+    for (const bool add_into_values : {false, true})
+      {
+        // the matrix-free operator, which adds the result of the integration
+        // to a copy of the input values in the second variant
+        dst = 0;
+        matrix_free.template cell_loop<Vector<double>, Vector<double>>(
+          [&](const auto &, auto &dst, const auto &src, const auto range) {
+            FEEvaluation<dim, -1, 0, 1, double> phi(matrix_free, range);
+            for (unsigned int cell = range.first; cell < range.second; ++cell)
+              {
+                phi.reinit(cell);
+                phi.read_dof_values(src);
+                phi.evaluate(flags);
+                for (const unsigned int q : phi.quadrature_point_indices())
+                  {
+                    if (flags & EvaluationFlags::values)
+                      phi.submit_value(phi.get_value(q), q);
+                    if (flags & EvaluationFlags::gradients)
+                      phi.submit_gradient(phi.get_gradient(q), q);
+                  }
+                if (add_into_values)
+                  {
+                    phi.read_dof_values(src);
+                    phi.integrate(flags, phi.begin_dof_values(), true);
+                  }
+                else
+                  phi.integrate(flags);
+                phi.distribute_local_to_global(dst);
+              }
+          },
+          dst,
+          src);
+
+        dst_ref = 0;
+        for (const auto &cell : dof_handler.active_cell_iterators())
+          {
+            fe_values.reinit(cell);
+            cell->get_dof_indices(dof_indices);
+            fe_values.get_function_values(src, values);
+            fe_values.get_function_gradients(src, gradients);
+            for (unsigned int i = 0; i < dof_indices.size(); ++i)
+              {
+                double sum = add_into_values ? src(dof_indices[i]) : 0.;
+                for (const unsigned int q :
+                     fe_values.quadrature_point_indices())
+                  {
+                    if (flags & EvaluationFlags::values)
+                      sum += values[q] * fe_values.shape_value(i, q) *
+                             fe_values.JxW(q);
+                    if (flags & EvaluationFlags::gradients)
+                      sum += gradients[q] * fe_values.shape_grad(i, q) *
+                             fe_values.JxW(q);
+                  }
+                dst_ref(dof_indices[i]) += sum;
+              }
+          }
+
+        dst_ref -= dst;
+        deallog << "flags " << static_cast<unsigned int>(flags) << ", add "
+                << add_into_values << ": "
+                << (dst_ref.l2_norm() < 1e-12 * dst.l2_norm() ? "OK" :
+                                                                "FAILED")
+                << std::endl;
+      }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  for (unsigned int degree = 1; degree <= 3; ++degree)
+    test<2>(0, degree);
+  for (unsigned int degree = 1; degree <= 2; ++degree)
+    {
+      test<3>(0, degree);
+      test<3>(1, degree);
+    }
+  test<3>(2, 1);
+}
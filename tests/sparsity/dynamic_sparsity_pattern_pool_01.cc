@@ -0,0 +1,110 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// DynamicSparsityPattern stores its rows in a memory pool that is shared by
+// all rows. Check that adding entries to different rows concurrently gives
+// the same pattern as adding them serially, and that clear_row() and
+// reinit() correctly recycle the memory of the rows.
+
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+
+#include "../tests.h"
+
+
+void
+fill_row(DynamicSparsityPattern &dsp, const unsigned int row)
+{
+  // rows of very different lengths so that the pool has to handle
+  // blocks of many different sizes
+  const unsigned int n_entries = 1 + (row * 37) % 300;
+  for (unsigned int k = 0; k < n_entries; ++k)
+    dsp.add(row, (row + 7 * k) % dsp.n_cols());
+}
+
+
+
+bool
+equal(const DynamicSparsityPattern &a, const DynamicSparsityPattern &b)
+{
+  if (a.n_rows() != b.n_rows() ||
+      a.n_nonzero_elements() != b.n_nonzero_elements())
+    return false;
+  for (unsigned int row = 0; row < a.n_rows(); ++row)
+    {
+      if (a.row_length(row) != b.row_length(row))
+        return false;
+      for (unsigned int k = 0; k < a.row_length(row); ++k)
+        if (a.column_number(row, k) != b.column_number(row, k))
+          return false;
+    }
+  return true;
+}
+
+
+
+void
+test()
+{
+  const unsigned int n = 5000;
+
+  DynamicSparsityPattern serial(n, n);
+  for (unsigned int row = 0; row < n; ++row)
+    fill_row(serial, row);
+  deallog << "n_nonzero_elements: " << serial.n_nonzero_elements()
+          << std::endl;
+
+  DynamicSparsityPattern concurrent(n, n);
+  parallel::apply_to_subranges(
+    0U,
+    n,
+    [&concurrent](const unsigned int begin, const unsigned int end) {
+      for (unsigned int row = begin; row < end; ++row)
+        fill_row(concurrent, row);
+    },
+    50);
+  deallog << "concurrent add: "
+          << (equal(serial, concurrent) ? "OK" : "FAILED") << std::endl;
+
+  // clear every other row and fill it again
+  for (unsigned int row = 0; row < n; row += 2)
+    concurrent.clear_row(row);
+  deallog << "after clear_row: " << concurrent.n_nonzero_elements()
+          << std::endl;
+  for (unsigned int row = 0; row < n; row += 2)
+    fill_row(concurrent, row);
+  deallog << "refill: " << (equal(serial, concurrent) ? "OK" : "FAILED")
+          << std::endl;
+
+  // reinit() releases all memory to the pool, the pattern must be empty
+  // afterwards and reusable
+  concurrent.reinit(n, n);
+  deallog << "after reinit: " << concurrent.n_nonzero_elements() << std::endl;
+  for (unsigned int row = 0; row < n; ++row)
+    fill_row(concurrent, row);
+  deallog << "reuse: " << (equal(serial, concurrent) ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test();
+}
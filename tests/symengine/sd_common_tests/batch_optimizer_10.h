@@ -0,0 +1,169 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that BatchOptimizer::optimize() with a cache directory gives an
+// optimizer that evaluates the same values, whether the optimizer is read
+// from the cache or not, that the second run really reads it from the cache,
+// and that BatchOptimizer::substitute_and_evaluate() gives the same values as
+// substitute() for each lane of a VectorizedArray without changing the values
+// stored by the last call to substitute().
+// The cache is kept in a fresh directory that is removed at the end, so
+// that each run of the test checks both a cold and a warm cache.
+
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/differentiation/sd.h>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../../tests.h"
+
+using namespace dealii;
+namespace SD = Differentiation::SD;
+
+
+// Return the names of the files in the given directory
+std::vector<std::string>
+list_files(const std::string &directory)
+{
+  std::vector<std::string> files;
+  if (DIR *dir = opendir(directory.c_str()))
+    {
+      while (const dirent *entry = readdir(dir))
+        if (std::string(entry->d_name) != "." &&
+            std::string(entry->d_name) != "..")
+          files.emplace_back(entry->d_name);
+      closedir(dir);
+    }
+  return files;
+}
+
+
+// Remove the given directory and the files in it, if it exists
+void
+remove_directory(const std::string &directory)
+{
+  for (const std::string &file : list_files(directory))
+    std::remove((directory + "/" + file).c_str());
+  rmdir(directory.c_str());
+}
+
+
+template <typename NumberType,
+          enum SD::OptimizerType     opt_method,
+          enum SD::OptimizationFlags opt_flags>
+void
+test_cache()
+{
+  using SD_number_t = SD::Expression;
+
+  // Define
+  const SD_number_t x("x"), y("y");
+  const SD_number_t f = x * y;
+  const SD_number_t g = x / y + x * x;
+
+  // Substitution map
+  const SD::types::substitution_map sub_vals =
+    SD::make_substitution_map(std::make_pair(x, NumberType(10.0)),
+                              std::make_pair(y, NumberType(2.0)));
+
+  // Start with an empty cache directory, also if a previous run of this
+  // test has been aborted
+  const std::string cache_directory =
+    std::string("batch_optimizer_cache_") +
+    (std::is_same<NumberType, float>::value ? "float" : "double");
+  remove_directory(cache_directory);
+  AssertThrow(mkdir(cache_directory.c_str(), 0755) == 0,
+              ExcMessage("Could not create directory " + cache_directory));
+
+  // The first run fills the cache, the second one reads from it
+  for (unsigned int run = 0; run < 2; ++run)
+    {
+      deallog << "Run " << run
+              << ": cached files: " << list_files(cache_directory).size()
+              << std::endl;
+
+      SD::BatchOptimizer<NumberType> optimizer(opt_method, opt_flags);
+      optimizer.register_symbols(SD::make_symbol_map(x, y));
+      optimizer.register_functions(f, g);
+      const bool loaded = optimizer.optimize(cache_directory);
+      Assert(optimizer.optimized() == true,
+             ExcMessage("Expected optimizer to be optimized."));
+      deallog << "Run " << run << ": loaded from cache: " << loaded
+              << std::endl;
+
+      optimizer.substitute(sub_vals);
+      deallog << "Run " << run << ": f(x,y): " << optimizer.evaluate(f)
+              << ", g(x,y): " << optimizer.evaluate(g) << std::endl;
+    }
+
+  remove_directory(cache_directory);
+
+  // Evaluate for all lanes of a VectorizedArray at once, passing the symbols
+  // in a different order than the one they are stored in
+  SD::BatchOptimizer<NumberType> optimizer(opt_method, opt_flags);
+  optimizer.register_symbols(SD::make_symbol_map(x, y));
+  optimizer.register_functions(f, g);
+  optimizer.optimize();
+  optimizer.substitute(sub_vals);
+
+  std::vector<VectorizedArray<NumberType>> values(2);
+  for (unsigned int v = 0; v < VectorizedArray<NumberType>::size(); ++v)
+    {
+      values[0][v] = NumberType(1.0 + v);
+      values[1][v] = NumberType(2.0 + 0.5 * v);
+    }
+  const std::vector<VectorizedArray<NumberType>> results =
+    optimizer.substitute_and_evaluate({y, x}, {values[1], values[0]});
+
+  bool ok = std::abs(optimizer.evaluate(f) - NumberType(20.0)) < 1e-6 &&
+            std::abs(optimizer.evaluate(g) - NumberType(105.0)) < 1e-6;
+  for (unsigned int v = 0; v < VectorizedArray<NumberType>::size(); ++v)
+    {
+      optimizer.substitute(
+        SD::make_substitution_map(std::make_pair(x, values[0][v]),
+                                  std::make_pair(y, values[1][v])));
+      ok &= std::abs(optimizer.extract(f, results)[v] -
+                     optimizer.evaluate(f)) < 1e-6;
+      ok &= std::abs(optimizer.extract(g, results)[v] -
+                     optimizer.evaluate(g)) < 1e-6;
+    }
+  deallog << "VectorizedArray: " << (ok ? "OK" : "FAILED") << std::endl;
+}
+
+
+template <enum SD::OptimizerType     opt_method,
+          enum SD::OptimizationFlags opt_flags>
+void
+run_tests()
+{
+  deallog.push("Float");
+  test_cache<float, opt_method, opt_flags>();
+  deallog.pop();
+
+  deallog.push("Double");
+  test_cache<double, opt_method, opt_flags>();
+  deallog.pop();
+
+  deallog << "OK" << std::endl;
+}